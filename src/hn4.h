@@ -204,6 +204,8 @@ typedef uint8_t  hn4_byte_t;
 
 /* Extended Hardware Flag */
 #define HN4_HW_FILE_BACKED      (1ULL << 63) /* HAL indicates target is a disk image file */
+#define HN4_HW_SIMULATED        (1ULL << 61) /* HAL device is a software timing model */
+#define HN4_HW_MEDIA_ECC        (1ULL << 60) /* Media ECC covers every read (PMEM w/ poison) */
 
 /* Volume State Flags (sb.state_flags) */
 #define HN4_VOL_CLEAN           (1 << 0)
@@ -237,6 +239,10 @@ typedef uint8_t  hn4_byte_t;
 #define HN4_FLAG_EXTENDED       (1ULL << 23) /* Inline Buffer holds Ext LBA */
 #define HN4_FLAG_RESERVED       (1ULL << 26) /* Transient allocation lock */
 #define HN4_FLAG_UNLINKED       (1ULL << 27) /* Soft-delete state */
+/* Bits 24-27 also carry HN4_AI_TYPE_MASK; bit 28 is HN4_FLAG_SIGNED (hn4_tensor.c) */
+#define HN4_HINT_ELEM_SHIFT     29           /* Element width: 0 none, 1/2/3 = 2/4/8 bytes */
+#define HN4_HINT_ELEM_MASK      (3ULL << 29) /* Shuffle before compressing (hn4_shuffle) */
+#define HN4_HINT_BITSHUFFLE     (1ULL << 31) /* Bit planes instead of byte planes */
 
 /* Add to On-Disk Structures */
 #define HN4_MAGIC_NANO          0x4E414E4F   /* "NANO" - Magic for data slots */
@@ -326,6 +332,9 @@ typedef union HN4_PACKED {
         uint64_t    magic_tail;         /* 0xEFBEADDE */
         hn4_addr_t  boot_map_ptr;       /* Pointer to Static Boot Map File */
         uint64_t    last_journal_seq;   /* High-water mark of log sequence */
+        uint64_t    lexicon_lba;        /* Newest trained TCC lexicon (sector LBA, 0 = none) */
+        uint32_t    lexicon_gen;        /* Its generation (hn4_lexicon.h) */
+        uint32_t    ns_generation;      /* Moves when a tensor shard joins, leaves or renames (manifests) */
         /* Pad remaining bytes is implicit in the Union */
     } info;
 
@@ -374,6 +383,7 @@ typedef struct HN4_PACKED {
 #define HN4_COMP_ALGO_MASK      0x0F
 #define HN4_COMP_NONE           0
 #define HN4_COMP_TCC            3
+#define HN4_COMP_TCC_SHUFFLE    4   /* payload[0] = shuffle filter, then TCC */
 #define HN4_COMP_SIZE_SHIFT     4   /* Bits 4-31 are size */
 
 #define HN4_CRC_SEED_HEADER 0xFFFFFFFFU
@@ -389,6 +399,9 @@ typedef struct HN4_PACKED {
 #define HN4_EXT_TYPE_TAG 0x01
 #define HN4_EXT_TYPE_LONGNAME 0x02
 
+#define HN4_EXT_TYPE_ORBITMAP   0x04    /* Per-file orbit map (hn4_orbitmap.h) */
+#define HN4_EXT_TYPE_LEXICON    0x05    /* Trained TCC lexicon (hn4_lexicon.h) */
+
 #define HN4_EXT_TYPE_SIGNET     0x99
 #define HN4_SIGNET_MAGIC        0x5349474E /* "SIGN" in ASCII */
 #define HN4_SIGNET_VERSION      3          
@@ -448,6 +461,13 @@ typedef struct HN4_PACKED {
 #define HN4_AI_TYPE_MANIFEST    (0x4000000ULL)
 #define HN4_AI_TYPE_TAG_DEF     (0x5000000ULL)
 
+/* KV_CACHE .. TAG_DEF never stream as tensor shards (hn4_tensor_open skips them) */
+#define HN4_AI_TYPE_IS_AUX(dc)  ((((dc) & HN4_AI_TYPE_MASK) >= HN4_AI_TYPE_KV_CACHE) && \
+                                 (((dc) & HN4_AI_TYPE_MASK) <= HN4_AI_TYPE_TAG_DEF))
+
+_Static_assert(((HN4_HINT_ELEM_MASK | HN4_HINT_BITSHUFFLE) & HN4_AI_TYPE_MASK) == 0,
+               "Shuffle hints must not overlap the AI type field");
+
 /* Extension Types */
 #define HN4_EXT_TYPE_VECTOR     0xAA
 
@@ -600,12 +620,26 @@ typedef struct HN4_PACKED HN4_ALIGNED(16) {
     #include <stdatomic.h>
 #endif
 
+/*
+ * Exclusive holders own 'flag'. The lock doubles as a writer-preferring
+ * reader-writer lock: shared holders are counted in 'rw_state' and back
+ * off while HN4_RW_WRITER is set. All-zero is unlocked.
+ */
 typedef struct {
-    atomic_flag flag;
-    uint32_t    pad;
+    atomic_flag      flag;
+    _Atomic uint32_t rw_state;
 } hn4_spinlock_t;
 
+#define HN4_RW_WRITER           (1U << 31)
+
+/* FIFO ticket lock. Fair under contention. All-zero is unlocked. */
+typedef struct {
+    _Atomic uint32_t next;
+    _Atomic uint32_t serving;
+} hn4_ticket_lock_t;
+
 #define HN4_MEDIC_QUEUE_SIZE 64
+#define HN4_MEDIC_REPAIR_SLOTS 32
 
 #define HN4_CORTEX_SHARD_BITS   6
 #define HN4_CORTEX_SHARDS       (1 << HN4_CORTEX_SHARD_BITS) /* 64 */
@@ -615,10 +649,25 @@ typedef struct {
     uint32_t score; /* (Density * Entropy) */
 } hn4_medic_entry_t;
 
+/* Deferred block repair (Auto-Medic). 'payload' is a verified good copy. */
+typedef struct {
+    hn4_addr_t  bad_lba;
+    void*       payload;
+    uint32_t    len;
+} hn4_medic_repair_t;
+
 typedef struct {
     hn4_medic_entry_t entries[HN4_MEDIC_QUEUE_SIZE];
     uint32_t count;
-    hn4_spinlock_t lock;
+    hn4_ticket_lock_t lock;
+
+    /* Auto-Medic backlog. Filled by readers, drained by the Scavenger. */
+    hn4_medic_repair_t repairs[HN4_MEDIC_REPAIR_SLOTS];
+    _Atomic uint32_t repair_count;
+
+    /* Blocks of the batch being applied. hn4_free_block waits on them. */
+    uint64_t claimed[HN4_MEDIC_REPAIR_SLOTS];
+    _Atomic uint32_t claim_count;
 } hn4_medic_queue_t;
 
 /* The Synapse Handle (Open File Context) */
@@ -751,6 +800,45 @@ typedef struct {
     hn4_medic_queue_t   medic_queue;
     int64_t             last_log_ts;
 
+    /* Coarse Clock (hn4_hal_get_vol_tick). Zero until first use. */
+    _Atomic uint64_t    clock_tick;
+
+    /* Per-file Orbit Maps (hn4_orbitmap.c). Created on first use. */
+    _Atomic(struct hn4_orbit_cache*) orbit_cache;
+
+    /* Block -> LBA memo for overwrites (hn4_residency.c). Created on first use. */
+    _Atomic(struct hn4_residency_cache*) residency_cache;
+
+    /* Compression workers for multi-block writes (hn4_write_blocks_atomic). Created on first use. */
+    _Atomic(struct hn4_hal_workq*) comp_workq;
+
+    /* Block I/O workers for tensor streams (hn4_tensor.c). Created on first use. */
+    _Atomic(struct hn4_hal_workq*) tensor_workq;
+
+    /* Per-file compression outcomes (hn4_compstat.c). Created on first use. */
+    _Atomic(struct hn4_compstat_cache*) compstat_cache;
+
+    /* Trained TCC lexicon generations (hn4_lexicon.c). Loaded at mount. */
+    _Atomic(struct hn4_lexicon_set*) lexicon_set;
+
+    /* HN4_INCOMPAT_* encodings first written this mount. OR-ed into every SB persisted. */
+    _Atomic uint64_t    incompat_written;
+
+    /* Live SB ns_generation (tensor manifests). Loaded at mount, stored with every SB persisted. */
+    _Atomic uint32_t    ns_generation;
+
+    /* Bytes of POSIX write-back images held by all open handles (hn4_posix.c). */
+    _Atomic uint64_t    wb_bytes;
+
+    /* Read Verification (hn4_read_set_integrity). Zero = full. */
+    struct {
+        _Atomic uint32_t    effective;      /* HN4_INTEGRITY_* in force */
+        uint32_t            requested;      /* As asked for at mount */
+        uint64_t            health_sig;     /* Health counters when granted */
+        uint64_t            scrub_cursor;   /* Scavenger scrub position (block) */
+        _Atomic uint64_t    scrubbed;       /* Blocks payload-checked by scrub */
+    } integrity;
+
     struct HN4_ALIGNED(HN4_CACHE_LINE_SIZE) {
         hn4_delta_entry_t delta_table[HN4_DELTA_TABLE_SIZE];
     } redirect;
@@ -832,6 +920,12 @@ typedef struct {
     uint32_t st_blksize;
 } hn4_vfs_stat_t;
 
+/* Read Verification Tiers (hn4_mount_params_t.integrity_level) */
+#define HN4_INTEGRITY_FULL      0   /* Header + payload CRC on every read */
+#define HN4_INTEGRITY_HEADER    1   /* Header CRC + identity; payload CRC by scrub */
+#define HN4_INTEGRITY_STRICT    2   /* Alias of FULL */
+#define HN4_INTEGRITY_TRUST     3   /* Identity only. Needs NVM + HN4_HW_MEDIA_ECC */
+
 /* Mount Parameters */
 typedef struct {
     uint64_t mount_flags;    /* e.g. HN4_MNT_READ_ONLY */
@@ -22,6 +22,8 @@
 #include "hn4_addr.h"
 #include "hn4_endians.h"
 #include "hn4_annotations.h"
+#include "hn4_allocator.h"
+#include "hn4_repair.h"
 
     
 
@@ -1480,42 +1482,44 @@ hn4_alloc_genesis(
                 if (vol->sb.info.format_profile == HN4_PROFILE_AI && vol->topo_map) {
 
                     uint32_t gpu_id = hn4_hal_get_calling_gpu_id();
-                    
-                    /* 0xFFFFFFFF indicates generic CPU context */
-                    if (gpu_id != 0xFFFFFFFF) {
-                        for (uint32_t i = 0; i < vol->topo_count; i++) {
-                            if (vol->topo_map[i].gpu_id == gpu_id) {
-                                
-                                uint64_t range_start_blk = vol->topo_map[i].lba_start / sec_per_blk;
-                                uint64_t range_len_blk   = vol->topo_map[i].lba_len / sec_per_blk;
+                    bool     cpu    = (gpu_id == 0xFFFFFFFF);
 
-                                if (range_start_blk >= flux_aligned_blk && 
-                                   (range_start_blk + range_len_blk) <= total_blocks) 
-                                {
-                                    uint64_t rel_start = range_start_blk - flux_aligned_blk;
-                                    
-                                    uint64_t rel_aligned = (rel_start + (S - 1)) & ~(S - 1);
+                    /* 0xFFFFFFFF indicates generic CPU context: bias to its NUMA node's slice */
+                    if (cpu) gpu_id = HN4_TOPO_NUMA_TAG | hn4_hal_numa_current_node();
+
+                    for (uint32_t i = 0; i < vol->topo_count; i++) {
+                        if (vol->topo_map[i].gpu_id == gpu_id) {
+                            
+                            uint64_t range_start_blk = vol->topo_map[i].lba_start / sec_per_blk;
+                            uint64_t range_len_blk   = vol->topo_map[i].lba_len / sec_per_blk;
+
+                            if (range_start_blk >= flux_aligned_blk && 
+                               (range_start_blk + range_len_blk) <= total_blocks) 
+                            {
+                                uint64_t rel_start = range_start_blk - flux_aligned_blk;
+                                
+                                uint64_t rel_aligned = (rel_start + (S - 1)) & ~(S - 1);
+                                
+                                if (rel_aligned < (rel_start + range_len_blk)) {
+                                    uint64_t len_aligned = (rel_start + range_len_blk) - rel_aligned;
                                     
-                                    if (rel_aligned < (rel_start + range_len_blk)) {
-                                        uint64_t len_aligned = (rel_start + range_len_blk) - rel_aligned;
-                                        
-                                        win_base = rel_aligned / S;
-                                        win_phi  = len_aligned / S;
-
-                                        if (win_phi > 0) {
-                                            if (win_base + win_phi > phi) {
-                                                win_phi = phi - win_base;
-                                            }
-                                            use_affinity = true;
+                                    win_base = rel_aligned / S;
+                                    win_phi  = len_aligned / S;
+
+                                    if (win_phi > 0) {
+                                        if (win_base + win_phi > phi) {
+                                            win_phi = phi - win_base;
                                         }
+                                        use_affinity = true;
                                     }
                                 }
-                                break;
                             }
+                            break;
                         }
                     }
                     
-                    if (!use_affinity) {
+                    /* Single-node hosts carry no node slices; CPU callers just go global */
+                    if (!use_affinity && !cpu) {
                         /* Rate-limited warning logic suppressed for clarity */
                         HN4_LOG_WARN("AI Allocator: Topology lookup failed for GPU %u. Using Global.", gpu_id);
                     }
@@ -1917,6 +1921,9 @@ void hn4_free_block(HN4_INOUT hn4_volume_t* vol, hn4_addr_t phys_lba) {
         return;
     }
 
+    /* No Auto-Medic repair may land once the block can be reallocated */
+    hn4_repair_fence(vol, block_idx);
+
     _bitmap_op(vol, block_idx, BIT_CLEAR, NULL);
 }
 
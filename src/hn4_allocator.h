@@ -0,0 +1,63 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Void Allocator (Bitmap & Horizon)
+ * HEADER:      hn4_allocator.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Entry points of hn4_allocator.c used by modules that place or release
+ * metadata blocks outside the ballistic write path: extension chains,
+ * lexicons, the Auto-Medic and the residency probe.
+ */
+
+#ifndef HN4_ALLOCATOR_H
+#define HN4_ALLOCATOR_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * _bitmap_op
+ * Sets, clears or tests one bit of the Void Bitmap ('block_idx' is in FS
+ * blocks). BIT_TEST reports the state through 'out_result'.
+ */
+HN4_HOT
+_Check_return_
+hn4_result_t _bitmap_op(
+    HN4_INOUT   hn4_volume_t* vol,
+    HN4_IN      uint64_t      block_idx,
+    HN4_IN      hn4_bit_op_t  op,
+    HN4_OUT_OPT bool*         out_result
+);
+
+/**
+ * hn4_alloc_horizon
+ * Claims one block from the Horizon ring. Returns its sector address.
+ * HN4_ERR_ENOSPC once the head meets the tail.
+ */
+_Check_return_
+hn4_result_t hn4_alloc_horizon(
+    HN4_INOUT hn4_volume_t* vol,
+    HN4_OUT   hn4_addr_t*   out_phys_lba
+);
+
+/**
+ * hn4_free_block
+ * Releases the block at sector address 'phys_lba' back to the Void Bitmap.
+ */
+void hn4_free_block(
+    HN4_INOUT hn4_volume_t* vol,
+    HN4_IN    hn4_addr_t    phys_lba
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_ALLOCATOR_H */
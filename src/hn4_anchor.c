@@ -13,6 +13,7 @@
  */
 
 #include "hn4_anchor.h"
+#include "hn4_tensor.h"
 #include "hn4_crc.h"
 #include "hn4_endians.h"
 #include "hn4_errors.h"
@@ -212,6 +213,33 @@ hn4_result_t hn4_anchor_write_genesis(hn4_hal_device_t* dev, const hn4_superbloc
     return hn4_hal_sync_io(dev, HN4_IO_FLUSH, hn4_addr_from_u64(0), NULL, 0);
 }
 
+/*
+ * _anchor_moves_namespace
+ * True when persisting 'next' over 'prev' (NULL = empty slot) can change
+ * the shard set of a tensor manifest: a tagged shard candidate appears,
+ * leaves (tombstone), is retagged or renamed. Untagged Anchors and the
+ * auxiliary AI types (KV freezes, graphs, manifests) never count.
+ */
+static bool _anchor_in_tensor_ns(const hn4_anchor_t* a)
+{
+    return a->tag_filter != 0 && !HN4_AI_TYPE_IS_AUX(hn4_le64_to_cpu(a->data_class));
+}
+
+static bool _anchor_moves_namespace(const hn4_anchor_t* prev, const hn4_anchor_t* next)
+{
+    const uint64_t live = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_FLAG_TOMBSTONE | HN4_FLAG_EXTENDED);
+
+    bool was = prev && _anchor_in_tensor_ns(prev);
+    bool is  = _anchor_in_tensor_ns(next);
+
+    if (!was && !is) return false;
+    if (was != is) return true;
+
+    return prev->tag_filter != next->tag_filter ||
+           (prev->data_class & live) != (next->data_class & live) ||
+           memcmp(prev->inline_buffer, next->inline_buffer, sizeof(prev->inline_buffer)) != 0;
+}
+
 /**
  * hn4_write_anchor_atomic
  * 
@@ -273,6 +301,7 @@ hn4_result_t hn4_write_anchor_atomic(
     
     uint64_t start_slot = h % total_slots;
     uint64_t target_slot = UINT64_MAX;
+    bool     ns_moved    = false;
 
     /* 
      * LINEAR PROBE LOGIC
@@ -317,6 +346,7 @@ hn4_result_t hn4_write_anchor_atomic(
         
         if (is_empty || is_us) {
             target_slot = curr_slot;
+            ns_moved    = _anchor_moves_namespace(is_empty ? NULL : cand, anchor);
             
             /* 
              * Optimization: Since we already read the sector into io_buf, 
@@ -367,6 +397,18 @@ hn4_result_t hn4_write_anchor_atomic(
         if (!(vol->sb.info.hw_caps_flags & HN4_HW_NVM)) {
             hn4_hal_barrier(vol->target_device);
         }
+
+        /* Cache Coherency: RAM-served lookups must see the committed slot */
+        if (vol->nano_cortex && target_slot < vol->cortex_size / sizeof(hn4_anchor_t)) {
+            hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+            ((hn4_anchor_t*)vol->nano_cortex)[target_slot] = *anchor;
+            hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        }
+
+        /* Tensor manifests indexed before this point are now stale; ours is refreshed */
+        uint32_t gen_from = ns_moved ? atomic_fetch_add(&vol->ns_generation, 1)
+                                     : atomic_load(&vol->ns_generation);
+        hn4_tensor_note_commit(vol, anchor, gen_from, gen_from + (ns_moved ? 1 : 0));
     }
 
     hn4_hal_mem_free(io_buf);
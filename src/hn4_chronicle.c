@@ -35,7 +35,7 @@ _Static_assert(sizeof(hn4_addr_t) == 8, "Chronicle requires 64-bit hn4_addr_t");
 #define HN4_CHRONICLE_MAX_VERIFY_DEPTH 65536
 
 static void _log_ratelimited(hn4_volume_t* vol, const char* msg, uint64_t val) {
-    hn4_time_t now = hn4_hal_get_time_ns();
+    hn4_time_t now = hn4_hal_get_vol_tick(vol);
     if ((now - vol->last_log_ts) > HN4_LOG_RATE_LIMIT_NS) {
         HN4_LOG_CRIT("%s (Val: %llu)", msg, (unsigned long long)val);
         vol->last_log_ts = now;
@@ -99,6 +99,8 @@ static hn4_result_t _persist_superblock_state(hn4_hal_device_t* dev, hn4_volume_
     hn4_sb_to_disk(&vol->sb, (hn4_superblock_t*)sb_buf);
     
     hn4_superblock_t* dsb = (hn4_superblock_t*)sb_buf;
+    dsb->info.incompat_flags |= hn4_cpu_to_le64(atomic_load(&vol->incompat_written));
+    dsb->info.ns_generation   = hn4_cpu_to_le32(atomic_load(&vol->ns_generation));
     dsb->raw.sb_crc = 0;
     uint32_t sb_crc = hn4_crc32(0, dsb, HN4_SB_SIZE - 4);
     dsb->raw.sb_crc = hn4_cpu_to_le32(sb_crc);
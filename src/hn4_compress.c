@@ -36,8 +36,19 @@
     #include "hn4_endians.h"
     #include <string.h>
 
+    #if defined(_MSC_VER)
+    #include <intrin.h>
+    #endif
+
     #if defined(__x86_64__) || defined(_M_X64)
     #include <immintrin.h>
+    /* SSE2 is baseline on x86-64; AVX2 kernels are dispatched at runtime */
+    #define HN4_TCC_VEC 1
+    #if defined(__GNUC__) || defined(__clang__)
+        #define HN4_TCC_AVX2_FN __attribute__((target("avx2,bmi2")))
+    #else
+        #define HN4_TCC_AVX2_FN
+    #endif
     #endif
 
     /* =========================================================================
@@ -90,6 +101,26 @@
     #define HN4_EXT_ESCAPE          0x00 
     #define HN4_EXT_OP_LEXICON      0x01
     #define HN4_EXT_OP_MANIFOLD     0x02
+    #define HN4_EXT_OP_ECHO         0x03
+    #define HN4_EXT_OP_ENTROPY      0x04    /* Leading header only (see 3b) */
+    #define HN4_EXT_OP_BIND         0x05    /* Leading: [00][05][Generation LE32] */
+    #define HN4_BIND_SIZE           6
+
+    /*
+     * ECHO (Back-Reference): [ESC] [0x03] [Offset LE16] [VarInt Len - MIN]
+     * Repeats 'Len' bytes starting 'Offset' bytes back in the output. The
+     * source may overlap the destination (Offset < Len).
+     */
+    #define HN4_ECHO_MIN_MATCH      8       /* Token is 5 bytes; must save >= 3 */
+    #define HN4_ECHO_MAX_MATCH      (HN4_MAX_TOKEN_LEN + HN4_ECHO_MIN_MATCH)
+    #define HN4_ECHO_MAX_OFFSET     65535
+    #define HN4_ECHO_HASH_BITS      12
+    #define HN4_ECHO_DEPTH_FAST     8       /* Chain probes, SSD/NVM/ZNS */
+    #define HN4_ECHO_DEPTH_DEEP     48      /* Chain probes, HDD (ratio priority) */
+    #define HN4_ECHO_MIN_INPUT      32      /* Below this the tables cost more than they find */
+
+    #define HN4_HUF_MAX_BITS        11      /* 2K-entry decode table */
+    #define HN4_HUF_MIN_LITERALS    128     /* Fewer literals never pay for the table */
 
 typedef struct {
     const char* str;
@@ -138,6 +169,121 @@ _Static_assert(sizeof(_hn4_lexicon_table) / sizeof(hn4_lexicon_entry_t) == HN4_L
         return v; 
     }
 
+/* x != 0 */
+HN4_INLINE uint32_t _tcc_ctz32(uint32_t x)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long r;
+    _BitScanForward(&r, x);
+    return (uint32_t)r;
+#else
+    return (uint32_t)__builtin_ctz(x);
+#endif
+}
+
+HN4_INLINE uint32_t _tcc_popcount32(uint32_t x)
+{
+    x = x - ((x >> 1) & 0x55555555U);
+    x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+    return (((x + (x >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24;
+}
+
+/*
+ * SCANNERS
+ * Compare-and-movemask over 32 bytes per step (two SSE2 lanes). Each one
+ * returns exactly what the byte loop it replaced returned, so the token
+ * stream is unchanged.
+ */
+
+/* ISOTOPE: first byte in [p, end) that is not 'v' */
+HN4_INLINE const uint8_t* _tcc_scan_run(const uint8_t* p, const uint8_t* end, uint8_t v)
+{
+#if defined(HN4_TCC_VEC)
+    const __m128i b = _mm_set1_epi8((char)v);
+    while ((size_t)(end - p) >= 32) {
+        uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), b)) |
+                      ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + 16)), b)) << 16);
+        if (eq != 0xFFFFFFFFU) return p + _tcc_ctz32(~eq);
+        p += 32;
+    }
+#endif
+    while (p < end && *p == v) p++;
+    return p;
+}
+
+/*
+ * GRADIENT: end of the progression p[i] == p[0] + i * slope. The values
+ * must stay in 0..255, which caps the length up front; below the cap the
+ * lanes can be compared mod 256.
+ */
+HN4_INLINE const uint8_t* _tcc_scan_ramp(const uint8_t* p, const uint8_t* end, int8_t slope)
+{
+    uint8_t  v0  = p[0];
+    size_t   cap = (slope > 0) ? (size_t)(255 - v0) / (size_t)slope + 1
+                               : (size_t)v0 / (size_t)(-slope) + 1;
+    if ((size_t)(end - p) < cap) cap = (size_t)(end - p);
+
+    const uint8_t* stop = p + cap;
+    const uint8_t* q    = p;
+    uint8_t        v    = v0;
+
+#if defined(HN4_TCC_VEC)
+    if (cap >= 16) {
+        uint8_t lane[16];
+        for (int i = 0; i < 16; i++) lane[i] = (uint8_t)(v0 + i * slope);
+
+        __m128i r    = _mm_loadu_si128((const __m128i*)lane);
+        __m128i step = _mm_set1_epi8((char)(uint8_t)(slope * 16));
+
+        while ((size_t)(stop - q) >= 16) {
+            uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)q), r));
+            if (eq != 0xFFFFU) return q + _tcc_ctz32(~eq);
+            r = _mm_add_epi8(r, step);
+            q += 16;
+        }
+        v = (uint8_t)_mm_cvtsi128_si32(r);
+    }
+#endif
+    while (q < stop && *q == v) {
+        q++;
+        v = (uint8_t)(v + slope);
+    }
+    return q;
+}
+
+/*
+ * BITMASK: one bit per non-zero 32-bit word of p[0 .. 8*mask_bytes words),
+ * 'words' words in total (trailing bits of the last byte stay 0). Returns
+ * the number of non-zero words; 'mask' may be NULL to only count.
+ */
+static uint32_t _tcc_scan_words(const uint8_t* p, uint32_t words, uint8_t* mask)
+{
+    uint32_t nz = 0;
+    uint32_t i  = 0;
+
+#if defined(HN4_TCC_VEC)
+    const __m128i z = _mm_setzero_si128();
+    for (; i + 8 <= words; i += 8) {
+        uint32_t zero = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(
+                            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + 4 * i)), z))) |
+                        ((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(
+                            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p + 4 * i + 16)), z))) << 4);
+        uint8_t bits = (uint8_t)~zero;
+        nz += _tcc_popcount32(bits);
+        if (mask) mask[i / 8] = bits;
+    }
+#endif
+    for (; i < words; i++) {
+        uint32_t w;
+        memcpy(&w, p + 4 * i, 4);
+        if (w != 0) {
+            nz++;
+            if (mask) mask[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+    }
+    return nz;
+}
+
     /**
      * _tcc_detect_linear_gradient
      * Detects STRICT linear arithmetic progression: f(x) = mx + c.
@@ -305,6 +451,26 @@ _Static_assert(sizeof(_hn4_lexicon_table) / sizeof(hn4_lexicon_entry_t) == HN4_L
     * ========================================================================= */
 
     
+    /*
+ * _tcc_bitmask_extent
+ * Stops a BITMASK span at the first 32-byte stretch of one repeated
+ * non-zero byte. Packed as mask words it costs its full size; left to
+ * ISOTOPE it is a 3-byte token (bit-plane filled blocks are made of these).
+ */
+static size_t _tcc_bitmask_extent(const uint8_t* ip, size_t max_scan)
+{
+    for (size_t off = 0; off + 32 <= max_scan; off += 32) {
+        if (ip[off] == 0) continue;
+
+        uint64_t pattern = (uint64_t)ip[off] * 0x0101010101010101ULL;
+        if (_tcc_load64(ip + off)      == pattern && _tcc_load64(ip + off + 8)  == pattern &&
+            _tcc_load64(ip + off + 16) == pattern && _tcc_load64(ip + off + 24) == pattern) {
+            return off;
+        }
+    }
+    return max_scan;
+}
+
     /*
  * _tcc_attempt_bitmask
  * Scans for sparse data patterns.
@@ -326,22 +492,13 @@ static uint32_t _tcc_attempt_bitmask(
     if (max_scan > HN4_MAX_TOKEN_LEN) {
         max_scan = HN4_MAX_TOKEN_LEN & ~(HN4_TSM_GRANULARITY - 1);
     }
-    
+
+    max_scan = _tcc_bitmask_extent(ip, max_scan);
     if (max_scan < 32) return 0;
 
     /* PASS 1: Analysis */
-    uint32_t non_zero_words = 0;
     uint32_t total_words = (uint32_t)(max_scan / HN4_TSM_GRANULARITY);
-    
-    /* 
-     * Optimization: Use aligned access. 
-     * Caller guarantees ip is 4-byte aligned via `((uintptr_t)ip & 3) == 0`.
-     */
-    const uint32_t* word_ptr = (const uint32_t*)ip;
-    
-    for (uint32_t i = 0; i < total_words; i++) {
-        if (word_ptr[i] != 0) non_zero_words++;
-    }
+    uint32_t non_zero_words = _tcc_scan_words(ip, total_words, NULL);
     
    /* Require at least 12.5% sparsity (7/8 density) */
    if (non_zero_words > (total_words - (total_words >> 3))) return 0;
@@ -376,14 +533,16 @@ static uint32_t _tcc_attempt_bitmask(
     
     memset(mask_out, 0, mask_bytes);
     
-    /* PASS 2: Encoding */
-    for (uint32_t i = 0; i < total_words; i++) {
-        uint32_t val = word_ptr[i];
-        
-        if (val != 0) {
-            mask_out[i / 8] |= (1 << (i % 8));
+    /* PASS 2: Encoding. Mask first, then pack the words it marks. */
+    (void)_tcc_scan_words(ip, total_words, mask_out);
+
+    for (uint32_t m = 0; m < mask_bytes; m++) {
+        uint32_t bits = mask_out[m];
+        while (bits) {
+            uint32_t i = m * 8 + _tcc_ctz32(bits);
             memcpy(data_out, ip + (i * 4), 4);
             data_out += 4;
+            bits &= bits - 1;
         }
     }
 
@@ -483,8 +642,10 @@ static int _tcc_scan_lexicon(const uint8_t* ip, const uint8_t* iend) {
             return -1;
     }
 
-    /* Linear scan of HN4_LEXICON_COUNT (64) */
+    /* Linear scan of HN4_LEXICON_COUNT (64); first byte filters before memcmp */
     for (int i = 0; i < HN4_LEXICON_COUNT; i++) {
+        if ((uint8_t)_hn4_lexicon_table[i].str[0] != c) continue;
+
         size_t len = _hn4_lexicon_table[i].len;
         if (avail >= len) {
             if (memcmp(ip, _hn4_lexicon_table[i].str, len) == 0) return i;
@@ -495,6 +656,18 @@ static int _tcc_scan_lexicon(const uint8_t* ip, const uint8_t* iend) {
 
 
 
+/* LEXICON: Trained entries. One bucket per first byte, longest first. */
+static int _tcc_scan_trained(const uint8_t* ip, const uint8_t* iend, const hn4_tcc_lexicon_t* lex) {
+    size_t  avail = (size_t)(iend - ip);
+    uint8_t c     = ip[0];
+
+    for (uint32_t i = lex->start[c]; i < lex->start[c + 1]; i++) {
+        size_t len = lex->len[i];
+        if (avail >= len && memcmp(ip, lex->data + lex->off[i], len) == 0) return (int)i;
+    }
+    return -1;
+}
+
 /* LEXICON: Emit (Write Only) */
 static uint8_t* _tcc_emit_lexicon(uint8_t* op, const uint8_t* oend, int idx) {
     /* Need 3 bytes: ESC + OP + IDX */
@@ -575,22 +748,141 @@ static uint8_t* _tcc_emit_manifold(uint8_t* op, const uint8_t* oend,
     return op;
 }
 
+/*
+ * ECHO: Hash-Chain Match Finder
+ * head[] holds the newest position (+1) per 4-byte hash, chain[] the
+ * distance to the previous position with the same hash. chain[] is a
+ * ring of 'mask + 1' entries, sized to the block (capped at 64K), so
+ * every position within the window still has its own link.
+ */
+typedef struct {
+    const uint8_t*  base;
+    uint32_t*       head;       /* [1 << HN4_ECHO_HASH_BITS], pos + 1, 0 = empty */
+    uint16_t*       chain;      /* [mask + 1], 0 = end of chain */
+    uint32_t        mask;
+    uint32_t        window;     /* Max offset, <= mask */
+    uint32_t        next;       /* First position not yet hashed */
+    uint32_t        depth;
+} _tcc_echo_t;
+
+HN4_INLINE uint32_t _tcc_hash4(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return (v * 2654435761U) >> (32 - HN4_ECHO_HASH_BITS);
+}
 
-  _Check_return_
-hn4_result_t hn4_compress_block(
-    HN4_IN  const void* src_void,
-    HN4_IN  uint32_t    src_len,
-    HN4_OUT void*       dst_void,
-    HN4_IN  uint32_t    dst_capacity,
-    HN4_OUT uint32_t*   out_size,
-    HN4_IN  uint32_t    device_type,
-    HN4_IN  uint64_t    hw_flags
-)
+static bool _tcc_echo_init(_tcc_echo_t* e, const uint8_t* base, uint32_t len, uint32_t device_type)
 {
-    if (HN4_UNLIKELY(!src_void || !dst_void || !out_size)) return HN4_ERR_INVALID_ARGUMENT;
-    if (HN4_UNLIKELY(src_void == dst_void)) return HN4_ERR_INVALID_ARGUMENT;
-    if (HN4_UNLIKELY(src_len > HN4_BLOCK_LIMIT)) return HN4_ERR_INVALID_ARGUMENT;
+    memset(e, 0, sizeof(*e));
+    if (len < HN4_ECHO_MIN_INPUT) return false;
+
+    uint32_t ring = 64;
+    while (ring < len && ring < 65536) ring <<= 1;
+
+    size_t head_sz = sizeof(uint32_t) << HN4_ECHO_HASH_BITS;
+    uint8_t* mem = hn4_hal_mem_alloc(head_sz + (size_t)ring * sizeof(uint16_t));
+    if (!mem) return false;
+
+    memset(mem, 0, head_sz);
+    e->base   = base;
+    e->head   = (uint32_t*)mem;
+    e->chain  = (uint16_t*)(mem + head_sz);
+    e->mask   = ring - 1;
+    e->window = (ring - 1 < HN4_ECHO_MAX_OFFSET) ? ring - 1 : HN4_ECHO_MAX_OFFSET;
+    e->depth  = (device_type == HN4_DEV_HDD) ? HN4_ECHO_DEPTH_DEEP : HN4_ECHO_DEPTH_FAST;
+    return true;
+}
+
+/* Hashes positions [next, upto). Caller guarantees 4 readable bytes at each. */
+HN4_INLINE void _tcc_echo_insert(_tcc_echo_t* e, uint32_t upto)
+{
+    for (uint32_t pos = e->next; pos < upto; pos++) {
+        uint32_t h    = _tcc_hash4(e->base + pos);
+        uint32_t prev = e->head[h];
+        uint32_t dist = prev ? pos + 1 - prev : 0;
+
+        e->chain[pos & e->mask] = (dist > e->window) ? 0 : (uint16_t)dist;
+        e->head[h] = pos + 1;
+    }
+    if (upto > e->next) e->next = upto;
+}
+
+/* Common prefix of a and b, at most 'max' bytes (8 at a time) */
+HN4_INLINE uint32_t _tcc_match_len(const uint8_t* a, const uint8_t* b, uint32_t max)
+{
+    uint32_t n = 0;
+    while (n + 8 <= max && _tcc_load64(a + n) == _tcc_load64(b + n)) n += 8;
+    while (n < max && a[n] == b[n]) n++;
+    return n;
+}
+
+/*
+ * Longest earlier occurrence of the bytes at 'ip' (needs 4 readable).
+ * Returns its length (0 if below HN4_ECHO_MIN_MATCH) and the offset.
+ */
+static uint32_t _tcc_echo_find(_tcc_echo_t* e, const uint8_t* ip, const uint8_t* iend, uint32_t* off_out)
+{
+    uint32_t pos = (uint32_t)(ip - e->base);
+    _tcc_echo_insert(e, pos);
+
+    size_t   avail = (size_t)(iend - ip);
+    uint32_t max   = (avail > HN4_ECHO_MAX_MATCH) ? HN4_ECHO_MAX_MATCH : (uint32_t)avail;
+    uint32_t best  = 0;
+    uint32_t cand  = e->head[_tcc_hash4(ip)];
+
+    for (uint32_t probe = 0; cand && probe < e->depth; probe++) {
+        uint32_t c   = cand - 1;
+        uint32_t off = pos - c;
+        if (off > e->window) break;
+
+        const uint8_t* m = e->base + c;
+        /* Cheap reject: must beat 'best' at its last byte */
+        if (m[best] == ip[best]) {
+            uint32_t l = _tcc_match_len(ip, m, max);
+            if (l > best) {
+                best = l;
+                *off_out = off;
+                if (l == max) break;
+            }
+        }
+
+        uint16_t d = e->chain[c & e->mask];
+        if (!d) break;
+        cand -= d;
+    }
+
+    return (best >= HN4_ECHO_MIN_MATCH) ? best : 0;
+}
+
+/* ECHO: Emit (Write Only) */
+static uint8_t* _tcc_emit_echo(uint8_t* op, const uint8_t* oend, uint32_t off, uint32_t len)
+{
+    if (op + 4 > oend) return NULL;
+
+    *op++ = HN4_EXT_ESCAPE;
+    *op++ = HN4_EXT_OP_ECHO;
+    *op++ = (uint8_t)(off & 0xFF);
+    *op++ = (uint8_t)(off >> 8);
 
+    return _tcc_write_varint(op, oend, len - HN4_ECHO_MIN_MATCH);
+}
+
+
+ /* Encoder main loop. 'echo' has NULL tables when back-references are off. */
+static hn4_result_t _tcc_encode(
+    const void*     src_void,
+    uint32_t        src_len,
+    void*           dst_void,
+    uint32_t        dst_capacity,
+    uint32_t*       out_size,
+    uint32_t        device_type,
+    uint64_t        hw_flags,
+    _tcc_echo_t*    echo,
+    const hn4_tcc_lexicon_t* lex,      /* Trained entries, or NULL */
+    bool*           lex_used
+)
+{
     const uint8_t* ip     = (const uint8_t*)src_void;
     const uint8_t* iend   = ip + src_len;
     const uint8_t* anchor = ip; 
@@ -626,8 +918,7 @@ hn4_result_t hn4_compress_block(
         uint64_t pattern = (uint64_t)ip[0] * 0x0101010101010101ULL;
         
         if (HN4_UNLIKELY(qword == pattern)) {
-            const uint8_t* run = ip + 8;
-            while (run < iend && *run == ip[0]) run++;
+            const uint8_t* run = _tcc_scan_run(ip + 8, iend, ip[0]);
             size_t run_len = (size_t)(run - ip);
             
             if (_flush_literal_buffer(&op, oend, anchor, (size_t)(ip - anchor), hw_flags) != HN4_OK) 
@@ -656,15 +947,7 @@ hn4_result_t hn4_compress_block(
         /* --- PRIORITY 2: GRADIENT (Linear Progression) --- */
         int8_t slope = _tcc_detect_linear_gradient(ip, iend, device_type);
         if (HN4_UNLIKELY(slope != 0)) {
-            const uint8_t* run = ip + 1;
-            int16_t expected = (int16_t)ip[0] + slope;
-
-            while (run < iend) {
-                if (expected < 0 || expected > 255) break; 
-                if (*run != (uint8_t)expected) break;
-                run++;
-                expected += slope;
-            }
+            const uint8_t* run = _tcc_scan_ramp(ip, iend, slope);
 
             size_t run_len = (size_t)(run - ip);
             
@@ -712,10 +995,43 @@ hn4_result_t hn4_compress_block(
             }
         }
 
-        /* --- PRIORITY 4: LEXICON (Extended Dictionary) --- */
-        int lex_idx = _tcc_scan_lexicon(ip, iend);
+        /* --- PRIORITY 4: ECHO (Repeat of Earlier Bytes) --- */
+        if (echo->head) {
+            uint32_t e_off = 0;
+            uint32_t e_len = _tcc_echo_find(echo, ip, iend, &e_off);
+
+            if (e_len > 0) {
+                if (ip > anchor) {
+                    if (_flush_literal_buffer(&op, oend, anchor, (size_t)(ip - anchor), hw_flags) != HN4_OK)
+                        return HN4_ERR_ENOSPC;
+                }
+
+                op = _tcc_emit_echo(op, oend, e_off, e_len);
+                if (!op) return HN4_ERR_ENOSPC;
+
+                ip += e_len;
+                anchor = ip;
+                continue;
+            }
+        }
+
+        /* --- PRIORITY 5: LEXICON (Trained, then Extended Dictionary) --- */
+        int    lex_idx   = -1;
+        size_t match_len = 0;
+
+        if (lex) {
+            int t = _tcc_scan_trained(ip, iend, lex);
+            if (t >= 0) {
+                lex_idx   = HN4_TCC_LEX_BASE + t;
+                match_len = lex->len[t];
+            }
+        }
+        if (lex_idx < 0) {
+            lex_idx = _tcc_scan_lexicon(ip, iend);
+            if (lex_idx >= 0) match_len = _hn4_lexicon_table[lex_idx].len;
+        }
+
         if (lex_idx >= 0) {
-            size_t match_len = _hn4_lexicon_table[lex_idx].len;
 
             /* 
              * PROFITABILITY CHECK:
@@ -732,6 +1048,7 @@ hn4_result_t hn4_compress_block(
                 
                 op = _tcc_emit_lexicon(op, oend, lex_idx);
                 if (!op) return HN4_ERR_ENOSPC;
+                if (lex_idx >= HN4_TCC_LEX_BASE) *lex_used = true;
                 
                 ip += match_len;
                 anchor = ip;
@@ -771,18 +1088,692 @@ hn4_result_t hn4_compress_block(
     return HN4_OK;
 }
 
+    /* =========================================================================
+    * 3b. ENTROPY STAGE (LITERAL HUFFMAN)
+    * =========================================================================
+    * Optional post-pass (HN4_TCC_ENTROPY). Literal payloads are lifted out of
+    * the token stream and Huffman-coded as one bitstream behind a leading
+    * header op; LITERAL tokens keep only their headers (lengths):
+    *
+    *   [00] [04] [First] [Count - 1] [Count x 4-bit length, low nibble first]
+    *   [Coded Bytes LE32] [Bitstream] [Tokens ...]
+    *
+    * Codes are canonical, at most HN4_HUF_MAX_BITS long, written LSB-first.
+    * A stream without the header decodes exactly as before.
+    */
+
+typedef struct {
+    uint8_t*        p;
+    uint64_t        acc;
+    uint32_t        bits;
+} _tcc_bitwr_t;
+
+typedef struct {
+    const uint8_t*  p;
+    const uint8_t*  end;
+    uint64_t        acc;
+    uint32_t        bits;
+    uint32_t        phantom;    /* Zero bytes fed past 'end' */
+} _tcc_bitrd_t;
+
+HN4_INLINE void _tcc_bits_put(_tcc_bitwr_t* w, uint32_t code, uint32_t n)
+{
+    w->acc  |= (uint64_t)code << w->bits;
+    w->bits += n;
+    while (w->bits >= 8) {
+        *w->p++ = (uint8_t)w->acc;
+        w->acc >>= 8;
+        w->bits -= 8;
+    }
+}
+
+HN4_INLINE void _tcc_bits_fill(_tcc_bitrd_t* r)
+{
+    while (r->bits <= 56) {
+        uint64_t b = 0;
+        if (r->p < r->end) b = *r->p++;
+        else r->phantom++;
+        r->acc  |= b << r->bits;
+        r->bits += 8;
+    }
+}
+
+/* Consumed more bits than the stream holds */
+HN4_INLINE bool _tcc_bits_overrun(const _tcc_bitrd_t* r)
+{
+    return r->bits < 8 * r->phantom;
+}
+
+/*
+ * Code lengths for the symbols with non-zero frequency (two-queue
+ * Huffman over the sorted leaves). Returns the longest length.
+ */
+static uint32_t _tcc_huf_build(const uint32_t f[256], uint8_t len[256])
+{
+    uint16_t sym[256];
+    uint32_t w[511];
+    uint16_t parent[511];
+    uint8_t  depth[511];
+    uint32_t n = 0;
+
+    memset(len, 0, 256);
+    for (uint32_t i = 0; i < 256; i++) if (f[i]) sym[n++] = (uint16_t)i;
+
+    if (n == 0) return 0;
+    if (n == 1) { len[sym[0]] = 1; return 1; }
+
+    /* Insertion sort by frequency; stable, so ties keep symbol order */
+    for (uint32_t i = 1; i < n; i++) {
+        uint16_t v = sym[i];
+        uint32_t j = i;
+        while (j > 0 && f[sym[j - 1]] > f[v]) { sym[j] = sym[j - 1]; j--; }
+        sym[j] = v;
+    }
+
+    /* Leaves are 0..n-1, internal nodes n..2n-2 in creation (= weight) order */
+    for (uint32_t i = 0; i < n; i++) w[i] = f[sym[i]];
+
+    uint32_t leaf = 0, inner = n;
+    for (uint32_t next = n; next < 2 * n - 1; next++) {
+        uint32_t pick[2];
+        for (int k = 0; k < 2; k++) {
+            if (leaf < n && (inner >= next || w[leaf] <= w[inner])) pick[k] = leaf++;
+            else                                                   pick[k] = inner++;
+        }
+        w[next] = w[pick[0]] + w[pick[1]];
+        parent[pick[0]] = parent[pick[1]] = (uint16_t)next;
+    }
+
+    /* Parents always come after their children */
+    uint32_t max = 0;
+    depth[2 * n - 2] = 0;
+    for (int32_t i = (int32_t)(2 * n - 3); i >= 0; i--) depth[i] = depth[parent[i]] + 1;
+    for (uint32_t i = 0; i < n; i++) {
+        len[sym[i]] = depth[i];
+        if (depth[i] > max) max = depth[i];
+    }
+    return max;
+}
+
+/* Length-limited lengths: flatten the histogram until the tree fits */
+static void _tcc_huf_lengths(const uint32_t freq[256], uint8_t len[256])
+{
+    uint32_t f[256];
+    memcpy(f, freq, sizeof(f));
+
+    while (_tcc_huf_build(f, len) > HN4_HUF_MAX_BITS) {
+        for (int i = 0; i < 256; i++) if (f[i]) f[i] = (f[i] >> 1) | 1;
+    }
+}
+
+/*
+ * Canonical codes, bit-reversed for the LSB-first stream. false if the
+ * lengths over-subscribe the code space (Kraft sum > 1).
+ */
+static bool _tcc_huf_codes(const uint8_t len[256], uint16_t code[256])
+{
+    uint32_t count[HN4_HUF_MAX_BITS + 1] = {0};
+    uint32_t next[HN4_HUF_MAX_BITS + 1];
+    uint32_t kraft = 0;
+
+    for (int s = 0; s < 256; s++) {
+        if (len[s] > HN4_HUF_MAX_BITS) return false;
+        if (len[s]) {
+            count[len[s]]++;
+            kraft += 1U << (HN4_HUF_MAX_BITS - len[s]);
+        }
+    }
+    if (kraft > (1U << HN4_HUF_MAX_BITS)) return false;
+
+    uint32_t c = 0;
+    for (uint32_t b = 1; b <= HN4_HUF_MAX_BITS; b++) {
+        c = (c + count[b - 1]) << 1;
+        next[b] = c;
+    }
+
+    for (int s = 0; s < 256; s++) {
+        if (!len[s]) continue;
+        uint32_t v = next[len[s]]++, r = 0;
+        for (uint32_t b = 0; b < len[s]; b++) r |= ((v >> b) & 1) << (len[s] - 1 - b);
+        code[s] = (uint16_t)r;
+    }
+    return true;
+}
+
+/*
+ * Size of the token at 'p' without its literal payload; '*lit' receives
+ * that payload's length (LITERAL only). 0 if the token is malformed.
+ */
+static uint32_t _tcc_token_span(const uint8_t* p, const uint8_t* end, uint32_t* lit)
+{
+    const uint8_t* s = p;
+    uint8_t  tag = *p & HN4_OP_MASK;
+    uint32_t len = *p++ & HN4_LEN_MASK;
+    uint8_t  b   = HN4_VARINT_MARKER;
+    *lit = 0;
+
+    if (tag == HN4_OP_LITERAL && len == 0) {
+        if (p >= end) return 0;
+        uint8_t ext = *p++;
+        if (ext == HN4_EXT_OP_LEXICON) {
+            p += 1;
+        } else if (ext == HN4_EXT_OP_BIND) {
+            p += 4;
+        } else if (ext == HN4_EXT_OP_MANIFOLD || ext == HN4_EXT_OP_ECHO) {
+            p += (ext == HN4_EXT_OP_MANIFOLD) ? 1 : 2;
+            uint32_t v = 0;
+            while (b == HN4_VARINT_MARKER) {
+                if (p >= end) return 0;
+                b = *p++;
+                v += b;
+            }
+            if (ext == HN4_EXT_OP_MANIFOLD) p += v;
+        } else {
+            return 0;
+        }
+        return (p <= end) ? (uint32_t)(p - s) : 0;
+    }
+
+    if (len == HN4_LEN_MASK) {
+        while (b == HN4_VARINT_MARKER) {
+            if (p >= end) return 0;
+            b = *p++;
+            len += b;
+        }
+    }
+
+    switch (tag) {
+        case HN4_OP_LITERAL:  *lit = len; break;
+        case HN4_OP_ISOTOPE:  p += 1; break;
+        case HN4_OP_GRADIENT: p += 2; break;
+        default: {
+            uint32_t words = len / HN4_TSM_GRANULARITY;
+            uint32_t mask_bytes = (words + 7) / 8;
+            if ((size_t)(end - p) < mask_bytes) return 0;
+            uint32_t set = 0;
+            for (uint32_t i = 0; i < mask_bytes; i++) set += _tcc_popcount32(p[i]);
+            p += mask_bytes + set * HN4_TSM_GRANULARITY;
+            break;
+        }
+    }
+    return (p <= end) ? (uint32_t)(p - s) : 0;
+}
+
+/*
+ * Rewrites the finished stream in dst[0 .. *out_size) with entropy-coded
+ * literals if that saves more than 1/64. Leaves it untouched otherwise.
+ */
+static void _tcc_entropy_pass(uint8_t* dst, uint32_t* out_size)
+{
+    const uint8_t* end = dst + *out_size;
+    uint32_t freq[256] = {0};
+    uint32_t total = 0;
+
+    for (const uint8_t* p = dst; p < end; ) {
+        uint32_t lit;
+        uint32_t h = _tcc_token_span(p, end, &lit);
+        if (!h || lit > (size_t)(end - p) - h) return;
+        for (uint32_t i = 0; i < lit; i++) freq[p[h + i]]++;
+        total += lit;
+        p += h + lit;
+    }
+    if (total < HN4_HUF_MIN_LITERALS) return;
+
+    uint8_t  len[256];
+    uint16_t code[256];
+    _tcc_huf_lengths(freq, len);
+    if (!_tcc_huf_codes(len, code)) return;
+
+    uint32_t first = 0, last = 255;
+    while (!len[first]) first++;
+    while (!len[last]) last--;
+    uint32_t count = last - first + 1;
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 256; i++) bits += (uint64_t)freq[i] * len[i];
+
+    uint32_t coded = (uint32_t)((bits + 7) / 8);
+    uint32_t hdr   = 4 + (count + 1) / 2 + 4;
+    uint32_t old_n = *out_size;
+    uint64_t new_n = (uint64_t)old_n - total + hdr + coded;
+    if (new_n + (old_n >> 6) >= old_n) return;
+
+    uint8_t* tmp = hn4_hal_mem_alloc((size_t)new_n);
+    if (!tmp) return;
+
+    uint8_t* h = tmp;
+    *h++ = HN4_EXT_ESCAPE;
+    *h++ = HN4_EXT_OP_ENTROPY;
+    *h++ = (uint8_t)first;
+    *h++ = (uint8_t)(count - 1);
+    memset(h, 0, (count + 1) / 2);
+    for (uint32_t i = 0; i < count; i++) h[i / 2] |= (uint8_t)(len[first + i] << ((i & 1) * 4));
+    h += (count + 1) / 2;
+    uint32_t coded_le = hn4_cpu_to_le32(coded);
+    memcpy(h, &coded_le, 4);
+    h += 4;
+
+    _tcc_bitwr_t bw = { h, 0, 0 };
+    uint8_t* tok = h + coded;
+
+    for (const uint8_t* p = dst; p < end; ) {
+        uint32_t lit;
+        uint32_t hl = _tcc_token_span(p, end, &lit);
+        memcpy(tok, p, hl);
+        tok += hl;
+        for (uint32_t i = 0; i < lit; i++) {
+            uint8_t c = p[hl + i];
+            _tcc_bits_put(&bw, code[c], len[c]);
+        }
+        p += hl + lit;
+    }
+    if (bw.bits) *bw.p++ = (uint8_t)bw.acc;
+
+    memcpy(dst, tmp, (size_t)new_n);
+    *out_size = (uint32_t)new_n;
+    hn4_hal_mem_free(tmp);
+}
+
+/*
+ * Decoder side: reads the entropy header at 'ip', builds the lookup table
+ * and points 'r' at the bitstream. Returns the first token, NULL on rot.
+ */
+static const uint8_t* _tcc_entropy_open(
+    const uint8_t* ip, const uint8_t* iend,
+    uint16_t table[1 << HN4_HUF_MAX_BITS], _tcc_bitrd_t* r
+)
+{
+    if ((size_t)(iend - ip) < 4) return NULL;
+    uint32_t first = ip[2];
+    uint32_t count = (uint32_t)ip[3] + 1;
+    ip += 4;
+    if (first + count > 256) return NULL;
+
+    uint32_t nib = (count + 1) / 2;
+    if ((size_t)(iend - ip) < (size_t)nib + 4) return NULL;
+
+    uint8_t len[256] = {0};
+    for (uint32_t i = 0; i < count; i++) len[first + i] = (ip[i / 2] >> ((i & 1) * 4)) & 0x0F;
+    ip += nib;
+
+    uint32_t coded;
+    memcpy(&coded, ip, 4);
+    coded = hn4_le32_to_cpu(coded);
+    ip += 4;
+    if ((size_t)(iend - ip) < coded) return NULL;
+
+    uint16_t code[256];
+    if (!_tcc_huf_codes(len, code)) return NULL;
+
+    /* Entry = symbol << 4 | length; 0 = no code (incomplete code space) */
+    memset(table, 0, sizeof(uint16_t) << HN4_HUF_MAX_BITS);
+    for (uint32_t s = 0; s < 256; s++) {
+        if (!len[s]) continue;
+        for (uint32_t k = code[s]; k < (1U << HN4_HUF_MAX_BITS); k += 1U << len[s]) {
+            table[k] = (uint16_t)((s << 4) | len[s]);
+        }
+    }
+
+    r->p = ip;
+    r->end = ip + coded;
+    r->acc = 0;
+    r->bits = 0;
+    r->phantom = 0;
+    _tcc_bits_fill(r);
+    return ip + coded;
+}
+
+HN4_INLINE bool _tcc_entropy_literals(
+    _tcc_bitrd_t* r, const uint16_t* table, uint8_t* op, uint32_t n
+)
+{
+    const uint64_t mask = (1U << HN4_HUF_MAX_BITS) - 1;
+    while (n--) {
+        if (r->bits < HN4_HUF_MAX_BITS) _tcc_bits_fill(r);
+        uint16_t e = table[r->acc & mask];
+        uint32_t l = e & 0x0F;
+        if (HN4_UNLIKELY(!l)) return false;
+        *op++ = (uint8_t)(e >> 4);
+        r->acc >>= l;
+        r->bits -= l;
+    }
+    return !_tcc_bits_overrun(r);
+}
+
 
     /* =========================================================================
-    * 4. DECOMPRESSION ENGINE (DECODER)
-    * ========================================================================= */
+    * 3c. TRAINED LEXICON
+    * =========================================================================
+    * A stream that uses a trained entry (LEXICON index >= 64) starts with
+    * [00] [05] [Generation LE32], after the entropy header if there is one.
+    * The encoder leaves room for it and drops the room again when no
+    * trained entry was used, so unbound streams are unchanged. The 6 bytes
+    * are within the fixed slack of hn4_compress_bound().
+    */
 
-   _Check_return_
-hn4_result_t hn4_decompress_block(
+bool hn4_tcc_lexicon_seal(HN4_INOUT hn4_tcc_lexicon_t* lex)
+{
+    if (!lex || lex->generation == 0 || lex->count > HN4_TCC_LEX_MAX) return false;
+
+    uint32_t prev = 0;
+    for (uint32_t i = 0; i < lex->count; i++) {
+        uint32_t len = lex->len[i];
+        if (len < HN4_TCC_LEX_MIN_LEN || len > HN4_TCC_LEX_MAX_LEN) return false;
+        if ((uint32_t)lex->off[i] + len > sizeof(lex->data)) return false;
+
+        uint32_t c = lex->data[lex->off[i]];
+        if (c < prev) return false;
+        prev = c;
+    }
+
+    /* start[c] = first entry whose first byte is >= c */
+    uint32_t i = 0;
+    for (uint32_t c = 0; c < 256; c++) {
+        while (i < lex->count && lex->data[lex->off[i]] < c) i++;
+        lex->start[c] = (uint16_t)i;
+    }
+    lex->start[256] = (uint16_t)lex->count;
+    return true;
+}
+
+/*
+ * Steps over the entropy header: [00][04][First][Count-1][Nibbles][Coded LE32][Bits].
+ * Returns 'ip' unchanged without one, NULL if it is truncated.
+ */
+static const uint8_t* _tcc_skip_entropy(const uint8_t* ip, const uint8_t* iend)
+{
+    if ((size_t)(iend - ip) < 4 || ip[0] != HN4_EXT_ESCAPE || ip[1] != HN4_EXT_OP_ENTROPY) return ip;
+
+    size_t hdr = 4 + ((size_t)ip[3] + 2) / 2;
+    if ((size_t)(iend - ip) < hdr + 4) return NULL;
+    uint32_t coded;
+    memcpy(&coded, ip + hdr, 4);
+    hdr += 4 + (size_t)hn4_le32_to_cpu(coded);
+    if ((size_t)(iend - ip) < hdr) return NULL;
+    return ip + hdr;
+}
+
+uint32_t hn4_tcc_stream_lexicon(HN4_IN const void* src_void, HN4_IN uint32_t src_len)
+{
+    const uint8_t* ip   = (const uint8_t*)src_void;
+    const uint8_t* iend = ip + src_len;
+    if (!ip) return 0;
+
+    ip = _tcc_skip_entropy(ip, iend);
+    if (!ip || (size_t)(iend - ip) < HN4_BIND_SIZE) return 0;
+    if (ip[0] != HN4_EXT_ESCAPE || ip[1] != HN4_EXT_OP_BIND) return 0;
+
+    uint32_t gen;
+    memcpy(&gen, ip + 2, 4);
+    return hn4_le32_to_cpu(gen);
+}
+
+uint32_t hn4_tcc_stream_features(HN4_IN const void* src_void, HN4_IN uint32_t src_len)
+{
+    const uint8_t* ip   = (const uint8_t*)src_void;
+    const uint8_t* iend = ip + src_len;
+    if (!ip) return 0;
+
+    /* Entropy-coded literals live in the bitstream; tokens keep only their headers */
+    const uint8_t* tok = _tcc_skip_entropy(ip, iend);
+    if (!tok) return 0;
+    bool coded = (tok != ip);
+    uint32_t uses = coded ? HN4_TCC_USES_ENTROPY : 0;
+
+    for (ip = tok; ip < iend; ) {
+        if ((size_t)(iend - ip) >= 2 && ip[0] == HN4_EXT_ESCAPE && ip[1] == HN4_EXT_OP_ECHO) {
+            return uses | HN4_TCC_USES_ECHO;
+        }
+        uint32_t lit;
+        uint32_t h = _tcc_token_span(ip, iend, &lit);
+        if (!h) break;
+        if (coded) lit = 0;
+        if (lit > (size_t)(iend - ip) - h) break;
+        ip += h + lit;
+    }
+    return uses;
+}
+
+  _Check_return_
+hn4_result_t hn4_compress_block_ex(
+    HN4_IN  const void*              src_void,
+    HN4_IN  uint32_t                 src_len,
+    HN4_OUT void*                    dst_void,
+    HN4_IN  uint32_t                 dst_capacity,
+    HN4_OUT uint32_t*                out_size,
+    HN4_IN  uint32_t                 device_type,
+    HN4_IN  uint64_t                 hw_flags,
+    HN4_IN  uint32_t                 tcc_flags,
+    HN4_IN  const hn4_tcc_lexicon_t* lex
+)
+{
+    if (HN4_UNLIKELY(!src_void || !dst_void || !out_size)) return HN4_ERR_INVALID_ARGUMENT;
+    if (HN4_UNLIKELY(src_void == dst_void)) return HN4_ERR_INVALID_ARGUMENT;
+    if (HN4_UNLIKELY(src_len > HN4_BLOCK_LIMIT)) return HN4_ERR_INVALID_ARGUMENT;
+
+    if (lex && (lex->count == 0 || dst_capacity <= HN4_BIND_SIZE)) lex = NULL;
+
+    uint8_t* dst      = (uint8_t*)dst_void;
+    uint32_t reserve  = lex ? HN4_BIND_SIZE : 0;
+    bool     lex_used = false;
+
+    /* Without scratch the block is still encoded, just without ECHO */
+    _tcc_echo_t echo;
+    _tcc_echo_init(&echo, (const uint8_t*)src_void, src_len, device_type);
+
+    hn4_result_t res = _tcc_encode(src_void, src_len, dst + reserve, dst_capacity - reserve,
+                                   out_size, device_type, hw_flags, &echo, lex, &lex_used);
+
+    hn4_hal_mem_free(echo.head);
+
+    if (res == HN4_OK && reserve) {
+        if (lex_used) {
+            uint32_t gen_le = hn4_cpu_to_le32(lex->generation);
+            dst[0] = HN4_EXT_ESCAPE;
+            dst[1] = HN4_EXT_OP_BIND;
+            memcpy(dst + 2, &gen_le, 4);
+            *out_size += HN4_BIND_SIZE;
+        } else {
+            memmove(dst, dst + reserve, *out_size);
+        }
+    }
+
+    if (res == HN4_OK && (tcc_flags & HN4_TCC_ENTROPY)) {
+        _tcc_entropy_pass((uint8_t*)dst_void, out_size);
+    }
+    return res;
+}
+
+  _Check_return_
+hn4_result_t hn4_compress_block(
     HN4_IN  const void* src_void,
     HN4_IN  uint32_t    src_len,
     HN4_OUT void*       dst_void,
     HN4_IN  uint32_t    dst_capacity,
-    HN4_OUT uint32_t*   out_size
+    HN4_OUT uint32_t*   out_size,
+    HN4_IN  uint32_t    device_type,
+    HN4_IN  uint64_t    hw_flags
+)
+{
+    return hn4_compress_block_ex(src_void, src_len, dst_void, dst_capacity,
+                                 out_size, device_type, hw_flags, 0, NULL);
+}
+
+
+    /* =========================================================================
+    * 4. DECOMPRESSION ENGINE (DECODER)
+    * ========================================================================= */
+
+/*
+ * DECODE KERNELS
+ * Each kernel writes exactly 'n' bytes (bytes past the token are never
+ * touched, callers may decode straight into user buffers) and matches the
+ * scalar reference byte for byte. SSE2 is baseline on x86-64; the BITMASK
+ * expander needs AVX2 + BMI2 and is selected at runtime (_hn4_cpu_features).
+ */
+
+/* Short copies (lexicon words, literals): two overlapping moves, no call */
+HN4_INLINE void _tcc_copy(uint8_t* d, const uint8_t* s, size_t n)
+{
+    if (n < 4 || n > 32) { memcpy(d, s, n); return; }
+
+#if defined(HN4_TCC_VEC)
+    if (n >= 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)s);
+        __m128i b = _mm_loadu_si128((const __m128i*)(s + n - 16));
+        _mm_storeu_si128((__m128i*)d, a);
+        _mm_storeu_si128((__m128i*)(d + n - 16), b);
+        return;
+    }
+#endif
+    if (n > 16) { memcpy(d, s, n); return; }
+
+    if (n >= 8) {
+        uint64_t a = _tcc_load64(s), b = _tcc_load64(s + n - 8);
+        memcpy(d, &a, 8);
+        memcpy(d + n - 8, &b, 8);
+    } else {
+        uint32_t a, b;
+        memcpy(&a, s, 4);
+        memcpy(&b, s + n - 4, 4);
+        memcpy(d, &a, 4);
+        memcpy(d + n - 4, &b, 4);
+    }
+}
+
+/* ISOTOPE: broadcast stores, overlapping tail. Long runs go to libc. */
+HN4_INLINE void _tcc_fill(uint8_t* d, uint8_t v, size_t n)
+{
+#if defined(HN4_TCC_VEC)
+    if (n >= 16 && n < 256) {
+        __m128i b = _mm_set1_epi8((char)v);
+        uint8_t* last = d + n - 16;
+        for (; d < last; d += 16) _mm_storeu_si128((__m128i*)d, b);
+        _mm_storeu_si128((__m128i*)last, b);
+        return;
+    }
+#endif
+    memset(d, v, n);
+}
+
+/*
+ * GRADIENT: lane i of the first vector is v + i * slope, every later
+ * vector adds 16 * slope. Computed mod 256; the decoder has already proved
+ * the ramp stays inside 0..255, so this equals the int32 accumulator.
+ */
+HN4_INLINE void _tcc_ramp(uint8_t* d, uint8_t v, int8_t slope, size_t n)
+{
+#if defined(HN4_TCC_VEC)
+    if (n >= 16) {
+        uint8_t lane[16];
+        for (int i = 0; i < 16; i++) lane[i] = (uint8_t)(v + i * slope);
+
+        __m128i r    = _mm_loadu_si128((const __m128i*)lane);
+        __m128i step = _mm_set1_epi8((char)(uint8_t)(slope * 16));
+
+        for (; n >= 16; n -= 16, d += 16) {
+            _mm_storeu_si128((__m128i*)d, r);
+            r = _mm_add_epi8(r, step);
+        }
+        v = (uint8_t)_mm_cvtsi128_si32(r);
+    }
+#endif
+    for (; n; n--) {
+        *d++ = v;
+        v = (uint8_t)(v + slope);
+    }
+}
+
+/*
+ * ECHO: copy 'n' bytes from 'off' back. Non-overlapping or >= 16 apart
+ * goes 16 bytes at a time (each chunk reads only finished output);
+ * closer repeats (off < 16, e.g. period-1 runs) go byte by byte.
+ */
+HN4_INLINE void _tcc_echo_copy(uint8_t* d, size_t off, size_t n)
+{
+    const uint8_t* s = d - off;
+
+    if (off >= n) {
+        _tcc_copy(d, s, n);
+        return;
+    }
+    if (off >= 16) {
+        for (; n >= 16; n -= 16, d += 16, s += 16) {
+#if defined(HN4_TCC_VEC)
+            _mm_storeu_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+#else
+            memcpy(d, s, 16);
+#endif
+        }
+    }
+    while (n--) *d++ = *s++;
+}
+
+/* BITMASK reference: one mask bit per 4-byte word, words [first, words) */
+static void _tcc_expand_scalar(
+    uint8_t* op, const uint8_t* ip,
+    const uint8_t* mask, uint32_t first, uint32_t words
+)
+{
+    for (uint32_t i = first; i < words; i++) {
+        if ((mask[i / 8] >> (i % 8)) & 1) {
+            memcpy(op, ip, 4);
+            ip += 4;
+        } else {
+            memset(op, 0, 4);
+        }
+        op += 4;
+    }
+}
+
+#if defined(HN4_TCC_VEC)
+/*
+ * BITMASK, AVX2 + BMI2: one mask byte = 8 words = one YMM store.
+ * PDEP spreads the mask into byte lanes and deposits the rank of every set
+ * lane (0, 1, 2 ...), giving the VPERMD index; unset lanes are zeroed.
+ * The 32-byte load may run past the packed words but never past 'iend'.
+ * Returns the mask bytes consumed; advances *op_p and *ip_p.
+ */
+HN4_TCC_AVX2_FN
+static uint32_t _tcc_expand_avx2(
+    uint8_t** op_p, const uint8_t** ip_p, const uint8_t* iend,
+    const uint8_t* mask, uint32_t mask_bytes
+)
+{
+    uint8_t*       op = *op_p;
+    const uint8_t* ip = *ip_p;
+    uint32_t       i  = 0;
+
+    for (; i < mask_bytes && (size_t)(iend - ip) >= 32; i++) {
+        uint64_t ones  = _pdep_u64(mask[i], 0x0101010101010101ULL);
+        uint64_t lanes = ones * 0xFF;
+        uint64_t rank  = _pdep_u64(0x0706050403020100ULL, lanes);
+
+        __m256i perm = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)rank));
+        __m256i keep = _mm256_cvtepi8_epi32(_mm_cvtsi64_si128((long long)lanes));
+        __m256i v    = _mm256_loadu_si256((const __m256i*)ip);
+
+        v = _mm256_and_si256(_mm256_permutevar8x32_epi32(v, perm), keep);
+        _mm256_storeu_si256((__m256i*)op, v);
+
+        op += 32;
+        ip += 4 * (uint32_t)((ones * 0x0101010101010101ULL) >> 56);
+    }
+
+    *op_p = op;
+    *ip_p = ip;
+    return i;
+}
+#endif
+
+   _Check_return_
+hn4_result_t hn4_decompress_block_ex(
+    HN4_IN  const void*              src_void,
+    HN4_IN  uint32_t                 src_len,
+    HN4_OUT void*                    dst_void,
+    HN4_IN  uint32_t                 dst_capacity,
+    HN4_OUT uint32_t*                out_size,
+    HN4_IN  const hn4_tcc_lexicon_t* lex
 )
 {
     if (HN4_UNLIKELY(!src_void || !dst_void || !out_size)) return HN4_ERR_INVALID_ARGUMENT;
@@ -796,6 +1787,29 @@ hn4_result_t hn4_decompress_block(
     uint64_t cost_counter = 0; 
     const uint64_t cost_limit = (uint64_t)src_len * 16 + 1024;
 
+    /* Entropy-coded literals: only ever the first token */
+    uint16_t     huf_table[1 << HN4_HUF_MAX_BITS];
+    _tcc_bitrd_t huf = {0};
+    bool         huf_on = false;
+
+    if (src_len >= 2 && ip[0] == HN4_EXT_ESCAPE && ip[1] == HN4_EXT_OP_ENTROPY) {
+        ip = _tcc_entropy_open(ip, iend, huf_table, &huf);
+        if (!ip) return HN4_ERR_DATA_ROT;
+        huf_on = true;
+    }
+
+    /* Trained entries exist only behind a BIND naming the caller's generation */
+    const hn4_tcc_lexicon_t* trained = NULL;
+
+    if ((size_t)(iend - ip) >= 2 && ip[0] == HN4_EXT_ESCAPE && ip[1] == HN4_EXT_OP_BIND) {
+        if ((size_t)(iend - ip) < HN4_BIND_SIZE) return HN4_ERR_DATA_ROT;
+        uint32_t gen;
+        memcpy(&gen, ip + 2, 4);
+        if (!lex || lex->generation != hn4_le32_to_cpu(gen)) return HN4_ERR_DECOMPRESS_FAIL;
+        trained = lex;
+        ip += HN4_BIND_SIZE;
+    }
+
     while (ip < iend) {
         if (++cost_counter > cost_limit) return HN4_ERR_DATA_ROT;
 
@@ -815,13 +1829,22 @@ hn4_result_t hn4_decompress_block(
                 if (ip >= iend) return HN4_ERR_DATA_ROT;
                 uint8_t idx = *ip++;
 
-                if (idx >= HN4_LEXICON_COUNT) return HN4_ERR_DATA_ROT;
-                
-                const char* word = _hn4_lexicon_table[idx].str;
-                size_t wlen      = _hn4_lexicon_table[idx].len;
-                
+                const uint8_t* word;
+                size_t         wlen;
+
+                if (idx < HN4_LEXICON_COUNT) {
+                    word = (const uint8_t*)_hn4_lexicon_table[idx].str;
+                    wlen = _hn4_lexicon_table[idx].len;
+                } else if (trained && idx >= HN4_TCC_LEX_BASE &&
+                           (uint32_t)(idx - HN4_TCC_LEX_BASE) < trained->count) {
+                    word = trained->data + trained->off[idx - HN4_TCC_LEX_BASE];
+                    wlen = trained->len[idx - HN4_TCC_LEX_BASE];
+                } else {
+                    return HN4_ERR_DATA_ROT;
+                }
+
                 if ((size_t)(oend - op) < wlen) return HN4_ERR_DATA_ROT;
-                memcpy(op, word, wlen);
+                _tcc_copy(op, word, wlen);
                 op += wlen;
                 continue;
             }
@@ -852,14 +1875,16 @@ hn4_result_t hn4_decompress_block(
                 if (stride > m_len) return HN4_ERR_DATA_ROT;
 
                 /* Row 0: Literal Copy */
-                memcpy(op, ip, stride);
+                _tcc_copy(op, ip, stride);
                 op += stride; ip += stride;
                 
-                /* Row 1..N: Decode 2D Spatial Delta */
-               size_t rem = m_len - stride;
+                /*
+                 * Row 1..N: Decode 2D Spatial Delta
+                 * Stays scalar: every byte depends on the one just written
+                 * (Left). 'Top' is always in range once row 0 is out.
+                 */
+                size_t rem = m_len - stride;
                 while (rem--) {
-                    if ((size_t)(op - ostart) < stride) return HN4_ERR_DATA_ROT;
-
                     /* Pred = Avg(Left, Top) */
                     uint8_t pred = (op[-1] + op[-(int)stride]) >> 1;
                     *op++ = *ip++ + pred; 
@@ -867,6 +1892,30 @@ hn4_result_t hn4_decompress_block(
                 continue;
             }
             
+            /* -- DECODE ECHO (0x03) -- */
+            if (ext_sig == HN4_EXT_OP_ECHO) {
+                if ((size_t)(iend - ip) < 3) return HN4_ERR_DATA_ROT;
+                uint32_t off = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8);
+                ip += 2;
+
+                uint64_t e_len_64 = 0;
+                uint8_t s = 255;
+                while (s == 255) {
+                    if (ip >= iend) return HN4_ERR_DATA_ROT;
+                    s = *ip++;
+                    e_len_64 += s;
+                    if (e_len_64 > HN4_MAX_TOKEN_LEN) return HN4_ERR_DATA_ROT;
+                }
+                size_t e_len = (size_t)e_len_64 + HN4_ECHO_MIN_MATCH;
+
+                if (off == 0 || off > (size_t)(op - ostart)) return HN4_ERR_DATA_ROT;
+                if ((size_t)(oend - op) < e_len) return HN4_ERR_DATA_ROT;
+
+                _tcc_echo_copy(op, off, e_len);
+                op += e_len;
+                continue;
+            }
+
             /* Unknown Extension */
             return HN4_ERR_DATA_ROT; 
         }
@@ -895,15 +1944,20 @@ hn4_result_t hn4_decompress_block(
         /* STANDARD OPCODE DISPATCH */
         switch (tag) {
             case HN4_OP_LITERAL:
+                if (huf_on) {
+                    if (!_tcc_entropy_literals(&huf, huf_table, op, len)) return HN4_ERR_DATA_ROT;
+                    op += len;
+                    break;
+                }
                 if (HN4_UNLIKELY((size_t)(iend - ip) < len)) return HN4_ERR_DATA_ROT;
-                memcpy(op, ip, len);
+                _tcc_copy(op, ip, len);
                 op += len;
                 ip += len;
                 break;
 
             case HN4_OP_ISOTOPE:
                 if (HN4_UNLIKELY(ip >= iend)) return HN4_ERR_DATA_ROT;
-                memset(op, *ip++, len);
+                _tcc_fill(op, *ip++, len);
                 op += len;
                 break;
 
@@ -919,11 +1973,8 @@ hn4_result_t hn4_decompress_block(
                 int64_t final_val   = (int64_t)val + total_delta;
                 if (final_val < 0 || final_val > 255) return HN4_ERR_DATA_ROT;
 
-                int32_t acc = val;
-                while (len--) {
-                    *op++ = (uint8_t)acc;
-                    acc += slope;
-                }
+                _tcc_ramp(op, val, slope, len);
+                op += len;
                 break;
             }
 
@@ -964,15 +2015,18 @@ hn4_result_t hn4_decompress_block(
                 
                 if (HN4_UNLIKELY((size_t)(iend - ip) < (set_bits * 4))) return HN4_ERR_DATA_ROT;
 
-                for (uint32_t i = 0; i < total_words; i++) {
-                    if ((mask_base[i / 8] >> (i % 8)) & 1) {
-                        memcpy(op, ip, 4);
-                        ip += 4;
-                    } else {
-                        memset(op, 0, 4);
-                    }
-                    op += 4;
+                uint8_t* tok_end = op + len;
+                uint32_t first = 0;
+
+#if defined(HN4_TCC_VEC)
+                const uint32_t need = HN4_CPU_X86_AVX2 | HN4_CPU_X86_BMI2;
+                if ((_hn4_cpu_features & need) == need) {
+                    first = 8 * _tcc_expand_avx2(&op, &ip, iend, mask_base, total_words / 8);
                 }
+#endif
+                _tcc_expand_scalar(op, ip, mask_base, first, total_words);
+                ip = mask_base + mask_bytes + 4 * (size_t)set_bits;
+                op = tok_end;
                 break;
             }
             default:
@@ -982,10 +2036,25 @@ hn4_result_t hn4_decompress_block(
 
     if (HN4_UNLIKELY(ip != iend)) return HN4_ERR_DATA_ROT;
 
+    /* Every coded byte must have been used; at most the padding is left */
+    if (huf_on && (huf.p != huf.end || huf.bits - 8 * huf.phantom >= 8)) return HN4_ERR_DATA_ROT;
+
     *out_size = (uint32_t)(op - ostart);
     return HN4_OK;
 }
 
+   _Check_return_
+hn4_result_t hn4_decompress_block(
+    HN4_IN  const void* src_void,
+    HN4_IN  uint32_t    src_len,
+    HN4_OUT void*       dst_void,
+    HN4_IN  uint32_t    dst_capacity,
+    HN4_OUT uint32_t*   out_size
+)
+{
+    return hn4_decompress_block_ex(src_void, src_len, dst_void, dst_capacity, out_size, NULL);
+}
+
     /* =========================================================================
     * 5. BOUNDS CALCULATION
     * ========================================================================= */
@@ -998,6 +2067,8 @@ hn4_result_t hn4_decompress_block(
      * 1. VarInt headers (up to 33 bytes).
      * 2. Bitmask Token Overhead (Header + Mask Bytes).
      * 3. Alignment padding.
+     * ECHO never adds to this: a match is >= 8 bytes and its token plus the
+     * literal header it may split off cost less than the bytes it replaces.
      */
     uint64_t safe_size = (uint64_t)isize;
     safe_size += (safe_size >> 6) + 384;
@@ -1006,3 +2077,99 @@ hn4_result_t hn4_decompress_block(
     return (uint32_t)safe_size;
 }
 
+
+    /* =========================================================================
+    * 6. PLANE SHUFFLE FILTER
+    * =========================================================================
+    * Byte mode: plane k holds byte k of every element, so the sign and
+    * exponent bytes of fp16/bf16/fp32 data line up into ISOTOPE runs.
+    * Bit mode: plane k holds bit k of every element, 8 elements per byte.
+    * Both are pure permutations; the tail is copied as-is.
+    */
+
+HN4_INLINE bool _shuf_width_ok(uint8_t filter)
+{
+    uint32_t w = filter & HN4_SHUF_WIDTH_MASK;
+    return w >= 2 && w <= 8 && (filter & ~(HN4_SHUF_WIDTH_MASK | HN4_SHUF_BITS)) == 0;
+}
+
+/* 8x8 bit matrix transpose: bit j of byte i <-> bit i of byte j. Involution. */
+HN4_INLINE uint64_t _shuf_transpose8(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7))  & 0x00AA00AA00AA00AAULL; x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL; x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL; x ^= t ^ (t << 28);
+    return x;
+}
+
+/* 'inverse' swaps the roles of element order and plane order */
+static void _shuf_bytes(const uint8_t* s, uint8_t* d, uint32_t len, uint32_t w, bool inverse)
+{
+    uint32_t n = len / w;
+
+    for (uint32_t k = 0; k < w; k++) {
+        if (inverse) {
+            const uint8_t* plane = s + (size_t)k * n;
+            for (uint32_t i = 0; i < n; i++) d[(size_t)i * w + k] = plane[i];
+        } else {
+            uint8_t* plane = d + (size_t)k * n;
+            for (uint32_t i = 0; i < n; i++) plane[i] = s[(size_t)i * w + k];
+        }
+    }
+    memcpy(d + (size_t)n * w, s + (size_t)n * w, len - n * w);
+}
+
+static void _shuf_bits(const uint8_t* s, uint8_t* d, uint32_t len, uint32_t w, bool inverse)
+{
+    uint32_t groups = (len / w) / 8;
+    uint32_t body   = groups * 8 * w;
+
+    for (uint32_t k = 0; k < w; k++) {
+        for (uint32_t j = 0; j < groups; j++) {
+            uint64_t x = 0;
+            if (inverse) {
+                for (uint32_t b = 0; b < 8; b++) x |= (uint64_t)s[(size_t)(k * 8 + b) * groups + j] << (8 * b);
+            } else {
+                for (uint32_t i = 0; i < 8; i++) x |= (uint64_t)s[(size_t)(j * 8 + i) * w + k] << (8 * i);
+            }
+
+            x = _shuf_transpose8(x);
+
+            if (inverse) {
+                for (uint32_t i = 0; i < 8; i++) d[(size_t)(j * 8 + i) * w + k] = (uint8_t)(x >> (8 * i));
+            } else {
+                for (uint32_t b = 0; b < 8; b++) d[(size_t)(k * 8 + b) * groups + j] = (uint8_t)(x >> (8 * b));
+            }
+        }
+    }
+    memcpy(d + body, s + body, len - body);
+}
+
+bool hn4_shuffle(
+    HN4_IN  const void* src,
+    HN4_OUT void*       dst,
+    HN4_IN  uint32_t    len,
+    HN4_IN  uint8_t     filter
+)
+{
+    if (HN4_UNLIKELY(!src || !dst || src == dst || !_shuf_width_ok(filter))) return false;
+
+    if (filter & HN4_SHUF_BITS) _shuf_bits(src, dst, len, filter & HN4_SHUF_WIDTH_MASK, false);
+    else                        _shuf_bytes(src, dst, len, filter & HN4_SHUF_WIDTH_MASK, false);
+    return true;
+}
+
+bool hn4_unshuffle(
+    HN4_IN  const void* src,
+    HN4_OUT void*       dst,
+    HN4_IN  uint32_t    len,
+    HN4_IN  uint8_t     filter
+)
+{
+    if (HN4_UNLIKELY(!src || !dst || src == dst || !_shuf_width_ok(filter))) return false;
+
+    if (filter & HN4_SHUF_BITS) _shuf_bits(src, dst, len, filter & HN4_SHUF_WIDTH_MASK, true);
+    else                        _shuf_bytes(src, dst, len, filter & HN4_SHUF_WIDTH_MASK, true);
+    return true;
+}
@@ -44,6 +44,69 @@ hn4_result_t hn4_compress_block(
 );
 
 
+/* tcc_flags for hn4_compress_block_ex */
+#define HN4_TCC_ENTROPY     (1U << 0)   /* Huffman-code literals: ratio over CPU (ARCHIVE) */
+
+/*
+ * Trained Lexicon. Extends the static 64-word table with up to 192
+ * volume-specific entries (LEXICON indices 64..255). A block that uses one
+ * is bound to its generation and decodes only against that generation.
+ * Entries are sorted by first byte, longest first within a byte.
+ */
+#define HN4_TCC_LEX_BASE        64
+#define HN4_TCC_LEX_MAX         192
+#define HN4_TCC_LEX_MIN_LEN     4       /* Token is 3 bytes */
+#define HN4_TCC_LEX_MAX_LEN     32
+
+typedef struct {
+    uint32_t    generation;                 /* Non-zero */
+    uint32_t    count;
+    uint16_t    off[HN4_TCC_LEX_MAX];       /* Into data[] */
+    uint8_t     len[HN4_TCC_LEX_MAX];
+    uint16_t    start[257];                 /* First-byte buckets (hn4_tcc_lexicon_seal) */
+    uint8_t     data[HN4_TCC_LEX_MAX * HN4_TCC_LEX_MAX_LEN];
+} hn4_tcc_lexicon_t;
+
+/*
+ * Validates a filled-in lexicon (lengths, offsets, order) and builds its
+ * bucket index. Must succeed before the lexicon is used.
+ */
+bool hn4_tcc_lexicon_seal(HN4_INOUT hn4_tcc_lexicon_t* lex);
+
+/*
+ * Generation a compressed stream is bound to, 0 if it uses no trained
+ * lexicon. Does not validate the stream.
+ */
+uint32_t hn4_tcc_stream_lexicon(HN4_IN const void* src, HN4_IN uint32_t src_len);
+
+/* Encodings a finished stream uses (hn4_tcc_stream_features) */
+#define HN4_TCC_USES_ECHO   (1U << 0)   /* Back-references: HN4_INCOMPAT_TCC_ECHO */
+#define HN4_TCC_USES_ENTROPY (1U << 1)  /* Huffman literals: HN4_INCOMPAT_TCC_ENTROPY */
+
+/*
+ * Walks a compressed stream and reports the HN4_TCC_USES_* encodings in
+ * it, so the writer can raise the matching incompat bits. Stops quietly
+ * at the first malformed token.
+ */
+uint32_t hn4_tcc_stream_features(HN4_IN const void* src, HN4_IN uint32_t src_len);
+
+/*
+ * hn4_compress_block with encoder options and an optional trained lexicon
+ * (NULL = static table only). The output is self-describing; the stream
+ * is bound to 'lex' only if one of its entries was used.
+ */
+hn4_result_t hn4_compress_block_ex(
+    HN4_IN  const void*              src,
+    HN4_IN  uint32_t                 src_len,
+    HN4_OUT void*                    dst,
+    HN4_IN  uint32_t                 dst_capacity,
+    HN4_OUT uint32_t*                out_size,
+    HN4_IN  uint32_t                 device_type,
+    HN4_IN  uint64_t                 hw_flags,
+    HN4_IN  uint32_t                 tcc_flags,
+    HN4_IN  const hn4_tcc_lexicon_t* lex
+);
+
 /*
  * Decompresses data.
  * Validates stream integrity and safety constraints.
@@ -56,6 +119,45 @@ hn4_result_t hn4_decompress_block(
     HN4_OUT uint32_t*   out_size
 );
 
+/*
+ * hn4_decompress_block for streams that may be bound to a trained lexicon.
+ * HN4_ERR_DECOMPRESS_FAIL if the stream needs a generation other than
+ * 'lex' (or 'lex' is NULL).
+ */
+hn4_result_t hn4_decompress_block_ex(
+    HN4_IN  const void*              src,
+    HN4_IN  uint32_t                 src_len,
+    HN4_OUT void*                    dst,
+    HN4_IN  uint32_t                 dst_capacity,
+    HN4_OUT uint32_t*                out_size,
+    HN4_IN  const hn4_tcc_lexicon_t* lex
+);
+
+/*
+ * Plane shuffle pre-filter for arrays of fixed-width numbers (fp16, bf16,
+ * fp32, fp64). Run before hn4_compress_block and undone after
+ * hn4_decompress_block. Byte mode groups byte k of every element together;
+ * bit mode groups bit k (slower, better on quantized data). The filter
+ * byte is what a shuffled block stores (HN4_COMP_TCC_SHUFFLE).
+ * Returns false for an invalid filter byte or src == dst.
+ */
+#define HN4_SHUF_WIDTH_MASK 0x0F        /* Element width in bytes, 2..8 */
+#define HN4_SHUF_BITS       0x10        /* Bit planes instead of byte planes */
+
+bool hn4_shuffle(
+    HN4_IN  const void* src,
+    HN4_OUT void*       dst,
+    HN4_IN  uint32_t    len,
+    HN4_IN  uint8_t     filter
+);
+
+bool hn4_unshuffle(
+    HN4_IN  const void* src,
+    HN4_OUT void*       dst,
+    HN4_IN  uint32_t    len,
+    HN4_IN  uint8_t     filter
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,242 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Compression Advisor (Per-File Adaptive Policy)
+ * SOURCE:      hn4_compstat.c
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * ENGINEERING NOTES:
+ * 1. TABLE: Direct-mapped by seed_id, striped locks. A collision evicts;
+ *    the newcomer starts with a clean slate and is always tried first.
+ * 2. PROFIT: An attempt counts as a win only if it saves at least
+ *    1/2^HN4_CSTAT_MIN_GAIN_SHIFT of the block. Barely shrinking output
+ *    still costs a decode on every read.
+ * 3. AVERAGES: Ratio and throughput are EWMAs with alpha = 1/8, so a
+ *    file whose content changes character converges within a few dozen
+ *    blocks.
+ * 4. ADVISORY: Losing the table only costs a few wasted TCC passes. The
+ *    policy never affects what is on disk, only whether we try.
+ */
+
+#include "hn4_compstat.h"
+#include "hn4_hal.h"
+#include "hn4_endians.h"
+#include "hn4_constants.h"
+#include <string.h>
+#include <stdatomic.h>
+
+#define HN4_CSTAT_SLOTS     1024
+#define HN4_CSTAT_LOCKS     32
+#define HN4_CSTAT_EWMA_SHIFT 3
+
+typedef struct {
+    hn4_u128_t      seed_id;
+    hn4_compstat_t  s;
+    uint32_t        window;     /* Current back-off length */
+    bool            used;
+} _cstat_entry_t;
+
+struct hn4_compstat_cache {
+    hn4_spinlock_t  locks[HN4_CSTAT_LOCKS];
+    hn4_spinlock_t  total_lock;
+    hn4_compstat_t  total;
+    _cstat_entry_t  slots[HN4_CSTAT_SLOTS];
+};
+
+/* =========================================================================
+ * INTERNAL HELPERS
+ * ========================================================================= */
+
+static struct hn4_compstat_cache* _cstat_cache(hn4_volume_t* vol, bool create)
+{
+    struct hn4_compstat_cache* c = atomic_load_explicit(&vol->compstat_cache, memory_order_acquire);
+    if (c || !create) return c;
+
+    c = hn4_hal_mem_alloc(sizeof(struct hn4_compstat_cache));
+    if (!c) return NULL;
+
+    memset(&c->total, 0, sizeof(c->total));
+    memset(c->slots, 0, sizeof(c->slots));
+    for (int i = 0; i < HN4_CSTAT_LOCKS; i++) hn4_hal_spinlock_init(&c->locks[i]);
+    hn4_hal_spinlock_init(&c->total_lock);
+
+    struct hn4_compstat_cache* expected = NULL;
+    if (!atomic_compare_exchange_strong(&vol->compstat_cache, &expected, c)) {
+        hn4_hal_mem_free(c);
+        c = expected;
+    }
+    return c;
+}
+
+HN4_INLINE uint32_t _cstat_index(hn4_u128_t seed)
+{
+    uint64_t h = (seed.lo ^ seed.hi) * HN4_NS_HASH_CONST;
+    return (uint32_t)((h >> 32) % HN4_CSTAT_SLOTS);
+}
+
+HN4_INLINE bool _cstat_match(const _cstat_entry_t* e, hn4_u128_t seed)
+{
+    return e->used && e->seed_id.lo == seed.lo && e->seed_id.hi == seed.hi;
+}
+
+HN4_INLINE uint32_t _ewma(uint32_t avg, uint32_t sample, bool first)
+{
+    if (first) return sample;
+    int64_t d = (int64_t)sample - (int64_t)avg;
+    return (uint32_t)((int64_t)avg + d / (1 << HN4_CSTAT_EWMA_SHIFT));
+}
+
+/* Fold one attempt into a stats record */
+static void _cstat_fold(hn4_compstat_t* s, uint32_t in_len, uint32_t out_len, uint64_t ns, bool win)
+{
+    bool first = (s->attempts == 0);
+
+    uint32_t ratio = (uint32_t)(((uint64_t)out_len << 16) / in_len);
+    /* bytes/ns * 1000 = MB/s */
+    uint64_t mbps  = ns ? ((uint64_t)in_len * 1000ULL) / ns : 0;
+    if (mbps > UINT32_MAX) mbps = UINT32_MAX;
+
+    s->ratio_q16 = _ewma(s->ratio_q16, ratio, first);
+    if (ns) s->mbps = _ewma(s->mbps, (uint32_t)mbps, s->busy_ns == 0);
+
+    s->attempts++;
+    if (win) s->wins++;
+    s->bytes_in  += in_len;
+    s->bytes_out += out_len;
+    s->busy_ns   += ns;
+}
+
+/* =========================================================================
+ * PUBLIC API
+ * ========================================================================= */
+
+bool hn4_compstat_should_try(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor
+)
+{
+    if (!vol || !anchor) return true;
+
+    /* Embedded profiles keep the static policy */
+    if (vol->sb.info.format_profile == HN4_PROFILE_PICO) return true;
+
+    struct hn4_compstat_cache* c = _cstat_cache(vol, false);
+    if (!c) return true;
+
+    hn4_u128_t seed = hn4_le128_to_cpu(anchor->seed_id);
+    uint32_t   idx  = _cstat_index(seed);
+    bool       skip = false;
+
+    hn4_hal_spinlock_acquire(&c->locks[idx % HN4_CSTAT_LOCKS]);
+
+    _cstat_entry_t* e = &c->slots[idx];
+    if (_cstat_match(e, seed) && e->s.backoff > 0) {
+        e->s.backoff--;
+        e->s.skipped++;
+        skip = true;
+    }
+
+    hn4_hal_spinlock_release(&c->locks[idx % HN4_CSTAT_LOCKS]);
+
+    if (skip) {
+        hn4_hal_spinlock_acquire(&c->total_lock);
+        c->total.skipped++;
+        hn4_hal_spinlock_release(&c->total_lock);
+    }
+    return !skip;
+}
+
+void hn4_compstat_record(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint32_t            in_len,
+    HN4_IN uint32_t            out_len,
+    HN4_IN uint64_t            ns
+)
+{
+    if (!vol || !anchor || in_len == 0) return;
+    if (vol->sb.info.format_profile == HN4_PROFILE_PICO) return;
+
+    struct hn4_compstat_cache* c = _cstat_cache(vol, true);
+    if (!c) return;
+
+    if (out_len > in_len) out_len = in_len;
+    bool win = (out_len <= in_len - (in_len >> HN4_CSTAT_MIN_GAIN_SHIFT));
+
+    hn4_u128_t seed = hn4_le128_to_cpu(anchor->seed_id);
+    uint32_t   idx  = _cstat_index(seed);
+
+    hn4_hal_spinlock_acquire(&c->locks[idx % HN4_CSTAT_LOCKS]);
+
+    _cstat_entry_t* e = &c->slots[idx];
+    if (!_cstat_match(e, seed)) {
+        memset(e, 0, sizeof(*e));
+        e->seed_id = seed;
+        e->used    = true;
+    }
+
+    _cstat_fold(&e->s, in_len, out_len, ns, win);
+
+    if (win) {
+        e->s.fail_streak = 0;
+        e->s.backoff     = 0;
+        e->window        = 0;
+    } else if (++e->s.fail_streak >= HN4_CSTAT_FAIL_LIMIT && e->s.backoff == 0) {
+        /*
+         * First trip opens the minimum window; every failed probe doubles it.
+         * Pipelined blocks tried before the window opened land while it is
+         * running and must not stretch it.
+         */
+        if (e->window == 0)                          e->window = HN4_CSTAT_BACKOFF_MIN;
+        else if (e->window < HN4_CSTAT_BACKOFF_MAX)  e->window <<= 1;
+        e->s.backoff = e->window;
+    }
+
+    hn4_hal_spinlock_release(&c->locks[idx % HN4_CSTAT_LOCKS]);
+
+    hn4_hal_spinlock_acquire(&c->total_lock);
+    _cstat_fold(&c->total, in_len, out_len, ns, win);
+    hn4_hal_spinlock_release(&c->total_lock);
+}
+
+_Check_return_
+hn4_result_t hn4_compstat_query(
+    HN4_IN  hn4_volume_t*       vol,
+    HN4_IN  const hn4_anchor_t* anchor,
+    HN4_OUT hn4_compstat_t*     out
+)
+{
+    if (!vol || !out) return HN4_ERR_INVALID_ARGUMENT;
+    memset(out, 0, sizeof(*out));
+
+    struct hn4_compstat_cache* c = _cstat_cache(vol, false);
+    if (!c) return HN4_ERR_NOT_FOUND;
+
+    if (!anchor) {
+        hn4_hal_spinlock_acquire(&c->total_lock);
+        *out = c->total;
+        hn4_hal_spinlock_release(&c->total_lock);
+        return HN4_OK;
+    }
+
+    hn4_u128_t   seed = hn4_le128_to_cpu(anchor->seed_id);
+    uint32_t     idx  = _cstat_index(seed);
+    hn4_result_t res  = HN4_ERR_NOT_FOUND;
+
+    hn4_hal_spinlock_acquire(&c->locks[idx % HN4_CSTAT_LOCKS]);
+    if (_cstat_match(&c->slots[idx], seed)) {
+        *out = c->slots[idx].s;
+        res  = HN4_OK;
+    }
+    hn4_hal_spinlock_release(&c->locks[idx % HN4_CSTAT_LOCKS]);
+
+    return res;
+}
+
+void hn4_compstat_release(HN4_IN hn4_volume_t* vol)
+{
+    if (!vol) return;
+
+    struct hn4_compstat_cache* c = atomic_exchange(&vol->compstat_cache, NULL);
+    if (c) hn4_hal_mem_free(c);
+}
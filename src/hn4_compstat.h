@@ -0,0 +1,95 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Compression Advisor (Per-File Adaptive Policy)
+ * HEADER:      hn4_compstat.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * The profile and data class say whether a file MAY be compressed. This
+ * module tracks whether it is worth it: a moving ratio and compressor
+ * throughput per file, and a back-off that stops running TCC over data
+ * that keeps coming out no smaller (quantized weights, media, ciphertext).
+ *
+ * After HN4_CSTAT_FAIL_LIMIT unprofitable blocks in a row the writer skips
+ * compression for a window of blocks, then probes one. Every failed probe
+ * doubles the window (up to HN4_CSTAT_BACKOFF_MAX); one good block resets
+ * it. State is RAM-only and rebuilt after mount.
+ */
+
+#ifndef HN4_COMPSTAT_H
+#define HN4_COMPSTAT_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HN4_CSTAT_FAIL_LIMIT        4       /* Unprofitable blocks before back-off */
+#define HN4_CSTAT_BACKOFF_MIN       16      /* First skip window (blocks) */
+#define HN4_CSTAT_BACKOFF_MAX       1024
+#define HN4_CSTAT_MIN_GAIN_SHIFT    4       /* Profitable: saves >= 1/16 */
+
+typedef struct {
+    uint64_t    attempts;       /* Blocks run through TCC */
+    uint64_t    wins;           /* Attempts that saved at least 1/16 */
+    uint64_t    skipped;        /* Eligible blocks the policy did not try */
+    uint64_t    bytes_in;       /* Raw bytes of attempted blocks */
+    uint64_t    bytes_out;      /* Output bytes (raw size on failure) */
+    uint64_t    busy_ns;        /* Time spent compressing */
+    uint32_t    ratio_q16;      /* Moving out/in, 16.16 (65536 = no gain) */
+    uint32_t    mbps;           /* Moving compressor throughput, MB/s */
+    uint32_t    fail_streak;    /* Unprofitable attempts in a row */
+    uint32_t    backoff;        /* Blocks left before the next probe */
+} hn4_compstat_t;
+
+/**
+ * hn4_compstat_should_try
+ * Writer hook, called once per eligible block. false while the file is in
+ * a back-off window (the block is counted as skipped).
+ */
+bool hn4_compstat_should_try(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor
+);
+
+/**
+ * hn4_compstat_record
+ * Reports one attempt: 'in_len' raw bytes came out as 'out_len' (pass
+ * in_len when TCC failed) in 'ns' nanoseconds.
+ */
+void hn4_compstat_record(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint32_t            in_len,
+    HN4_IN uint32_t            out_len,
+    HN4_IN uint64_t            ns
+);
+
+/**
+ * hn4_compstat_query
+ * Copies the file's statistics, or the volume totals when 'anchor' is
+ * NULL (fail_streak and backoff are zero there). HN4_ERR_NOT_FOUND when
+ * the file has no tracked history.
+ */
+_Check_return_
+hn4_result_t hn4_compstat_query(
+    HN4_IN  hn4_volume_t*       vol,
+    HN4_IN  const hn4_anchor_t* anchor,
+    HN4_OUT hn4_compstat_t*     out
+);
+
+/**
+ * hn4_compstat_release
+ * Drops the table. Called from unmount.
+ */
+void hn4_compstat_release(HN4_IN hn4_volume_t* vol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_COMPSTAT_H */
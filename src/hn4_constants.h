@@ -97,8 +97,21 @@ extern "C" {
 /* Taint Threshold for forced Read-Only */
 #define HN4_TAINT_THRESHOLD_RO  20
 
-/* Define supported features mask (currently none for v1.0) */
-#define HN4_SUPPORTED_INCOMPAT_MASK  0x0000000000000000ULL 
+/* Blocks may bind a trained TCC lexicon (hn4_lexicon.h) */
+#define HN4_INCOMPAT_TCC_LEXICON     (1ULL << 1)
+
+/* Blocks may carry TCC ECHO back-references (ext op 0x03) */
+#define HN4_INCOMPAT_TCC_ECHO        (1ULL << 2)
+
+/* Blocks may open with a TCC entropy header (ext op 0x04) */
+#define HN4_INCOMPAT_TCC_ENTROPY     (1ULL << 3)
+
+/* Blocks may be stored as HN4_COMP_TCC_SHUFFLE (plane-shuffled) */
+#define HN4_INCOMPAT_TCC_SHUFFLE     (1ULL << 4)
+
+/* Define supported features mask */
+#define HN4_SUPPORTED_INCOMPAT_MASK  (HN4_INCOMPAT_TCC_LEXICON | HN4_INCOMPAT_TCC_ECHO | \
+                                      HN4_INCOMPAT_TCC_ENTROPY | HN4_INCOMPAT_TCC_SHUFFLE)
 
 
 /* =========================================================================
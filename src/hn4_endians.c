@@ -203,6 +203,9 @@ void hn4_sb_to_cpu(hn4_superblock_t* sb) {
     
     sb->info.boot_map_ptr    = hn4_addr_to_cpu(sb->info.boot_map_ptr);
     sb->info.last_journal_seq = hn4_bswap64(sb->info.last_journal_seq);
+    sb->info.lexicon_lba     = hn4_bswap64(sb->info.lexicon_lba);
+    sb->info.lexicon_gen     = hn4_bswap32(sb->info.lexicon_gen);
+    sb->info.ns_generation   = hn4_bswap32(sb->info.ns_generation);
 
     sb->raw.sb_crc = hn4_bswap32(sb->raw.sb_crc);
 #else
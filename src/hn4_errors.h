@@ -75,6 +75,12 @@ typedef int32_t hn4_result_t;
 /* Volume is marked VOL_PENDING_WIPE. No allocations allowed. */
 #define HN4_ERR_WIPE_PENDING            -0x107
 
+/* ZNS Write did not start at the Zone Write Pointer (or crossed a zone). */
+#define HN4_ERR_ZONE_WP_MISMATCH        -0x108
+
+/* ZNS Open/Active zone resource limit reached. */
+#define HN4_ERR_ZONE_LIMIT              -0x109
+
 
 /* =========================================================================
  * 2. THE CORTEX (IDENTITY & LOOKUP)
@@ -270,6 +276,8 @@ typedef int32_t hn4_result_t;
     X(HN4_ERR_ATOMICS_TIMEOUT,         "ERR_ATOMICS_TIMEOUT") \
     X(HN4_ERR_ZONE_FULL,               "ERR_ZONE_FULL") \
     X(HN4_ERR_WIPE_PENDING,            "ERR_WIPE_PENDING") \
+    X(HN4_ERR_ZONE_WP_MISMATCH,        "ERR_ZONE_WP_MISMATCH") \
+    X(HN4_ERR_ZONE_LIMIT,              "ERR_ZONE_LIMIT") \
     \
     /* --- The Cortex (Lookup) --- */ \
     X(HN4_ERR_NOT_FOUND,               "ERR_NOT_FOUND") \
@@ -10,6 +10,10 @@
  * architecture-specific barriers (x86/ARM64/ZNS).
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE     /* sched_getcpu, syscall */
+#endif
+
 #include "hn4_hal.h"
 #include "hn4_endians.h"
 #include "hn4_addr.h"
@@ -17,12 +21,18 @@
 #include <string.h>     /* memcpy/memset */
 #include <stdatomic.h>
 #include <stdbool.h>
+#include <time.h>       /* clock_gettime (hosted builds) */
 
 /* =========================================================================
  * 0. CONSTANTS & INTERNAL DEFINITIONS
  * ========================================================================= */
 
-/* ZNS Simulation Constants */
+/*
+ * ZNS Simulation Constants
+ * Legacy shared write pointers for caller-allocated devices that carry no
+ * driver context. Devices from hn4_hal_sim_create() keep their own zone
+ * state machine (Section 9).
+ */
 #define ZNS_SIM_ZONES       64
 #define ZNS_SIM_ZONE_SIZE   (256ULL * 1024 * 1024)
 #define ZNS_SIM_SECTOR_SIZE 4096
@@ -49,6 +59,21 @@ static const uint32_t HN4_MEM_MAGIC = 0x484E3421; /* "HN4!" */
     #define HN4_YIELD() atomic_signal_fence(memory_order_seq_cst)
 #endif
 
+/* Scheduler Yield (hosted builds). Bare metal degrades to a CPU hint. */
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    #include <sched.h>
+    #define HN4_OS_YIELD() sched_yield()
+#else
+    #define HN4_OS_YIELD() HN4_YIELD()
+#endif
+
+/* Worker Threads (hosted builds). Bare metal runs offloaded jobs inline. */
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    #define HN4_HAS_THREADS 1
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
 /* =========================================================================
  * 1. INTERNAL STRUCTURES & GLOBALS
  * ========================================================================= */
@@ -66,11 +91,23 @@ static _Atomic uint64_t _zns_zone_ptrs[ZNS_SIM_ZONES];
 
 uint32_t _hn4_cpu_features = 0;
 
+/* Simulated Device Backend (Section 9) */
+HN4_INLINE bool _is_sim(const hn4_hal_device_t* dev)
+{
+    return dev && (dev->caps.hw_flags & HN4_HW_SIMULATED) && dev->driver_ctx;
+}
+
+static void _sim_submit(hn4_hal_device_t* dev, hn4_io_req_t* req, hn4_io_callback_t cb, uint64_t* done_out);
+static void _sim_wait_until(hn4_hal_device_t* dev, uint64_t done_ns);
+static void _sim_drain(hn4_hal_device_t* dev);
+static void _hal_clock_calibrate(void);
+static void _hal_numa_bind(void* ptr, size_t size, uint32_t node);
+
 /* =========================================================================
  * 2. INITIALIZATION & HELPERS
  * ========================================================================= */
 
-static void _probe_cpu_persistence_features(void)
+static void _probe_cpu_features(void)
 {
     _hn4_cpu_features = 0;
 
@@ -96,6 +133,31 @@ static void _probe_cpu_persistence_features(void)
 
     if (regs[1] & (1 << 23)) _hn4_cpu_features |= HN4_CPU_X86_CLFLUSHOPT;
     if (regs[1] & (1 << 24)) _hn4_cpu_features |= HN4_CPU_X86_CLWB;
+    if (regs[1] & (1 << 8))  _hn4_cpu_features |= HN4_CPU_X86_BMI2;
+
+    /*
+     * Leaf 7 EBX bit 5 = AVX2. Only usable if the OS enabled YMM state
+     * (Leaf 1 ECX bit 27 = OSXSAVE, XCR0 bits 1|2).
+     */
+    bool avx2 = (regs[1] & (1 << 5)) != 0;
+
+    #if defined(_MSC_VER)
+        __cpuid(regs, 1);
+    #else
+        __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+
+    if (avx2 && (regs[2] & (1 << 27))) {
+        uint64_t xcr0;
+        #if defined(_MSC_VER)
+            xcr0 = _xgetbv(0);
+        #else
+            uint32_t lo, hi;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            xcr0 = ((uint64_t)hi << 32) | lo;
+        #endif
+        if ((xcr0 & 6) == 6) _hn4_cpu_features |= HN4_CPU_X86_AVX2;
+    }
 #endif
 }
 
@@ -113,7 +175,8 @@ hn4_result_t hn4_hal_init(void)
         return HN4_OK;
     }
 
-    _probe_cpu_persistence_features();
+    _probe_cpu_features();
+    _hal_clock_calibrate();
 
     for (int i = 0; i < ZNS_SIM_ZONES; i++) {
         atomic_store(&_zns_zone_ptrs[i], 0);
@@ -252,6 +315,12 @@ void hn4_hal_submit_io(hn4_hal_device_t* dev, hn4_io_req_t* req, hn4_io_callback
         return;
     }
 
+    /* Software timing model owns its own media */
+    if (_is_sim(dev)) {
+        _sim_submit(dev, req, cb, NULL);
+        return;
+    }
+
     /* ---------------------------------------------------------------------
      * PATH A: NVM / MEMORY MAPPED IO
      * --------------------------------------------------------------------- */
@@ -442,7 +511,7 @@ typedef struct {
     uint64_t _pad64; /* Padding to reach 24 bytes? No, force 32 or alignment logic */
 } __attribute__((aligned(16))) alloc_header_t;
 
-void* hn4_hal_mem_alloc(size_t size)
+static void* _hal_mem_alloc_impl(size_t size, uint32_t node)
 {
     _assert_hal_init();
     if (size == 0) return NULL;
@@ -485,11 +554,19 @@ void* hn4_hal_mem_alloc(size_t size)
     h->raw_ptr = raw;
     h->_pad32  = 0;
 
+    /* Placement policy must be set before the zeroing pass faults pages in */
+    if (node != HN4_NUMA_NODE_ANY) _hal_numa_bind(ptr, size, node);
+
     /* Safety: Zero memory */
     memset(ptr, 0, size);
     return ptr;
 }
 
+void* hn4_hal_mem_alloc(size_t size)
+{
+    return _hal_mem_alloc_impl(size, HN4_NUMA_NODE_ANY);
+}
+
 void hn4_hal_mem_free(void* ptr)
 {
     if (!ptr) return;
@@ -550,7 +627,13 @@ hn4_result_t hn4_hal_sync_io(hn4_hal_device_t* dev, uint8_t op, hn4_addr_t lba,
     bundle->req.user_ctx = &bundle->ctx;
 
     /* 2. Submit */
-    hn4_hal_submit_io(dev, &bundle->req, _sync_cb);
+    uint64_t sim_done = 0;
+    if (_is_sim(dev)) {
+        _assert_hal_init();
+        _sim_submit(dev, &bundle->req, _sync_cb, &sim_done);
+    } else {
+        hn4_hal_submit_io(dev, &bundle->req, _sync_cb);
+    }
 
     /* 3. Wait with Timeout */
     hn4_time_t start_ts = hn4_hal_get_time_ns();
@@ -571,6 +654,9 @@ hn4_result_t hn4_hal_sync_io(hn4_hal_device_t* dev, uint8_t op, hn4_addr_t lba,
     /* 4. Cleanup on Success */
     HN4_BARRIER();
     hn4_result_t res = bundle->ctx.res;
+
+    /* Caller blocked for the whole service time */
+    if (sim_done) _sim_wait_until(dev, sim_done);
     
     hn4_hal_mem_free(bundle);
     return res;
@@ -703,14 +789,163 @@ hn4_result_t hn4_hal_sync_io_large(hn4_hal_device_t* dev,
  * 6. TELEMETRY, LOCKS & CAPS
  * ========================================================================= */
 
+/*
+ * Clock Engine
+ * Timestamps are taken on every write (mod_clock), in the Scavenger, the
+ * Chronicle and TTL checks, so the hot path must avoid syscalls and shared
+ * cache lines. On x86 with an invariant TSC we read RDTSC and scale it:
+ *
+ *   ns = mono_base + ((tsc - tsc_base) * mult) >> 32
+ *
+ * 'mult' is calibrated once against CLOCK_MONOTONIC over a short window,
+ * so both sources agree on the epoch. Everything else uses clock_gettime.
+ */
+#define HN4_CLOCK_CALIB_NS  (2ULL * 1000000ULL)   /* 2ms window */
+
+typedef struct {
+    _Atomic uint32_t state;     /* 0 = Raw, 1 = Calibrating, 2 = Ready */
+    uint32_t         source;
+    uint64_t         tsc_base;
+    uint64_t         mono_base;
+    uint64_t         mult;      /* ns per tick, 32.32 fixed point */
+} _hal_clock_t;
+
+static _hal_clock_t _hal_clock;
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    #define HN4_HAS_MONOTONIC 1
+
+static uint64_t _mono_ns(clockid_t id)
+{
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#if defined(HN4_ARCH_X86) && defined(HN4_HAS_MONOTONIC) && !defined(_MSC_VER)
+    #define HN4_HAS_TSC 1
+
+static bool _tsc_is_invariant(void)
+{
+    unsigned int a, b, c, d;
+    if (!__get_cpuid(0x80000000, &a, &b, &c, &d) || a < 0x80000007) return false;
+    __cpuid(0x80000007, a, b, c, d);
+    return (d & (1U << 8)) != 0;
+}
+#endif
+
+HN4_INLINE uint64_t _tsc_scale(uint64_t delta, uint64_t mult)
+{
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)delta * mult) >> 32);
+#else
+    return (delta >> 32) * mult + (((delta & 0xFFFFFFFFULL) * mult) >> 32);
+#endif
+}
+
+static void _hal_clock_calibrate(void)
+{
+    uint32_t expected = 0;
+    if (!atomic_compare_exchange_strong(&_hal_clock.state, &expected, 1)) return;
+
+    _hal_clock.source = HN4_CLOCK_COUNTER;
+
+#if defined(HN4_HAS_MONOTONIC)
+    _hal_clock.source = HN4_CLOCK_MONOTONIC;
+#endif
+
+#if defined(HN4_HAS_TSC)
+    if (_tsc_is_invariant()) {
+        uint64_t m0 = _mono_ns(CLOCK_MONOTONIC);
+        uint64_t t0 = __rdtsc();
+        uint64_t m1, t1;
+
+        do {
+            HN4_YIELD();
+            m1 = _mono_ns(CLOCK_MONOTONIC);
+        } while (m1 - m0 < HN4_CLOCK_CALIB_NS);
+        t1 = __rdtsc();
+
+        /* Reject nonsense (virtualized TSC stuck or running backwards) */
+        if (t1 > t0) {
+            _hal_clock.mult      = ((m1 - m0) << 32) / (t1 - t0);
+            _hal_clock.tsc_base  = t1;
+            _hal_clock.mono_base = m1;
+            if (_hal_clock.mult != 0) _hal_clock.source = HN4_CLOCK_TSC;
+        }
+    }
+#endif
+
+    atomic_store_explicit(&_hal_clock.state, 2, memory_order_release);
+}
+
 hn4_time_t hn4_hal_get_time_ns(void)
 {
+    if (HN4_UNLIKELY(atomic_load_explicit(&_hal_clock.state, memory_order_acquire) != 2)) {
+        _hal_clock_calibrate();
+#if defined(HN4_HAS_MONOTONIC)
+        /* Another thread is mid-calibration: answer from the OS clock */
+        if (atomic_load_explicit(&_hal_clock.state, memory_order_acquire) != 2) {
+            return (hn4_time_t)_mono_ns(CLOCK_MONOTONIC);
+        }
+#endif
+    }
+
+#if defined(HN4_HAS_TSC)
+    if (HN4_LIKELY(_hal_clock.source == HN4_CLOCK_TSC)) {
+        return (hn4_time_t)(_hal_clock.mono_base +
+                            _tsc_scale(__rdtsc() - _hal_clock.tsc_base, _hal_clock.mult));
+    }
+#endif
+
+#if defined(HN4_HAS_MONOTONIC)
+    return (hn4_time_t)_mono_ns(CLOCK_MONOTONIC);
+#else
     /*
      * This is strictly monotonic but has no correlation to wall-clock time.
      * Suitable for ordering checks, NOT for calendar time.
      */
     static _Atomic uint64_t ticks = 0;
     return (hn4_time_t)atomic_fetch_add(&ticks, 100);
+#endif
+}
+
+hn4_time_t hn4_hal_get_coarse_ns(void)
+{
+#if defined(CLOCK_MONOTONIC_COARSE)
+    return (hn4_time_t)_mono_ns(CLOCK_MONOTONIC_COARSE);
+#else
+    return hn4_hal_get_time_ns();
+#endif
+}
+
+hn4_time_t hn4_hal_get_vol_tick(hn4_volume_t* vol)
+{
+    hn4_time_t now = hn4_hal_get_coarse_ns();
+    if (HN4_UNLIKELY(!vol)) return now;
+
+    /*
+     * Monotonic floor. The CAS only fires when the coarse clock has moved,
+     * i.e. at most once per tick per volume, so the line stays shared.
+     */
+    uint64_t cur = atomic_load_explicit(&vol->clock_tick, memory_order_relaxed);
+    while ((uint64_t)now > cur) {
+        if (atomic_compare_exchange_weak_explicit(&vol->clock_tick, &cur, (uint64_t)now,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            return now;
+        }
+    }
+    return (hn4_time_t)cur;
+}
+
+uint32_t hn4_hal_clock_source(void)
+{
+    if (atomic_load_explicit(&_hal_clock.state, memory_order_acquire) != 2) {
+        _hal_clock_calibrate();
+        while (atomic_load_explicit(&_hal_clock.state, memory_order_acquire) != 2) HN4_YIELD();
+    }
+    return _hal_clock.source;
 }
 
 uint64_t hn4_hal_get_random_u64(void)
@@ -730,28 +965,112 @@ const hn4_hal_caps_t* hn4_hal_get_caps(hn4_hal_device_t* dev)
 }
 
 /* Stubs */
-void     hn4_hal_poll(hn4_hal_device_t* d)            { (void)d; HN4_YIELD(); }
 uint32_t hn4_hal_get_temperature(hn4_hal_device_t* d) { (void)d; return 40; }
 void     hn4_hal_micro_sleep(uint32_t us)             { (void)us; HN4_YIELD(); }
 
-/* Spinlock */
+void hn4_hal_poll(hn4_hal_device_t* d)
+{
+    /* Simulated device: host waits for every outstanding command */
+    if (_is_sim(d)) _sim_drain(d);
+    HN4_YIELD();
+}
+
+/*
+ * Backoff Policy
+ * Exponential PAUSE bursts up to HN4_SPIN_LIMIT rounds, then hand the CPU
+ * back to the scheduler. Pure TAS spinning collapses when waiters
+ * outnumber cores (the holder is descheduled while everyone burns quanta).
+ */
+#define HN4_SPIN_LIMIT      64
+
+HN4_INLINE void _hal_backoff(uint32_t* spins)
+{
+    if (*spins < HN4_SPIN_LIMIT) {
+        uint32_t burst = 1U << ((*spins >> 4) & 3); /* 1,2,4,8 */
+        for (uint32_t i = 0; i < burst; i++) HN4_YIELD();
+        (*spins)++;
+    } else {
+        HN4_OS_YIELD();
+    }
+}
+
+/* Spinlock (Exclusive + Shared) */
 void hn4_hal_spinlock_init(hn4_spinlock_t* l)
 {
     atomic_flag_clear(&l->flag);
+    atomic_store_explicit(&l->rw_state, 0, memory_order_relaxed);
 }
 
 void hn4_hal_spinlock_acquire(hn4_spinlock_t* l)
 {
+    uint32_t spins = 0;
+
     while (atomic_flag_test_and_set_explicit(&l->flag, memory_order_acquire)) {
-        HN4_YIELD();
+        _hal_backoff(&spins);
+    }
+
+    /* Announce: new readers now back off. Then drain the active ones. */
+    atomic_fetch_or_explicit(&l->rw_state, HN4_RW_WRITER, memory_order_seq_cst);
+    while ((atomic_load_explicit(&l->rw_state, memory_order_acquire) & ~HN4_RW_WRITER) != 0) {
+        _hal_backoff(&spins);
     }
 }
 
 void hn4_hal_spinlock_release(hn4_spinlock_t* l)
 {
+    atomic_fetch_and_explicit(&l->rw_state, ~HN4_RW_WRITER, memory_order_release);
     atomic_flag_clear_explicit(&l->flag, memory_order_release);
 }
 
+void hn4_hal_spinlock_acquire_shared(hn4_spinlock_t* l)
+{
+    uint32_t spins = 0;
+
+    for (;;) {
+        uint32_t prev = atomic_fetch_add_explicit(&l->rw_state, 1, memory_order_seq_cst);
+        if (HN4_LIKELY(!(prev & HN4_RW_WRITER))) return;
+
+        /* Writer active or pending: step aside until it leaves */
+        atomic_fetch_sub_explicit(&l->rw_state, 1, memory_order_relaxed);
+        while (atomic_load_explicit(&l->rw_state, memory_order_relaxed) & HN4_RW_WRITER) {
+            _hal_backoff(&spins);
+        }
+    }
+}
+
+void hn4_hal_spinlock_release_shared(hn4_spinlock_t* l)
+{
+    atomic_fetch_sub_explicit(&l->rw_state, 1, memory_order_release);
+}
+
+/* Ticket Lock (FIFO) */
+void hn4_hal_ticket_lock_init(hn4_ticket_lock_t* l)
+{
+    atomic_store_explicit(&l->next, 0, memory_order_relaxed);
+    atomic_store_explicit(&l->serving, 0, memory_order_release);
+}
+
+void hn4_hal_ticket_lock_acquire(hn4_ticket_lock_t* l)
+{
+    uint32_t ticket = atomic_fetch_add_explicit(&l->next, 1, memory_order_relaxed);
+    uint32_t spins  = 0;
+
+    for (;;) {
+        uint32_t ahead = ticket - atomic_load_explicit(&l->serving, memory_order_acquire);
+        if (ahead == 0) return;
+
+        /* Proportional backoff: deep in the queue means a long wait */
+        if (ahead > 1) spins = HN4_SPIN_LIMIT;
+        _hal_backoff(&spins);
+    }
+}
+
+void hn4_hal_ticket_lock_release(hn4_ticket_lock_t* l)
+{
+    uint32_t cur = atomic_load_explicit(&l->serving, memory_order_relaxed);
+    atomic_store_explicit(&l->serving, cur + 1, memory_order_release);
+}
+
 /* =========================================================================
  * 7. AI CONTEXT SIMULATION
  * ========================================================================= */
@@ -860,57 +1179,319 @@ uint32_t hn4_hal_get_calling_gpu_id(void)
 }
 
 /* =========================================================================
- * 8. AI TOPOLOGY DISCOVERY (SIMULATION STUBS)
+ * 8. NUMA / AI TOPOLOGY DISCOVERY
  * ========================================================================= */
 
+/*
+ * Node table discovered from <root>/devices/system/node (Linux sysfs).
+ * Scanned once on first use; hn4_hal_topology_set_root() points the scan
+ * at a fake tree (tests) and rescans. Hosts without sysfs see one node.
+ */
+typedef struct {
+    uint32_t node_count;
+    uint32_t node_ids[HN4_NUMA_MAX_NODES];
+    uint8_t  distance[HN4_NUMA_MAX_NODES][HN4_NUMA_MAX_NODES];
+    uint16_t cpu_node[HN4_NUMA_MAX_CPUS];   /* Index into node_ids */
+} _hal_numa_t;
+
+static _hal_numa_t      _hal_numa;
+static _Atomic uint32_t _hal_numa_state;    /* 0 = Raw, 1 = Scanning, 2 = Ready */
+static char             _hal_sysfs_root[256] = "/sys";
+
+#if defined(__linux__)
+    #define HN4_HAS_SYSFS 1
+    #include <stdio.h>
+    #include <unistd.h>
+    #include <sys/syscall.h>
+
+static bool _sysfs_read(const char* rel, char* out, size_t out_len)
+{
+    char path[384];
+    snprintf(path, sizeof(path), "%s/devices/system/node/%s", _hal_sysfs_root, rel);
+
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    bool ok = (fgets(out, (int)out_len, f) != NULL);
+    fclose(f);
+    return ok;
+}
+
+/* Parses "0-3,8,10-11" style lists. Calls back per ID. */
+static void _sysfs_parse_list(const char* s, void (*fn)(uint32_t id, void* ctx), void* ctx)
+{
+    while (*s) {
+        if (*s < '0' || *s > '9') { s++; continue; }
+
+        uint32_t lo = (uint32_t)strtoul(s, (char**)&s, 10);
+        uint32_t hi = lo;
+        if (*s == '-') hi = (uint32_t)strtoul(s + 1, (char**)&s, 10);
+
+        for (uint32_t id = lo; id <= hi && id < HN4_NUMA_MAX_CPUS; id++) fn(id, ctx);
+    }
+}
+
+static void _numa_add_node(uint32_t id, void* ctx)
+{
+    (void)ctx;
+    if (_hal_numa.node_count < HN4_NUMA_MAX_NODES) {
+        _hal_numa.node_ids[_hal_numa.node_count++] = id;
+    }
+}
+
+static void _numa_add_cpu(uint32_t cpu, void* ctx)
+{
+    _hal_numa.cpu_node[cpu] = (uint16_t)(uintptr_t)ctx;
+}
+#endif
+
+static void _hal_numa_scan(void)
+{
+    memset(&_hal_numa, 0, sizeof(_hal_numa));
+
+#if defined(HN4_HAS_SYSFS)
+    char buf[1024];
+
+    if (_sysfs_read("online", buf, sizeof(buf))) {
+        _sysfs_parse_list(buf, _numa_add_node, NULL);
+    }
+
+    for (uint32_t i = 0; i < _hal_numa.node_count; i++) {
+        char rel[64];
+        uint32_t nid = _hal_numa.node_ids[i];
+
+        snprintf(rel, sizeof(rel), "node%u/cpulist", nid);
+        if (_sysfs_read(rel, buf, sizeof(buf))) {
+            _sysfs_parse_list(buf, _numa_add_cpu, (void*)(uintptr_t)i);
+        }
+
+        /* SLIT row: one entry per online node, in node order */
+        snprintf(rel, sizeof(rel), "node%u/distance", nid);
+        if (_sysfs_read(rel, buf, sizeof(buf))) {
+            char* p = buf;
+            for (uint32_t j = 0; j < _hal_numa.node_count && *p; j++) {
+                unsigned long d = strtoul(p, &p, 10);
+                _hal_numa.distance[i][j] = (uint8_t)(d > 255 ? 255 : d);
+            }
+        }
+    }
+#endif
+
+    /* No sysfs (or unreadable): one local node */
+    if (_hal_numa.node_count == 0) {
+        _hal_numa.node_count     = 1;
+        _hal_numa.node_ids[0]    = 0;
+        _hal_numa.distance[0][0] = 10;
+    }
+}
+
+static const _hal_numa_t* _hal_numa_get(void)
+{
+    if (HN4_LIKELY(atomic_load_explicit(&_hal_numa_state, memory_order_acquire) == 2)) {
+        return &_hal_numa;
+    }
+
+    uint32_t expected = 0;
+    if (atomic_compare_exchange_strong(&_hal_numa_state, &expected, 1)) {
+        _hal_numa_scan();
+        atomic_store_explicit(&_hal_numa_state, 2, memory_order_release);
+    } else {
+        while (atomic_load_explicit(&_hal_numa_state, memory_order_acquire) != 2) HN4_YIELD();
+    }
+    return &_hal_numa;
+}
+
+hn4_result_t hn4_hal_topology_set_root(const char* sysfs_root)
+{
+    const char* root = sysfs_root ? sysfs_root : "/sys";
+    if (strlen(root) >= sizeof(_hal_sysfs_root)) return HN4_ERR_INVALID_ARGUMENT;
+
+    /* Not safe against concurrent readers. Call before mount. */
+    atomic_store(&_hal_numa_state, 1);
+    strcpy(_hal_sysfs_root, root);
+    _hal_numa_scan();
+    atomic_store_explicit(&_hal_numa_state, 2, memory_order_release);
+    return HN4_OK;
+}
+
+uint32_t hn4_hal_numa_node_count(void)
+{
+    return _hal_numa_get()->node_count;
+}
+
+uint32_t hn4_hal_numa_current_node(void)
+{
+    const _hal_numa_t* t = _hal_numa_get();
+    if (t->node_count < 2) return t->node_ids[0];
+
+#if defined(HN4_HAS_SYSFS)
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && cpu < HN4_NUMA_MAX_CPUS) return t->node_ids[t->cpu_node[cpu]];
+#endif
+    return t->node_ids[0];
+}
+
+uint32_t hn4_hal_numa_distance(uint32_t node_a, uint32_t node_b)
+{
+    const _hal_numa_t* t = _hal_numa_get();
+    uint32_t ia = HN4_NUMA_MAX_NODES, ib = HN4_NUMA_MAX_NODES;
+
+    for (uint32_t i = 0; i < t->node_count; i++) {
+        if (t->node_ids[i] == node_a) ia = i;
+        if (t->node_ids[i] == node_b) ib = i;
+    }
+    if (ia == HN4_NUMA_MAX_NODES || ib == HN4_NUMA_MAX_NODES) return 0;
+    return t->distance[ia][ib];
+}
+
+/*
+ * Node Placement
+ * Large allocations get an MPOL_PREFERRED policy on their whole pages before
+ * the zeroing pass faults them in. Small ones share heap pages with other
+ * objects, so they rely on first-touch (the zeroing runs on the caller).
+ */
+#define HN4_NUMA_BIND_MIN   (64u * 1024u)
+#define HN4_MPOL_PREFERRED  1
+#define HN4_MPOL_MF_MOVE    (1u << 1)
+
+#if defined(HN4_HAS_SYSFS) && defined(SYS_mbind)
+static _Atomic bool _hal_mbind_off;     /* Set by the first failed mbind */
+#endif
+
+static void _hal_numa_bind(void* ptr, size_t size, uint32_t node)
+{
+#if defined(HN4_HAS_SYSFS) && defined(SYS_mbind)
+    unsigned long mask = 0;
+    const unsigned long mask_bits = sizeof(mask) * 8;
+
+    if (size < HN4_NUMA_BIND_MIN || node >= mask_bits || hn4_hal_numa_node_count() < 2) return;
+    if (atomic_load_explicit(&_hal_mbind_off, memory_order_relaxed)) return;
+
+    /* Whole pages only */
+    uintptr_t pg    = 4096;
+    uintptr_t first = ((uintptr_t)ptr + pg - 1) & ~(pg - 1);
+    uintptr_t last  = ((uintptr_t)ptr + size) & ~(pg - 1);
+    if (last > first) {
+        mask = 1UL << node;
+
+        /* The kernel reads maxnode - 1 bits of the mask */
+        long rc = syscall(SYS_mbind, (void*)first, (unsigned long)(last - first),
+                          HN4_MPOL_PREFERRED, &mask, mask_bits + 1, HN4_MPOL_MF_MOVE);
+
+        /*
+         * No NUMA policy support, seccomp, or a node the kernel rejects. The
+         * pages fall back to first-touch; stop paying for the syscall.
+         */
+        if (rc != 0 && !atomic_exchange(&_hal_mbind_off, true)) {
+            HN4_LOG_WARN("HAL: mbind to node %u failed. NUMA placement off.", node);
+        }
+    }
+#else
+    (void)ptr; (void)size; (void)node;
+#endif
+}
+
+void* hn4_hal_mem_alloc_node(size_t size, uint32_t node)
+{
+    if (node == HN4_NUMA_NODE_LOCAL) node = hn4_hal_numa_current_node();
+    return _hal_mem_alloc_impl(size, node);
+}
+
+/*
+ * Affinity Map
+ * With more than one NUMA node, the device LBA space is split into one
+ * 1MB-aligned slice per node, tagged HN4_TOPO_NUMA_TAG | node_id. Mount
+ * clips slices to the data region; the allocator steers CPU threads that
+ * carry no accelerator context into their own node's slice. Weight is 1
+ * (same root complex) because the device's home node is not exposed here.
+ */
+#define HN4_TOPO_SLICE_ALIGN_BYTES  (1024u * 1024u)
+
+typedef struct {
+    uint32_t gpu_id;
+    uint32_t affinity_weight;
+    uint64_t lba_start;
+    uint64_t lba_len;
+} _hal_topo_entry_t;
+
+static uint64_t _topo_slice_sectors(hn4_hal_device_t* dev, uint32_t nodes)
+{
+    if (!dev || nodes < 2) return 0;
+
+    uint32_t ss = dev->caps.logical_block_size;
+    if (ss == 0) return 0;
+
+#ifdef HN4_USE_128BIT
+    if (dev->caps.total_capacity_bytes.hi > 0) return 0;
+    uint64_t cap_sectors = dev->caps.total_capacity_bytes.lo / ss;
+#else
+    uint64_t cap_sectors = dev->caps.total_capacity_bytes / ss;
+#endif
+
+    uint64_t align = HN4_TOPO_SLICE_ALIGN_BYTES / ss;
+    if (align == 0) align = 1;
+
+    return ((cap_sectors / nodes) / align) * align;
+}
+
 uint32_t hn4_hal_get_topology_count(hn4_hal_device_t* dev)
 {
-    (void)dev;
+    uint32_t nodes = hn4_hal_numa_node_count();
+
     /*
-     * PRODUCTION NOTE:
-     * Queries ACPI SRAT (System Resource Affinity Table) or PCIe Root Complex.
-     *
-     * Returns 0 by default. Allocator logic handles 0 gracefully
-     * by disabling AI optimization.
+     * Returns 0 on single-node hosts (or devices too small to slice).
+     * Allocator logic handles 0 gracefully by disabling affinity bias.
      */
-    return 0;
+    if (_topo_slice_sectors(dev, nodes) == 0) return 0;
+    return nodes;
 }
 
 hn4_result_t hn4_hal_get_topology_data(hn4_hal_device_t* dev, void* buffer, size_t buf_len)
 {
-    (void)dev;
-    (void)buffer;
-    (void)buf_len;
+    const _hal_numa_t* t = _hal_numa_get();
+    uint64_t slice = _topo_slice_sectors(dev, t->node_count);
+    if (slice == 0) return HN4_OK;
 
-    /*
-     * PRODUCTION NOTE:
-     * Populates the buffer with {GPU_ID, Weight, LBA_Start, LBA_Len}.
-     * Ensure buffer is cast to correct structure defined in volume header.
-     */
+    if (!buffer || buf_len < t->node_count * sizeof(_hal_topo_entry_t)) {
+        return HN4_ERR_INVALID_ARGUMENT;
+    }
+
+    _hal_topo_entry_t* out = (_hal_topo_entry_t*)buffer;
+    for (uint32_t i = 0; i < t->node_count; i++) {
+        out[i].gpu_id          = HN4_TOPO_NUMA_TAG | t->node_ids[i];
+        out[i].affinity_weight = 1;
+        out[i].lba_start       = (uint64_t)i * slice;
+        out[i].lba_len         = slice;
+    }
     return HN4_OK;
 }
 
+#define HN4_PREFETCH_MAX_BYTES  (256U * 1024U)  /* Bound the hint, it runs on the caller's thread */
+
 void hn4_hal_prefetch(hn4_hal_device_t* dev, hn4_addr_t lba, uint32_t len) {
     if (!dev) return;
 
     /* 
      * IMPLEMENTATION NOTE: 
      * This is a "Best Effort" hint. Failure is ignored.
+     * Block devices have no host-side cache to warm here; streaming
+     * readahead is done by the read pipeline (hn4_read_block_ra).
+     * Memory-mapped NVM gets its first lines pulled towards the CPU.
      */
-#if defined(__linux__) && defined(POSIX_FADV_WILLNEED)
-    /* User-space optimization: Hint the OS page cache */
-    uint64_t offset = hn4_addr_to_u64(lba) * 512; /* Assuming 512B sector base */
-    uint64_t bytes  = len * 512;
-    posix_fadvise(dev->fd, (off_t)offset, (off_t)bytes, POSIX_FADV_WILLNEED);
+    if (!(dev->caps.hw_flags & HN4_HW_NVM) || !dev->mmio_base || _is_sim(dev)) return;
 
-#elif defined(_WIN32)
-    /* Windows Prefetch logic (File mapping hint or empty) */
-    /* No-op for standard file handles */
+    uint64_t ss      = dev->caps.logical_block_size;
+    uint64_t offset  = hn4_addr_to_u64(lba) * ss;
+    uint64_t bytes   = (uint64_t)len * ss;
+    uint64_t max_cap = hn4_addr_to_u64(dev->caps.total_capacity_bytes);
 
-#else
-    /* Embedded/Bare-metal: No-op unless specific controller registers exist */
-    (void)lba;
-    (void)len;
+    if (offset >= max_cap) return;
+    if (bytes > max_cap - offset) bytes = max_cap - offset;
+    if (bytes > HN4_PREFETCH_MAX_BYTES) bytes = HN4_PREFETCH_MAX_BYTES;
+
+#if defined(__GNUC__) || defined(__clang__)
+    for (uint64_t off = 0; off < bytes; off += HN4_CACHE_LINE_SIZE) {
+        __builtin_prefetch(dev->mmio_base + offset + off, 0, 0);
+    }
 #endif
 }
 
@@ -961,7 +1542,13 @@ hn4_result_t hn4_hal_zns_append_sync(
     req->user_ctx = ctx;
 
     /* Submit to hardware queue */
-    hn4_hal_submit_io(dev, req, _hal_internal_cb);
+    uint64_t sim_done = 0;
+    if (_is_sim(dev)) {
+        _assert_hal_init();
+        _sim_submit(dev, req, _hal_internal_cb, &sim_done);
+    } else {
+        hn4_hal_submit_io(dev, req, _hal_internal_cb);
+    }
 
     /* 
      * THE POLLING LOOP
@@ -999,6 +1586,7 @@ hn4_result_t hn4_hal_zns_append_sync(
     }
 
     hn4_result_t final_res = ctx->res;
+    if (sim_done) _sim_wait_until(dev, sim_done);
 
     /* Safe to free resources */
     hn4_hal_mem_free(req);
@@ -1006,3 +1594,965 @@ hn4_result_t hn4_hal_zns_append_sync(
 
     return final_res;
 }
+
+/* =========================================================================
+ * 9. SIMULATED DEVICE (TIMING MODEL)
+ * ========================================================================= */
+
+/*
+ * MODEL:
+ * - Each command occupies one of 'queue_depth' service channels. It starts
+ *   when both the host clock and the channel are free, so async bursts
+ *   overlap while a chain of sync_io calls serialises.
+ * - Service = fixed latency + transfer (bytes / bandwidth).
+ * - HDD adds seek (settle + sqrt-distance curve) and rotational delay
+ *   whenever the head is not already at the target sector.
+ * - FLUSH waits for every channel to drain, then charges flush_latency.
+ * - ZNS runs a per-zone state machine (see ZONE MODEL below).
+ *
+ * The host clock ('now_ns') only moves when the caller waits for an I/O.
+ */
+
+#define HN4_SIM_MAX_CHANNELS 64
+
+typedef struct {
+    uint64_t    wp;             /* Sectors written */
+    uint64_t    last_write;     /* LRU stamp for implicit close */
+    uint8_t     state;          /* HN4_ZONE_* */
+} _hal_sim_zone_t;
+
+typedef struct {
+    hn4_hal_sim_profile_t prof;
+    uint8_t*              media;
+    uint64_t              media_bytes;
+    uint64_t              total_sectors;
+    hn4_spinlock_t        lock;
+    uint64_t              now_ns;
+    uint64_t              horizon_ns;
+    uint64_t              chan_free_ns[HN4_SIM_MAX_CHANNELS];
+    uint64_t              head_lba;
+    uint64_t              prng;
+    _hal_sim_zone_t*      zones;
+    uint64_t              zone_count;
+    uint64_t              zone_sectors;
+    uint32_t              open_count;
+    uint32_t              active_count;
+    uint64_t              open_clock;     /* LRU stamp source */
+    uint64_t              weak_lba;       /* Reads here complete HEALED */
+    uint64_t              weak_sectors;
+    hn4_hal_sim_stats_t   stats;
+} _hal_sim_ctx_t;
+
+static uint64_t _sim_next_rand(_hal_sim_ctx_t* s)
+{
+    /* SplitMix64: deterministic for a given seed */
+    uint64_t z = (s->prng += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t _sim_isqrt(uint64_t v)
+{
+    uint64_t r = 0, bit = 1ULL << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) { v -= r + bit; r = (r >> 1) + bit; }
+        else              { r >>= 1; }
+        bit >>= 2;
+    }
+    return r;
+}
+
+static uint64_t _sim_transfer_ns(const hn4_hal_sim_profile_t* p, uint64_t bytes)
+{
+    if (p->bytes_per_sec == 0) return 0;
+    return (bytes / p->bytes_per_sec) * 1000000000ULL +
+           ((bytes % p->bytes_per_sec) * 1000000000ULL) / p->bytes_per_sec;
+}
+
+/* Mechanical positioning cost. Updates head position. Lock held. */
+static uint64_t _sim_position_ns(_hal_sim_ctx_t* s, uint64_t lba, uint64_t sectors)
+{
+    const hn4_hal_sim_profile_t* p = &s->prof;
+    uint64_t cost = 0;
+
+    if (p->device_type != HN4_DEV_HDD) return 0;
+
+    uint64_t dist = (lba > s->head_lba) ? (lba - s->head_lba) : (s->head_lba - lba);
+    if (dist != 0) {
+        /* Seek time grows with sqrt(distance / full stroke), in Q16 */
+        uint64_t frac = (dist << 16) / (s->total_sectors ? s->total_sectors : 1);
+        if (frac > (1ULL << 16)) frac = 1ULL << 16;
+        uint64_t root  = _sim_isqrt(frac << 16);
+        uint64_t span  = (p->seek_full_ns > p->seek_settle_ns) ? (p->seek_full_ns - p->seek_settle_ns) : 0;
+
+        cost += p->seek_settle_ns + ((span * root) >> 16);
+        if (p->rotation_ns) cost += _sim_next_rand(s) % p->rotation_ns;
+
+        s->stats.seeks++;
+        s->stats.seek_distance += dist;
+    }
+
+    s->head_lba = lba + sectors;
+    return cost;
+}
+
+/* Places a command on the earliest free channel. Lock held. */
+static uint64_t _sim_schedule(_hal_sim_ctx_t* s, uint64_t cost)
+{
+    uint32_t qd   = s->prof.queue_depth;
+    uint32_t best = 0;
+
+    for (uint32_t c = 1; c < qd; c++) {
+        if (s->chan_free_ns[c] < s->chan_free_ns[best]) best = c;
+    }
+
+    uint64_t start = (s->chan_free_ns[best] > s->now_ns) ? s->chan_free_ns[best] : s->now_ns;
+    uint64_t done  = start + cost;
+
+    s->chan_free_ns[best] = done;
+    if (done > s->horizon_ns) s->horizon_ns = done;
+    s->stats.busy_ns += cost;
+    return done;
+}
+
+/* Barrier: drain all channels, then pay the cache flush. Lock held. */
+static uint64_t _sim_flush(_hal_sim_ctx_t* s)
+{
+    uint64_t start = (s->horizon_ns > s->now_ns) ? s->horizon_ns : s->now_ns;
+    uint64_t done  = start + s->prof.flush_latency_ns;
+
+    for (uint32_t c = 0; c < s->prof.queue_depth; c++) s->chan_free_ns[c] = done;
+    s->horizon_ns = done;
+    s->stats.busy_ns += s->prof.flush_latency_ns;
+    s->stats.flushes++;
+    return done;
+}
+
+/*
+ * ZONE MODEL:
+ *   EMPTY --write--> OPEN --wp==cap--> FULL --reset--> EMPTY
+ *                    OPEN <--write-- CLOSED (implicit close under limit)
+ * - Sequential zones accept WRITE only at the write pointer; APPEND
+ *   lands at the pointer and reports the LBA.
+ * - OPEN and CLOSED zones hold an Active resource; OPEN also holds an
+ *   Open resource. Hitting max_open implicitly closes the LRU open zone.
+ *   Hitting max_active fails the write (HN4_ERR_ZONE_LIMIT).
+ * - Leading 'conventional_zones' take random writes (format metadata).
+ */
+
+/* Returns zone index for a sequential zone, or UINT64_MAX. Lock held. */
+static uint64_t _sim_seq_zone(const _hal_sim_ctx_t* s, uint64_t lba)
+{
+    if (s->zone_count == 0) return UINT64_MAX;
+    uint64_t z = lba / s->zone_sectors;
+    if (z < s->prof.conventional_zones || z >= s->zone_count) return UINT64_MAX;
+    return z;
+}
+
+static hn4_result_t _sim_zone_open(_hal_sim_ctx_t* s, uint64_t z, uint64_t sectors)
+{
+    _hal_sim_zone_t* zn = &s->zones[z];
+
+    if (zn->state == HN4_ZONE_FULL || zn->wp + sectors > s->zone_sectors) {
+        return HN4_ERR_ZONE_FULL;
+    }
+
+    if (zn->state != HN4_ZONE_OPEN) {
+        if (zn->state == HN4_ZONE_EMPTY && s->prof.max_active_zones &&
+            s->active_count >= s->prof.max_active_zones) {
+            return HN4_ERR_ZONE_LIMIT;
+        }
+
+        if (s->prof.max_open_zones && s->open_count >= s->prof.max_open_zones) {
+            uint64_t victim = UINT64_MAX;
+            uint64_t oldest = UINT64_MAX;
+
+            for (uint64_t i = s->prof.conventional_zones; i < s->zone_count; i++) {
+                if (s->zones[i].state == HN4_ZONE_OPEN && s->zones[i].last_write < oldest) {
+                    oldest = s->zones[i].last_write;
+                    victim = i;
+                }
+            }
+            if (victim == UINT64_MAX) return HN4_ERR_ZONE_LIMIT;
+
+            s->zones[victim].state = HN4_ZONE_CLOSED;
+            s->open_count--;
+        }
+
+        if (zn->state == HN4_ZONE_EMPTY) s->active_count++;
+        zn->state = HN4_ZONE_OPEN;
+        s->open_count++;
+    }
+
+    zn->last_write = ++s->open_clock;
+    return HN4_OK;
+}
+
+static void _sim_zone_advance(_hal_sim_ctx_t* s, uint64_t z, uint64_t sectors)
+{
+    _hal_sim_zone_t* zn = &s->zones[z];
+
+    zn->wp += sectors;
+    if (zn->wp == s->zone_sectors) {
+        zn->state = HN4_ZONE_FULL;
+        s->open_count--;
+        s->active_count--;
+    }
+}
+
+static void _sim_zone_reset(_hal_sim_ctx_t* s, uint64_t z)
+{
+    _hal_sim_zone_t* zn = &s->zones[z];
+
+    if (zn->state == HN4_ZONE_OPEN)   { s->open_count--; s->active_count--; }
+    if (zn->state == HN4_ZONE_CLOSED) { s->active_count--; }
+
+    zn->state = HN4_ZONE_EMPTY;
+    zn->wp    = 0;
+}
+
+/* Validates a random-LBA write against the zone model. Lock held. */
+static hn4_result_t _sim_zone_check_write(_hal_sim_ctx_t* s, uint64_t lba, uint64_t sectors, uint64_t* zone_out)
+{
+    *zone_out = UINT64_MAX;
+    if (s->zone_count == 0 || sectors == 0) return HN4_OK;
+
+    uint64_t z_first = _sim_seq_zone(s, lba);
+    uint64_t z_last  = _sim_seq_zone(s, lba + sectors - 1);
+
+    if (z_first == UINT64_MAX && z_last == UINT64_MAX) return HN4_OK; /* Conventional */
+    if (z_first != z_last) return HN4_ERR_ZONE_WP_MISMATCH;           /* Crosses a boundary */
+    if (lba != z_first * s->zone_sectors + s->zones[z_first].wp) return HN4_ERR_ZONE_WP_MISMATCH;
+
+    hn4_result_t res = _sim_zone_open(s, z_first, sectors);
+    if (res == HN4_OK) *zone_out = z_first;
+    return res;
+}
+
+static void _sim_submit(hn4_hal_device_t* dev, hn4_io_req_t* req, hn4_io_callback_t cb, uint64_t* done_out)
+{
+    _hal_sim_ctx_t* s  = (_hal_sim_ctx_t*)dev->driver_ctx;
+    uint32_t ss        = dev->caps.logical_block_size;
+    uint64_t lba       = hn4_addr_to_u64(req->lba);
+    uint64_t sectors   = req->length;
+    uint64_t bytes     = sectors * ss;
+    uint64_t done      = 0;
+    hn4_result_t res   = HN4_OK;
+
+    req->result_lba = req->lba;
+
+    hn4_hal_spinlock_acquire(&s->lock);
+
+    if (req->op_code != HN4_IO_FLUSH) {
+        if (HN4_UNLIKELY(lba > s->total_sectors || sectors > (s->total_sectors - lba))) {
+            res = HN4_ERR_HW_IO;
+            goto out;
+        }
+    }
+
+    switch (req->op_code) {
+        case HN4_IO_READ:
+            memcpy(req->buffer, s->media + lba * ss, bytes);
+            done = _sim_schedule(s, s->prof.read_latency_ns + _sim_position_ns(s, lba, sectors) +
+                                    _sim_transfer_ns(&s->prof, bytes));
+            s->stats.reads++;
+            s->stats.bytes_read += bytes;
+
+            /* Weak cells: the data comes back, corrected by the device ECC */
+            if (lba < s->weak_lba + s->weak_sectors && s->weak_lba < lba + sectors) res = HN4_INFO_HEALED;
+            break;
+
+        case HN4_IO_WRITE:
+        case HN4_IO_ZERO:
+        {
+            uint64_t zone;
+            res = _sim_zone_check_write(s, lba, sectors, &zone);
+            if (res != HN4_OK) goto out;
+
+            if (req->op_code == HN4_IO_WRITE) memcpy(s->media + lba * ss, req->buffer, bytes);
+            else                              memset(s->media + lba * ss, 0, bytes);
+
+            /* A rewrite refreshes weak cells */
+            if (lba <= s->weak_lba && s->weak_lba + s->weak_sectors <= lba + sectors) s->weak_sectors = 0;
+            done = _sim_schedule(s, s->prof.write_latency_ns + _sim_position_ns(s, lba, sectors) +
+                                    _sim_transfer_ns(&s->prof, bytes));
+            s->stats.writes++;
+            s->stats.bytes_written += bytes;
+
+            if (zone != UINT64_MAX) _sim_zone_advance(s, zone, sectors);
+            break;
+        }
+
+        case HN4_IO_DISCARD:
+            done = _sim_schedule(s, s->prof.discard_latency_ns);
+            s->stats.discards++;
+            break;
+
+        case HN4_IO_FLUSH:
+            done = _sim_flush(s);
+            break;
+
+        case HN4_IO_ZONE_APPEND:
+        {
+            uint64_t zone = _sim_seq_zone(s, lba);
+            if (zone == UINT64_MAX) { res = HN4_ERR_INVALID_ARGUMENT; goto out; }
+
+            res = _sim_zone_open(s, zone, sectors);
+            if (res != HN4_OK) goto out;
+
+            uint64_t final_lba = zone * s->zone_sectors + s->zones[zone].wp;
+            _sim_zone_advance(s, zone, sectors);
+
+            memcpy(s->media + final_lba * ss, req->buffer, bytes);
+            req->result_lba = hn4_addr_from_u64(final_lba);
+
+            done = _sim_schedule(s, s->prof.write_latency_ns + _sim_transfer_ns(&s->prof, bytes));
+            s->stats.zone_appends++;
+            s->stats.bytes_written += bytes;
+            break;
+        }
+
+        case HN4_IO_ZONE_RESET:
+        {
+            uint64_t zone = _sim_seq_zone(s, lba);
+            if (zone == UINT64_MAX) { res = HN4_ERR_INVALID_ARGUMENT; goto out; }
+
+            _sim_zone_reset(s, zone);
+            memset(s->media + zone * s->zone_sectors * ss, 0, s->zone_sectors * ss);
+
+            done = _sim_schedule(s, s->prof.discard_latency_ns);
+            s->stats.zone_resets++;
+            break;
+        }
+
+        default:
+            res = HN4_ERR_INVALID_ARGUMENT;
+            break;
+    }
+
+out:
+    if (HN4_IS_ERR(res)) s->stats.errors++;
+    hn4_hal_spinlock_release(&s->lock);
+
+    if (done_out) *done_out = done;
+    atomic_thread_fence(memory_order_release);
+    if (cb) cb(req, res);
+}
+
+/* Host blocked on an I/O: advance the virtual clock to its completion. */
+static void _sim_wait_until(hn4_hal_device_t* dev, uint64_t done_ns)
+{
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    hn4_hal_spinlock_acquire(&s->lock);
+    if (done_ns > s->now_ns) s->now_ns = done_ns;
+    hn4_hal_spinlock_release(&s->lock);
+}
+
+static void _sim_drain(hn4_hal_device_t* dev)
+{
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    hn4_hal_spinlock_acquire(&s->lock);
+    if (s->horizon_ns > s->now_ns) s->now_ns = s->horizon_ns;
+    hn4_hal_spinlock_release(&s->lock);
+}
+
+void hn4_hal_sim_default_profile(uint8_t device_type, hn4_hal_sim_profile_t* out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    out->device_type = device_type;
+    out->sector_size = 4096;
+    out->seed        = 0x484E3453494DULL; /* "HN4SIM" */
+
+    switch (device_type) {
+        case HN4_DEV_HDD:
+            /* 7200 RPM Nearline */
+            out->queue_depth        = 1;
+            out->read_latency_ns    = 50000;
+            out->write_latency_ns   = 50000;
+            out->discard_latency_ns = 0;
+            out->flush_latency_ns   = 8000000;
+            out->bytes_per_sec      = 200ULL * 1024 * 1024;
+            out->seek_settle_ns     = 1000000;
+            out->seek_full_ns       = 15000000;
+            out->rotation_ns        = 8333333;
+            break;
+
+        case HN4_DEV_ZNS:
+            out->queue_depth        = 16;
+            out->read_latency_ns    = 80000;
+            out->write_latency_ns   = 30000;
+            out->discard_latency_ns = 2000000; /* Zone reset */
+            out->flush_latency_ns   = 300000;
+            out->bytes_per_sec      = 1536ULL * 1024 * 1024;
+            out->zone_size_bytes    = 16 * 1024 * 1024;
+            out->max_open_zones     = 8;
+            out->max_active_zones   = 14;
+            out->conventional_zones = 1;
+            break;
+
+        case HN4_DEV_SSD:
+        default:
+            /* TLC NVMe without power-loss protection */
+            out->device_type        = HN4_DEV_SSD;
+            out->queue_depth        = 32;
+            out->read_latency_ns    = 80000;
+            out->write_latency_ns   = 20000;
+            out->discard_latency_ns = 50000;
+            out->flush_latency_ns   = 800000;
+            out->bytes_per_sec      = 2048ULL * 1024 * 1024;
+            break;
+    }
+}
+
+hn4_result_t hn4_hal_sim_create(const hn4_hal_sim_profile_t* profile,
+                                uint64_t capacity_bytes,
+                                hn4_hal_device_t** out_dev)
+{
+    _assert_hal_init();
+    if (!profile || !out_dev || capacity_bytes == 0) return HN4_ERR_INVALID_ARGUMENT;
+    *out_dev = NULL;
+
+    uint32_t ss = profile->sector_size ? profile->sector_size : 4096;
+    if (capacity_bytes % ss) return HN4_ERR_ALIGNMENT_FAIL;
+    if (capacity_bytes > (uint64_t)SIZE_MAX) return HN4_ERR_NOMEM;
+
+    bool zoned = (profile->device_type == HN4_DEV_ZNS);
+    if (zoned && (profile->zone_size_bytes == 0 || (profile->zone_size_bytes % ss) != 0)) {
+        return HN4_ERR_INVALID_ARGUMENT;
+    }
+
+    hn4_hal_device_t* dev = hn4_hal_mem_alloc(sizeof(struct hn4_hal_device));
+    _hal_sim_ctx_t*   s   = hn4_hal_mem_alloc(sizeof(_hal_sim_ctx_t));
+    /* calloc: untouched media pages stay lazily zero-mapped */
+    uint8_t*          m   = calloc(1, (size_t)capacity_bytes);
+
+    if (!dev || !s || !m) goto nomem;
+
+    s->prof          = *profile;
+    s->prof.sector_size = ss;
+    s->media         = m;
+    s->media_bytes   = capacity_bytes;
+    s->total_sectors = capacity_bytes / ss;
+    s->prng          = profile->seed ? profile->seed : 0x9E3779B97F4A7C15ULL;
+    hn4_hal_spinlock_init(&s->lock);
+
+    if (s->prof.queue_depth == 0) s->prof.queue_depth = 1;
+    if (s->prof.queue_depth > HN4_SIM_MAX_CHANNELS) s->prof.queue_depth = HN4_SIM_MAX_CHANNELS;
+    if (s->prof.device_type == HN4_DEV_HDD) s->prof.queue_depth = 1; /* One actuator */
+
+    if (zoned) {
+        s->zone_sectors = profile->zone_size_bytes / ss;
+        s->zone_count   = s->total_sectors / s->zone_sectors;
+        s->zones        = hn4_hal_mem_alloc(s->zone_count * sizeof(_hal_sim_zone_t));
+        if (!s->zones) goto nomem;
+
+        for (uint64_t z = 0; z < s->zone_count; z++) {
+            s->zones[z].state = (z < s->prof.conventional_zones) ? HN4_ZONE_CONVENTIONAL : HN4_ZONE_EMPTY;
+        }
+    }
+
+    dev->caps.total_capacity_bytes = hn4_addr_from_u64(capacity_bytes);
+    dev->caps.logical_block_size   = ss;
+    dev->caps.optimal_io_boundary  = ss;
+    dev->caps.zone_size_bytes      = zoned ? profile->zone_size_bytes : 0;
+    dev->caps.max_transfer_bytes   = 1024 * 1024;
+    dev->caps.queue_count          = s->prof.queue_depth;
+    dev->caps.hw_flags             = HN4_HW_SIMULATED | HN4_HW_STRICT_FLUSH;
+
+    if (s->prof.device_type == HN4_DEV_HDD) dev->caps.hw_flags |= HN4_HW_ROTATIONAL;
+    if (zoned)                              dev->caps.hw_flags |= HN4_HW_ZNS_NATIVE;
+
+    dev->driver_ctx = s;
+    *out_dev = dev;
+    return HN4_OK;
+
+nomem:
+    if (s && s->zones) hn4_hal_mem_free(s->zones);
+    free(m);
+    if (s)   hn4_hal_mem_free(s);
+    if (dev) hn4_hal_mem_free(dev);
+    return HN4_ERR_NOMEM;
+}
+
+void hn4_hal_sim_destroy(hn4_hal_device_t* dev)
+{
+    if (!_is_sim(dev)) return;
+
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    if (s->zones) hn4_hal_mem_free(s->zones);
+    free(s->media);
+    hn4_hal_mem_free(s);
+    hn4_hal_mem_free(dev);
+}
+
+hn4_time_t hn4_hal_sim_now(hn4_hal_device_t* dev)
+{
+    if (!_is_sim(dev)) return 0;
+
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    hn4_hal_spinlock_acquire(&s->lock);
+    uint64_t now = s->now_ns;
+    hn4_hal_spinlock_release(&s->lock);
+    return (hn4_time_t)now;
+}
+
+void hn4_hal_sim_set_weak(hn4_hal_device_t* dev, uint64_t lba, uint64_t sectors)
+{
+    if (!_is_sim(dev)) return;
+
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    hn4_hal_spinlock_acquire(&s->lock);
+    s->weak_lba     = lba;
+    s->weak_sectors = sectors;
+    hn4_hal_spinlock_release(&s->lock);
+}
+
+hn4_result_t hn4_hal_sim_get_stats(hn4_hal_device_t* dev, hn4_hal_sim_stats_t* out)
+{
+    if (!out) return HN4_ERR_INVALID_ARGUMENT;
+    if (!_is_sim(dev)) return HN4_ERR_INVALID_ARGUMENT;
+
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    hn4_hal_spinlock_acquire(&s->lock);
+    *out = s->stats;
+    hn4_hal_spinlock_release(&s->lock);
+    return HN4_OK;
+}
+
+hn4_result_t hn4_hal_zone_report(hn4_hal_device_t* dev, uint64_t zone_idx, hn4_hal_zone_info_t* out)
+{
+    if (!out || !_is_sim(dev)) return HN4_ERR_INVALID_ARGUMENT;
+
+    _hal_sim_ctx_t* s = (_hal_sim_ctx_t*)dev->driver_ctx;
+    if (zone_idx >= s->zone_count) return HN4_ERR_INVALID_ARGUMENT;
+
+    hn4_hal_spinlock_acquire(&s->lock);
+    uint64_t start = zone_idx * s->zone_sectors;
+    out->start_lba        = hn4_addr_from_u64(start);
+    out->write_ptr        = hn4_addr_from_u64(start + s->zones[zone_idx].wp);
+    out->capacity_sectors = s->zone_sectors;
+    out->state            = s->zones[zone_idx].state;
+    hn4_hal_spinlock_release(&s->lock);
+
+    return HN4_OK;
+}
+
+/* =========================================================================
+ * 10. ELEVATOR SCHEDULER (ROTATIONAL MEDIA)
+ * ========================================================================= */
+
+/*
+ * One device command built from a run of queued requests. 'req' MUST be
+ * the first member: the completion callback casts back to the wrapper.
+ */
+typedef struct {
+    hn4_io_req_t        req;
+    hn4_io_sched_t*     sched;
+    uint8_t*            bounce;     /* NULL for single parts and DISCARD/ZERO */
+    uint32_t            count;
+    hn4_sched_slot_t    parts[];
+} _sched_cmd_t;
+
+HN4_INLINE bool _sched_sortable(uint8_t op)
+{
+    return op == HN4_IO_READ || op == HN4_IO_WRITE ||
+           op == HN4_IO_DISCARD || op == HN4_IO_ZERO;
+}
+
+HN4_INLINE bool _sched_needs_bounce(uint8_t op)
+{
+    return op == HN4_IO_READ || op == HN4_IO_WRITE;
+}
+
+HN4_INLINE uint64_t _sched_lba(const hn4_io_req_t* r)
+{
+    return hn4_addr_to_u64(r->lba);
+}
+
+void hn4_hal_sched_init(hn4_io_sched_t* s, hn4_hal_device_t* dev)
+{
+    if (!s) return;
+    memset(s, 0, sizeof(*s));
+    s->dev = dev;
+    hn4_hal_spinlock_init(&s->lock);
+}
+
+static void _sched_cmd_done(hn4_io_req_t* req, hn4_result_t res)
+{
+    _sched_cmd_t*   c  = (_sched_cmd_t*)req;
+    hn4_io_sched_t* s  = c->sched;
+    uint32_t        ss = s->dev->caps.logical_block_size;
+    size_t          off = 0;
+
+    for (uint32_t i = 0; i < c->count; i++) {
+        hn4_io_req_t* p = c->parts[i].req;
+        size_t bytes = (size_t)p->length * ss;
+
+        /* INFO results (e.g. a healed read) still carry the data */
+        if (c->bounce && p->op_code == HN4_IO_READ && !HN4_IS_ERR(res)) {
+            memcpy(p->buffer, c->bounce + off, bytes);
+        }
+        off += bytes;
+
+        p->result_lba = p->lba;
+        if (c->parts[i].cb) c->parts[i].cb(p, res);
+    }
+
+    if (c->bounce) hn4_hal_mem_free(c->bounce);
+    hn4_hal_mem_free(c);
+    atomic_fetch_sub_explicit(&s->in_flight, 1, memory_order_release);
+}
+
+/* Issues slots [0, n) (contiguous, same op) as one device command */
+static void _sched_issue(hn4_io_sched_t* s, const hn4_sched_slot_t* run, uint32_t n)
+{
+    uint32_t ss    = s->dev->caps.logical_block_size;
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < n; i++) total += run[i].req->length;
+
+    _sched_cmd_t* c = hn4_hal_mem_alloc(sizeof(_sched_cmd_t) + n * sizeof(hn4_sched_slot_t));
+    uint8_t* bounce = NULL;
+
+    if (c && n > 1 && _sched_needs_bounce(run[0].req->op_code)) {
+        bounce = hn4_hal_mem_alloc((size_t)total * ss);
+        if (!bounce) { hn4_hal_mem_free(c); c = NULL; }
+    }
+
+    /* OOM: degrade to unmerged pass-through, order is still C-LOOK */
+    if (!c) {
+        for (uint32_t i = 0; i < n; i++) hn4_hal_submit_io(s->dev, run[i].req, run[i].cb);
+        s->dispatched += n;
+        return;
+    }
+
+    c->req        = *run[0].req;
+    c->req.length = total;
+    c->req.user_ctx = NULL;
+    c->sched      = s;
+    c->bounce     = bounce;
+    c->count      = n;
+    memcpy(c->parts, run, n * sizeof(hn4_sched_slot_t));
+
+    if (bounce) {
+        c->req.buffer = bounce;
+        if (c->req.op_code == HN4_IO_WRITE) {
+            size_t off = 0;
+            for (uint32_t i = 0; i < n; i++) {
+                size_t bytes = (size_t)run[i].req->length * ss;
+                memcpy(bounce + off, run[i].req->buffer, bytes);
+                off += bytes;
+            }
+        }
+    }
+
+    s->dispatched++;
+    s->merged += n - 1;
+    atomic_fetch_add_explicit(&s->in_flight, 1, memory_order_relaxed);
+    hn4_hal_submit_io(s->dev, &c->req, _sched_cmd_done);
+}
+
+/*
+ * Merge Test
+ * Same op and flags, physically adjacent, combined size within the cap.
+ */
+static bool _sched_can_merge(const hn4_sched_slot_t* tail, const hn4_sched_slot_t* next,
+                             uint64_t run_bytes, uint32_t ss)
+{
+    const hn4_io_req_t* a = tail->req;
+    const hn4_io_req_t* b = next->req;
+
+    if (a->op_code != b->op_code || a->flags != b->flags) return false;
+    if (_sched_lba(a) + a->length != _sched_lba(b)) return false;
+    return run_bytes + (uint64_t)b->length * ss <= HN4_SCHED_MAX_MERGE_BYTES;
+}
+
+void hn4_hal_sched_kick(hn4_io_sched_t* s)
+{
+    if (!s || !s->dev) return;
+
+    hn4_sched_slot_t batch[HN4_SCHED_DEPTH];
+    bool             done[HN4_SCHED_DEPTH];
+    uint32_t         n;
+    uint64_t         head;
+
+    /* Detach the whole queue; completions may re-enter submit */
+    hn4_hal_spinlock_acquire(&s->lock);
+    n = s->count;
+    memcpy(batch, s->slots, n * sizeof(hn4_sched_slot_t));
+    s->count = 0;
+    head = s->head_lba;
+    hn4_hal_spinlock_release(&s->lock);
+
+    if (n == 0) return;
+    memset(done, 0, n);
+
+    uint32_t ss  = s->dev->caps.logical_block_size;
+    hn4_time_t now = hn4_hal_get_time_ns();
+
+    /* 1. Expired requests first, oldest deadline first */
+    for (;;) {
+        uint32_t pick = n;
+        for (uint32_t i = 0; i < n; i++) {
+            if (done[i] || batch[i].deadline > now) continue;
+            if (pick == n || batch[i].deadline < batch[pick].deadline) pick = i;
+        }
+        if (pick == n) break;
+
+        done[pick] = true;
+        s->expired++;
+        _sched_issue(s, &batch[pick], 1);
+        head = _sched_lba(batch[pick].req) + batch[pick].req->length;
+    }
+
+    /* 2. C-LOOK: ascending sweep from the head, then wrap to the lowest LBA */
+    uint32_t start = 0;
+    while (start < n && _sched_lba(batch[start].req) < head) start++;
+
+    hn4_sched_slot_t run[HN4_SCHED_DEPTH];
+    for (uint32_t k = 0; k < n; k++) {
+        uint32_t i = (start + k) % n;
+        if (done[i]) continue;
+
+        uint32_t rn = 0;
+        uint64_t run_bytes = (uint64_t)batch[i].req->length * ss;
+        run[rn++] = batch[i];
+        done[i] = true;
+
+        /* Absorb adjacent neighbours (queue is LBA-sorted) */
+        uint32_t j = i + 1;
+        while (j < n && !done[j] && _sched_can_merge(&run[rn - 1], &batch[j], run_bytes, ss)) {
+            run_bytes += (uint64_t)batch[j].req->length * ss;
+            run[rn++] = batch[j];
+            done[j] = true;
+            j++;
+        }
+
+        _sched_issue(s, run, rn);
+        head = _sched_lba(run[rn - 1].req) + run[rn - 1].req->length;
+    }
+
+    hn4_hal_spinlock_acquire(&s->lock);
+    s->head_lba = head;
+    hn4_hal_spinlock_release(&s->lock);
+}
+
+void hn4_hal_sched_drain(hn4_io_sched_t* s)
+{
+    if (!s || !s->dev) return;
+    hn4_hal_sched_kick(s);
+
+    while (atomic_load_explicit(&s->in_flight, memory_order_acquire) != 0) {
+        hn4_hal_poll(s->dev);
+    }
+}
+
+void hn4_hal_sched_submit(hn4_io_sched_t* s, hn4_io_req_t* req, hn4_io_callback_t cb)
+{
+    if (HN4_UNLIKELY(!s || !s->dev || !req)) {
+        if (cb) cb(req, HN4_ERR_INVALID_ARGUMENT);
+        return;
+    }
+
+    /* Ordering point: everything queued must be on media first */
+    if (!_sched_sortable(req->op_code)) {
+        hn4_hal_sched_drain(s);
+        hn4_hal_submit_io(s->dev, req, cb);
+        return;
+    }
+
+    hn4_time_t now = hn4_hal_get_time_ns();
+    hn4_time_t ttl = (req->op_code == HN4_IO_READ) ? HN4_SCHED_READ_EXPIRE_NS
+                                                   : HN4_SCHED_WRITE_EXPIRE_NS;
+    bool fire = false;
+
+    for (;;) {
+        hn4_hal_spinlock_acquire(&s->lock);
+        if (s->count < HN4_SCHED_DEPTH) break;
+        hn4_hal_spinlock_release(&s->lock);
+        hn4_hal_sched_kick(s);
+    }
+
+    /* Sorted insert (stable: equal LBAs keep submission order) */
+    uint64_t lba = _sched_lba(req);
+    uint32_t pos = s->count;
+    while (pos > 0 && _sched_lba(s->slots[pos - 1].req) > lba) {
+        s->slots[pos] = s->slots[pos - 1];
+        pos--;
+    }
+    s->slots[pos].req      = req;
+    s->slots[pos].cb       = cb;
+    s->slots[pos].deadline = now + ttl;
+    s->count++;
+
+    if (s->count == HN4_SCHED_DEPTH) fire = true;
+    for (uint32_t i = 0; i < s->count && !fire; i++) {
+        if (s->slots[i].deadline <= now) fire = true;
+    }
+    hn4_hal_spinlock_release(&s->lock);
+
+    if (fire) hn4_hal_sched_kick(s);
+}
+
+/* =========================================================================
+ * 11. WORK QUEUE (CPU OFFLOAD)
+ * ========================================================================= */
+
+typedef struct {
+    hn4_hal_work_fn_t   fn;
+    void*               arg;
+    _Atomic uint32_t*   done;
+} _workq_item_t;
+
+struct hn4_hal_workq {
+#if defined(HN4_HAS_THREADS)
+    pthread_mutex_t     mu;
+    pthread_cond_t      not_full;
+    pthread_cond_t      not_empty;
+    pthread_cond_t      progress;       /* A job finished */
+    pthread_t           threads[HN4_WORKQ_MAX_THREADS];
+#endif
+    uint32_t            n_threads;
+    uint32_t            depth;
+    uint32_t            head;
+    uint32_t            count;
+    uint32_t            busy;
+    bool                stop;
+    _workq_item_t       ring[];
+};
+
+uint32_t hn4_hal_cpu_count(void)
+{
+#if defined(HN4_HAS_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) return (uint32_t)n;
+#endif
+    return 1;
+}
+
+static void _workq_run(const _workq_item_t* it)
+{
+    it->fn(it->arg);
+    if (it->done) atomic_store_explicit(it->done, 1, memory_order_release);
+}
+
+#if defined(HN4_HAS_THREADS)
+static void* _workq_main(void* ctx)
+{
+    hn4_hal_workq_t* q = (hn4_hal_workq_t*)ctx;
+
+    pthread_mutex_lock(&q->mu);
+    for (;;) {
+        while (q->count == 0 && !q->stop) pthread_cond_wait(&q->not_empty, &q->mu);
+        if (q->count == 0) break;   /* Stopping and drained */
+
+        _workq_item_t it = q->ring[q->head];
+        q->head = (q->head + 1) % q->depth;
+        q->count--;
+        q->busy++;
+        pthread_cond_signal(&q->not_full);
+        pthread_mutex_unlock(&q->mu);
+
+        _workq_run(&it);
+
+        pthread_mutex_lock(&q->mu);
+        q->busy--;
+        pthread_cond_broadcast(&q->progress);
+    }
+    pthread_mutex_unlock(&q->mu);
+    return NULL;
+}
+#endif
+
+hn4_hal_workq_t* hn4_hal_workq_create(uint32_t threads, uint32_t depth)
+{
+#if defined(HN4_HAS_THREADS)
+    if (threads == 0 || depth == 0) return NULL;
+    if (threads > HN4_WORKQ_MAX_THREADS) threads = HN4_WORKQ_MAX_THREADS;
+
+    hn4_hal_workq_t* q = hn4_hal_mem_alloc(sizeof(hn4_hal_workq_t) + depth * sizeof(_workq_item_t));
+    if (!q) return NULL;
+    memset(q, 0, sizeof(hn4_hal_workq_t));
+    q->depth = depth;
+
+    pthread_mutex_init(&q->mu, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->progress, NULL);
+
+    for (uint32_t i = 0; i < threads; i++) {
+        if (pthread_create(&q->threads[i], NULL, _workq_main, q) != 0) break;
+        q->n_threads++;
+    }
+
+    if (q->n_threads == 0) {
+        hn4_hal_workq_destroy(q);
+        return NULL;
+    }
+    return q;
+#else
+    (void)threads; (void)depth;
+    return NULL;
+#endif
+}
+
+void hn4_hal_workq_submit(hn4_hal_workq_t* q, hn4_hal_work_fn_t fn, void* arg,
+                          _Atomic uint32_t* done)
+{
+    _workq_item_t it = { fn, arg, done };
+    if (done) atomic_store_explicit(done, 0, memory_order_relaxed);
+
+#if defined(HN4_HAS_THREADS)
+    if (q) {
+        pthread_mutex_lock(&q->mu);
+        while (q->count == q->depth) pthread_cond_wait(&q->not_full, &q->mu);
+        q->ring[(q->head + q->count) % q->depth] = it;
+        q->count++;
+        pthread_cond_signal(&q->not_empty);
+        pthread_mutex_unlock(&q->mu);
+        return;
+    }
+#endif
+    (void)q;
+    _workq_run(&it);
+}
+
+void hn4_hal_workq_wait(hn4_hal_workq_t* q, _Atomic uint32_t* done)
+{
+#if defined(HN4_HAS_THREADS)
+    if (!q) return;
+    if (done && atomic_load_explicit(done, memory_order_acquire)) return;
+
+    pthread_mutex_lock(&q->mu);
+    for (;;) {
+        if (done ? atomic_load_explicit(done, memory_order_acquire) != 0
+                 : (q->count == 0 && q->busy == 0)) break;
+        pthread_cond_wait(&q->progress, &q->mu);
+    }
+    pthread_mutex_unlock(&q->mu);
+#else
+    (void)q; (void)done;
+#endif
+}
+
+void hn4_hal_workq_destroy(hn4_hal_workq_t* q)
+{
+    if (!q) return;
+#if defined(HN4_HAS_THREADS)
+    pthread_mutex_lock(&q->mu);
+    q->stop = true;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_mutex_unlock(&q->mu);
+
+    for (uint32_t i = 0; i < q->n_threads; i++) pthread_join(q->threads[i], NULL);
+
+    pthread_mutex_destroy(&q->mu);
+    pthread_cond_destroy(&q->not_full);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->progress);
+#endif
+    hn4_hal_mem_free(q);
+}
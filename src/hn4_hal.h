@@ -45,6 +45,8 @@ extern uint32_t _hn4_cpu_features;
 #define HN4_CPU_X86_CLFLUSH     (1 << 0)
 #define HN4_CPU_X86_CLFLUSHOPT  (1 << 1)
 #define HN4_CPU_X86_CLWB        (1 << 2)
+#define HN4_CPU_X86_AVX2        (1 << 3)    /* Set only if the OS saves YMM state */
+#define HN4_CPU_X86_BMI2        (1 << 4)
 
 #define HN4_CACHE_LINE_SIZE     64
 #define HN4_GPU_ID_NONE 0xFFFFFFFFU
@@ -86,14 +88,42 @@ const hn4_hal_caps_t* hn4_hal_get_caps(hn4_hal_device_t* dev);
 void* hn4_hal_mem_alloc(size_t size);
 void  hn4_hal_mem_free(void* ptr);
 
+#define HN4_NUMA_NODE_ANY       0xFFFFFFFFU     /* No placement policy */
+#define HN4_NUMA_NODE_LOCAL     0xFFFFFFFEU     /* Node of the calling thread */
+
+/**
+ * hn4_hal_mem_alloc_node
+ * As hn4_hal_mem_alloc(), but prefers pages on the given NUMA node.
+ * Best effort: falls back to default placement without NUMA support.
+ * Release with hn4_hal_mem_free().
+ */
+void* hn4_hal_mem_alloc_node(size_t size, uint32_t node);
+
 /* =========================================================================
  * 4. CONCURRENCY PRIMITIVES
  * ========================================================================= */
 
+/*
+ * All waits spin with PAUSE for a bounded number of rounds, then yield
+ * the CPU to the scheduler so oversubscribed hosts keep making progress.
+ */
 void hn4_hal_spinlock_init(hn4_spinlock_t* lock);
 void hn4_hal_spinlock_acquire(hn4_spinlock_t* lock);
 void hn4_hal_spinlock_release(hn4_spinlock_t* lock);
 
+/**
+ * hn4_hal_spinlock_acquire_shared
+ * Read-side entry for read-mostly sections (anchor snapshots, topology).
+ * Any number of readers may hold the lock together. A waiting writer
+ * blocks new readers (writer preference).
+ */
+void hn4_hal_spinlock_acquire_shared(hn4_spinlock_t* lock);
+void hn4_hal_spinlock_release_shared(hn4_spinlock_t* lock);
+
+void hn4_hal_ticket_lock_init(hn4_ticket_lock_t* lock);
+void hn4_hal_ticket_lock_acquire(hn4_ticket_lock_t* lock);
+void hn4_hal_ticket_lock_release(hn4_ticket_lock_t* lock);
+
 /* =========================================================================
  * 5. IO KINETICS & SUBMISSION
  * ========================================================================= */
@@ -145,7 +175,42 @@ void hn4_hal_poll(hn4_hal_device_t* dev);
  * 6. TELEMETRY & UTILITIES
  * ========================================================================= */
 
+/*
+ * Clock Sources
+ * TSC:       Invariant TSC scaled by a factor calibrated against the OS
+ *            monotonic clock at init. No syscall, no shared cache line.
+ * MONOTONIC: clock_gettime(CLOCK_MONOTONIC) (vDSO on Linux).
+ * COUNTER:   Bare metal without a timer. Strictly increasing, not real time.
+ * All sources share the CLOCK_MONOTONIC epoch where one exists.
+ */
+#define HN4_CLOCK_COUNTER       0
+#define HN4_CLOCK_MONOTONIC     1
+#define HN4_CLOCK_TSC           2
+
+/* Coarse tick resolution budget (hn4_hal_get_vol_tick) */
+#define HN4_CLOCK_COARSE_NS     (4ULL * 1000000ULL)
+
 hn4_time_t hn4_hal_get_time_ns(void);
+
+/**
+ * hn4_hal_get_coarse_ns
+ * Millisecond-class monotonic time (CLOCK_MONOTONIC_COARSE where
+ * available). Same epoch as hn4_hal_get_time_ns(), may lag it by up to
+ * one scheduler tick.
+ */
+hn4_time_t hn4_hal_get_coarse_ns(void);
+
+/**
+ * hn4_hal_get_vol_tick
+ * Per-volume coarse timestamp for metadata that does not need nanosecond
+ * precision (mod_clock, pulse scheduling). Never goes backwards for a
+ * given volume, even across threads.
+ */
+hn4_time_t hn4_hal_get_vol_tick(hn4_volume_t* vol);
+
+/* Active source (HN4_CLOCK_*). Calibrates on first use if needed. */
+uint32_t   hn4_hal_clock_source(void);
+
 uint32_t   hn4_hal_get_temperature(hn4_hal_device_t* dev);
 void       hn4_hal_micro_sleep(uint32_t us);
 uint64_t   hn4_hal_get_random_u64(void);
@@ -256,6 +321,7 @@ uint32_t hn4_hal_get_calling_gpu_id(void);
 /**
  * hn4_hal_get_topology_count
  * Returns the number of Affinity Regions (NUMA nodes / PCIe Switches) available.
+ * NUMA-derived regions carry HN4_TOPO_NUMA_TAG | node_id in the gpu_id field.
  */
 uint32_t hn4_hal_get_topology_count(hn4_hal_device_t* dev);
 
@@ -265,6 +331,24 @@ uint32_t hn4_hal_get_topology_count(hn4_hal_device_t* dev);
  */
 hn4_result_t hn4_hal_get_topology_data(hn4_hal_device_t* dev, void* buffer, size_t buf_len);
 
+/* NUMA Topology (sysfs-backed on Linux, single node elsewhere) */
+#define HN4_NUMA_MAX_NODES      64
+#define HN4_NUMA_MAX_CPUS       1024
+#define HN4_TOPO_NUMA_TAG       0x80000000U
+
+/**
+ * hn4_hal_topology_set_root
+ * Rescans topology from '<sysfs_root>/devices/system/node'. NULL restores
+ * "/sys". For tests and containers; not safe against concurrent users.
+ */
+hn4_result_t hn4_hal_topology_set_root(const char* sysfs_root);
+
+uint32_t hn4_hal_numa_node_count(void);
+uint32_t hn4_hal_numa_current_node(void);
+
+/* SLIT distance (10 = local). Returns 0 for unknown nodes. */
+uint32_t hn4_hal_numa_distance(uint32_t node_a, uint32_t node_b);
+
 hn4_result_t hn4_hal_zns_append_sync(
     hn4_hal_device_t* dev,
     hn4_addr_t zone_start_lba,
@@ -273,6 +357,205 @@ hn4_result_t hn4_hal_zns_append_sync(
     hn4_addr_t* result_lba
 );
 
+/* Zone States (NVMe ZNS subset) */
+#define HN4_ZONE_EMPTY          0
+#define HN4_ZONE_OPEN           1   /* Holds an Open + Active resource */
+#define HN4_ZONE_CLOSED         2   /* Partially written, holds Active resource */
+#define HN4_ZONE_FULL           3
+#define HN4_ZONE_CONVENTIONAL   4   /* Random-write zone (no write pointer) */
+
+typedef struct {
+    hn4_addr_t  start_lba;
+    hn4_addr_t  write_ptr;        /* Absolute LBA of next append */
+    uint64_t    capacity_sectors;
+    uint8_t     state;
+} hn4_hal_zone_info_t;
+
+/**
+ * hn4_hal_zone_report
+ * Reports the state of one zone. Requires a device with a per-device
+ * zone model (see hn4_hal_sim_create). Returns HN4_ERR_INVALID_ARGUMENT
+ * for devices without one.
+ */
+hn4_result_t hn4_hal_zone_report(hn4_hal_device_t* dev, uint64_t zone_idx, hn4_hal_zone_info_t* out);
+
+/* =========================================================================
+ * 7. SIMULATED DEVICE (TIMING MODEL)
+ * =========================================================================
+ * RAM-backed device that charges every I/O against a virtual clock.
+ * Used by benchmarks to compare layout/barrier decisions on SSD, HDD and
+ * ZNS media without real hardware. All costs are deterministic for a
+ * given profile + seed. Virtual time only advances when the caller waits
+ * (sync_io, barrier, poll); async submissions overlap across channels.
+ *
+ * ZNS profiles get a per-device zone state machine (write pointer
+ * enforcement, open/active limits). Zeroing the latency fields yields a
+ * pure functional zone emulator.
+ */
+
+typedef struct {
+    uint8_t     device_type;      /* HN4_DEV_SSD / HN4_DEV_HDD / HN4_DEV_ZNS */
+    uint32_t    queue_depth;      /* Parallel service channels (HDD forced to 1) */
+    uint32_t    sector_size;
+    uint32_t    zone_size_bytes;  /* ZNS only */
+    uint32_t    max_open_zones;   /* ZNS: 0 = unlimited. LRU open zone is implicitly closed */
+    uint32_t    max_active_zones; /* ZNS: 0 = unlimited. Exceeding fails with ZONE_LIMIT */
+    uint32_t    conventional_zones; /* ZNS: leading random-write zones (metadata) */
+    uint64_t    read_latency_ns;  /* Fixed per-command cost */
+    uint64_t    write_latency_ns;
+    uint64_t    discard_latency_ns;
+    uint64_t    flush_latency_ns; /* Cost of draining the volatile cache */
+    uint64_t    bytes_per_sec;    /* Media transfer rate */
+    uint64_t    seek_settle_ns;   /* HDD: track-to-track seek */
+    uint64_t    seek_full_ns;     /* HDD: full-stroke seek */
+    uint64_t    rotation_ns;      /* HDD: one revolution */
+    uint64_t    seed;             /* Jitter / rotational phase PRNG seed */
+} hn4_hal_sim_profile_t;
+
+typedef struct {
+    uint64_t    reads;
+    uint64_t    writes;
+    uint64_t    flushes;
+    uint64_t    discards;
+    uint64_t    zone_appends;
+    uint64_t    zone_resets;
+    uint64_t    bytes_read;
+    uint64_t    bytes_written;
+    uint64_t    seeks;            /* HDD: non-sequential head movements */
+    uint64_t    seek_distance;    /* HDD: total sectors travelled */
+    uint64_t    busy_ns;          /* Sum of per-command service time */
+    uint64_t    errors;
+} hn4_hal_sim_stats_t;
+
+/**
+ * hn4_hal_sim_default_profile
+ * Fills 'out' with a representative profile for the device class.
+ */
+void hn4_hal_sim_default_profile(uint8_t device_type, hn4_hal_sim_profile_t* out);
+
+/**
+ * hn4_hal_sim_create
+ * Allocates a simulated device of 'capacity_bytes'. Caps are derived from
+ * the profile (ROTATIONAL for HDD, ZNS_NATIVE for ZNS).
+ */
+hn4_result_t hn4_hal_sim_create(const hn4_hal_sim_profile_t* profile,
+                                uint64_t capacity_bytes,
+                                hn4_hal_device_t** out_dev);
+
+void hn4_hal_sim_destroy(hn4_hal_device_t* dev);
+
+/**
+ * hn4_hal_sim_now
+ * Returns the device's virtual clock (ns). 0 for non-simulated devices.
+ */
+hn4_time_t hn4_hal_sim_now(hn4_hal_device_t* dev);
+
+hn4_result_t hn4_hal_sim_get_stats(hn4_hal_device_t* dev, hn4_hal_sim_stats_t* out);
+
+/**
+ * hn4_hal_sim_set_weak
+ * Marks [lba, lba + sectors) as weak: reads still return the data but
+ * complete with HN4_INFO_HEALED (on-device ECC correction) until a write
+ * covers the range. sectors = 0 clears it.
+ */
+void hn4_hal_sim_set_weak(hn4_hal_device_t* dev, uint64_t lba, uint64_t sectors);
+
+/* =========================================================================
+ * 8. ELEVATOR SCHEDULER (ROTATIONAL MEDIA)
+ * ========================================================================= */
+
+/*
+ * Optional, caller-owned request queue for bursty scattered I/O on HDDs
+ * (reaper, evacuation, mount scans). Pending requests are kept sorted by
+ * LBA and dispatched in C-LOOK order (one ascending sweep, then wrap to
+ * the lowest LBA). Adjacent READ/WRITE/DISCARD requests of the same type
+ * are merged into one device command through a bounce buffer. Every
+ * request carries a deadline; once one expires, it is served next so a
+ * far-away read cannot starve behind a dense write cluster.
+ *
+ * FLUSH and zone commands are ordering points: the queue is drained
+ * before they are passed through.
+ */
+#define HN4_SCHED_DEPTH             128
+#define HN4_SCHED_MAX_MERGE_BYTES   (1024u * 1024u)
+#define HN4_SCHED_READ_EXPIRE_NS    (50ULL * 1000000ULL)    /* 50ms */
+#define HN4_SCHED_WRITE_EXPIRE_NS   (500ULL * 1000000ULL)   /* 500ms */
+
+typedef struct {
+    hn4_io_req_t*       req;
+    hn4_io_callback_t   cb;
+    hn4_time_t          deadline;
+} hn4_sched_slot_t;
+
+typedef struct {
+    hn4_hal_device_t*   dev;
+    hn4_spinlock_t      lock;
+    uint32_t            count;          /* Pending, sorted by LBA */
+    uint64_t            head_lba;       /* End of last dispatch (sweep position) */
+    _Atomic uint32_t    in_flight;
+
+    /* Telemetry */
+    uint64_t            dispatched;     /* Device commands issued */
+    uint64_t            merged;         /* Requests folded into a neighbour */
+    uint64_t            expired;        /* Dispatches forced by a deadline */
+
+    hn4_sched_slot_t    slots[HN4_SCHED_DEPTH];
+} hn4_io_sched_t;
+
+void hn4_hal_sched_init(hn4_io_sched_t* s, hn4_hal_device_t* dev);
+
+/**
+ * hn4_hal_sched_submit
+ * Queues 'req'. Dispatches the queue when it is full, when a pending
+ * deadline has passed, or when 'req' is an ordering point. 'cb' fires
+ * once the request (or the merged command containing it) completes.
+ */
+void hn4_hal_sched_submit(hn4_io_sched_t* s, hn4_io_req_t* req, hn4_io_callback_t cb);
+
+/* Dispatches everything pending (end of burst). Does not wait. */
+void hn4_hal_sched_kick(hn4_io_sched_t* s);
+
+/* Kick, then poll the device until every dispatched command completed. */
+void hn4_hal_sched_drain(hn4_io_sched_t* s);
+
+/* =========================================================================
+ * 9. WORK QUEUE (CPU OFFLOAD)
+ * ========================================================================= */
+
+/*
+ * Bounded FIFO of CPU jobs served by a fixed set of worker threads. Hosted
+ * builds only: on bare metal hn4_hal_workq_create() returns NULL and every
+ * call below accepts a NULL queue by running the job inline in the caller.
+ */
+#define HN4_WORKQ_MAX_THREADS   16
+
+typedef void (*hn4_hal_work_fn_t)(void* arg);
+typedef struct hn4_hal_workq hn4_hal_workq_t;
+
+/* Online CPUs (1 when unknown) */
+uint32_t hn4_hal_cpu_count(void);
+
+/**
+ * hn4_hal_workq_create
+ * Spawns 'threads' workers (capped at HN4_WORKQ_MAX_THREADS) behind a
+ * queue of 'depth' slots. NULL when threads are unavailable.
+ */
+hn4_hal_workq_t* hn4_hal_workq_create(uint32_t threads, uint32_t depth);
+
+/**
+ * hn4_hal_workq_submit
+ * Queues fn(arg). Blocks while the queue is full (back-pressure). If
+ * 'done' is given it is set to 1 once fn has returned.
+ */
+void hn4_hal_workq_submit(hn4_hal_workq_t* q, hn4_hal_work_fn_t fn, void* arg,
+                          _Atomic uint32_t* done);
+
+/* Sleeps until *done is set, or (done == NULL) until the queue is idle */
+void hn4_hal_workq_wait(hn4_hal_workq_t* q, _Atomic uint32_t* done);
+
+/* Drains the queue, joins the workers and frees 'q' */
+void hn4_hal_workq_destroy(hn4_hal_workq_t* q);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,591 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Trained Lexicon (Per-Volume TCC Dictionary)
+ * SOURCE:      hn4_lexicon.c
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * ENGINEERING NOTES:
+ * 1. TRAINING: Strings of 4..32 bytes are counted in one hash table per
+ *    call. Candidates are ranked by bytes saved, (len - 3) * hits, and
+ *    taken greedily. A candidate inside an entry already taken, or sharing
+ *    half its length with one (shifted copies of the same text), is
+ *    skipped.
+ * 2. FIT: A generation is one block. The entry count is capped by what
+ *    the block holds, so small-block volumes get fewer entries.
+ * 3. LIFETIME: Loaded generations stay until unmount. Pointers handed to
+ *    the read and write paths never dangle.
+ * 4. AUDIT: LEXICON blocks are referenced from the Superblock only; the
+ *    Scavenger leak audit never reclaims them.
+ */
+
+#include "hn4_lexicon.h"
+#include "hn4_allocator.h"
+#include "hn4_hal.h"
+#include "hn4_crc.h"
+#include "hn4_endians.h"
+#include "hn4_addr.h"
+#include "hn4_constants.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* hn4_read.c (no public prototype: older callers predate 'session_perms') */
+_Check_return_
+hn4_result_t hn4_read_block_atomic(
+    hn4_volume_t* vol,
+    hn4_anchor_t* anchor_ptr,
+    uint64_t      block_idx,
+    void*         out_buffer,
+    uint32_t      buffer_len,
+    uint32_t      session_perms
+);
+
+#define HN4_LEX_HASH_BITS   18
+#define HN4_LEX_PROBES      16
+
+_Static_assert(sizeof(hn4_lexicon_payload_t) == 32, "Lexicon Payload ABI Violation");
+
+/* Candidate lengths, longest first */
+static const uint8_t _lex_lengths[] = { 32, 24, 16, 12, 8, 6, 4 };
+
+typedef struct {
+    uint32_t    pos;        /* First occurrence in the sample */
+    uint32_t    last;       /* Last counted occurrence */
+    uint32_t    hits;
+    uint32_t    len;        /* 0 = empty slot */
+} _lex_cand_t;
+
+struct hn4_lexicon_set {
+    hn4_spinlock_t      lock;
+    _Atomic uint32_t    training;
+    uint32_t            active;                         /* Newest generation at mount */
+    hn4_tcc_lexicon_t*  gens[HN4_LEX_MAX_GENERATIONS];  /* [generation - 1] */
+};
+
+/* =========================================================================
+ * INTERNAL HELPERS
+ * ========================================================================= */
+
+static struct hn4_lexicon_set* _lex_set(hn4_volume_t* vol, bool create)
+{
+    struct hn4_lexicon_set* s = atomic_load_explicit(&vol->lexicon_set, memory_order_acquire);
+    if (s || !create) return s;
+
+    s = hn4_hal_mem_alloc(sizeof(struct hn4_lexicon_set));
+    if (!s) return NULL;
+
+    memset(s, 0, sizeof(*s));
+    hn4_hal_spinlock_init(&s->lock);
+
+    struct hn4_lexicon_set* expected = NULL;
+    if (!atomic_compare_exchange_strong(&vol->lexicon_set, &expected, s)) {
+        hn4_hal_mem_free(s);
+        s = expected;
+    }
+    return s;
+}
+
+HN4_INLINE uint32_t _lex_spb(hn4_volume_t* vol)
+{
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    uint32_t ss = (caps && caps->logical_block_size) ? caps->logical_block_size : 512;
+    uint32_t spb = vol->vol_block_size / ss;
+    return spb ? spb : 1;
+}
+
+/* Lengths plus data bytes one LEXICON block can carry */
+HN4_INLINE uint32_t _lex_body_cap(hn4_volume_t* vol)
+{
+    return vol->vol_block_size - (uint32_t)sizeof(hn4_extension_header_t)
+                               - (uint32_t)sizeof(hn4_lexicon_payload_t);
+}
+
+/* Extension pointers are sector addresses, block aligned (see namespace). */
+static bool _lex_ptr_ok(hn4_volume_t* vol, uint64_t lba, uint32_t spb)
+{
+    if (lba == 0 || lba == UINT64_MAX || (lba % spb) != 0) return false;
+    return (lba / spb) < (vol->vol_capacity_bytes / vol->vol_block_size);
+}
+
+static uint32_t _lex_crc(const hn4_lexicon_payload_t* p, uint32_t body_len)
+{
+    hn4_lexicon_payload_t tmp = *p;
+    tmp.crc = 0;
+    uint32_t crc = hn4_crc32(HN4_CRC_SEED_HEADER, &tmp, sizeof(tmp));
+    return hn4_crc32(crc, p->body, body_len);
+}
+
+HN4_INLINE uint32_t _lex_hash(const uint8_t* p, uint32_t len)
+{
+    uint64_t h = (uint64_t)len * 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < len; i++) h = (h ^ p[i]) * 0x100000001B3ULL;
+    h ^= h >> 29;
+    return (uint32_t)(h >> (64 - HN4_LEX_HASH_BITS));
+}
+
+/* Counts every candidate string; overlapping repeats count once */
+static void _lex_count(const uint8_t* s, uint32_t n, _lex_cand_t* tab)
+{
+    const uint32_t mask  = (1U << HN4_LEX_HASH_BITS) - 1;
+    const uint32_t limit = (mask + 1) / 4 * 3;
+    uint32_t used = 0;
+
+    for (size_t l = 0; l < sizeof(_lex_lengths); l++) {
+        uint32_t len = _lex_lengths[l];
+
+        for (uint32_t p = 0; p + len <= n; p++) {
+            uint32_t h = _lex_hash(s + p, len);
+
+            for (uint32_t k = 0; k < HN4_LEX_PROBES; k++) {
+                _lex_cand_t* c = &tab[(h + k) & mask];
+
+                if (c->len == 0) {
+                    if (used < limit) {
+                        c->pos = c->last = p;
+                        c->hits = 1;
+                        c->len  = len;
+                        used++;
+                    }
+                    break;
+                }
+                if (c->len == len && memcmp(s + c->pos, s + p, len) == 0) {
+                    if (p >= c->last + len) {
+                        c->hits++;
+                        c->last = p;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static int _lex_score_cmp(const void* a, const void* b)
+{
+    const _lex_cand_t* x = (const _lex_cand_t*)a;
+    const _lex_cand_t* y = (const _lex_cand_t*)b;
+    uint64_t sx = (uint64_t)(x->len - 3) * x->hits;
+    uint64_t sy = (uint64_t)(y->len - 3) * y->hits;
+    if (sx != sy) return (sx > sy) ? -1 : 1;
+    return (x->pos < y->pos) ? -1 : (x->pos > y->pos);
+}
+
+/* Already covered: inside a taken entry, or overlapping half of one */
+static bool _lex_redundant(const uint8_t* str, uint32_t len, const uint8_t* const* sel,
+                           const uint32_t* sel_len, uint32_t n_sel)
+{
+    for (uint32_t i = 0; i < n_sel; i++) {
+        const uint8_t* e  = sel[i];
+        uint32_t       el = sel_len[i];
+
+        for (uint32_t o = 0; el >= len && o <= el - len; o++) {
+            if (memcmp(e + o, str, len) == 0) return true;
+        }
+
+        uint32_t max = (len < el) ? len : el;
+        for (uint32_t k = (len + 1) / 2; k < max; k++) {
+            if (memcmp(e + el - k, str, k) == 0) return true;
+            if (memcmp(str + len - k, e, k) == 0) return true;
+        }
+    }
+    return false;
+}
+
+/* A string of one repeated byte is an ISOTOPE, not a word */
+static bool _lex_is_run(const uint8_t* str, uint32_t len)
+{
+    for (uint32_t i = 1; i < len; i++) if (str[i] != str[0]) return false;
+    return true;
+}
+
+typedef struct {
+    const uint8_t*  str;
+    uint32_t        len;
+} _lex_pick_t;
+
+static int _lex_order_cmp(const void* a, const void* b)
+{
+    const _lex_pick_t* x = (const _lex_pick_t*)a;
+    const _lex_pick_t* y = (const _lex_pick_t*)b;
+    if (x->str[0] != y->str[0]) return (int)x->str[0] - (int)y->str[0];
+    if (x->len != y->len) return (x->len > y->len) ? -1 : 1;
+    return memcmp(x->str, y->str, x->len);
+}
+
+/*
+ * Fills 'lex' (count, off, len, data) from the sample. 'body_cap' bounds
+ * the on-disk size: one length byte plus the string per entry.
+ */
+static hn4_result_t _lex_build(const uint8_t* s, uint32_t n, uint32_t body_cap, hn4_tcc_lexicon_t* lex)
+{
+    _lex_cand_t* tab = hn4_hal_mem_alloc(sizeof(_lex_cand_t) << HN4_LEX_HASH_BITS);
+    if (!tab) return HN4_ERR_NOMEM;
+    memset(tab, 0, sizeof(_lex_cand_t) << HN4_LEX_HASH_BITS);
+
+    _lex_count(s, n, tab);
+
+    /* Compact the frequent ones to the front of the table */
+    uint32_t cands = 0;
+    for (uint32_t i = 0; i < (1U << HN4_LEX_HASH_BITS); i++) {
+        if (tab[i].len && tab[i].hits >= HN4_LEX_MIN_HITS) tab[cands++] = tab[i];
+    }
+    qsort(tab, cands, sizeof(_lex_cand_t), _lex_score_cmp);
+
+    const uint8_t* sel[HN4_TCC_LEX_MAX];
+    uint32_t       sel_len[HN4_TCC_LEX_MAX];
+    uint32_t       n_sel = 0, budget = body_cap, data = 0;
+
+    for (uint32_t i = 0; i < cands && n_sel < HN4_TCC_LEX_MAX; i++) {
+        const uint8_t* str = s + tab[i].pos;
+        uint32_t       len = tab[i].len;
+
+        if (1 + len > budget || data + len > sizeof(lex->data)) continue;
+        if (_lex_is_run(str, len)) continue;
+        if (_lex_redundant(str, len, sel, sel_len, n_sel)) continue;
+
+        sel[n_sel]     = str;
+        sel_len[n_sel] = len;
+        n_sel++;
+        budget -= 1 + len;
+        data   += len;
+    }
+    hn4_hal_mem_free(tab);
+
+    if (n_sel == 0) return HN4_ERR_COMPRESSION_INEFFICIENT;
+
+    /* Encoder buckets by first byte and takes the first (longest) match */
+    _lex_pick_t pick[HN4_TCC_LEX_MAX];
+    for (uint32_t i = 0; i < n_sel; i++) {
+        pick[i].str = sel[i];
+        pick[i].len = sel_len[i];
+    }
+    qsort(pick, n_sel, sizeof(_lex_pick_t), _lex_order_cmp);
+
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < n_sel; i++) {
+        lex->off[i] = (uint16_t)off;
+        lex->len[i] = (uint8_t)pick[i].len;
+        memcpy(lex->data + off, pick[i].str, pick[i].len);
+        off += pick[i].len;
+    }
+    lex->count = n_sel;
+    return HN4_OK;
+}
+
+/* Writes one generation, linked to 'prev'. Durable on return. */
+static hn4_result_t _lex_write(hn4_volume_t* vol, const hn4_tcc_lexicon_t* lex, uint64_t prev, uint64_t* out_lba)
+{
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t spb = _lex_spb(vol);
+
+    void* buf = hn4_hal_mem_alloc(bs);
+    if (!buf) return HN4_ERR_NOMEM;
+    memset(buf, 0, bs);
+
+    hn4_extension_header_t* ext = (hn4_extension_header_t*)buf;
+    hn4_lexicon_payload_t*  p   = (hn4_lexicon_payload_t*)ext->payload;
+
+    ext->magic        = hn4_cpu_to_le32(HN4_MAGIC_META);
+    ext->type         = hn4_cpu_to_le32(HN4_EXT_TYPE_LEXICON);
+    ext->next_ext_lba = hn4_cpu_to_le64(prev);
+
+    uint32_t data_len = 0;
+    for (uint32_t i = 0; i < lex->count; i++) {
+        p->body[i] = lex->len[i];
+        memcpy(p->body + lex->count + data_len, lex->data + lex->off[i], lex->len[i]);
+        data_len += lex->len[i];
+    }
+
+    p->magic       = hn4_cpu_to_le32(HN4_LEX_MAGIC);
+    p->volume_uuid = hn4_cpu_to_le128(vol->sb.info.volume_uuid);
+    p->generation  = hn4_cpu_to_le32(lex->generation);
+    p->count       = hn4_cpu_to_le16((uint16_t)lex->count);
+    p->data_len    = hn4_cpu_to_le16((uint16_t)data_len);
+    p->crc         = hn4_cpu_to_le32(_lex_crc(p, lex->count + data_len));
+
+    hn4_addr_t   phys;
+    hn4_result_t res = hn4_alloc_horizon(vol, &phys);
+
+    if (res == HN4_OK) {
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, phys, buf, spb) != HN4_OK ||
+            hn4_hal_barrier(vol->target_device) != HN4_OK) {
+            hn4_free_block(vol, phys);
+            res = HN4_ERR_HW_IO;
+        } else {
+            *out_lba = hn4_addr_to_u64(phys);
+        }
+    }
+
+    hn4_hal_mem_free(buf);
+    return res;
+}
+
+/* Decodes one LEXICON block of generation 'gen'. NULL if it is not one. */
+static hn4_tcc_lexicon_t* _lex_parse(hn4_volume_t* vol, const void* buf, uint32_t gen, uint64_t* next)
+{
+    const hn4_extension_header_t* ext = (const hn4_extension_header_t*)buf;
+    const hn4_lexicon_payload_t*  p   = (const hn4_lexicon_payload_t*)ext->payload;
+
+    if (hn4_le32_to_cpu(ext->magic) != HN4_MAGIC_META) return NULL;
+    if (hn4_le32_to_cpu(ext->type) != HN4_EXT_TYPE_LEXICON) return NULL;
+    if (hn4_le32_to_cpu(p->magic) != HN4_LEX_MAGIC) return NULL;
+    if (hn4_le32_to_cpu(p->generation) != gen) return NULL;
+
+    hn4_u128_t uuid = hn4_le128_to_cpu(p->volume_uuid);
+    if (uuid.lo != vol->sb.info.volume_uuid.lo || uuid.hi != vol->sb.info.volume_uuid.hi) return NULL;
+
+    uint32_t count    = hn4_le16_to_cpu(p->count);
+    uint32_t data_len = hn4_le16_to_cpu(p->data_len);
+
+    if (count == 0 || count > HN4_TCC_LEX_MAX) return NULL;
+    if (count + data_len > _lex_body_cap(vol)) return NULL;
+    if (hn4_le32_to_cpu(p->crc) != _lex_crc(p, count + data_len)) return NULL;
+
+    hn4_tcc_lexicon_t* lex = hn4_hal_mem_alloc(sizeof(hn4_tcc_lexicon_t));
+    if (!lex) return NULL;
+    memset(lex, 0, sizeof(*lex));
+
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t len = p->body[i];
+        if (off + len > data_len || off + len > sizeof(lex->data)) {
+            hn4_hal_mem_free(lex);
+            return NULL;
+        }
+        lex->off[i] = (uint16_t)off;
+        lex->len[i] = (uint8_t)len;
+        memcpy(lex->data + off, p->body + count + off, len);
+        off += len;
+    }
+
+    lex->generation = gen;
+    lex->count      = count;
+
+    if (off != data_len || !hn4_tcc_lexicon_seal(lex)) {
+        hn4_hal_mem_free(lex);
+        return NULL;
+    }
+
+    *next = hn4_le64_to_cpu(ext->next_ext_lba);
+    return lex;
+}
+
+/* =========================================================================
+ * PUBLIC API
+ * ========================================================================= */
+
+_Check_return_
+hn4_result_t hn4_lexicon_train(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  const void*   sample,
+    HN4_IN  size_t        len,
+    HN4_OUT uint32_t*     out_gen
+)
+{
+    if (HN4_UNLIKELY(!vol || !sample || len == 0)) return HN4_ERR_INVALID_ARGUMENT;
+    if (vol->read_only) return HN4_ERR_ACCESS_DENIED;
+
+    struct hn4_lexicon_set* set = _lex_set(vol, true);
+    if (!set) return HN4_ERR_NOMEM;
+
+    if (atomic_exchange(&set->training, 1)) return HN4_ERR_BUSY;
+
+    hn4_result_t       res = HN4_OK;
+    hn4_tcc_lexicon_t* lex = NULL;
+    uint32_t           gen = vol->sb.info.lexicon_gen + 1;
+    uint64_t           lba = 0;
+
+    if (gen > HN4_LEX_MAX_GENERATIONS) {
+        res = HN4_ERR_ENOSPC;
+        goto out;
+    }
+
+    lex = hn4_hal_mem_alloc(sizeof(hn4_tcc_lexicon_t));
+    if (!lex) {
+        res = HN4_ERR_NOMEM;
+        goto out;
+    }
+    memset(lex, 0, sizeof(*lex));
+
+    uint32_t n = (len > HN4_LEX_SAMPLE_MAX) ? HN4_LEX_SAMPLE_MAX : (uint32_t)len;
+    res = _lex_build((const uint8_t*)sample, n, _lex_body_cap(vol), lex);
+    if (res != HN4_OK) goto out;
+
+    lex->generation = gen;
+    if (!hn4_tcc_lexicon_seal(lex)) {
+        res = HN4_ERR_INTERNAL_FAULT;
+        goto out;
+    }
+
+    res = _lex_write(vol, lex, vol->sb.info.lexicon_lba, &lba);
+    if (res != HN4_OK) goto out;
+
+    /* Decodable at once; compressed with from the next mount */
+    hn4_hal_spinlock_acquire(&set->lock);
+    set->gens[gen - 1]            = lex;
+    vol->sb.info.lexicon_lba      = lba;
+    vol->sb.info.lexicon_gen      = gen;
+    vol->sb.info.incompat_flags  |= HN4_INCOMPAT_TCC_LEXICON;
+    hn4_hal_spinlock_release(&set->lock);
+
+    lex = NULL;
+    if (out_gen) *out_gen = gen;
+
+out:
+    hn4_hal_mem_free(lex);
+    atomic_store(&set->training, 0);
+    return res;
+}
+
+_Check_return_
+hn4_result_t hn4_lexicon_train_volume(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_OUT uint32_t*     out_gen
+)
+{
+    if (HN4_UNLIKELY(!vol)) return HN4_ERR_INVALID_ARGUMENT;
+    if (!vol->nano_cortex) return HN4_ERR_UNINITIALIZED;
+
+    uint32_t bs       = vol->vol_block_size;
+    uint32_t payload  = HN4_BLOCK_PayloadSize(bs);
+    uint32_t per_file = HN4_LEX_SAMPLE_MAX / 8;   /* No single file dominates */
+
+    uint8_t* sample = hn4_hal_mem_alloc(HN4_LEX_SAMPLE_MAX);
+    uint8_t* blk    = hn4_hal_mem_alloc(payload);
+    if (!sample || !blk) {
+        hn4_hal_mem_free(sample);
+        hn4_hal_mem_free(blk);
+        return HN4_ERR_NOMEM;
+    }
+
+    hn4_anchor_t* anchors = (hn4_anchor_t*)vol->nano_cortex;
+    size_t        count   = vol->cortex_size / sizeof(hn4_anchor_t);
+    uint32_t      used    = 0;
+
+    for (size_t i = 0; i < count && used < HN4_LEX_SAMPLE_MAX; i++) {
+        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+        hn4_anchor_t a = anchors[i];
+        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+
+        uint64_t dclass = hn4_le64_to_cpu(a.data_class);
+        uint64_t mass   = hn4_le64_to_cpu(a.mass);
+
+        if (!(dclass & HN4_FLAG_VALID) || (dclass & HN4_FLAG_TOMBSTONE)) continue;
+        if ((dclass & HN4_HINT_ENCRYPTED) || mass == 0) continue;
+
+        uint32_t took = 0;
+        for (uint64_t b = 0; b * payload < mass && took < per_file && used < HN4_LEX_SAMPLE_MAX; b++) {
+            if (hn4_read_block_atomic(vol, &a, b, blk, payload, HN4_PERM_READ) != HN4_OK) break;
+
+            uint64_t left = mass - b * payload;
+            uint32_t n    = (left < payload) ? (uint32_t)left : payload;
+            if (n > per_file - took)               n = per_file - took;
+            if (n > HN4_LEX_SAMPLE_MAX - used)     n = HN4_LEX_SAMPLE_MAX - used;
+
+            memcpy(sample + used, blk, n);
+            used += n;
+            took += n;
+        }
+    }
+
+    hn4_result_t res = used ? hn4_lexicon_train(vol, sample, used, out_gen) : HN4_ERR_NOT_FOUND;
+
+    hn4_hal_mem_free(blk);
+    hn4_hal_mem_free(sample);
+    return res;
+}
+
+_Check_return_
+hn4_result_t hn4_lexicon_load(HN4_IN hn4_volume_t* vol)
+{
+    if (HN4_UNLIKELY(!vol)) return HN4_ERR_INVALID_ARGUMENT;
+
+    uint32_t gen = vol->sb.info.lexicon_gen;
+    uint64_t lba = vol->sb.info.lexicon_lba;
+
+    if (gen == 0) return HN4_OK;
+    if (gen > HN4_LEX_MAX_GENERATIONS) return HN4_ERR_DATA_ROT;
+
+    struct hn4_lexicon_set* set = _lex_set(vol, true);
+    if (!set) return HN4_ERR_NOMEM;
+
+    uint32_t spb = _lex_spb(vol);
+    void*    buf = hn4_hal_mem_alloc(vol->vol_block_size);
+    if (!buf) return HN4_ERR_NOMEM;
+
+    hn4_result_t res = HN4_OK;
+
+    /* Newest first; each link must be exactly one generation older */
+    for (uint32_t g = gen; g >= 1; g--) {
+        if (!_lex_ptr_ok(vol, lba, spb)) {
+            res = HN4_ERR_DATA_ROT;
+            break;
+        }
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_addr_from_u64(lba), buf, spb) != HN4_OK) {
+            res = HN4_ERR_HW_IO;
+            break;
+        }
+
+        uint64_t next = 0;
+        hn4_tcc_lexicon_t* lex = _lex_parse(vol, buf, g, &next);
+        if (!lex) {
+            res = HN4_ERR_DATA_ROT;
+            break;
+        }
+
+        hn4_hal_spinlock_acquire(&set->lock);
+        if (!set->gens[g - 1]) {
+            set->gens[g - 1] = lex;
+            lex = NULL;
+        }
+        hn4_hal_spinlock_release(&set->lock);
+        hn4_hal_mem_free(lex);
+
+        lba = next;
+    }
+
+    hn4_hal_spinlock_acquire(&set->lock);
+    if (set->gens[gen - 1]) set->active = gen;
+    hn4_hal_spinlock_release(&set->lock);
+
+    hn4_hal_mem_free(buf);
+    return res;
+}
+
+const hn4_tcc_lexicon_t* hn4_lexicon_active(HN4_IN hn4_volume_t* vol)
+{
+    if (!vol) return NULL;
+
+    struct hn4_lexicon_set* set = _lex_set(vol, false);
+    if (!set) return NULL;
+
+    hn4_hal_spinlock_acquire(&set->lock);
+    const hn4_tcc_lexicon_t* lex = set->active ? set->gens[set->active - 1] : NULL;
+    hn4_hal_spinlock_release(&set->lock);
+    return lex;
+}
+
+const hn4_tcc_lexicon_t* hn4_lexicon_get(HN4_IN hn4_volume_t* vol, HN4_IN uint32_t gen)
+{
+    if (!vol || gen == 0 || gen > HN4_LEX_MAX_GENERATIONS) return NULL;
+
+    struct hn4_lexicon_set* set = _lex_set(vol, false);
+    if (!set) return NULL;
+
+    hn4_hal_spinlock_acquire(&set->lock);
+    const hn4_tcc_lexicon_t* lex = set->gens[gen - 1];
+    hn4_hal_spinlock_release(&set->lock);
+    return lex;
+}
+
+void hn4_lexicon_release(HN4_IN hn4_volume_t* vol)
+{
+    if (!vol) return;
+
+    struct hn4_lexicon_set* set = atomic_exchange(&vol->lexicon_set, NULL);
+    if (!set) return;
+
+    for (uint32_t i = 0; i < HN4_LEX_MAX_GENERATIONS; i++) hn4_hal_mem_free(set->gens[i]);
+    hn4_hal_mem_free(set);
+}
@@ -0,0 +1,110 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Trained Lexicon (Per-Volume TCC Dictionary)
+ * HEADER:      hn4_lexicon.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * The static TCC lexicon knows generic JSON and log boilerplate. This
+ * module learns the volume's own vocabulary (protobuf field names,
+ * tokenizer pieces, log templates) from a sample and stores it as
+ * LEXICON extension blocks (Horizon), one per generation, chained newest
+ * first from the Superblock (lexicon_lba / lexicon_gen).
+ *
+ * Generations are never rewritten or dropped. Every block that uses
+ * trained entries names its generation, and all generations are loaded at
+ * mount. A new generation is used for compression from the next mount
+ * on, once the Superblock that points at it is on media: a crash before
+ * that loses the lexicon, never data.
+ */
+
+#ifndef HN4_LEXICON_H
+#define HN4_LEXICON_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+#include "hn4_compress.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HN4_LEX_MAGIC           0x4E58454C  /* "LEXN" */
+#define HN4_LEX_MAX_GENERATIONS 64
+#define HN4_LEX_SAMPLE_MAX      (64U * 1024) /* Bytes of sample used for training */
+#define HN4_LEX_MIN_HITS        4           /* Occurrences before a string is a candidate */
+
+/*
+ * LEXICON Extension Payload (inside hn4_extension_header_t).
+ * next_ext_lba links to the previous generation (0 = none).
+ */
+typedef struct HN4_PACKED {
+    uint32_t    magic;          /* HN4_LEX_MAGIC */
+    uint32_t    crc;            /* CRC32C of payload (crc = 0) + body */
+    hn4_u128_t  volume_uuid;    /* Binding to the volume */
+    uint32_t    generation;
+    uint16_t    count;
+    uint16_t    data_len;
+    uint8_t     body[];         /* 'count' entry lengths, then 'data_len' bytes */
+} hn4_lexicon_payload_t;
+
+/**
+ * hn4_lexicon_train
+ * Builds the next generation from 'sample' (only the first
+ * HN4_LEX_SAMPLE_MAX bytes are used), writes it and links it into the
+ * Superblock. HN4_ERR_COMPRESSION_INEFFICIENT when the sample repeats
+ * nothing worth an entry, HN4_ERR_ENOSPC after HN4_LEX_MAX_GENERATIONS.
+ */
+_Check_return_
+hn4_result_t hn4_lexicon_train(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  const void*   sample,
+    HN4_IN  size_t        len,
+    HN4_OUT uint32_t*     out_gen
+);
+
+/**
+ * hn4_lexicon_train_volume
+ * hn4_lexicon_train over a sample of the volume itself: the leading
+ * blocks of its files, in Cortex order. Encrypted files are skipped.
+ */
+_Check_return_
+hn4_result_t hn4_lexicon_train_volume(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_OUT uint32_t*     out_gen
+);
+
+/**
+ * hn4_lexicon_load
+ * Mount hook. Loads every generation on the Superblock's chain.
+ * HN4_ERR_DATA_ROT if the chain is damaged; blocks bound to a missing
+ * generation then fail with HN4_ERR_DECOMPRESS_FAIL.
+ */
+_Check_return_
+hn4_result_t hn4_lexicon_load(HN4_IN hn4_volume_t* vol);
+
+/**
+ * hn4_lexicon_active
+ * Generation the writer compresses with (newest as of mount), or NULL.
+ */
+const hn4_tcc_lexicon_t* hn4_lexicon_active(HN4_IN hn4_volume_t* vol);
+
+/**
+ * hn4_lexicon_get
+ * Generation 'gen' for the read path, or NULL. Valid until unmount.
+ */
+const hn4_tcc_lexicon_t* hn4_lexicon_get(HN4_IN hn4_volume_t* vol, HN4_IN uint32_t gen);
+
+/**
+ * hn4_lexicon_release
+ * Drops every loaded generation. Called from unmount.
+ */
+void hn4_lexicon_release(HN4_IN hn4_volume_t* vol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_LEXICON_H */
@@ -634,8 +634,12 @@ hn4_result_t _hn4_spatial_router(
     uint32_t count = 0;
     uint32_t mode = 0;
 
-    /* Snapshot current topology under lock to prevent race with hot-plug/removal */
-    hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+    /*
+     * Snapshot current topology under the shared lock to prevent races with
+     * hot-plug/removal. Concurrent routers only read the table, so they do
+     * not serialize each other; pins are atomic for that reason.
+     */
+    hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
 count = vol->array.count;
 mode  = vol->array.mode;
 
@@ -645,7 +649,7 @@ if (count > 0) {
     if (count > HN4_SMALL_ARRAY_LIMIT) {
         snapshot = hn4_hal_mem_alloc(count * sizeof(hn4_drive_t));
         if (!snapshot) {
-            hn4_hal_spinlock_release(&vol->locking.l2_lock);
+            hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
             return HN4_ERR_NOMEM;
         }
         using_heap = true;
@@ -654,22 +658,25 @@ if (count > 0) {
     
     /* Pin devices by incrementing usage counters on the SOURCE array */
     for (uint32_t i = 0; i < count; i++) {
-        vol->array.devices[i].usage_counter++;
+        atomic_fetch_add_explicit((_Atomic uint64_t*)&vol->array.devices[i].usage_counter,
+                                  1, memory_order_relaxed);
     }
 }
-hn4_hal_spinlock_release(&vol->locking.l2_lock);
+hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
 
 /* Cleanup macro must now decrement refcounts */
 #define CLEANUP_AND_RETURN(res) do { \
     if (count > 0) { \
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock); \
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock); \
         /* Safety: Check bounds against live array to prevent OOB if array shrank */ \
         uint32_t safe_limit = (count < vol->array.count) ? count : vol->array.count; \
         for (uint32_t i = 0; i < safe_limit; i++) { \
-            if (vol->array.devices[i].usage_counter > 0) \
-                vol->array.devices[i].usage_counter--; \
+            _Atomic uint64_t* uc = (_Atomic uint64_t*)&vol->array.devices[i].usage_counter; \
+            uint64_t cur = atomic_load_explicit(uc, memory_order_relaxed); \
+            while (cur > 0 && !atomic_compare_exchange_weak_explicit( \
+                       uc, &cur, cur - 1, memory_order_relaxed, memory_order_relaxed)) {} \
         } \
-        hn4_hal_spinlock_release(&vol->locking.l2_lock); \
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock); \
     } \
     if (using_heap) hn4_hal_mem_free(snapshot); \
     return (res); \
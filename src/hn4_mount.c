@@ -14,12 +14,14 @@
 
 #include "hn4.h"
 #include "hn4_hal.h"
+#include "hn4_read.h"
 #include "hn4_endians.h"
 #include "hn4_crc.h"
 #include "hn4_ecc.h"
 #include "hn4_errors.h"
 #include "hn4_epoch.h"
 #include "hn4_chronicle.h" 
+#include "hn4_lexicon.h"
 #include "hn4_annotations.h" 
 #include "hn4_constants.h"
 #include <string.h>
@@ -692,6 +694,9 @@ static hn4_result_t _mark_volume_dirty_and_sync(HN4_IN hn4_hal_device_t* dev, HN
 
     if (dirty_sb.info.state_flags & HN4_VOL_CLEAN) dirty_sb.info.copy_generation++;
 
+    /* After a crash the persisted ns_generation may predate Anchor changes: void the tensor manifests */
+    if (!(dirty_sb.info.state_flags & HN4_VOL_CLEAN)) dirty_sb.info.ns_generation++;
+
     dirty_sb.info.state_flags |= HN4_VOL_DIRTY;
     dirty_sb.info.state_flags &= ~HN4_VOL_CLEAN;
     dirty_sb.info.last_mount_time = hn4_hal_get_time_ns();
@@ -920,7 +925,8 @@ static hn4_result_t _load_bitmap_resources(HN4_IN hn4_hal_device_t* dev, HN4_INO
         return HN4_ERR_NOMEM;
     }
 
-    vol->void_bitmap = hn4_hal_mem_alloc(alloc_bytes);
+    /* Hot metadata (bitmaps, Cortex) lives on the mounting thread's NUMA node */
+    vol->void_bitmap = hn4_hal_mem_alloc_node(alloc_bytes, HN4_NUMA_NODE_LOCAL);
     if (!vol->void_bitmap) return HN4_ERR_NOMEM;
     vol->bitmap_size = armor_words * sizeof(hn4_armored_word_t);
 
@@ -1234,7 +1240,7 @@ static hn4_result_t _load_qmask_resources(HN4_IN hn4_hal_device_t* dev, HN4_INOU
     
     size_t alloc_sz = HN4_ALIGN_UP(qmask_bytes_needed, 8);
     
-    vol->quality_mask = hn4_hal_mem_alloc(alloc_sz);
+    vol->quality_mask = hn4_hal_mem_alloc_node(alloc_sz, HN4_NUMA_NODE_LOCAL);
     if (!vol->quality_mask) return HN4_ERR_NOMEM;
     vol->qmask_size = alloc_sz;
     
@@ -1388,6 +1394,22 @@ static hn4_result_t _load_topology_resources(
     for (uint32_t i = 0; i < count; i++) {
         uint64_t start = entries[i].lba_start;
         uint64_t len   = entries[i].lba_len;
+
+        /*
+         * 0. NUMA slices cover the whole device; trim the head slice to the
+         * data region instead of rejecting the map. Accelerator maps are
+         * still held to the strict bounds check below.
+         */
+        if ((entries[i].gpu_id & HN4_TOPO_NUMA_TAG) && start < usable_start_sector) {
+            uint64_t clip = ((usable_start_sector + spb - 1) / spb) * spb;
+            uint64_t end  = start + len;
+            if (clip >= end) {
+                HN4_LOG_WARN("AI Topo: Region %u lies inside Metadata", i);
+                goto Fail;
+            }
+            entries[i].lba_start = start = clip;
+            entries[i].lba_len   = len   = end - clip;
+        }
         
         /* 1. Alignment & Size */
         if ((start % spb != 0) || (len % spb != 0) || (len < spb)) {
@@ -1652,22 +1674,32 @@ hn4_result_t _reconstruct_cortex_state(
         return HN4_OK; 
     }
 
-    vol->nano_cortex = hn4_hal_mem_alloc(cortex_bytes);
-    if (!vol->nano_cortex) return HN4_ERR_NOMEM;
-    vol->cortex_size = cortex_bytes;
+    /*
+     * 2. Borrow the runtime cache if Phase 5 already loaded it.
+     * Reconstruction only reads anchors, so the Synapse VFS copy is
+     * authoritative; a private image is loaded only when it is absent.
+     */
+    void* cortex_img = NULL;
+    bool  borrowed   = (vol->nano_cortex != NULL && vol->cortex_size == cortex_bytes);
 
-    /* 3. Linear Read (Bulk Load Cortex) */
-    hn4_result_t res = hn4_hal_sync_io(dev, HN4_IO_READ, vol->sb.info.lba_cortex_start, vol->nano_cortex, (uint32_t)cortex_sectors);
-    if (res != HN4_OK) {
-        HN4_LOG_WARN("Cortex Linear Read failed. Disabling Zero-Scan Cache.");
-        hn4_hal_mem_free(vol->nano_cortex);
-        vol->nano_cortex = NULL;
-        return HN4_OK; /* Soft fail */
+    if (borrowed) {
+        cortex_img = vol->nano_cortex;
+    } else {
+        cortex_img = hn4_hal_mem_alloc_node(cortex_bytes, HN4_NUMA_NODE_LOCAL);
+        if (!cortex_img) return HN4_ERR_NOMEM;
+
+        /* 3. Linear Read (Bulk Load Cortex) */
+        hn4_result_t res = hn4_hal_sync_io(dev, HN4_IO_READ, vol->sb.info.lba_cortex_start, cortex_img, (uint32_t)cortex_sectors);
+        if (res != HN4_OK) {
+            HN4_LOG_WARN("Cortex Linear Read failed. Disabling Zero-Scan Cache.");
+            hn4_hal_mem_free(cortex_img);
+            return HN4_OK; /* Soft fail */
+        }
     }
 
     /* 4. Sequence Verification & Trajectory Re-Projection */
     uint32_t anchor_count = (uint32_t)(cortex_bytes / sizeof(hn4_anchor_t));
-    hn4_anchor_t* anchors = (hn4_anchor_t*)vol->nano_cortex;
+    hn4_anchor_t* anchors = (hn4_anchor_t*)cortex_img;
     
     uint64_t ghost_repairs = 0;
     uint64_t phantom_filtered = 0;
@@ -1675,8 +1707,7 @@ hn4_result_t _reconstruct_cortex_state(
     /* Pre-allocate a scratch buffer for verification reads */
     void* verify_buf = hn4_hal_mem_alloc(bs);
     if (!verify_buf) { 
-        hn4_hal_mem_free(vol->nano_cortex);
-        vol->nano_cortex = NULL;
+        if (!borrowed) hn4_hal_mem_free(cortex_img);
         return HN4_ERR_NOMEM; 
     }
 
@@ -1846,8 +1877,7 @@ hn4_result_t _reconstruct_cortex_state(
     }
 
     /* Reconstruction is transient. Runtime caching is separate. */
-    hn4_hal_mem_free(vol->nano_cortex);
-    vol->nano_cortex = NULL;
+    if (!borrowed) hn4_hal_mem_free(cortex_img);
 
     return HN4_OK;
 }
@@ -1873,7 +1903,7 @@ static hn4_result_t _load_cortex_resources(HN4_IN hn4_hal_device_t* dev, HN4_INO
         return HN4_OK;
     }
 
-    vol->nano_cortex = hn4_hal_mem_alloc(size_bytes);
+    vol->nano_cortex = hn4_hal_mem_alloc_node(size_bytes, HN4_NUMA_NODE_LOCAL);
     if (!vol->nano_cortex) {
         /* CHANGED: Replaced "POSIX layer" with "Synapse VFS" */
         HN4_LOG_WARN("OOM loading Cortex. Synapse VFS disabled.");
@@ -1929,7 +1959,7 @@ static void _build_occupancy_bitmap(hn4_volume_t* vol) {
     }
 
     size_t alloc_bytes = bitmap_words * sizeof(uint64_t);
-    uint64_t* new_bitmap = hn4_hal_mem_alloc(alloc_bytes);
+    uint64_t* new_bitmap = hn4_hal_mem_alloc_node(alloc_bytes, HN4_NUMA_NODE_LOCAL);
     
     if (!new_bitmap) {
         HN4_LOG_WARN("Mount: OOM building acceleration bitmap. Disabling optimization.");
@@ -2037,7 +2067,7 @@ hn4_result_t hn4_mount(
     hn4_hal_spinlock_init(&vol->locking.l2_lock);
 
      /* Initialize Medic Priority Queue Lock */
-    hn4_hal_spinlock_init(&vol->medic_queue.lock);
+    hn4_hal_ticket_lock_init(&vol->medic_queue.lock);
 
     if (params && (params->mount_flags & HN4_MNT_READ_ONLY)) force_ro = true;
  
@@ -2325,6 +2355,8 @@ hn4_result_t hn4_mount(
         }
     }
 
+    atomic_store(&vol->ns_generation, vol->sb.info.ns_generation);
+
     /* --- PHASE 5: RESOURCE LOADING --- */
     res = _load_cortex_resources(dev, vol);
     if (HN4_UNLIKELY(res != HN4_OK)) {
@@ -2354,7 +2386,7 @@ hn4_result_t hn4_mount(
         uint64_t l2_bits = (total_blocks + 511) / 512;
         size_t l2_bytes = HN4_ALIGN_UP(l2_bits, 8) / 8;
         
-        vol->locking.l2_summary_bitmap = hn4_hal_mem_alloc(l2_bytes);
+        vol->locking.l2_summary_bitmap = hn4_hal_mem_alloc_node(l2_bytes, HN4_NUMA_NODE_LOCAL);
         if (vol->locking.l2_summary_bitmap) {
             memset(vol->locking.l2_summary_bitmap, 0, l2_bytes);
             /* Note: Bitmap is lazily populated by allocators */
@@ -2421,6 +2453,11 @@ hn4_result_t hn4_mount(
 
      vol->read_only = force_ro;
 
+    /* Blocks bound to a lost generation fail individually; the volume mounts */
+    if (hn4_lexicon_load(vol) != HN4_OK) {
+        HN4_LOG_WARN("Trained lexicon chain damaged. Bound blocks unreadable.");
+    }
+
     /* 
      * [OPTIMIZATION] Pre-calculate Allocator Saturation Limits.
      * We do the expensive division here so the Allocator is O(1).
@@ -2445,6 +2482,9 @@ hn4_result_t hn4_mount(
         vol->alloc.limit_recover = one_pct * 85;
     }
     
+    /* Read Verification Tier (after taint has been loaded) */
+    if (params) hn4_read_set_integrity(vol, params->integrity_level);
+
     /* Initialize Ref Count to 1 (The Mount itself) */
     atomic_store(&vol->health.ref_count, 1);
     
@@ -19,6 +19,7 @@
 #include "hn4_errors.h"
 #include "hn4_addr.h"
 #include "hn4_annotations.h"
+#include "hn4_namespace.h"
 #include <string.h>
 
 /*
@@ -335,7 +336,7 @@ hn4_result_t _ns_scan_cortex_slot(
             hn4_anchor_t stack_copy;
             bool match = false;
             
-            hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+            hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
             
             if (ram_base[curr_slot].seed_id.lo == target_lo_le && 
                 ram_base[curr_slot].seed_id.hi == target_hi_le) 
@@ -347,11 +348,11 @@ hn4_result_t _ns_scan_cortex_slot(
                  ram_base[curr_slot].seed_id.hi == 0 &&
                  ram_base[curr_slot].data_class == 0))
             {
-                hn4_hal_spinlock_release(&vol->locking.l2_lock);
+                hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
                 break;
             }
             
-            hn4_hal_spinlock_release(&vol->locking.l2_lock);
+            hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
 
             if (!match) continue;
 
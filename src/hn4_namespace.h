@@ -0,0 +1,87 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Namespace Logic (Resonance Engine)
+ * HEADER:      hn4_namespace.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Cortex lookups (hn4_namespace.c): by Seed ID, by path or URI selector,
+ * and by tag resonance (Bloom mask over tag_filter). Lookups are served
+ * from the Nano-Cortex when it is resident, from media otherwise.
+ */
+
+#ifndef HN4_NAMESPACE_H
+#define HN4_NAMESPACE_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * _ns_generate_tag_mask
+ * Bloom mask of a tag string; '/'-separated components are masked
+ * individually and OR-ed. Stored in the Anchor's tag_filter.
+ */
+uint64_t _ns_generate_tag_mask(const char* tag, size_t len);
+
+/**
+ * hn4_ns_get_anchor_by_id
+ * Returns the highest-generation valid Anchor with 'seed_id'.
+ * @return HN4_OK, HN4_ERR_NOT_FOUND or HN4_ERR_TOMBSTONE.
+ */
+_Check_return_
+hn4_result_t hn4_ns_get_anchor_by_id(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  hn4_u128_t    seed_id,
+    HN4_OUT hn4_anchor_t* out_anchor
+);
+
+/**
+ * hn4_ns_get_name
+ * Copies the Anchor's name (inline or extension chain) into 'buf'.
+ */
+_Check_return_
+hn4_result_t hn4_ns_get_name(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  hn4_anchor_t* anchor,
+    HN4_OUT char*         buf,
+    HN4_IN  uint32_t      len
+);
+
+/**
+ * hn4_ns_resolve
+ * Resolves a path or URI ("id:", "tag:" selectors, "#time:" / "#gen:"
+ * slices) to its Anchor.
+ */
+_Check_return_
+hn4_result_t hn4_ns_resolve(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  const char*   path,
+    HN4_OUT hn4_anchor_t* out_anchor
+);
+
+/**
+ * hn4_ns_gather_tensor_shards
+ * Scans the Cortex for up to 'max_count' Anchors resonating with
+ * 'model_tag'. 'out_found' receives the number found.
+ * @return HN4_OK, or HN4_ERR_NOT_FOUND when none match.
+ */
+_Check_return_
+hn4_result_t hn4_ns_gather_tensor_shards(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  const char*   model_tag,
+    HN4_OUT hn4_anchor_t* out_shards,
+    HN4_IN  uint32_t      max_count,
+    HN4_OUT uint32_t*     out_found
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_NAMESPACE_H */
@@ -0,0 +1,598 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Orbit Map (Per-File Trajectory Cache)
+ * SOURCE:      hn4_orbitmap.c
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * ENGINEERING NOTES:
+ * 1. CACHE: Direct-mapped by seed_id. A colliding file evicts the resident
+ *    map, dirty or not. Losing a map is harmless (reads fan out), so no
+ *    I/O is ever issued from the write path.
+ * 2. GROWTH: One RAM map covers the file from cluster 16 up to its highest
+ *    recorded cluster and doubles on demand (HN4_OMAP_MAX_CLUSTERS cap).
+ * 3. PERSISTENCE: One ORBITMAP extension block per segment of clusters,
+ *    at most HN4_OMAP_MAX_SEGS per file. Existing blocks are rewritten in
+ *    place (the CRC rejects torn writes), new ones are appended behind the
+ *    naming extensions so the Namespace walk meets the name first. The
+ *    chain never grows past the Namespace walk depth. Clusters past the
+ *    last segment stay in RAM; reads of them fan out after a remount.
+ * 4. INLINE ANCHORS: Converted to the extended layout on their first
+ *    persist. The first 16 name bytes move behind the chain pointer, any
+ *    tail goes into a LONGNAME block at the HEAD of the new chain, and the
+ *    map segments hang behind it.
+ */
+
+#include "hn4_orbitmap.h"
+#include "hn4_allocator.h"
+#include "hn4_hal.h"
+#include "hn4_crc.h"
+#include "hn4_endians.h"
+#include "hn4_addr.h"
+#include "hn4_constants.h"
+#include <string.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define HN4_OMAP_SLOTS          256
+#define HN4_OMAP_MAX_CHAIN      16      /* == HN4_NS_MAX_EXT_DEPTH (Spec 6.2) */
+#define HN4_OMAP_INLINE_FRAG    16      /* Name bytes kept inline when extended */
+
+_Static_assert(sizeof(hn4_orbit_map_payload_t) == 40, "Orbit Map Payload ABI Violation");
+
+typedef struct {
+    hn4_spinlock_t  lock;
+    hn4_u128_t      seed_id;
+    bool            used;
+    bool            loaded;     /* On-disk map merged (or there is none) */
+    bool            dirty;
+    uint64_t        cap;        /* Clusters covered by 'bits' */
+    uint8_t*        bits;       /* 2 bits per cluster from HN4_OMAP_FIRST_CLUSTER */
+} _omap_slot_t;
+
+struct hn4_orbit_cache {
+    _omap_slot_t    slots[HN4_OMAP_SLOTS];
+};
+
+/* =========================================================================
+ * INTERNAL HELPERS
+ * ========================================================================= */
+
+static struct hn4_orbit_cache* _omap_cache(hn4_volume_t* vol, bool create)
+{
+    struct hn4_orbit_cache* c = atomic_load_explicit(&vol->orbit_cache, memory_order_acquire);
+    if (c || !create) return c;
+
+    c = hn4_hal_mem_alloc(sizeof(struct hn4_orbit_cache));
+    if (!c) return NULL;
+
+    for (int i = 0; i < HN4_OMAP_SLOTS; i++) hn4_hal_spinlock_init(&c->slots[i].lock);
+
+    struct hn4_orbit_cache* expected = NULL;
+    if (!atomic_compare_exchange_strong(&vol->orbit_cache, &expected, c)) {
+        hn4_hal_mem_free(c);
+        c = expected;
+    }
+    return c;
+}
+
+static _omap_slot_t* _omap_slot(struct hn4_orbit_cache* c, hn4_u128_t seed)
+{
+    uint64_t h = (seed.lo ^ seed.hi) * HN4_NS_HASH_CONST;
+    return &c->slots[(h >> 32) % HN4_OMAP_SLOTS];
+}
+
+HN4_INLINE bool _omap_owns(const _omap_slot_t* s, hn4_u128_t seed)
+{
+    return s->used && s->seed_id.lo == seed.lo && s->seed_id.hi == seed.hi;
+}
+
+/* Caller holds the slot lock. */
+static void _omap_reset(_omap_slot_t* s, hn4_u128_t seed)
+{
+    hn4_hal_mem_free(s->bits);
+    s->bits    = NULL;
+    s->cap     = 0;
+    s->seed_id = seed;
+    s->used    = true;
+    s->loaded  = false;
+    s->dirty   = false;
+}
+
+HN4_INLINE uint8_t _omap_get(const uint8_t* bits, uint64_t idx)
+{
+    return (uint8_t)((bits[idx >> 2] >> ((idx & 3) * 2)) & 0x3);
+}
+
+HN4_INLINE void _omap_set(uint8_t* bits, uint64_t idx, uint8_t v)
+{
+    uint32_t shift = (uint32_t)(idx & 3) * 2;
+    bits[idx >> 2] = (uint8_t)((bits[idx >> 2] & ~(0x3u << shift)) | ((uint32_t)v << shift));
+}
+
+/* Caller holds the slot lock. Grows 'bits' to cover index 'idx'. */
+static bool _omap_reserve(_omap_slot_t* s, uint64_t idx)
+{
+    if (idx < s->cap) return true;
+    if (idx >= HN4_OMAP_MAX_CLUSTERS) return false;
+
+    uint64_t new_cap = s->cap ? s->cap : 256;
+    while (new_cap <= idx) new_cap <<= 1;
+    if (new_cap > HN4_OMAP_MAX_CLUSTERS) new_cap = HN4_OMAP_MAX_CLUSTERS;
+
+    uint8_t* nb = hn4_hal_mem_alloc((size_t)(new_cap >> 2));
+    if (!nb) return false;
+
+    if (s->bits) memcpy(nb, s->bits, (size_t)(s->cap >> 2));
+    hn4_hal_mem_free(s->bits);
+
+    s->bits = nb;
+    s->cap  = new_cap;
+    return true;
+}
+
+HN4_INLINE uint32_t _omap_spb(hn4_volume_t* vol)
+{
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    uint32_t ss = (caps && caps->logical_block_size) ? caps->logical_block_size : 512;
+    uint32_t spb = vol->vol_block_size / ss;
+    return spb ? spb : 1;
+}
+
+/* Clusters carried by one ORBITMAP block */
+HN4_INLINE uint64_t _omap_per_block(hn4_volume_t* vol)
+{
+    return (uint64_t)(vol->vol_block_size - sizeof(hn4_extension_header_t)
+                      - sizeof(hn4_orbit_map_payload_t)) * 4;
+}
+
+/* Extension pointers are sector addresses, block aligned (see namespace). */
+static bool _omap_ext_ptr_ok(hn4_volume_t* vol, uint64_t lba, uint32_t spb)
+{
+    if (lba == 0 || lba == UINT64_MAX || (lba % spb) != 0) return false;
+    return (lba / spb) < (vol->vol_capacity_bytes / vol->vol_block_size);
+}
+
+HN4_INLINE uint64_t _omap_head(const hn4_anchor_t* anchor)
+{
+    uint64_t head = 0;
+    if (!(hn4_le64_to_cpu(anchor->data_class) & HN4_FLAG_EXTENDED)) return 0;
+    memcpy(&head, anchor->inline_buffer, 8);
+    return hn4_le64_to_cpu(head);
+}
+
+static uint32_t _omap_block_crc(const hn4_orbit_map_payload_t* p, uint64_t per_blk)
+{
+    hn4_orbit_map_payload_t tmp = *p;
+    tmp.crc = 0;
+    uint32_t crc = hn4_crc32(HN4_CRC_SEED_HEADER, &tmp, sizeof(tmp));
+    return hn4_crc32(crc, p->bits, (size_t)(per_blk >> 2));
+}
+
+/*
+ * Walks the Anchor's extension chain. For every valid ORBITMAP block bound
+ * to this file: records its sector address in 'seg_lba' (when given) and
+ * hands its entries to 'merge' (when given). Other extension types are
+ * skipped. Reports the last block and the link count in 'tail'/'links'
+ * (when given). Returns true only if the walk reached the end of the chain.
+ */
+static bool _omap_walk(
+    hn4_volume_t*       vol,
+    const hn4_anchor_t* anchor,
+    void*               buf,
+    uint64_t*           seg_lba,
+    uint64_t            nseg,
+    _omap_slot_t*       merge,
+    uint64_t*           tail,
+    int*                links
+)
+{
+    uint32_t   spb     = _omap_spb(vol);
+    uint64_t   per_blk = _omap_per_block(vol);
+    hn4_u128_t seed    = hn4_le128_to_cpu(anchor->seed_id);
+    uint64_t   lba     = _omap_head(anchor);
+    uint64_t   prev    = 0;
+    int        depth   = 0;
+
+    if (tail)  *tail  = 0;
+    if (links) *links = 0;
+
+    for (; depth < HN4_OMAP_MAX_CHAIN && _omap_ext_ptr_ok(vol, lba, spb); depth++) {
+        if (lba == prev) return false;
+        prev = lba;
+
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_addr_from_u64(lba), buf, spb) != HN4_OK) return false;
+
+        hn4_extension_header_t* ext = (hn4_extension_header_t*)buf;
+        if (hn4_le32_to_cpu(ext->magic) != HN4_MAGIC_META) return false;
+
+        if (tail)  *tail  = lba;
+        if (links) *links = depth + 1;
+
+        uint64_t next = hn4_le64_to_cpu(ext->next_ext_lba);
+
+        if (hn4_le32_to_cpu(ext->type) == HN4_EXT_TYPE_ORBITMAP) {
+            hn4_orbit_map_payload_t* p = (hn4_orbit_map_payload_t*)ext->payload;
+            hn4_u128_t owner = hn4_le128_to_cpu(p->seed_id);
+            uint64_t   first = hn4_le64_to_cpu(p->first_cluster);
+            uint32_t   n     = hn4_le32_to_cpu(p->clusters);
+
+            bool ok = hn4_le32_to_cpu(p->magic) == HN4_OMAP_MAGIC &&
+                      owner.lo == seed.lo && owner.hi == seed.hi &&
+                      first >= HN4_OMAP_FIRST_CLUSTER &&
+                      ((first - HN4_OMAP_FIRST_CLUSTER) % per_blk) == 0 &&
+                      n <= per_blk &&
+                      hn4_le32_to_cpu(p->crc) == _omap_block_crc(p, per_blk);
+
+            if (ok) {
+                uint64_t seg  = (first - HN4_OMAP_FIRST_CLUSTER) / per_blk;
+                uint64_t base = first - HN4_OMAP_FIRST_CLUSTER;
+
+                if (seg_lba && seg < nseg && seg_lba[seg] == 0) seg_lba[seg] = lba;
+
+                if (merge) {
+                    hn4_hal_spinlock_acquire(&merge->lock);
+                    if (_omap_owns(merge, seed)) {
+                        for (uint32_t i = 0; i < n; i++) {
+                            uint8_t v = _omap_get(p->bits, i);
+                            if (v == 0 || !_omap_reserve(merge, base + i)) continue;
+                            /* RAM entries are newer than the media */
+                            if (_omap_get(merge->bits, base + i) == 0) _omap_set(merge->bits, base + i, v);
+                        }
+                    }
+                    hn4_hal_spinlock_release(&merge->lock);
+                }
+            }
+        }
+
+        lba = next;
+    }
+
+    return lba == 0;
+}
+
+/*
+ * Moves an inline name into the extended layout (Note 4). A name longer
+ * than the inline fragment gets a LONGNAME block for its tail that points
+ * at 'map_head', so the Namespace walk meets the name before the map.
+ * Returns the new chain head in 'head_out' and the LONGNAME block, if
+ * one was written, in 'name_blk_out'. The Anchor is only touched by the
+ * caller once everything is on media.
+ */
+static hn4_result_t _omap_migrate_inline(
+    hn4_volume_t*       vol,
+    const hn4_anchor_t* anchor,
+    void*               buf,
+    uint64_t            map_head,
+    uint64_t*           head_out,
+    uint64_t*           name_blk_out
+)
+{
+    uint32_t    spb  = _omap_spb(vol);
+    const char* name = (const char*)anchor->inline_buffer;
+    size_t      len  = 0;
+
+    while (len < sizeof(anchor->inline_buffer) && name[len] != '\0') len++;
+
+    *head_out     = map_head;
+    *name_blk_out = 0;
+    if (len <= HN4_OMAP_INLINE_FRAG) return HN4_OK;
+
+    hn4_addr_t phys;
+    hn4_result_t res = hn4_alloc_horizon(vol, &phys);
+    if (res != HN4_OK) return res;
+
+    memset(buf, 0, vol->vol_block_size);
+    hn4_extension_header_t* ext = (hn4_extension_header_t*)buf;
+    ext->magic        = hn4_cpu_to_le32(HN4_MAGIC_META);
+    ext->type         = hn4_cpu_to_le32(HN4_EXT_TYPE_LONGNAME);
+    ext->next_ext_lba = hn4_cpu_to_le64(map_head);
+    memcpy(ext->payload, name + HN4_OMAP_INLINE_FRAG, len - HN4_OMAP_INLINE_FRAG);
+
+    if (hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, phys, buf, spb) != HN4_OK) {
+        hn4_free_block(vol, phys);
+        return HN4_ERR_HW_IO;
+    }
+
+    *head_out     = hn4_addr_to_u64(phys);
+    *name_blk_out = *head_out;
+    return HN4_OK;
+}
+
+/* =========================================================================
+ * PUBLIC API
+ * ========================================================================= */
+
+void hn4_orbit_map_record(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx,
+    HN4_IN uint8_t             k
+)
+{
+    uint64_t cluster = block_idx >> 4;
+    if (!vol || !anchor || cluster < HN4_OMAP_FIRST_CLUSTER) return;
+
+    struct hn4_orbit_cache* c = _omap_cache(vol, true);
+    if (!c) return;
+
+    hn4_u128_t    seed = hn4_le128_to_cpu(anchor->seed_id);
+    _omap_slot_t* s    = _omap_slot(c, seed);
+    uint64_t      idx  = cluster - HN4_OMAP_FIRST_CLUSTER;
+    uint8_t       v    = (k <= HN4_OMAP_MAX_K) ? (uint8_t)(k + 1) : 0;
+
+    hn4_hal_spinlock_acquire(&s->lock);
+
+    if (!_omap_owns(s, seed)) {
+        _omap_reset(s, seed);
+        /* A brand-new file has nothing on disk to merge */
+        s->loaded = !(hn4_le64_to_cpu(anchor->data_class) & HN4_FLAG_EXTENDED);
+    }
+
+    if (_omap_reserve(s, idx)) {
+        if (_omap_get(s->bits, idx) != v) {
+            _omap_set(s->bits, idx, v);
+            s->dirty = true;
+        }
+    } else if (v != 0 && idx < HN4_OMAP_MAX_CLUSTERS) {
+        /* OOM: the entry stays unknown, reads fan out */
+        HN4_LOG_WARN("OrbitMap: OOM growing map for cluster %llu", (unsigned long long)cluster);
+    }
+
+    hn4_hal_spinlock_release(&s->lock);
+}
+
+int hn4_orbit_map_lookup(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx
+)
+{
+    uint64_t cluster = block_idx >> 4;
+    if (!vol || !anchor || cluster < HN4_OMAP_FIRST_CLUSTER) return -1;
+
+    hn4_u128_t seed     = hn4_le128_to_cpu(anchor->seed_id);
+    bool       extended = (hn4_le64_to_cpu(anchor->data_class) & HN4_FLAG_EXTENDED) != 0;
+
+    /* Nothing recorded in RAM and nothing on disk: don't build a slot */
+    struct hn4_orbit_cache* c = _omap_cache(vol, extended);
+    if (!c) return -1;
+
+    _omap_slot_t* s   = _omap_slot(c, seed);
+    uint64_t      idx = cluster - HN4_OMAP_FIRST_CLUSTER;
+
+    hn4_hal_spinlock_acquire(&s->lock);
+
+    if (!_omap_owns(s, seed)) {
+        if (!extended) {
+            hn4_hal_spinlock_release(&s->lock);
+            return -1;
+        }
+        _omap_reset(s, seed);
+    }
+
+    if (!s->loaded) {
+        s->loaded = true;
+        hn4_hal_spinlock_release(&s->lock);
+
+        void* buf = hn4_hal_mem_alloc(vol->vol_block_size);
+        if (buf) {
+            (void)_omap_walk(vol, anchor, buf, NULL, 0, s, NULL, NULL);
+            hn4_hal_mem_free(buf);
+        }
+
+        hn4_hal_spinlock_acquire(&s->lock);
+        if (!_omap_owns(s, seed)) {
+            hn4_hal_spinlock_release(&s->lock);
+            return -1;
+        }
+    }
+
+    int k = -1;
+    if (idx < s->cap) {
+        uint8_t v = _omap_get(s->bits, idx);
+        if (v != 0) k = (int)v - 1;
+    }
+
+    hn4_hal_spinlock_release(&s->lock);
+    return k;
+}
+
+_Check_return_
+hn4_result_t hn4_orbit_map_persist(
+    HN4_IN    hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor
+)
+{
+    if (HN4_UNLIKELY(!vol || !anchor)) return HN4_ERR_INVALID_ARGUMENT;
+    if (vol->read_only) return HN4_OK;
+
+    struct hn4_orbit_cache* c = _omap_cache(vol, false);
+    if (!c) return HN4_OK;
+
+    hn4_u128_t    seed    = hn4_le128_to_cpu(anchor->seed_id);
+    _omap_slot_t* s       = _omap_slot(c, seed);
+    uint64_t      per_blk = _omap_per_block(vol);
+    uint32_t      bs      = vol->vol_block_size;
+    uint32_t      spb     = _omap_spb(vol);
+
+    /* 1. Snapshot the dirty map */
+    hn4_hal_spinlock_acquire(&s->lock);
+    if (!_omap_owns(s, seed) || !s->dirty || s->cap == 0) {
+        hn4_hal_spinlock_release(&s->lock);
+        return HN4_OK;
+    }
+
+    uint64_t cap  = s->cap;
+    uint8_t* snap = hn4_hal_mem_alloc((size_t)(cap >> 2));
+    if (!snap) {
+        hn4_hal_spinlock_release(&s->lock);
+        return HN4_ERR_NOMEM;
+    }
+    memcpy(snap, s->bits, (size_t)(cap >> 2));
+    s->dirty = false;
+    hn4_hal_spinlock_release(&s->lock);
+
+    /* Trim trailing unknown entries. Past the segment cap the map is RAM-only. */
+    uint64_t used = cap;
+    while (used > 0 && _omap_get(snap, used - 1) == 0) used--;
+    if (used > HN4_OMAP_MAX_SEGS * per_blk) used = HN4_OMAP_MAX_SEGS * per_blk;
+
+    uint64_t nseg  = (used + per_blk - 1) / per_blk;
+    uint64_t seg_lba[HN4_OMAP_MAX_SEGS] = {0};
+    uint64_t fresh[HN4_OMAP_MAX_SEGS + 1];
+    int      nfresh = 0;
+    uint64_t tail   = 0;
+    int      links  = 0;
+    void*    buf    = hn4_hal_mem_alloc(bs);
+
+    hn4_result_t res = HN4_OK;
+
+    if (!buf) {
+        res = HN4_ERR_NOMEM;
+        goto cleanup;
+    }
+
+    /* 2. Locate the blocks already on the chain, and its tail */
+    bool complete = _omap_walk(vol, anchor, buf, seg_lba, nseg, NULL, &tail, &links);
+
+    int missing = 0;
+    for (uint64_t seg = 0; seg < nseg; seg++) if (seg_lba[seg] == 0) missing++;
+
+    /*
+     * An unreadable or over-long chain gets no new blocks: appending behind
+     * a tail we could not see would grow it on every persist.
+     */
+    bool append = missing > 0 && complete && (links + missing) <= HN4_OMAP_MAX_CHAIN;
+
+    /*
+     * 3. Write segments. Existing ones in place, new ones as a private
+     *    sub-chain that is linked in last. Highest segment first so every
+     *    new block can point at its successor.
+     */
+    uint64_t chain_next = 0;
+
+    for (uint64_t i = nseg; i-- > 0; ) {
+        if (seg_lba[i] == 0 && !append) continue;
+
+        uint64_t base = i * per_blk;
+        uint64_t n    = (used - base < per_blk) ? (used - base) : per_blk;
+
+        memset(buf, 0, bs);
+        hn4_extension_header_t*  ext = (hn4_extension_header_t*)buf;
+        hn4_orbit_map_payload_t* p   = (hn4_orbit_map_payload_t*)ext->payload;
+
+        ext->magic = hn4_cpu_to_le32(HN4_MAGIC_META);
+        ext->type  = hn4_cpu_to_le32(HN4_EXT_TYPE_ORBITMAP);
+
+        p->magic         = hn4_cpu_to_le32(HN4_OMAP_MAGIC);
+        p->seed_id       = hn4_cpu_to_le128(seed);
+        p->first_cluster = hn4_cpu_to_le64(HN4_OMAP_FIRST_CLUSTER + base);
+        p->clusters      = hn4_cpu_to_le32((uint32_t)n);
+
+        for (uint64_t j = 0; j < n; j++) _omap_set(p->bits, j, _omap_get(snap, base + j));
+
+        hn4_addr_t phys;
+
+        if (seg_lba[i] != 0) {
+            /* Rewrite in place: keep the existing chain link */
+            void* cur = hn4_hal_mem_alloc(bs);
+            if (!cur) { res = HN4_ERR_NOMEM; goto cleanup; }
+
+            phys = hn4_addr_from_u64(seg_lba[i]);
+            res  = hn4_hal_sync_io(vol->target_device, HN4_IO_READ, phys, cur, spb);
+            ext->next_ext_lba = ((hn4_extension_header_t*)cur)->next_ext_lba;
+            hn4_hal_mem_free(cur);
+            if (res != HN4_OK) goto cleanup;
+        } else {
+            res = hn4_alloc_horizon(vol, &phys);
+            if (res != HN4_OK) goto cleanup;
+            fresh[nfresh++]   = hn4_addr_to_u64(phys);
+            ext->next_ext_lba = hn4_cpu_to_le64(chain_next);
+        }
+
+        p->crc = hn4_cpu_to_le32(_omap_block_crc(p, per_blk));
+
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, phys, buf, spb) != HN4_OK) {
+            res = HN4_ERR_HW_IO;
+            goto cleanup;
+        }
+
+        if (seg_lba[i] == 0) chain_next = hn4_addr_to_u64(phys);
+    }
+
+    if (nfresh == 0) goto cleanup;
+
+    /* An inline Anchor needs its name tail ahead of the map (Note 4) */
+    bool migrate = !(hn4_le64_to_cpu(anchor->data_class) & HN4_FLAG_EXTENDED);
+
+    if (migrate) {
+        uint64_t name_blk = 0;
+        res = _omap_migrate_inline(vol, anchor, buf, chain_next, &chain_next, &name_blk);
+        if (res != HN4_OK) goto cleanup;
+        if (name_blk != 0) fresh[nfresh++] = name_blk;
+    }
+
+    /* 4. New blocks must be on media before anything points at them */
+    if (hn4_hal_barrier(vol->target_device) != HN4_OK) {
+        res = HN4_ERR_HW_IO;
+        goto cleanup;
+    }
+
+    if (migrate) {
+        uint8_t frag[HN4_OMAP_INLINE_FRAG];
+        memcpy(frag, anchor->inline_buffer, sizeof(frag));
+        memset(anchor->inline_buffer, 0, sizeof(anchor->inline_buffer));
+        memcpy(anchor->inline_buffer + 8, frag, sizeof(frag));
+
+        uint64_t ptr_le = hn4_cpu_to_le64(chain_next);
+        memcpy(anchor->inline_buffer, &ptr_le, 8);
+
+        uint64_t dclass = hn4_le64_to_cpu(anchor->data_class) | HN4_FLAG_EXTENDED;
+        anchor->data_class = hn4_cpu_to_le64(dclass);
+    } else if (tail == 0) {
+        /* Extended Anchor without a chain: the caller commits the pointer */
+        uint64_t ptr_le = hn4_cpu_to_le64(chain_next);
+        memcpy(anchor->inline_buffer, &ptr_le, 8);
+    } else {
+        /* Link behind the current tail. Only its header changes. */
+        hn4_addr_t t = hn4_addr_from_u64(tail);
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, t, buf, spb) != HN4_OK) {
+            res = HN4_ERR_HW_IO;
+            goto cleanup;
+        }
+        ((hn4_extension_header_t*)buf)->next_ext_lba = hn4_cpu_to_le64(chain_next);
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, t, buf, spb) != HN4_OK) {
+            res = HN4_ERR_HW_IO;
+            goto cleanup;
+        }
+    }
+
+    nfresh = 0;     /* Linked: owned by the chain now */
+
+cleanup:
+    if (res != HN4_OK) {
+        /* Unlinked blocks go back to the Horizon */
+        for (int i = 0; i < nfresh; i++) hn4_free_block(vol, hn4_addr_from_u64(fresh[i]));
+
+        /* Retry on the next persist */
+        hn4_hal_spinlock_acquire(&s->lock);
+        if (_omap_owns(s, seed)) s->dirty = true;
+        hn4_hal_spinlock_release(&s->lock);
+    }
+
+    hn4_hal_mem_free(buf);
+    hn4_hal_mem_free(snap);
+    return res;
+}
+
+void hn4_orbit_map_release(HN4_IN hn4_volume_t* vol)
+{
+    if (!vol) return;
+
+    struct hn4_orbit_cache* c = atomic_exchange(&vol->orbit_cache, NULL);
+    if (!c) return;
+
+    for (int i = 0; i < HN4_OMAP_SLOTS; i++) hn4_hal_mem_free(c->slots[i].bits);
+    hn4_hal_mem_free(c);
+}
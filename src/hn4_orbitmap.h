@@ -0,0 +1,107 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Orbit Map (Per-File Trajectory Cache)
+ * HEADER:      hn4_orbitmap.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Extends the Anchor's 16-cluster 'orbit_hints' to the whole file. The
+ * writer records the orbit (k) each cluster landed on, the reader aims at
+ * it before falling back to the Shotgun fan-out. Maps live in a per-volume
+ * RAM cache and persist as ORBITMAP blocks (Horizon) at the tail of the
+ * file's extension chain. Inline-named Anchors are moved to the extended
+ * layout the first time their map is persisted.
+ *
+ * LIMITS: An entry is 2 bits, so only orbits 0..HN4_OMAP_MAX_K are
+ * encodable; a cluster on a higher orbit is recorded as unknown. At most
+ * HN4_OMAP_MAX_SEGS blocks are persisted per file (with 4KB blocks about
+ * 64K clusters, i.e. the first ~4GB); entries past them live in RAM only.
+ * Either way the reader falls back to the fan-out, it never misreads.
+ *
+ * The map is advisory. Every block it points at is still validated against
+ * the Anchor; a stale or lost map only costs the fan-out.
+ */
+
+#ifndef HN4_ORBITMAP_H
+#define HN4_ORBITMAP_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HN4_OMAP_MAGIC          0x50414D4F  /* "OMAP" */
+#define HN4_OMAP_FIRST_CLUSTER  16          /* orbit_hints covers 0..15 */
+#define HN4_OMAP_MAX_CLUSTERS   (1ULL << 26) /* 16MB of map per file */
+#define HN4_OMAP_MAX_K          2           /* Encodable orbits: 0..2 (LIMITS) */
+#define HN4_OMAP_MAX_SEGS       4           /* ORBITMAP blocks per file (LIMITS) */
+
+/*
+ * ORBITMAP Extension Payload (inside hn4_extension_header_t).
+ * 2 bits per cluster: 0 = unknown, otherwise k + 1.
+ */
+typedef struct HN4_PACKED {
+    uint32_t    magic;          /* HN4_OMAP_MAGIC */
+    uint32_t    crc;            /* CRC32C of payload (crc = 0) + bits */
+    hn4_u128_t  seed_id;        /* Binding to the owning Anchor */
+    uint64_t    first_cluster;  /* Cluster index of bits[0] */
+    uint32_t    clusters;       /* Entries carried by this block */
+    uint32_t    reserved;
+    uint8_t     bits[];
+} hn4_orbit_map_payload_t;
+
+/**
+ * hn4_orbit_map_record
+ * Writer hook. Notes that 'block_idx' of the file now lives on orbit 'k'.
+ * Clusters inside the orbit_hints range are ignored. k beyond
+ * HN4_OMAP_MAX_K clears the entry (reader fans out).
+ */
+void hn4_orbit_map_record(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx,
+    HN4_IN uint8_t             k
+);
+
+/**
+ * hn4_orbit_map_lookup
+ * Returns the recorded orbit for 'block_idx', or -1 when unknown. The
+ * first lookup for an extended Anchor loads its on-disk map.
+ */
+int hn4_orbit_map_lookup(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx
+);
+
+/**
+ * hn4_orbit_map_persist
+ * Writes the file's dirty map into ORBITMAP extension blocks, reusing the
+ * ones already on its chain and appending new ones behind its tail (at
+ * most HN4_OMAP_MAX_SEGS, never past the Namespace walk depth). An
+ * inline Anchor is converted to the extended layout and an extended one
+ * with an empty chain gets its chain pointer set in 'inline_buffer'; in
+ * both cases the caller commits the Anchor (hn4_write_anchor_atomic).
+ * HN4_OK when clean.
+ */
+_Check_return_
+hn4_result_t hn4_orbit_map_persist(
+    HN4_IN    hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor
+);
+
+/**
+ * hn4_orbit_map_release
+ * Drops every cached map. Called from unmount.
+ */
+void hn4_orbit_map_release(HN4_IN hn4_volume_t* vol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_ORBITMAP_H */
@@ -8,7 +8,10 @@
  */
 
 #include "hn4.h"
+#include "hn4_read.h"
+#include "hn4_write.h"
 #include "hn4_hal.h"
+#include "hn4_orbitmap.h"
 #include "hn4_errors.h"
 #include "hn4_endians.h"
 #include "hn4_addr.h"
@@ -166,6 +169,20 @@ static bool _imp_safe_add_signed(int64_t base, int64_t offset, int64_t* res) {
 #define HN4_EXT_TYPE_TETHER     0x03 
 #define HN4_FLAG_EXTENDED       (1ULL << 23)
 #define HN4_EXT_TYPE_LONGNAME   0x02
+#define HN4_WB_SLOTS            8       /* Write-back block images per handle */
+#define HN4_WB_VOL_BUDGET       (4ULL << 20) /* Write-back image bytes per volume, all handles */
+
+/*
+ * Write-Back Slot
+ * One block image absorbing small/unaligned writes. 'buf' survives the
+ * flush and is reused by the next claim.
+ */
+typedef struct {
+    uint64_t        b_idx;
+    uint32_t        len;            /* Valid payload bytes (loaded + written) */
+    bool            used;
+    void*           buf;            /* vol_block_size bytes, payload at 0 */
+} hn4_wb_slot_t;
 
 typedef struct {
     hn4_handle_t    pub; 
@@ -176,6 +193,9 @@ typedef struct {
     bool            dirty;
     bool            is_directory;
     bool            unlinked;
+    bool            ra_disabled;    /* Profile/array has no readahead */
+    hn4_readahead_t* ra;            /* Lazily created on first read */
+    hn4_wb_slot_t   wb[HN4_WB_SLOTS];
 } hn4_vfs_handle_t;
 
 typedef struct {
@@ -187,6 +207,16 @@ typedef struct {
     char            name[HN4_INLINE_NAME_MAX + 1];
 } hn4_lookup_ctx_t;
 
+/*
+ * A rename rewrites the whole 'inline_buffer', chain pointer included.
+ * The Anchor goes back to the inline layout; its old chain (long name,
+ * Orbit Map) is abandoned and the map is rebuilt from RAM.
+ */
+static void _posix_drop_extension(hn4_anchor_t* a) {
+    uint64_t dc = hn4_le64_to_cpu(a->data_class);
+    a->data_class = hn4_cpu_to_le64(dc & ~HN4_FLAG_EXTENDED);
+}
+
 static int _map_err(hn4_result_t res) {
     switch (res) {
         case HN4_OK: return 0;
@@ -306,6 +336,219 @@ static int _find_free_slot(hn4_volume_t* vol, uint64_t* slot_idx) {
     return -HN4_ENOSPC;
 }
 
+/* =========================================================================
+ * 3b. WRITE-BACK BUFFER
+ * Small and unaligned writes land in per-handle block images instead of
+ * paying a read-modify-write and a barrier per call. A slot goes to disk as
+ * a full-block replace when the writer reaches the end of its payload, when
+ * the handle runs out of slots or memory, when the volume-wide image budget
+ * (HN4_WB_VOL_BUDGET) is spent, and on fsync/close. Reads through
+ * the same handle see the buffered bytes; other handles see them once the
+ * slot is flushed.
+ * ========================================================================= */
+
+static hn4_wb_slot_t* _wb_find(hn4_vfs_handle_t* fh, uint64_t b_idx) {
+    for (int i = 0; i < HN4_WB_SLOTS; i++) {
+        if (fh->wb[i].used && fh->wb[i].b_idx == b_idx) return &fh->wb[i];
+    }
+    return NULL;
+}
+
+/* Logical size as seen by this handle: committed Mass plus buffered tail */
+static uint64_t _handle_size(const hn4_vfs_handle_t* fh, uint32_t payload) {
+    uint64_t size = hn4_le64_to_cpu(fh->pub.cached_anchor.mass);
+    for (int i = 0; i < HN4_WB_SLOTS; i++) {
+        if (!fh->wb[i].used) continue;
+        uint64_t end = fh->wb[i].b_idx * payload + fh->wb[i].len;
+        if (end > size) size = end;
+    }
+    return size;
+}
+
+/*
+ * Writes one block through the core and re-syncs the handle with the live
+ * Anchor. 'replace' when 'io' holds the whole payload image.
+ */
+static hn4_anchor_t* _handle_target(hn4_volume_t* vol, hn4_vfs_handle_t* fh) {
+    if (vol->nano_cortex && fh->anchor_idx < (vol->cortex_size / sizeof(hn4_anchor_t))) {
+        return &((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx];
+    }
+    return &fh->pub.cached_anchor;
+}
+
+/* Adopts the Anchor the core just advanced. Rejects a generation rollback */
+static int _handle_sync(hn4_volume_t* vol, hn4_vfs_handle_t* fh, const hn4_anchor_t* target_anchor) {
+    if (vol->nano_cortex) {
+        uint32_t target_gen = hn4_le32_to_cpu(target_anchor->write_gen);
+        if (target_gen < fh->cached_gen) return -HN4_EIO;
+        fh->pub.cached_anchor = *target_anchor;
+        fh->cached_gen = target_gen;
+    }
+
+    fh->dirty = true;
+    return 0;
+}
+
+static int _handle_put_block(hn4_volume_t* vol, hn4_vfs_handle_t* fh, uint64_t b_idx,
+                             const void* io, uint32_t len, bool replace)
+{
+    hn4_anchor_t* target_anchor = _handle_target(vol, fh);
+
+    hn4_result_t w = replace
+        ? hn4_write_block_replace(vol, target_anchor, b_idx, io, len, fh->session_perms)
+        : hn4_write_block_atomic(vol, target_anchor, b_idx, io, len, fh->session_perms);
+    
+    if (HN4_UNLIKELY(w < 0)) return _map_err(w);
+
+    return _handle_sync(vol, fh, target_anchor);
+}
+
+/*
+ * Writes 'n' whole blocks from the caller's buffer in one pipelined pass
+ * (compression overlaps I/O). '*done' receives the blocks committed.
+ */
+static int _handle_put_run(hn4_volume_t* vol, hn4_vfs_handle_t* fh, uint64_t b_idx,
+                           const uint8_t* src, uint64_t n, uint32_t payload, uint64_t* done)
+{
+    hn4_anchor_t* target_anchor = _handle_target(vol, fh);
+
+    hn4_result_t w = hn4_write_blocks_atomic(vol, target_anchor, b_idx, src, n * payload,
+                                             fh->session_perms, done);
+
+    int r = (*done > 0) ? _handle_sync(vol, fh, target_anchor) : 0;
+    if (HN4_UNLIKELY(w < 0)) return _map_err(w);
+    return r;
+}
+
+static int _wb_put(hn4_volume_t* vol, hn4_vfs_handle_t* fh, hn4_wb_slot_t* slot) {
+    int r = _handle_put_block(vol, fh, slot->b_idx, slot->buf, slot->len, true);
+    if (r == 0) slot->used = false;
+    return r;
+}
+
+/* Writes out every buffered block in file order. Stops at the first error */
+static int _wb_flush(hn4_volume_t* vol, hn4_vfs_handle_t* fh) {
+    while (1) {
+        hn4_wb_slot_t* next = NULL;
+        for (int i = 0; i < HN4_WB_SLOTS; i++) {
+            if (fh->wb[i].used && (!next || fh->wb[i].b_idx < next->b_idx)) next = &fh->wb[i];
+        }
+        if (!next) return 0;
+
+        int r = _wb_put(vol, fh, next);
+        if (r != 0) return r;
+    }
+}
+
+static void _wb_release(hn4_volume_t* vol, hn4_vfs_handle_t* fh) {
+    for (int i = 0; i < HN4_WB_SLOTS; i++) {
+        if (fh->wb[i].buf) atomic_fetch_sub(&vol->wb_bytes, vol->vol_block_size);
+        hn4_hal_mem_free(fh->wb[i].buf);
+        fh->wb[i].buf  = NULL;
+        fh->wb[i].used = false;
+    }
+}
+
+/* Takes one image's worth of the volume budget. False when it is spent */
+static bool _wb_charge(hn4_volume_t* vol, uint32_t bs) {
+    uint64_t held = atomic_fetch_add(&vol->wb_bytes, bs);
+    if (held + bs <= HN4_WB_VOL_BUDGET) return true;
+    atomic_fetch_sub(&vol->wb_bytes, bs);
+    return false;
+}
+
+/*
+ * Claims a slot for 'b_idx' and loads the block's committed bytes into it.
+ * A full buffer is flushed first. On memory pressure, or once the volume
+ * budget is spent, the buffer is flushed and released, and *out is NULL:
+ * the caller writes through.
+ */
+static int _wb_claim(hn4_volume_t* vol, hn4_vfs_handle_t* fh, uint64_t b_idx,
+                     uint32_t bs, uint32_t payload, hn4_wb_slot_t** out)
+{
+    *out = NULL;
+
+    hn4_wb_slot_t* slot = NULL;
+    for (int i = 0; i < HN4_WB_SLOTS && !slot; i++) {
+        if (!fh->wb[i].used) slot = &fh->wb[i];
+    }
+
+    if (!slot) {
+        int r = _wb_flush(vol, fh);
+        if (r != 0) return r;
+        slot = &fh->wb[0];
+    }
+
+    if (!slot->buf && _wb_charge(vol, bs)) {
+        slot->buf = hn4_hal_mem_alloc(bs);
+        if (!slot->buf) atomic_fetch_sub(&vol->wb_bytes, bs);
+    }
+    if (!slot->buf) {
+        int r = _wb_flush(vol, fh);
+        if (r == 0) _wb_release(vol, fh);
+        return r;
+    }
+
+    _imp_memset(slot->buf, 0, bs);
+    slot->len = 0;
+
+    /* Only a block holding committed bytes needs its old image */
+    uint64_t b_start = b_idx * payload;
+    uint64_t mass    = hn4_le64_to_cpu(fh->pub.cached_anchor.mass);
+    
+    if (b_start < mass) {
+        hn4_result_t r = hn4_read_block_atomic(vol, &fh->pub.cached_anchor, b_idx, slot->buf, bs, fh->session_perms);
+        
+        if (HN4_UNLIKELY(r != HN4_OK && r != HN4_INFO_SPARSE && r != HN4_ERR_NOT_FOUND && r != HN4_INFO_HEALED)) {
+            return _map_err(r);
+        }
+        if (r == HN4_INFO_SPARSE || r == HN4_ERR_NOT_FOUND) _imp_memset(slot->buf, 0, bs);
+
+        slot->len = (mass - b_start < payload) ? (uint32_t)(mass - b_start) : payload;
+    }
+
+    slot->b_idx = b_idx;
+    slot->used  = true;
+    *out = slot;
+    return 0;
+}
+
+/*
+ * Commits the handle's RAM Anchor (and Orbit Map) to disk and publishes it
+ * to the Nano-Cortex. Refuses if the file was deleted or rewritten by a
+ * newer generation behind our back.
+ */
+static int _handle_commit(hn4_volume_t* vol, hn4_vfs_handle_t* fh) {
+    hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+    hn4_anchor_t* live = &((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx];
+    uint64_t dclass = _imp_atomic_load_u64(&live->data_class);
+    uint32_t live_gen = hn4_le32_to_cpu(live->write_gen);
+    hn4_hal_spinlock_release(&vol->locking.l2_lock);
+
+    dclass = hn4_le64_to_cpu(dclass);
+    
+    if ((dclass & HN4_FLAG_TOMBSTONE) || (live_gen > fh->cached_gen)) {
+        return -HN4_EIO; 
+    }
+
+    /* Orbit Map is advisory: a failed persist only costs read fan-out */
+    if (hn4_orbit_map_persist(vol, &fh->pub.cached_anchor) != HN4_OK) {
+        HN4_LOG_WARN("POSIX: Orbit Map persist failed, map kept in RAM");
+    }
+
+    /* Flush using PUBLIC anchor state */
+    if (hn4_write_anchor_atomic(vol, &fh->pub.cached_anchor) != HN4_OK) {
+        return -HN4_EIO;
+    }
+
+    hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+    ((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx] = fh->pub.cached_anchor;
+    _imp_dcache_flush(&((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx], sizeof(hn4_anchor_t));
+    hn4_hal_spinlock_release(&vol->locking.l2_lock);
+    fh->dirty = false;
+    return 0;
+}
+
 /* =========================================================================
  * 4. API IMPLEMENTATION
  * ========================================================================= */
@@ -494,6 +737,7 @@ int hn4_posix_open(hn4_volume_t* vol, const char* path, int flags, hn4_mode_t mo
      * --------------------------------------------------------- */
     hn4_vfs_handle_t* fh = hn4_hal_mem_alloc(sizeof(hn4_vfs_handle_t));
     if (!fh) return -HN4_ENOMEM;
+    _imp_memset(fh, 0, sizeof(hn4_vfs_handle_t));
 
     /* Initialize Public Fields */
     fh->pub.cached_anchor = lk.anchor;
@@ -540,10 +784,10 @@ hn4_ssize_t hn4_posix_read(hn4_volume_t* vol, hn4_handle_t* handle, void* buf, s
     if (payload == 0) return -HN4_EIO;
 
     if (vol->nano_cortex) {
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
         hn4_anchor_t* live = &((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx];
         uint32_t live_gen = hn4_le32_to_cpu(live->write_gen);
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
 
         if (live_gen != fh->cached_gen) {
             return -HN4_EIO; 
@@ -551,7 +795,7 @@ hn4_ssize_t hn4_posix_read(hn4_volume_t* vol, hn4_handle_t* handle, void* buf, s
     }
 
     /* Access public fields via fh->pub */
-    uint64_t size = hn4_le64_to_cpu(fh->pub.cached_anchor.mass);
+    uint64_t size = _handle_size(fh, payload);
 
     if (fh->pub.current_offset >= size) return 0;
 
@@ -567,13 +811,30 @@ hn4_ssize_t hn4_posix_read(hn4_volume_t* vol, hn4_handle_t* handle, void* buf, s
     void* io = hn4_hal_mem_alloc(bs);
     if (!io) return -HN4_ENOMEM;
 
+    if (!fh->ra && !fh->ra_disabled) {
+        fh->ra = hn4_readahead_create(vol);
+        fh->ra_disabled = (fh->ra == NULL);
+    }
+
     while (to_read > 0) {
         uint64_t b_idx = fh->pub.current_offset / payload;
         uint32_t b_off = fh->pub.current_offset % payload;
         uint32_t chunk = payload - b_off;
         if (chunk > to_read) chunk = to_read;
 
-         hn4_result_t res = hn4_read_block_atomic(
+        /* Read-your-writes: buffered image is newer than the disk */
+        hn4_wb_slot_t* slot = _wb_find(fh, b_idx);
+        if (slot) {
+            _imp_memcpy(ptr, (uint8_t*)slot->buf + b_off, chunk);
+            ptr += chunk;
+            fh->pub.current_offset += chunk;
+            to_read -= chunk;
+            total += chunk;
+            continue;
+        }
+
+         hn4_result_t res = hn4_read_block_ra(
+             fh->ra,
              vol, 
              &fh->pub.cached_anchor, 
              b_idx, 
@@ -617,7 +878,7 @@ hn4_ssize_t hn4_posix_write(hn4_volume_t* vol, hn4_handle_t* handle, const void*
     if (acc != HN4_O_WRONLY && acc != HN4_O_RDWR) return -HN4_EBADF;
 
     if (vol->nano_cortex) {
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
         _imp_memory_barrier();
         
         size_t max_slots = vol->cortex_size / sizeof(hn4_anchor_t);
@@ -628,102 +889,140 @@ hn4_ssize_t hn4_posix_write(hn4_volume_t* vol, hn4_handle_t* handle, const void*
             if (live->seed_id.lo != fh->pub.cached_anchor.seed_id.lo ||
                 live->seed_id.hi != fh->pub.cached_anchor.seed_id.hi) 
             {
-                hn4_hal_spinlock_release(&vol->locking.l2_lock);
+                hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
                 return -HN4_EBADF; 
             }
 
             fh->pub.cached_anchor = *live;
         }
         
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
     } else {
         return -HN4_EIO;
     }
 
     uint32_t perms = hn4_le32_to_cpu(fh->pub.cached_anchor.permissions);
     if (perms & HN4_PERM_IMMUTABLE) return -HN4_EPERM;
-
-    if (fh->open_flags & HN4_O_APPEND) {
-        fh->pub.current_offset = hn4_le64_to_cpu(fh->pub.cached_anchor.mass);
-    }
-
-    if (count > 0 && (UINT64_MAX - fh->pub.current_offset < count)) return -HN4_EFBIG;
+    if (vol->read_only) return -HN4_EROFS;
 
     uint32_t bs = vol->vol_block_size;
     if (bs == 0) return -HN4_EIO;
     uint32_t payload = HN4_BLOCK_PayloadSize(bs);
     if (payload == 0) return -HN4_EIO;
 
+    /*
+     * Append-only files write through: the core checks each block against
+     * the committed Mass, which a deferred flush could no longer honour.
+     */
+    bool buffered = ((perms | fh->session_perms) & HN4_PERM_WRITE) != 0;
+
+    if (fh->open_flags & HN4_O_APPEND) {
+        fh->pub.current_offset = _handle_size(fh, payload);
+    }
+
+    if (count > 0 && (UINT64_MAX - fh->pub.current_offset < count)) return -HN4_EFBIG;
+
     const uint8_t* ptr = (const uint8_t*)buf;
     size_t total_written = 0;
     size_t rem = count;
 
-    void* io = hn4_hal_mem_alloc(bs);
-    if (!io) return -HN4_ENOMEM;
+    void* io = NULL;    /* Write-through scratch, only when the buffer is bypassed */
 
     int ret_code = 0;
 
     while (rem > 0) {
         if (fh->open_flags & HN4_O_APPEND) {
-             fh->pub.current_offset = hn4_le64_to_cpu(fh->pub.cached_anchor.mass);
+             fh->pub.current_offset = _handle_size(fh, payload);
         }
 
         uint64_t b_idx = fh->pub.current_offset / payload;
         
-        if (b_idx > (UINT64_MAX / bs)) return -HN4_EFBIG;
+        if (b_idx > (UINT64_MAX / bs)) {
+            ret_code = -HN4_EFBIG;
+            goto cleanup;
+        }
 
         uint32_t b_off = fh->pub.current_offset % payload;
         uint32_t chunk = payload - b_off;
         if (chunk > rem) chunk = rem;
 
         bool rmw_needed = (b_off > 0) || (chunk < payload);
+
+        hn4_wb_slot_t* slot = _wb_find(fh, b_idx);
         
-        memset(io, 0, bs);
+        if (!slot && rmw_needed && buffered) {
+            ret_code = _wb_claim(vol, fh, b_idx, bs, payload, &slot);
+            if (ret_code != 0) goto cleanup;
+        }
 
-        if (rmw_needed) {
-            hn4_result_t r = hn4_read_block_atomic(vol, &fh->pub.cached_anchor, b_idx, io, bs, fh->session_perms);
-            
-            if (HN4_UNLIKELY(r != HN4_OK && r != HN4_INFO_SPARSE && r != HN4_ERR_NOT_FOUND && r != HN4_INFO_HEALED)) {
-                ret_code = _map_err(r);
-                goto cleanup;
+        /* Run of whole blocks the buffer does not hold: pipeline them */
+        uint64_t run = rmw_needed ? 0 : rem / payload;
+        for (int i = 0; i < HN4_WB_SLOTS && run > 1; i++) {
+            if (fh->wb[i].used && fh->wb[i].b_idx >= b_idx && fh->wb[i].b_idx < b_idx + run) {
+                run = fh->wb[i].b_idx - b_idx;
             }
         }
 
-        memcpy((uint8_t*)io + b_off, ptr, chunk);
+        if (!slot && run > 1) {
+            uint64_t done = 0;
+            ret_code = _handle_put_run(vol, fh, b_idx, ptr, run, payload, &done);
 
-        uint32_t valid_len = payload;
-        if (fh->pub.current_offset + chunk > hn4_le64_to_cpu(fh->pub.cached_anchor.mass)) {
-             valid_len = b_off + chunk;
+            ptr += done * payload;
+            fh->pub.current_offset += done * payload;
+            rem -= done * payload;
+            total_written += done * payload;
+            
+            if (ret_code != 0) goto cleanup;
+            continue;
         }
 
-        hn4_anchor_t* target_anchor = &fh->pub.cached_anchor;
-        
-        if (vol->nano_cortex && fh->anchor_idx < (vol->cortex_size / sizeof(hn4_anchor_t))) {
-            target_anchor = &((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx];
-        }
+        if (slot) {
+            _imp_memcpy((uint8_t*)slot->buf + b_off, ptr, chunk);
+            if (b_off + chunk > slot->len) slot->len = b_off + chunk;
+            fh->dirty = true;
 
-        hn4_result_t w = hn4_write_block_atomic(vol, target_anchor, b_idx, io, valid_len, fh->session_perms);
-        
-        if (HN4_UNLIKELY(w < 0)) {
-            ret_code = _map_err(w);
-            goto cleanup;
-        }
+            /* Block fill: the writer reached the end of the payload */
+            if (b_off + chunk == payload) {
+                ret_code = _wb_put(vol, fh, slot);
+                if (ret_code != 0) goto cleanup;
+            }
+        } else {
+            if (!io) {
+                io = hn4_hal_mem_alloc(bs);
+                if (!io) {
+                    ret_code = -HN4_ENOMEM;
+                    goto cleanup;
+                }
+            }
+            
+            _imp_memset(io, 0, bs);
+
+            /* As in _wb_claim: only a block holding committed bytes needs its old image */
+            if (rmw_needed && b_idx * payload < hn4_le64_to_cpu(fh->pub.cached_anchor.mass)) {
+                hn4_result_t r = hn4_read_block_atomic(vol, &fh->pub.cached_anchor, b_idx, io, bs, fh->session_perms);
+                
+                if (HN4_UNLIKELY(r != HN4_OK && r != HN4_INFO_SPARSE && r != HN4_ERR_NOT_FOUND && r != HN4_INFO_HEALED)) {
+                    ret_code = _map_err(r);
+                    goto cleanup;
+                }
+            }
 
-        if (vol->nano_cortex) {
-            uint32_t target_gen = hn4_le32_to_cpu(target_anchor->write_gen);
-            if (target_gen < fh->cached_gen) {
-                ret_code = -HN4_EIO;
-                goto cleanup;
+            _imp_memcpy((uint8_t*)io + b_off, ptr, chunk);
+
+            uint32_t valid_len = payload;
+            if (fh->pub.current_offset + chunk > hn4_le64_to_cpu(fh->pub.cached_anchor.mass)) {
+                 valid_len = b_off + chunk;
             }
-            fh->pub.cached_anchor = *target_anchor;
-            fh->cached_gen = target_gen;
+
+            /* A chunk covering the whole payload replaces the block outright: no RMW, no Thaw */
+            ret_code = _handle_put_block(vol, fh, b_idx, io, valid_len, !rmw_needed);
+            if (ret_code != 0) goto cleanup;
         }
 
         ptr += chunk;
         fh->pub.current_offset += chunk;
         rem -= chunk;
         total_written += chunk;
-        fh->dirty = true;
     }
 
 cleanup:
@@ -752,7 +1051,7 @@ hn4_off_t hn4_posix_lseek(hn4_volume_t* vol, hn4_handle_t* handle, hn4_off_t off
      * If the file is being written to by another thread/node, RAM (Nano-Cortex) is truth.
      */
     if (vol->nano_cortex) {
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
         
         /* Access global slot directly */
         hn4_anchor_t* live = &((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx];
@@ -767,11 +1066,11 @@ hn4_off_t hn4_posix_lseek(hn4_volume_t* vol, hn4_handle_t* handle, hn4_off_t off
             fh->pub.cached_anchor.mass = live->mass;
         }
         
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
     }
 
-    /* 3. Calculation */
-    uint64_t size = hn4_le64_to_cpu(fh->pub.cached_anchor.mass);
+    /* 3. Calculation (includes this handle's buffered tail) */
+    uint64_t size = _handle_size(fh, HN4_BLOCK_PayloadSize(vol->vol_block_size));
     int64_t current = (int64_t)fh->pub.current_offset;
     int64_t target = 0;
 
@@ -849,7 +1148,7 @@ int hn4_posix_readdir(hn4_volume_t* vol, const char* path, void* buf,
     while (cursor < total_count) {
         int items_in_batch = 0;
 
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
         _imp_memory_barrier();
         
         hn4_anchor_t* anchors = (hn4_anchor_t*)vol->nano_cortex;
@@ -872,12 +1171,12 @@ int hn4_posix_readdir(hn4_volume_t* vol, const char* path, void* buf,
             /* Extract Name */
             if (dclass & HN4_FLAG_EXTENDED) {
             hn4_anchor_t temp_anchor = *a;
-            hn4_hal_spinlock_release(&vol->locking.l2_lock);
+            hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
     
             hn4_ns_get_name(vol, &temp_anchor, snap->name, HN4_INLINE_NAME_MAX + 1);
     
             /* Re-acquire lock to continue iteration */
-            hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+            hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
     
         } else {
             _imp_memcpy(snap->name, a->inline_buffer, HN4_INLINE_NAME_MAX);
@@ -911,7 +1210,7 @@ int hn4_posix_readdir(hn4_volume_t* vol, const char* path, void* buf,
             items_in_batch++;
         }
         
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
         /* --- CRITICAL SECTION END --- */
 
         /* 
@@ -1001,17 +1300,19 @@ if (dst.found) {
 /* Update Source Name */
 _imp_memset(src.anchor.inline_buffer, 0, HN4_INLINE_NAME_MAX);
 _imp_strncpy_safe((char*)src.anchor.inline_buffer, p, HN4_INLINE_NAME_MAX);
+_posix_drop_extension(&src.anchor);
 hn4_write_anchor_atomic(vol, &src.anchor);
     }
 
     if (vol->nano_cortex) {
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
         src.anchor = ((hn4_anchor_t*)vol->nano_cortex)[src.slot_idx];
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
     }
 
     _imp_memset(src.anchor.inline_buffer, 0, HN4_INLINE_NAME_MAX);
     _imp_strncpy_safe((char*)src.anchor.inline_buffer, p, HN4_INLINE_NAME_MAX);
+    _posix_drop_extension(&src.anchor);
     
     src.anchor.mod_clock = hn4_cpu_to_le64(hn4_hal_get_time_ns());
 
@@ -1056,33 +1357,31 @@ int hn4_posix_close(hn4_volume_t* vol, hn4_handle_t* handle) {
     
     int ret = 0;
     if (fh->dirty && !vol->read_only && !fh->is_directory) {
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
-        hn4_anchor_t* live = &((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx];
-        uint64_t dclass = _imp_atomic_load_u64(&live->data_class);
-        uint32_t live_gen = hn4_le32_to_cpu(live->write_gen);
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
-
-        dclass = hn4_le64_to_cpu(dclass);
-        
-        if ((dclass & HN4_FLAG_TOMBSTONE) || (live_gen > fh->cached_gen)) {
-            ret = -HN4_EIO; 
-        } else {
-            /* Flush using PUBLIC anchor state */
-            if (hn4_write_anchor_atomic(vol, &fh->pub.cached_anchor) != HN4_OK) {
-                ret = -HN4_EIO;
-            } else {
-                hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
-                ((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx] = fh->pub.cached_anchor;
-                _imp_dcache_flush(&((hn4_anchor_t*)vol->nano_cortex)[fh->anchor_idx], sizeof(hn4_anchor_t));
-                hn4_hal_spinlock_release(&vol->locking.l2_lock);
-                fh->dirty = false;
-            }
-        }
+        /* Unflushed images are the only copy: keep the handle, caller may retry */
+        ret = _wb_flush(vol, fh);
+        if (ret != 0) return ret;
+        ret = _handle_commit(vol, fh);
     }
     
     atomic_fetch_sub(&vol->health.ref_count, 1);
 
+    _wb_release(vol, fh);
+    hn4_readahead_destroy(fh->ra);
     hn4_hal_mem_free(fh);
     return ret;
 }
 
+int hn4_posix_fsync(hn4_volume_t* vol, hn4_handle_t* handle) {
+    if (!vol || !handle) return -HN4_EINVAL;
+    hn4_vfs_handle_t* fh = (hn4_vfs_handle_t*)((uint8_t*)handle - offsetof(hn4_vfs_handle_t, pub));
+
+    if (!fh->dirty || fh->is_directory) return 0;
+    if (vol->read_only) return -HN4_EROFS;
+
+    /* Buffered blocks first, then the Anchor that makes them reachable */
+    int ret = _wb_flush(vol, fh);
+    if (ret != 0) return ret;
+
+    return _handle_commit(vol, fh);
+}
+
@@ -15,6 +15,12 @@
  */
 
 #include "hn4.h"
+#include "hn4_read.h"
+#include "hn4_allocator.h"
+#include "hn4_orbitmap.h"
+#include "hn4_lexicon.h"
+#include "hn4_repair.h"
+#include "hn4_residency.h"
 #include "hn4_hal.h"
 #include "hn4_crc.h"
 #include "hn4_swizzle.h"
@@ -235,7 +241,8 @@ static hn4_result_t _validate_block(
     HN4_IN hn4_u128_t    expected_well_id,
     HN4_IN uint64_t      logical_seq,
     HN4_IN uint64_t      expected_gen,
-    HN4_IN uint64_t      anchor_dclass
+    HN4_IN uint64_t      anchor_dclass,
+    HN4_IN uint32_t      tier
 )
 {
     const hn4_block_header_t* hdr = (const hn4_block_header_t*)buffer;
@@ -277,11 +284,13 @@ static hn4_result_t _validate_block(
         return HN4_ERR_PHANTOM_BLOCK;
     }
 
-    /* 2. Header Integrity Check (CRC) */
-    uint32_t stored_crc = hn4_le32_to_cpu(hdr->header_crc);
-    uint32_t calc_crc   = hn4_crc32(HN4_CRC_SEED_HEADER, hdr, offsetof(hn4_block_header_t, header_crc));
+    /* 2. Header Integrity Check (CRC). Media ECC vouches for it in TRUST. */
+    if (tier != HN4_INTEGRITY_TRUST) {
+        uint32_t stored_crc = hn4_le32_to_cpu(hdr->header_crc);
+        uint32_t calc_crc   = hn4_crc32(HN4_CRC_SEED_HEADER, hdr, offsetof(hn4_block_header_t, header_crc));
 
-    if (HN4_UNLIKELY(stored_crc != calc_crc)) return HN4_ERR_HEADER_ROT;
+        if (HN4_UNLIKELY(stored_crc != calc_crc)) return HN4_ERR_HEADER_ROT;
+    }
 
     /* 3. Identity Check (Anti-Collision) */
     hn4_u128_t disk_id = hn4_le128_to_cpu(hdr->well_id);
@@ -311,7 +320,7 @@ static hn4_result_t _validate_block(
     uint32_t c_size     = comp_meta >> HN4_COMP_SIZE_SHIFT;
     uint8_t  algo       = comp_meta & HN4_COMP_ALGO_MASK;
 
-    if (HN4_UNLIKELY(algo != HN4_COMP_NONE && algo != HN4_COMP_TCC)) {
+    if (HN4_UNLIKELY(algo != HN4_COMP_NONE && algo != HN4_COMP_TCC && algo != HN4_COMP_TCC_SHUFFLE)) {
         HN4_LOG_WARN("Block Validation: Unknown Algo %u", algo);
         return HN4_ERR_ALGO_UNKNOWN;
     }
@@ -326,6 +335,9 @@ static hn4_result_t _validate_block(
         return HN4_ERR_HEADER_ROT;
     }
 
+    /* Relaxed tiers leave the payload CRC to the Scavenger scrub */
+    if (tier != HN4_INTEGRITY_FULL) return HN4_OK;
+
     uint32_t stored_dcrc = hn4_le32_to_cpu(hdr->data_crc);
     uint32_t calc_dcrc   = hn4_crc32(HN4_CRC_SEED_DATA, hdr->payload, payload_sz);
 
@@ -338,23 +350,92 @@ static hn4_result_t _validate_block(
 }
 
 /* =========================================================================
- * CORE LOGIC
+ * VERIFICATION TIERS
+ * =========================================================================
+ * FULL checks everything. HEADER skips the payload CRC (the Scavenger
+ * scrub covers it in the background). TRUST also skips the header CRC and
+ * is only granted on ECC-protected NVM. Identity, sequence and generation
+ * are always checked: they decide WHICH block is the answer, not whether
+ * its bits rotted.
+ *
+ * A relaxed tier is granted against a snapshot of the health counters.
+ * The first read that sees them move promotes the mount to FULL.
+ */
+
+static uint64_t _health_signature(hn4_volume_t* vol)
+{
+    return atomic_load_explicit(&vol->health.crc_failures, memory_order_relaxed) +
+           atomic_load_explicit(&vol->health.taint_counter, memory_order_relaxed) +
+           atomic_load_explicit(&vol->health.toxic_blocks, memory_order_relaxed) +
+           atomic_load_explicit(&vol->health.heal_count, memory_order_relaxed);
+}
+
+uint32_t hn4_read_set_integrity(hn4_volume_t* vol, uint32_t level)
+{
+    if (!vol) return HN4_INTEGRITY_FULL;
+
+    uint32_t tier = level;
+
+    if (tier == HN4_INTEGRITY_TRUST) {
+        const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+        uint64_t need = HN4_HW_NVM | HN4_HW_MEDIA_ECC;
+
+        if (!caps || (caps->hw_flags & need) != need) tier = HN4_INTEGRITY_HEADER;
+    }
+
+    if (tier != HN4_INTEGRITY_HEADER && tier != HN4_INTEGRITY_TRUST) tier = HN4_INTEGRITY_FULL;
+
+    /* Known-sick media gets no discount */
+    if (tier != HN4_INTEGRITY_FULL && atomic_load(&vol->health.taint_counter) != 0) {
+        tier = HN4_INTEGRITY_FULL;
+    }
+
+    vol->integrity.requested  = level;
+    vol->integrity.health_sig = _health_signature(vol);
+    atomic_store_explicit(&vol->integrity.effective, tier, memory_order_release);
+
+    if (tier != level && level != HN4_INTEGRITY_STRICT) {
+        HN4_LOG_WARN("Integrity: Requested tier %u, granted %u", level, tier);
+    }
+    return tier;
+}
+
+uint32_t hn4_read_get_integrity(hn4_volume_t* vol)
+{
+    uint32_t tier = atomic_load_explicit(&vol->integrity.effective, memory_order_acquire);
+
+    if (HN4_LIKELY(tier == HN4_INTEGRITY_FULL)) return tier;
+
+    if (HN4_UNLIKELY(_health_signature(vol) != vol->integrity.health_sig)) {
+        uint32_t expected = tier;
+        if (atomic_compare_exchange_strong(&vol->integrity.effective, &expected, HN4_INTEGRITY_FULL)) {
+            HN4_LOG_WARN("Integrity: Health counters moved. Promoting tier %u to FULL.", tier);
+        }
+        return HN4_INTEGRITY_FULL;
+    }
+    return tier;
+}
+
+/* =========================================================================
+ * TRAJECTORY & DECODE HELPERS
  * ========================================================================= */
 
-_Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
-    HN4_IN  hn4_volume_t* vol,
-    HN4_IN  hn4_anchor_t* anchor_ptr,
-    HN4_IN  uint64_t      block_idx,
-    HN4_OUT void*         out_buffer,
-    HN4_IN  uint32_t      buffer_len,
-    HN4_IN uint32_t session_perms /* Delegated rights */
-)
+/* 
+ * Calculate Hardware Index (0..3) 
+ * 0=SSD, 1=HDD, 2=TAPE
+ */
+HN4_INLINE uint32_t _hw_index(const hn4_volume_t* vol)
 {
-    if (HN4_UNLIKELY(!vol || !anchor_ptr || !out_buffer)) return HN4_ERR_INVALID_ARGUMENT;
+    uint32_t dev_type = vol->sb.info.device_type_tag;
 
-    hn4_anchor_t anchor;
-    
-    /* Optimization: Only lock if reading from shared Nano-Cortex RAM */
+    if (dev_type == HN4_DEV_TAPE) return 2;
+    if (dev_type == HN4_DEV_HDD || (vol->sb.info.hw_caps_flags & HN4_HW_ROTATIONAL)) return 1;
+    return 0;
+}
+
+/* Only lock if reading from shared Nano-Cortex RAM */
+static void _snapshot_anchor(hn4_volume_t* vol, const hn4_anchor_t* anchor_ptr, hn4_anchor_t* out)
+{
     bool need_lock = false;
     if (vol->nano_cortex) {
         uintptr_t ptr = (uintptr_t)anchor_ptr;
@@ -364,13 +445,366 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
     }
 
     if (need_lock) {
-        hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
-        volatile hn4_anchor_t* v_ptr = (volatile hn4_anchor_t*)anchor_ptr;
-        memcpy(&anchor, (void*)v_ptr, sizeof(hn4_anchor_t));
-        hn4_hal_spinlock_release(&vol->locking.l2_lock);
+        hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
+        volatile const hn4_anchor_t* v_ptr = (volatile const hn4_anchor_t*)anchor_ptr;
+        memcpy(out, (const void*)v_ptr, sizeof(hn4_anchor_t));
+        hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
     } else {
-        memcpy(&anchor, anchor_ptr, sizeof(hn4_anchor_t));
+        memcpy(out, anchor_ptr, sizeof(hn4_anchor_t));
+    }
+}
+
+HN4_INLINE uint64_t _anchor_orbit_vector(const hn4_anchor_t* anchor)
+{
+    const uint8_t* raw_v = anchor->orbit_vector;
+
+    return (uint64_t)raw_v[0] |
+           ((uint64_t)raw_v[1] << 8)  |
+           ((uint64_t)raw_v[2] << 16) |
+           ((uint64_t)raw_v[3] << 24) |
+           ((uint64_t)raw_v[4] << 32) |
+           ((uint64_t)raw_v[5] << 40);
+}
+
+/*
+ * Orbit 'block_idx' was last written to: the Anchor hints for the first
+ * 16 clusters (2 bits per cluster of 16 blocks), the per-file Orbit Map
+ * beyond. -1 when unknown.
+ */
+static int _recorded_orbit(hn4_volume_t* vol, const hn4_anchor_t* anchor, uint64_t block_idx)
+{
+    uint64_t cluster_idx = block_idx >> 4;
+
+    if (cluster_idx < 16) {
+        return (int)((hn4_le32_to_cpu(anchor->orbit_hints) >> (uint32_t)(cluster_idx * 2)) & 0x3u);
+    }
+
+    return hn4_orbit_map_lookup(vol, anchor, block_idx);
+}
+
+/*
+ * Resolves the ballistic LBA of 'block_idx' on orbit 'k'.
+ */
+static uint64_t _orbit_lba_for_block(
+    hn4_volume_t* vol,
+    uint64_t      G,
+    uint64_t      V,
+    uint16_t      M,
+    uint8_t       k,
+    uint64_t      block_idx
+)
+{
+    /*
+     * Trajectory Jitter.
+     * For higher orbits (k >= 8), apply a secondary swizzle to 'G' (Gravity Center)
+     * to force candidates into uncorrelated physical regions (Anti-Wordline Bias).
+     */
+    uint64_t effective_G = (k >= 8) ? (G ^ hn4_swizzle_gravity_assist(G)) : G;
+    uint64_t effective_V = (k >= 4) ? hn4_swizzle_gravity_assist(V) : V;
+
+    return _calc_trajectory_lba(vol, effective_G, effective_V, block_idx, M, k);
+}
+
+/*
+ * Bitmap existence check for a read candidate. 'optimistic' lets a RO mount
+ * without a loaded bitmap probe anyway (the primary orbit only).
+ */
+static bool _probe_allocated(hn4_volume_t* vol, uint64_t lba, bool optimistic, hn4_result_t* probe_error)
+{
+    if (vol->read_only && !vol->void_bitmap) return optimistic;
+
+    bool is_allocated = false;
+    hn4_result_t op_res = _bitmap_op(vol, lba, BIT_TEST, &is_allocated);
+
+    if (op_res == HN4_ERR_UNINITIALIZED && vol->read_only) {
+        return optimistic;
+    }
+
+    if (op_res != HN4_OK) {
+        *probe_error = _merge_error(*probe_error, op_res);
+        return false;
     }
+    return is_allocated;
+}
+
+/* Cloud arrays: every block goes through the spatial router (mirror/shard map) */
+HN4_INLINE bool _routed_volume(const hn4_volume_t* vol)
+{
+    return vol->sb.info.format_profile == HN4_PROFILE_HYPER_CLOUD && vol->array.count > 0;
+}
+
+/*
+ * Copies or inflates a validated block payload into the caller buffer.
+ * Tail beyond the payload is zeroed.
+ */
+static hn4_result_t _decode_payload(
+    hn4_volume_t*             vol,
+    const hn4_block_header_t* hdr,
+    void*                     out_buffer,
+    uint32_t                  buffer_len
+)
+{
+    uint32_t comp_meta   = hn4_le32_to_cpu(hdr->comp_meta);
+    uint8_t  algo        = comp_meta & HN4_COMP_ALGO_MASK;
+    uint32_t c_size      = comp_meta >> HN4_COMP_SIZE_SHIFT;
+    uint32_t max_payload = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    hn4_result_t res     = HN4_OK;
+
+    switch (algo) {
+        case HN4_COMP_NONE:
+        {
+            uint32_t copy_len = (buffer_len < max_payload) ? buffer_len : max_payload;
+            if (buffer_len < max_payload) {
+                HN4_LOG_WARN("READ_ATOMIC: Output truncated.");
+            }
+            memcpy(out_buffer, hdr->payload, copy_len);
+            if (buffer_len > copy_len) {
+                memset((uint8_t*)out_buffer + copy_len, 0, buffer_len - copy_len);
+            }
+            break;
+        }
+
+        case HN4_COMP_TCC:
+        case HN4_COMP_TCC_SHUFFLE:
+        {
+            uint32_t       actual_out_size = 0;
+            const uint8_t* stream = hdr->payload;
+            uint32_t       s_len  = c_size;
+            uint8_t        filter = 0;
+            void*          planes = NULL;
+
+            /* Shuffled: [Filter] [TCC of the planes]. Inflate aside, then unshuffle. */
+            if (algo == HN4_COMP_TCC_SHUFFLE) {
+                if (c_size == 0) {
+                    res = HN4_ERR_DECOMPRESS_FAIL;
+                    break;
+                }
+                filter = *stream++;
+                s_len--;
+                planes = hn4_hal_mem_alloc(buffer_len);
+                if (!planes) {
+                    res = HN4_ERR_NOMEM;
+                    break;
+                }
+            }
+
+            const hn4_tcc_lexicon_t* lex = hn4_lexicon_get(vol, hn4_tcc_stream_lexicon(stream, s_len));
+            res = hn4_decompress_block_ex(stream, s_len, planes ? planes : out_buffer, buffer_len,
+                                          &actual_out_size, lex);
+
+            if (res == HN4_OK && planes && !hn4_unshuffle(planes, out_buffer, actual_out_size, filter)) {
+                res = HN4_ERR_DATA_ROT;
+            }
+            hn4_hal_mem_free(planes);
+
+            /* Map internal buffer exhaustion to semantic API error */
+            if (res == HN4_ERR_NOMEM) {
+                res = HN4_ERR_DECOMPRESS_FAIL;
+            }
+
+            if (res == HN4_OK) {
+                if (buffer_len > actual_out_size) {
+                    memset((uint8_t*)out_buffer + actual_out_size, 0, buffer_len - actual_out_size);
+                }
+            }
+            break;
+        }
+
+        default:
+            res = HN4_ERR_ALGO_UNKNOWN;
+            break;
+    }
+
+    return res;
+}
+
+/* =========================================================================
+ * HEDGED ORBIT PROBE
+ * =========================================================================
+ * Submits every remaining candidate orbit at once and takes the first
+ * completion (in completion order) that validates with the right well_id,
+ * sequence and generation. An orbit-miss chain then costs one device
+ * round trip instead of one per k.
+ *
+ * The HAL has no abort. Losers complete into a refcounted context that the
+ * last completion frees, so the reader returns as soon as it has a winner.
+ */
+
+#define HN4_HEDGE_WAIT_NS   (2000ULL * 1000ULL * 1000ULL)
+
+struct _hedge_ctx;
+
+typedef struct {
+    hn4_io_req_t        req;
+    struct _hedge_ctx*  ctx;
+    hn4_result_t        res;
+    uint32_t            seq;        /* Completion order */
+    _Atomic uint32_t    done;
+} _hedge_slot_t;
+
+typedef struct _hedge_ctx {
+    _Atomic uint32_t    refs;       /* One per submission + the reader */
+    _Atomic uint32_t    completed;
+    uint8_t*            bufs;
+    _hedge_slot_t       slots[HN4_ORBIT_LIMIT];
+} _hedge_ctx_t;
+
+static void _hedge_put(_hedge_ctx_t* h)
+{
+    if (atomic_fetch_sub_explicit(&h->refs, 1, memory_order_acq_rel) == 1) {
+        hn4_hal_mem_free(h->bufs);
+        hn4_hal_mem_free(h);
+    }
+}
+
+static void _hedge_io_done(hn4_io_req_t* req, hn4_result_t result)
+{
+    _hedge_slot_t* slot = (_hedge_slot_t*)req->user_ctx;
+    _hedge_ctx_t*  h    = slot->ctx;
+
+    slot->res = result;
+    slot->seq = atomic_fetch_add_explicit(&h->completed, 1, memory_order_relaxed);
+    atomic_store_explicit(&slot->done, 1, memory_order_release);
+    _hedge_put(h);
+}
+
+/*
+ * Returns the index (into 'candidates') of the winner, or -1. On success
+ * 'io_buf' holds the raw winning block and 'out_buffer' the decoded payload;
+ * 'out_healed' says the device had to correct it. Rotten copies seen before
+ * the winner are flagged in 'failed_mask' / 'cand_err' for the Auto-Medic.
+ * Everything else is left for the serial loop to classify and retry.
+ */
+static int _hedged_probe(
+    hn4_volume_t*   vol,
+    const uint64_t* candidates,
+    int             first,
+    int             count,
+    uint32_t        sectors,
+    hn4_u128_t      well_id,
+    uint64_t        block_idx,
+    uint64_t        anchor_gen,
+    uint64_t        dclass,
+    uint32_t        tier,
+    void*           io_buf,
+    void*           out_buffer,
+    uint32_t        buffer_len,
+    uint32_t*       failed_mask,
+    hn4_result_t*   cand_err,
+    bool*           out_healed
+)
+{
+    uint32_t          bs  = vol->vol_block_size;
+    hn4_hal_device_t* dev = vol->target_device;
+
+    if (count <= 0 || count > HN4_ORBIT_LIMIT) return -1;
+
+    _hedge_ctx_t* h = hn4_hal_mem_alloc(sizeof(_hedge_ctx_t));
+    if (!h) return -1;
+
+    h->bufs = hn4_hal_mem_alloc((size_t)bs * (size_t)count);
+    if (!h->bufs) {
+        hn4_hal_mem_free(h);
+        return -1;
+    }
+
+    atomic_store_explicit(&h->refs, (uint32_t)count + 1, memory_order_relaxed);
+    atomic_store_explicit(&h->completed, 0, memory_order_relaxed);
+
+    for (int j = 0; j < count; j++) {
+        _hedge_slot_t* slot = &h->slots[j];
+        uint64_t       lba  = candidates[first + j];
+
+        slot->ctx = h;
+        atomic_store_explicit(&slot->done, 0, memory_order_relaxed);
+
+        slot->req.op_code  = HN4_IO_READ;
+        slot->req.buffer   = h->bufs + (size_t)j * bs;
+        slot->req.length   = sectors;
+        slot->req.user_ctx = slot;
+
+        if (lba > (UINT64_MAX / sectors)) {
+            _hedge_io_done(&slot->req, HN4_ERR_GEOMETRY);
+            continue;
+        }
+
+        slot->req.lba = hn4_lba_from_blocks(lba * sectors);
+        hn4_hal_submit_io(dev, &slot->req, _hedge_io_done);
+    }
+
+    uint32_t   all      = (1U << count) - 1;
+    uint32_t   examined = 0;
+    uint32_t   rot      = 0;
+    int        winner   = -1;
+    hn4_time_t start    = hn4_hal_get_time_ns();
+
+    while (examined != all) {
+        int      pick = -1;
+        uint32_t best = UINT32_MAX;
+
+        for (int j = 0; j < count; j++) {
+            if (examined & (1U << j)) continue;
+            if (!atomic_load_explicit(&h->slots[j].done, memory_order_acquire)) continue;
+            if (h->slots[j].seq < best) {
+                best = h->slots[j].seq;
+                pick = j;
+            }
+        }
+
+        if (pick < 0) {
+            if ((hn4_hal_get_time_ns() - start) > (hn4_time_t)HN4_HEDGE_WAIT_NS) break;
+            hn4_hal_poll(dev);
+            continue;
+        }
+
+        examined |= (1U << pick);
+        if (!HN4_IS_OK(h->slots[pick].res)) continue;
+
+        const uint8_t* raw = h->bufs + (size_t)pick * bs;
+
+        hn4_result_t v = _validate_block(vol, raw, bs, well_id, block_idx, anchor_gen, dclass, tier);
+        if (v != HN4_OK) {
+            if (v == HN4_ERR_HEADER_ROT || v == HN4_ERR_PAYLOAD_ROT || v == HN4_ERR_DATA_ROT) {
+                rot |= (1U << (first + pick));
+                cand_err[first + pick] = v;
+            }
+            continue;
+        }
+        if (HN4_IS_ERR(_decode_payload(vol, (const hn4_block_header_t*)raw, out_buffer, buffer_len))) continue;
+
+        memcpy(io_buf, raw, bs);
+        winner      = first + pick;
+        *out_healed = (h->slots[pick].res == HN4_INFO_HEALED);
+        break;
+    }
+
+    /* Without a winner the serial loop re-reads and does the accounting */
+    if (winner >= 0 && rot) {
+        *failed_mask |= rot;
+        for (uint32_t m = rot; m; m &= m - 1) atomic_fetch_add(&vol->health.crc_failures, 1);
+    }
+
+    _hedge_put(h);
+    return winner;
+}
+
+/* =========================================================================
+ * CORE LOGIC
+ * ========================================================================= */
+
+_Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
+    HN4_IN  hn4_volume_t* vol,
+    HN4_IN  hn4_anchor_t* anchor_ptr,
+    HN4_IN  uint64_t      block_idx,
+    HN4_OUT void*         out_buffer,
+    HN4_IN  uint32_t      buffer_len,
+    HN4_IN uint32_t session_perms /* Delegated rights */
+)
+{
+    if (HN4_UNLIKELY(!vol || !anchor_ptr || !out_buffer)) return HN4_ERR_INVALID_ARGUMENT;
+
+    hn4_anchor_t anchor;
+    _snapshot_anchor(vol, anchor_ptr, &anchor);
 
     uint32_t payload_cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
 
@@ -389,14 +823,7 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
     /* 2. Physics & Geometry Extraction */
      uint64_t G = hn4_le64_to_cpu(anchor.gravity_center);
 
-    const uint8_t* raw_v = anchor.orbit_vector;
-
-    uint64_t V = (uint64_t)raw_v[0] |
-                 ((uint64_t)raw_v[1] << 8)  |
-                 ((uint64_t)raw_v[2] << 16) |
-                 ((uint64_t)raw_v[3] << 24) |
-                 ((uint64_t)raw_v[4] << 32) |
-                 ((uint64_t)raw_v[5] << 40);
+    uint64_t V = _anchor_orbit_vector(&anchor);
 
     uint16_t   M          = hn4_le16_to_cpu(anchor.fractal_scale);
     hn4_u128_t well_id    = hn4_le128_to_cpu(anchor.seed_id);
@@ -413,20 +840,8 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
     uint32_t sectors = bs / ss;
 
     /* 3. Hardware Profile Tuning */
-    uint32_t profile  = vol->sb.info.format_profile & 7;
-    uint32_t dev_type = vol->sb.info.device_type_tag;
-    uint64_t hw_caps  = vol->sb.info.hw_caps_flags;
-
-    /* 
-     * Calculate Hardware Index (0..3) 
-     * 0=SSD, 1=HDD, 2=TAPE
-     */
-    uint32_t hw_idx = 0;
-    if (dev_type == HN4_DEV_TAPE) {
-        hw_idx = 2;
-    } else if (dev_type == HN4_DEV_HDD || (hw_caps & HN4_HW_ROTATIONAL)) {
-        hw_idx = 1;
-    }
+    uint32_t profile = vol->sb.info.format_profile & 7;
+    uint32_t hw_idx  = _hw_index(vol);
 
     /* O(1) Fetch */
     hn4_read_policy_t pol = _read_policy_lut[(profile << 2) | hw_idx];
@@ -436,6 +851,7 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
     uint8_t  depth_limit   = pol.depth;
     bool     allow_healing = !vol->read_only && !(pol.flags & RP_NO_HEAL);
     bool     is_hdd        = (pol.flags & RP_IS_HDD);
+    uint32_t tier          = hn4_read_get_integrity(vol);
 
     /* Dynamic Logic: Gaming Mass Check */
     if (HN4_UNLIKELY(pol.flags & RP_CHECK_MASS)) {
@@ -449,6 +865,7 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
     hn4_result_t candidate_errors[HN4_ORBIT_LIMIT];
     hn4_result_t probe_error = HN4_OK;
     int          valid_candidates = 0;
+    bool         trusted_hint = false;
     uint64_t     max_blocks = vol->vol_capacity_bytes / bs;
 
     for (int i = 0; i < HN4_ORBIT_LIMIT; i++) candidate_errors[i] = HN4_ERR_NOT_FOUND;
@@ -483,58 +900,41 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
         }
     } else {
 
-        /* Determine target Orbit (k) from Anchor Hint (2 bits per cluster) */
-        uint8_t target_k = 0;
-        uint64_t cluster_idx = block_idx >> 4;
-
-        if (cluster_idx < 16) {
-            uint32_t hints = hn4_le32_to_cpu(anchor.orbit_hints);
-            uint32_t shift = (uint32_t)(cluster_idx * 2);
-            target_k = (uint8_t)((hints >> shift) & 0x3u);
+        /*
+         * Sniper: the first 16 clusters carry the orbit recorded by the
+         * allocator, and only that orbit is read. Beyond the hint range every
+         * claimed orbit inside the policy depth is a candidate (Shotgun); the
+         * one in the Orbit Map, if any, is tried alone first.
+         */
+        bool     hinted    = (block_idx >> 4) < 16;
+        int      rec_k     = _recorded_orbit(vol, &anchor, block_idx);
+        uint8_t  primary_k = (rec_k > 0) ? (uint8_t)rec_k : 0;
+
+        trusted_hint = !hinted && (rec_k >= 0);
+
+        uint64_t lba = _orbit_lba_for_block(vol, G, V, M, primary_k, block_idx);
+
+        if (lba != HN4_LBA_INVALID && lba < max_blocks) {
+            /* 
+             * If we are Read-Only and the Bitmap failed to load (NULL), we cannot 
+             * check allocation status. We MUST assume the block exists and let 
+             * the Physical Validation (Magic/CRC) determine truth.
+             */
+            if (_probe_allocated(vol, lba, true, &probe_error)) {
+                candidates[valid_candidates++] = lba;
+            }
         }
 
-        /* Only scan the specific target orbit */
-        uint8_t k = target_k;
-        {
-            /*
-             * Trajectory Jitter.
-             * For higher orbits (k >= 8), apply a secondary swizzle to 'G' (Gravity Center)
-             * to force candidates into uncorrelated physical regions (Anti-Wordline Bias).
-             */
-            uint64_t effective_G = (k >= 8) ? (G ^ hn4_swizzle_gravity_assist(G)) : G;
-            uint64_t effective_V = (k >= 4) ? hn4_swizzle_gravity_assist(V) : V;
-
-            uint64_t lba = _calc_trajectory_lba(vol, effective_G, effective_V, block_idx, M, k);
-
-            if (lba != HN4_LBA_INVALID && lba < max_blocks) {
-                /* Atomic Reservation / Existence Check */
-                bool is_allocated = false;
-                /* 
-                 * If we are Read-Only and the Bitmap failed to load (NULL), we cannot 
-                 * check allocation status. We MUST assume the block exists and let 
-                 * the Physical Validation (Magic/CRC) determine truth.
-                 */
-                if (vol->read_only && !vol->void_bitmap) {
-                    is_allocated = true; /* Optimistic probe */
-                } else {
-                    hn4_result_t op_res = _bitmap_op(vol, lba, BIT_TEST, &is_allocated);
+        for (uint8_t k = 0; !hinted && k < depth_limit && valid_candidates < HN4_ORBIT_LIMIT; k++) {
+            if (k == primary_k) continue;
 
-                    if (op_res == HN4_ERR_UNINITIALIZED && vol->read_only) {
-                        is_allocated = true; 
-                        op_res = HN4_OK;
-                    }
+            uint64_t orbit_lba = _calc_trajectory_lba(vol, G, V, block_idx, M, k);
 
-                    if (op_res != HN4_OK) {
-                        probe_error = _merge_error(probe_error, op_res);
-                        is_allocated = false;
-                    }
-                }
+            if (orbit_lba == HN4_LBA_INVALID || orbit_lba >= max_blocks) continue;
+            if (valid_candidates > 0 && orbit_lba == candidates[0]) continue;
 
-                if (is_allocated) {
-                    if (valid_candidates < HN4_ORBIT_LIMIT) {
-                        candidates[valid_candidates++] = lba;
-                    }
-                }
+            if (_probe_allocated(vol, orbit_lba, false, &probe_error)) {
+                candidates[valid_candidates++] = orbit_lba;
             }
         }
     }
@@ -555,8 +955,10 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
         return HN4_INFO_SPARSE;
     }
     
-     if (is_hdd && valid_candidates > 1) {
-        _sort_candidates_mechanical(candidates, valid_candidates);
+    /* A mapped primary keeps its slot, the fallbacks are swept in head order */
+    if (is_hdd && valid_candidates > 1) {
+        int sort_from = trusted_hint ? 1 : 0;
+        _sort_candidates_mechanical(candidates + sort_from, valid_candidates - sort_from);
     }
 
 
@@ -567,10 +969,38 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
     hn4_result_t deep_error = HN4_ERR_NOT_FOUND;
     int          winner_idx = -1;
     uint32_t     failed_mask = 0;
+    bool         winner_healed = false;  /* Device corrected the winning copy */
+
+    /*
+     * Hedged fan-out: every claimed orbit goes out at once. With an Orbit
+     * Map entry the mapped orbit is read alone first and the fan-out only
+     * covers the fallbacks. Array volumes keep the serial path (the spatial
+     * router owns mirror/shard placement). Whatever the fan-out cannot
+     * settle, the serial loop re-reads with retries and error accounting.
+     */
+    bool can_hedge = (valid_candidates > 1) && !_routed_volume(vol);
+
+    if (can_hedge && !trusted_hint) {
+        winner_idx = _hedged_probe(vol, candidates, 0, valid_candidates, sectors, well_id,
+                                   block_idx, anchor_gen, dclass, tier, io_buf, out_buffer, buffer_len,
+                                   &failed_mask, candidate_errors, &winner_healed);
+        if (winner_idx >= 0) deep_error = HN4_OK;
+    }
 
-    for (int i = 0; i < valid_candidates; i++) {
+    for (int i = 0; i < valid_candidates && winner_idx < 0; i++) {
         uint64_t target_lba = candidates[i];
 
+        if (i == 1 && can_hedge && trusted_hint) {
+            int w = _hedged_probe(vol, candidates, 1, valid_candidates - 1, sectors, well_id,
+                                  block_idx, anchor_gen, dclass, tier, io_buf, out_buffer, buffer_len,
+                                  &failed_mask, candidate_errors, &winner_healed);
+            if (w >= 0) {
+                winner_idx = w;
+                deep_error = HN4_OK;
+                break;
+            }
+        }
+
         if (target_lba > (UINT64_MAX / sectors)) {
             failed_mask |= (1ULL << i);
             candidate_errors[i] = HN4_ERR_GEOMETRY;
@@ -620,15 +1050,12 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
                 well_id
             );
 
-            if (HN4_LIKELY(io_res == HN4_OK)) {
-                hn4_result_t val_res = _validate_block(vol, io_buf, bs, well_id, block_idx, anchor_gen, dclass);
+            if (HN4_LIKELY(HN4_IS_OK(io_res))) {
+                hn4_result_t val_res = _validate_block(vol, io_buf, bs, well_id, block_idx, anchor_gen, dclass, tier);
 
                 if (HN4_LIKELY(val_res == HN4_OK)) {
-                    if (io_res == HN4_INFO_HEALED) {
-                        /* Mark candidate for repair if HAL reported soft error */
-                        failed_mask |= (1U << i);
-                        candidate_errors[i] = HN4_ERR_DATA_ROT;
-                    }
+                    /* HAL reported a soft error: the copy is good but due for a rewrite */
+                    winner_healed = (io_res == HN4_INFO_HEALED);
                     io_res = HN4_OK;
                 } else if (val_res != HN4_ERR_DATA_ROT && val_res != HN4_ERR_PAYLOAD_ROT) {
                     io_res = val_res;
@@ -653,110 +1080,12 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
         candidate_errors[i] = io_res;
 
         if (io_res == HN4_OK) {
-            hn4_block_header_t* hdr    = (hn4_block_header_t*)io_buf;
-            uint32_t comp_meta         = hn4_le32_to_cpu(hdr->comp_meta);
-            uint8_t  algo              = comp_meta & HN4_COMP_ALGO_MASK;
-            uint32_t c_size            = comp_meta >> HN4_COMP_SIZE_SHIFT;
-            uint32_t max_payload       = payload_cap;
-            hn4_result_t decomp_res    = HN4_OK;
-
-            switch (algo) {
-                case HN4_COMP_NONE:
-                {
-                    uint32_t copy_len = (buffer_len < max_payload) ? buffer_len : max_payload;
-                    if (buffer_len < max_payload) {
-                        HN4_LOG_WARN("READ_ATOMIC: Output truncated.");
-                    }
-                    memcpy(out_buffer, hdr->payload, copy_len);
-                    if (buffer_len > copy_len) {
-                        memset((uint8_t*)out_buffer + copy_len, 0, buffer_len - copy_len);
-                    }
-                    break;
-                }
-
-                case HN4_COMP_TCC:
-                {
-                    uint32_t actual_out_size = 0;
-                    decomp_res = hn4_decompress_block(hdr->payload, c_size, out_buffer, buffer_len, &actual_out_size);
-
-                    /* Map internal buffer exhaustion to semantic API error */
-                    if (decomp_res == HN4_ERR_NOMEM) {
-                        decomp_res = HN4_ERR_DECOMPRESS_FAIL;
-                    }
-
-                    if (decomp_res == HN4_OK) {
-                        if (buffer_len > actual_out_size) {
-                            memset((uint8_t*)out_buffer + actual_out_size, 0, buffer_len - actual_out_size);
-                        }
-                    }
-                    break;
-                }
-
-                default:
-                    decomp_res = HN4_ERR_ALGO_UNKNOWN;
-                    break;
-            }
+            hn4_result_t decomp_res = _decode_payload(vol, (const hn4_block_header_t*)io_buf,
+                                                      out_buffer, buffer_len);
 
             if (HN4_LIKELY(HN4_IS_OK(decomp_res))) {
                 winner_idx = i;
                 deep_error = decomp_res;
-     
-                int pf_mode = 0;
-                
-                if ((vol->sb.info.hw_caps_flags & HN4_HW_ROTATIONAL) || (dev_type == HN4_DEV_HDD)) {
-                    pf_mode = 2; /* HDD Priority */
-                } else if (profile == HN4_PROFILE_GAMING || profile == HN4_PROFILE_HYPER_CLOUD) {
-                    pf_mode = 1; /* SSD Streaming */
-                }
-
-                 uint32_t pf_len_sectors = 0;
-
-                switch (pf_mode) {
-                    case 2: /* HDD: Adaptive Lookahead via LUT */
-                    {
-                        uint32_t shift = vol->block_shift;
-                        if (shift > 31) shift = 31;
-                        
-                        if (sectors > 0) {
-                            pf_len_sectors = _hdd_prefetch_lut[shift] * sectors;
-                        }
-                        break;
-                    }
-                    
-                    case 1: /* SSD Streaming: Simple N+1 Fetch */
-                        pf_len_sectors = sectors;
-                        break;
-
-                    default: 
-                        break;
-                }
-
-                if (pf_len_sectors > 0) {
-                    uint8_t next_k = 0;
-                    uint64_t next_cluster = (block_idx + 1) >> 4;
-
-                    if (next_cluster < 16) {
-                        uint32_t h = hn4_le32_to_cpu(anchor.orbit_hints);
-                        uint32_t shift = (uint32_t)(next_cluster * 2);
-                        next_k = (uint8_t)((h >> shift) & 0x3u);
-                    }
-
-                    uint64_t next_lba = _calc_trajectory_lba(vol, G, V, block_idx + 1, M, next_k);
-                    
-                    if (next_lba != HN4_LBA_INVALID && next_lba < max_blocks) {
-                         #ifdef HN4_USE_128BIT
-                             hn4_u128_t blk_128 = hn4_u128_from_u64(next_lba);
-                             hn4_addr_t pf_phys = hn4_u128_mul_u64(blk_128, sectors);
-                             hn4_hal_prefetch(vol->target_device, pf_phys, pf_len_sectors);
-                         #else
-                             if (next_lba <= (UINT64_MAX / sectors)) {
-                                 hn4_addr_t pf_phys = hn4_lba_from_blocks(next_lba * sectors);
-                                 hn4_hal_prefetch(vol->target_device, pf_phys, pf_len_sectors);
-                             }
-                         #endif
-                    }
-                }
-            
                 break;
             } else {
                 failed_mask |= (1ULL << i);
@@ -774,38 +1103,37 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
         }
     }
 
-    /* 6. Auto-Medic */
-       if (HN4_UNLIKELY(HN4_IS_OK(deep_error) && failed_mask != 0 && allow_healing && winner_idx >= 0)) {
+    /* The writer's next overwrite of this block can eclipse it without a probe */
+    if (winner_idx >= 0) {
+        hn4_residency_note(vol, &anchor, block_idx, candidates[winner_idx]);
+    }
+
+    /*
+     * 6. Auto-Medic
+     * The good copy is in hand; the repair goes to the medic queue and the
+     * Scavenger writes it back in a batch. Readers never wait on a barrier.
+     */
+    if (HN4_UNLIKELY(HN4_IS_OK(deep_error) && (failed_mask != 0 || winner_healed) && allow_healing && winner_idx >= 0)) {
         
         if (vol->read_only) {
             HN4_LOG_WARN("READ_ATOMIC: Skipping Auto-Medic (RO).");
         } else {
+            for (int i = 0; i < valid_candidates; i++) {
+                /* A healed winner is rewritten with its own corrected data */
+                bool rewrite = (i == winner_idx) ? winner_healed : (failed_mask & (1U << i)) != 0;
 
-            void* repair_copy = hn4_hal_mem_alloc(bs);
-            
-            if (repair_copy) {
-                /* Snapshot the valid data */
-                memcpy(repair_copy, io_buf, bs);
-
-                for (int i = 0; i < valid_candidates; i++) {
-                    if (i == winner_idx) continue;
-
-                    if (failed_mask & (1U << i)) {
-                        hn4_result_t err = candidate_errors[i];
-                        /* Don't overwrite Skewed/Mismatch blocks - they might be valid history */
-                        if (err == HN4_ERR_GENERATION_SKEW || err == HN4_ERR_ID_MISMATCH) continue;
+                if (rewrite) {
+                    hn4_result_t err = candidate_errors[i];
+                    /* Don't overwrite Skewed/Mismatch blocks - they might be valid history */
+                    if (err == HN4_ERR_GENERATION_SKEW || err == HN4_ERR_ID_MISMATCH) continue;
 
-                        uint64_t   bad_lba_idx = candidates[i];
-                        hn4_addr_t bad_phys    = hn4_lba_from_blocks(bad_lba_idx * sectors);
+                    uint64_t   bad_lba_idx = candidates[i];
+                    hn4_addr_t bad_phys    = hn4_lba_from_blocks(bad_lba_idx * sectors);
 
-                        if (hn4_repair_block(vol, bad_phys, repair_copy, bs) != HN4_OK) {
-                            HN4_LOG_WARN("READ_ATOMIC: Auto-Medic failed for candidate %d", i);
-                        }
+                    if (hn4_repair_defer(vol, bad_phys, io_buf, bs) != HN4_OK) {
+                        HN4_LOG_WARN("READ_ATOMIC: Auto-Medic backlog refused candidate %d", i);
                     }
                 }
-                hn4_hal_mem_free(repair_copy);
-            } else {
-                HN4_LOG_WARN("READ_ATOMIC: OOM during Auto-Medic. Repair skipped.");
             }
         }
     }
@@ -814,9 +1142,430 @@ _Check_return_ HN4_NO_INLINE hn4_result_t hn4_read_block_atomic(
 
     if (winner_idx == -1)  return deep_error;
     
-    if (deep_error == HN4_OK && probe_error == HN4_INFO_HEALED) {
+    if (deep_error == HN4_OK && (probe_error == HN4_INFO_HEALED || winner_healed)) {
         return HN4_INFO_HEALED;
     }
 
     return deep_error;
-}
\ No newline at end of file
+}
+
+/* =========================================================================
+ * READAHEAD ENGINE
+ * =========================================================================
+ * Per-handle stride detector feeding a window of async trajectory reads.
+ * Each access at block N updates (stride, hits). Once the same stride is
+ * seen HN4_RA_TRIGGER times, blocks N+S .. N+W*S are resolved through
+ * the Anchor and submitted without waiting. When half the window has
+ * been consumed the next batch goes out and W doubles, up to the profile
+ * cap. Any stride change collapses W back to its opening size.
+ *
+ * Prefetched blocks are raw: identity, generation and CRC are checked
+ * when the block is consumed, against the Anchor as it is THEN. A rewrite
+ * in between bumps write_gen, so stale data is never returned; the caller
+ * just pays the synchronous path.
+ */
+
+/*
+ * Window ceiling per profile (blocks). Further clamped to HN4_RA_MAX_BYTES.
+ * PICO has no RAM to spend on a window.
+ */
+static const uint8_t _ra_window_cap_lut[8] = {
+    [HN4_PROFILE_GENERIC]     = 16,
+    [HN4_PROFILE_GAMING]      = 32,
+    [HN4_PROFILE_AI]          = 64,
+    [HN4_PROFILE_ARCHIVE]     = 32,
+    [HN4_PROFILE_PICO]        = 0,
+    [HN4_PROFILE_SYSTEM]      = 8,
+    [HN4_PROFILE_USB]         = 4,
+    [HN4_PROFILE_HYPER_CLOUD] = 32,
+};
+
+#define HN4_RA_MIN_WINDOW   4
+#define HN4_RA_TRIGGER      2       /* Stride confirmations before going async */
+#define HN4_RA_MAX_STRIDE   64      /* Wider gaps are treated as random access */
+#define HN4_RA_SLOTS        (HN4_RA_MAX_WINDOW * 2)
+#define HN4_RA_WAIT_NS      (2000ULL * 1000ULL * 1000ULL)
+
+#define RA_SLOT_EMPTY       0
+#define RA_SLOT_INFLIGHT    1
+#define RA_SLOT_READY       2
+#define RA_SLOT_FAILED      3
+
+typedef struct {
+    hn4_io_req_t        req;
+    void*               buf;        /* Raw block (header + payload) */
+    uint64_t            block_idx;
+    uint32_t            batch;      /* Submission epoch, see _ra_wait */
+    _Atomic uint32_t    state;
+} _ra_slot_t;
+
+struct hn4_readahead {
+    hn4_volume_t*       vol;
+    atomic_flag         busy;       /* Shared handle: losers bypass the window */
+    uint32_t            sectors;    /* Device sectors per block */
+    uint32_t            window_init;
+    uint32_t            window_cap;
+    uint32_t            window;
+    bool                streaming;  /* A batch is out for the current stride */
+
+    /* Stream identity. File switch or rewrite restarts detection */
+    bool                primed;
+    hn4_u128_t          stream_id;
+    uint32_t            stream_gen;
+
+    /* Stride detector */
+    uint64_t            last_block;
+    uint64_t            stride;
+    uint32_t            hits;
+    uint64_t            next_block; /* First block not yet submitted */
+
+    uint32_t            batch;
+    uint32_t            reaped;
+
+    hn4_readahead_stats_t stats;
+    _ra_slot_t          slots[HN4_RA_SLOTS];
+};
+
+static void _ra_io_done(hn4_io_req_t* req, hn4_result_t result)
+{
+    _ra_slot_t* slot = (_ra_slot_t*)req->user_ctx;
+    atomic_store_explicit(&slot->state,
+                          (result == HN4_OK) ? RA_SLOT_READY : RA_SLOT_FAILED,
+                          memory_order_release);
+}
+
+hn4_readahead_t* hn4_readahead_create(hn4_volume_t* vol)
+{
+    if (HN4_UNLIKELY(!vol || !vol->target_device)) return NULL;
+
+    uint32_t profile = vol->sb.info.format_profile & 7;
+    uint32_t cap     = _ra_window_cap_lut[profile];
+    if (cap == 0) return NULL;
+
+    /* Cloud arrays: the spatial router owns placement, keep reads synchronous */
+    if (_routed_volume(vol)) return NULL;
+
+    uint32_t bs = vol->vol_block_size;
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+
+    if (!caps || bs == 0 || caps->logical_block_size == 0 || (bs % caps->logical_block_size) != 0) {
+        return NULL;
+    }
+
+    if (cap > HN4_RA_MAX_BYTES / bs) cap = HN4_RA_MAX_BYTES / bs;
+    if (cap < 2) return NULL;
+
+    /* Rotational media opens with the LUT lookahead so one seek covers ~128KB */
+    uint32_t init = HN4_RA_MIN_WINDOW;
+    if (_hw_index(vol) != 0) {
+        uint32_t shift = (vol->block_shift > 31) ? 31 : vol->block_shift;
+        if (_hdd_prefetch_lut[shift] > init) init = _hdd_prefetch_lut[shift];
+    }
+    if (init > cap) init = cap;
+
+    hn4_readahead_t* ra = hn4_hal_mem_alloc(sizeof(hn4_readahead_t));
+    if (!ra) return NULL;
+
+    ra->vol         = vol;
+    ra->sectors     = bs / caps->logical_block_size;
+    ra->window_init = init;
+    ra->window_cap  = cap;
+    ra->window      = init;
+    atomic_flag_clear(&ra->busy);
+
+    return ra;
+}
+
+void hn4_readahead_destroy(hn4_readahead_t* ra)
+{
+    if (!ra) return;
+
+    hn4_hal_device_t* dev   = ra->vol->target_device;
+    hn4_time_t        start = hn4_hal_get_time_ns();
+
+    for (uint32_t i = 0; i < HN4_RA_SLOTS; i++) {
+        while (atomic_load_explicit(&ra->slots[i].state, memory_order_acquire) == RA_SLOT_INFLIGHT) {
+            if ((hn4_hal_get_time_ns() - start) > (hn4_time_t)HN4_RA_WAIT_NS) {
+                HN4_LOG_CRIT("Readahead: window read stuck in flight. Leaking context.");
+                return;
+            }
+            hn4_hal_poll(dev);
+        }
+    }
+
+    for (uint32_t i = 0; i < HN4_RA_SLOTS; i++) hn4_hal_mem_free(ra->slots[i].buf);
+    hn4_hal_mem_free(ra);
+}
+
+void hn4_readahead_get_stats(const hn4_readahead_t* ra, hn4_readahead_stats_t* out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!ra) return;
+
+    *out = ra->stats;
+    out->stride     = ra->stride;
+    out->window     = ra->window;
+    out->window_cap = ra->window_cap;
+}
+
+static void _ra_reset(hn4_readahead_t* ra)
+{
+    ra->primed     = false;
+    ra->stride     = 0;
+    ra->hits       = 0;
+    ra->next_block = 0;
+    ra->window     = ra->window_init;
+    ra->streaming  = false;
+
+    /* Drop settled blocks of the previous stream. In-flight ones drain on their own */
+    for (uint32_t i = 0; i < HN4_RA_SLOTS; i++) {
+        uint32_t st = atomic_load_explicit(&ra->slots[i].state, memory_order_acquire);
+        if (st != RA_SLOT_INFLIGHT) {
+            atomic_store_explicit(&ra->slots[i].state, RA_SLOT_EMPTY, memory_order_relaxed);
+        }
+    }
+}
+
+static void _ra_observe(hn4_readahead_t* ra, uint64_t block_idx)
+{
+    /* Sub-block reads of the block we are already on */
+    if (ra->primed && block_idx == ra->last_block) return;
+
+    uint64_t delta = (ra->primed && block_idx > ra->last_block) ? (block_idx - ra->last_block) : 0;
+
+    if (delta != 0 && delta == ra->stride) {
+        if (ra->hits < UINT32_MAX) ra->hits++;
+    } else {
+        /* Backwards, random or new stride: detection restarts, window collapses */
+        ra->stride     = (delta <= HN4_RA_MAX_STRIDE) ? delta : 0;
+        ra->hits       = (ra->stride != 0) ? 1 : 0;
+        ra->next_block = 0;
+        ra->window     = ra->window_init;
+        ra->streaming  = false;
+    }
+
+    ra->last_block = block_idx;
+    ra->primed     = true;
+}
+
+static _ra_slot_t* _ra_find(hn4_readahead_t* ra, uint64_t block_idx)
+{
+    for (uint32_t i = 0; i < HN4_RA_SLOTS; i++) {
+        _ra_slot_t* s = &ra->slots[i];
+        if (atomic_load_explicit(&s->state, memory_order_acquire) != RA_SLOT_EMPTY &&
+            s->block_idx == block_idx) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+/* A settled slot is reusable unless it holds the current or a pending window block */
+static _ra_slot_t* _ra_get_free(hn4_readahead_t* ra, uint64_t cur)
+{
+    for (uint32_t i = 0; i < HN4_RA_SLOTS; i++) {
+        _ra_slot_t* s  = &ra->slots[i];
+        uint32_t    st = atomic_load_explicit(&s->state, memory_order_acquire);
+
+        if (st == RA_SLOT_INFLIGHT) continue;
+        if (st == RA_SLOT_EMPTY) return s;
+        if (s->block_idx == cur) continue;
+        if (s->block_idx > cur && s->block_idx < ra->next_block) continue;
+        return s;
+    }
+    return NULL;
+}
+
+/*
+ * Primary LBA for 'block_idx', or HN4_LBA_INVALID for holes and
+ * out-of-range targets (those are left to the synchronous path).
+ */
+static uint64_t _ra_resolve(hn4_volume_t* vol, const hn4_anchor_t* anchor, uint64_t block_idx)
+{
+    uint64_t max_blocks = vol->vol_capacity_bytes / vol->vol_block_size;
+    uint64_t G          = hn4_le64_to_cpu(anchor->gravity_center);
+    uint16_t M          = hn4_le16_to_cpu(anchor->fractal_scale);
+    uint64_t lba        = HN4_LBA_INVALID;
+
+    if (hn4_le64_to_cpu(anchor->data_class) & HN4_HINT_HORIZON) {
+        uint16_t safe_M = (M > 32) ? 32 : M;
+        uint64_t stride = (1ULL << safe_M);
+
+        if (block_idx < (UINT64_MAX / stride) && (UINT64_MAX - G) >= block_idx * stride) {
+            lba = G + block_idx * stride;
+        }
+    } else {
+        int k = _recorded_orbit(vol, anchor, block_idx);
+        lba = _orbit_lba_for_block(vol, G, _anchor_orbit_vector(anchor), M,
+                                   (k > 0) ? (uint8_t)k : 0, block_idx);
+    }
+
+    if (lba == HN4_LBA_INVALID || lba >= max_blocks) return HN4_LBA_INVALID;
+
+    /* RO mount without a bitmap: let validation decide, as the sync path does */
+    if (vol->read_only && !vol->void_bitmap) return lba;
+
+    bool allocated = false;
+    if (_bitmap_op(vol, lba, BIT_TEST, &allocated) != HN4_OK || !allocated) return HN4_LBA_INVALID;
+
+    return lba;
+}
+
+static void _ra_issue(hn4_readahead_t* ra, const hn4_anchor_t* anchor, uint64_t cur)
+{
+    hn4_volume_t* vol = ra->vol;
+    uint64_t      ahead;
+
+    if (ra->next_block <= cur) {
+        ra->next_block = cur + ra->stride;
+        ahead = 0;
+    } else {
+        ahead = (ra->next_block - cur) / ra->stride - 1;
+    }
+
+    /* Low-water mark: refill once half of the window has been consumed */
+    if (ahead > ra->window / 2) return;
+
+    if (ra->streaming) {
+        ra->window = (ra->window * 2 > ra->window_cap) ? ra->window_cap : ra->window * 2;
+    }
+    ra->streaming = true;
+
+    uint32_t want = ra->window - (uint32_t)ahead;
+    bool     opened = false;
+
+    for (uint32_t n = 0; n < want; n++) {
+        uint64_t b = ra->next_block;
+        if (b > UINT64_MAX - ra->stride) break;
+
+        uint64_t lba = _ra_resolve(vol, anchor, b);
+
+        if (lba != HN4_LBA_INVALID && !_ra_find(ra, b)) {
+            if (lba > (UINT64_MAX / ra->sectors)) break;
+
+            _ra_slot_t* slot = _ra_get_free(ra, cur);
+            if (!slot) break;
+
+            if (!slot->buf) {
+                slot->buf = hn4_hal_mem_alloc(vol->vol_block_size);
+                if (!slot->buf) break;
+            }
+
+            if (!opened) {
+                ra->batch++;
+                opened = true;
+            }
+
+            memset(&slot->req, 0, sizeof(hn4_io_req_t));
+            slot->block_idx    = b;
+            slot->batch        = ra->batch;
+            slot->req.op_code  = HN4_IO_READ;
+            slot->req.lba      = hn4_lba_from_blocks(lba * ra->sectors);
+            slot->req.buffer   = slot->buf;
+            slot->req.length   = ra->sectors;
+            slot->req.user_ctx = slot;
+
+            atomic_store_explicit(&slot->state, RA_SLOT_INFLIGHT, memory_order_release);
+            ra->stats.issued++;
+
+            hn4_hal_submit_io(vol->target_device, &slot->req, _ra_io_done);
+        }
+
+        ra->next_block = b + ra->stride;
+    }
+}
+
+/*
+ * Block until 'slot' settles. The first consumer of a batch polls once;
+ * that reaps every command of the batch (they were queued together).
+ */
+static bool _ra_wait(hn4_readahead_t* ra, _ra_slot_t* slot)
+{
+    hn4_hal_device_t* dev = ra->vol->target_device;
+
+    if ((int32_t)(slot->batch - ra->reaped) > 0) {
+        hn4_hal_poll(dev);
+        ra->reaped = ra->batch;
+    }
+
+    if (atomic_load_explicit(&slot->state, memory_order_acquire) != RA_SLOT_INFLIGHT) return true;
+
+    hn4_time_t start = hn4_hal_get_time_ns();
+
+    while (atomic_load_explicit(&slot->state, memory_order_acquire) == RA_SLOT_INFLIGHT) {
+        if ((hn4_hal_get_time_ns() - start) > (hn4_time_t)HN4_RA_WAIT_NS) return false;
+        hn4_hal_poll(dev);
+    }
+    return true;
+}
+
+_Check_return_ hn4_result_t hn4_read_block_ra(
+    HN4_IN  hn4_readahead_t* ra,
+    HN4_IN  hn4_volume_t*    vol,
+    HN4_IN  hn4_anchor_t*    anchor_ptr,
+    HN4_IN  uint64_t         block_idx,
+    HN4_OUT void*            out_buffer,
+    HN4_IN  uint32_t         buffer_len,
+    HN4_IN  uint32_t         session_perms
+)
+{
+    if (!ra || ra->vol != vol || !anchor_ptr || !out_buffer) {
+        return hn4_read_block_atomic(vol, anchor_ptr, block_idx, out_buffer, buffer_len, session_perms);
+    }
+
+    /* Concurrent reader on the same handle: do not serialize, just skip the window */
+    if (atomic_flag_test_and_set_explicit(&ra->busy, memory_order_acquire)) {
+        return hn4_read_block_atomic(vol, anchor_ptr, block_idx, out_buffer, buffer_len, session_perms);
+    }
+
+    hn4_anchor_t anchor;
+    _snapshot_anchor(vol, anchor_ptr, &anchor);
+
+    hn4_u128_t well_id    = hn4_le128_to_cpu(anchor.seed_id);
+    uint32_t   anchor_gen = hn4_le32_to_cpu(anchor.write_gen);
+    uint64_t   dclass     = hn4_le64_to_cpu(anchor.data_class);
+    uint32_t   perms      = hn4_le32_to_cpu(anchor.permissions) | session_perms;
+    uint32_t   bs         = vol->vol_block_size;
+
+    if (!ra->primed || ra->stream_gen != anchor_gen ||
+        ra->stream_id.lo != well_id.lo || ra->stream_id.hi != well_id.hi) {
+        _ra_reset(ra);
+        ra->stream_id  = well_id;
+        ra->stream_gen = anchor_gen;
+    }
+
+    _ra_observe(ra, block_idx);
+
+    hn4_result_t res    = HN4_ERR_NOT_FOUND;
+    bool         served = false;
+    _ra_slot_t*  slot   = _ra_find(ra, block_idx);
+
+    if (slot && (perms & (HN4_PERM_READ | HN4_PERM_SOVEREIGN)) &&
+        buffer_len >= HN4_BLOCK_PayloadSize(bs) && _ra_wait(ra, slot)) {
+
+        if (atomic_load_explicit(&slot->state, memory_order_acquire) == RA_SLOT_READY &&
+            _validate_block(vol, slot->buf, bs, well_id, block_idx, anchor_gen, dclass,
+                            hn4_read_get_integrity(vol)) == HN4_OK) {
+            res    = _decode_payload(vol, (const hn4_block_header_t*)slot->buf, out_buffer, buffer_len);
+            served = HN4_IS_OK(res);
+        }
+
+        /* Kept READY on success so sub-block reads of this block stay in RAM */
+        if (!served) atomic_store_explicit(&slot->state, RA_SLOT_EMPTY, memory_order_relaxed);
+    }
+
+    if (served) {
+        ra->stats.hits++;
+    } else {
+        ra->stats.misses++;
+        res = hn4_read_block_atomic(vol, anchor_ptr, block_idx, out_buffer, buffer_len, session_perms);
+    }
+
+    if (HN4_IS_OK(res) && ra->stride != 0 && ra->hits >= HN4_RA_TRIGGER) {
+        _ra_issue(ra, &anchor, block_idx);
+    }
+
+    atomic_flag_clear_explicit(&ra->busy, memory_order_release);
+    return res;
+}
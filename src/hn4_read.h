@@ -0,0 +1,96 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Ballistic Read Pipeline
+ * HEADER:      hn4_read.h
+ * STATUS:      HARDENED / PRODUCTION (v26.3)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Per-handle streaming state for hn4_read_block_atomic(). Detects
+ * sequential and strided block access, then keeps a geometrically growing
+ * window of trajectory-resolved reads in flight so streaming consumers
+ * (POSIX read, tensor read) are not bound to queue depth 1.
+ *
+ * Also selects how much of each block the read path verifies.
+ */
+
+#ifndef HN4_READ_H
+#define HN4_READ_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HN4_RA_MAX_WINDOW       64          /* Hard ceiling, in blocks */
+#define HN4_RA_MAX_BYTES        (8U << 20)  /* Per-handle buffer budget */
+
+typedef struct hn4_readahead hn4_readahead_t;
+
+typedef struct {
+    uint64_t    hits;           /* Blocks served from the window */
+    uint64_t    misses;         /* Blocks read synchronously */
+    uint64_t    issued;         /* Async reads submitted */
+    uint64_t    stride;         /* Detected stride in blocks (0 = none) */
+    uint32_t    window;         /* Current window, in blocks */
+    uint32_t    window_cap;     /* Profile-dependent ceiling */
+} hn4_readahead_stats_t;
+
+/**
+ * hn4_readahead_create
+ * Allocates readahead state for one handle. Returns NULL when the volume
+ * profile disables readahead (PICO), the volume is a Cloud array (the
+ * spatial router owns placement) or on OOM. Callers treat NULL as
+ * "read synchronously".
+ */
+hn4_readahead_t* hn4_readahead_create(hn4_volume_t* vol);
+
+/**
+ * hn4_readahead_destroy
+ * Waits for in-flight window reads and frees the state. NULL is a no-op.
+ */
+void hn4_readahead_destroy(hn4_readahead_t* ra);
+
+/**
+ * hn4_read_block_ra
+ * hn4_read_block_atomic() with readahead. Same contract and return codes.
+ * A prefetched block is re-validated against the Anchor at consumption
+ * time; any mismatch falls back to the synchronous path. 'ra' may be NULL.
+ */
+_Check_return_
+hn4_result_t hn4_read_block_ra(
+    HN4_IN  hn4_readahead_t* ra,
+    HN4_IN  hn4_volume_t*    vol,
+    HN4_IN  hn4_anchor_t*    anchor_ptr,
+    HN4_IN  uint64_t         block_idx,
+    HN4_OUT void*            out_buffer,
+    HN4_IN  uint32_t         buffer_len,
+    HN4_IN  uint32_t         session_perms
+);
+
+void hn4_readahead_get_stats(const hn4_readahead_t* ra, hn4_readahead_stats_t* out);
+
+/**
+ * hn4_read_set_integrity
+ * Selects the read verification tier (HN4_INTEGRITY_*). TRUST degrades to
+ * HEADER unless the device is NVM with HN4_HW_MEDIA_ECC; any relaxed tier
+ * degrades to FULL on a tainted volume. Relaxed tiers are promoted back to
+ * FULL for the rest of the mount as soon as a health counter moves (CRC
+ * failure, taint, toxic block, heal). Returns the tier now in force.
+ */
+uint32_t hn4_read_set_integrity(hn4_volume_t* vol, uint32_t level);
+
+/**
+ * hn4_read_get_integrity
+ * Tier in force for the next read (applies pending promotion).
+ */
+uint32_t hn4_read_get_integrity(hn4_volume_t* vol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_READ_H */
@@ -9,6 +9,7 @@
  *   1. DMA GHOST DEFENSE: Verify buffers are poisoned (0xDD) before read.
  *   2. LATTICE MONOTONICITY: Health state only degrades. Toxic is sticky.
  *   3. BARRIER-FIRST: Flush to NAND before verifying data.
+ *   4. OFF THE READ PATH: Readers queue repairs, the Scavenger batches them.
  */
 
 #include "hn4.h"
@@ -16,6 +17,10 @@
 #include "hn4_errors.h"
 #include "hn4_annotations.h"
 #include "hn4_addr.h"
+#include "hn4_repair.h"
+#include "hn4_allocator.h"
+#include "hn4_crc.h"
+#include "hn4_endians.h"
 #include <string.h>
 #include <stdatomic.h>
 
@@ -65,87 +70,53 @@ HN4_INLINE int _map_repair_outcome(hn4_result_t res) {
  * CORE REPAIR LOGIC
  * ========================================================================= */
 
-_Check_return_ hn4_result_t hn4_repair_block(
-    HN4_IN hn4_volume_t* vol,
-    HN4_IN hn4_addr_t    bad_lba,
-    HN4_IN const void*   good_data,
-    HN4_IN uint32_t      len
+/*
+ * Read-back, quality mask and telemetry for a write that has already gone
+ * through the barrier. 'res' is the outcome of that write + barrier.
+ */
+static hn4_result_t _repair_settle(
+    hn4_volume_t* vol,
+    hn4_addr_t    bad_lba,
+    const void*   good_data,
+    uint32_t      len,
+    hn4_result_t  res
 )
 {
-    /* 1. Pre-flight Validation */
-    if (!vol || !good_data) return HN4_ERR_INVALID_ARGUMENT;
-    if (len == 0) return HN4_OK;
-
-    if (vol->read_only) {
-        return HN4_ERR_ACCESS_DENIED;
-    }
-
     const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
-    uint32_t ss = caps->logical_block_size;
-
-    /*
-     * ALIGNMENT SAFETY:
-     * We cannot safely repair partial sectors without RMW, which is dangerous
-     * on already corrupted media. Require strict sector padding.
-     */
-    if (len % ss != 0) {
-        return HN4_ERR_ALIGNMENT_FAIL;
-    }
-
+    uint32_t ss      = caps->logical_block_size;
     uint32_t sectors = len / ss;
-    hn4_result_t res;
 
-    /*
-     * 2. ATTEMPT OVERWRITE (The Scrub)
-     * We write the good data to the bad location.
-     */
-    res = hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, bad_lba, (void*)good_data, sectors);
-
-    /*
-     * 3. THE WALL (Barrier & Verify)
-     * Only verify if the write appeared to succeed.
-     */
-   if (res == HN4_OK) {
-        /*
-         * BARRIER ENFORCEMENT:
-         * Force electrons into the floating gates.
-         * OPTIMIZATION: Skip if NVM (Byte-addressable persistence).
-         */
-        if (!(vol->sb.info.hw_caps_flags & HN4_HW_NVM)) {
-            res = hn4_hal_barrier(vol->target_device);
-        }
+    /* 3b. VERIFY (Only if the write + barrier appeared to succeed) */
+    if (res == HN4_OK) {
+        void* verify_buf = hn4_hal_mem_alloc(len);
 
-        if (res == HN4_OK) {
-            void* verify_buf = hn4_hal_mem_alloc(len);
-
-            if (verify_buf) {
-                /*
-                 * DMA GHOST DEFENSE:
-                 * Poison the buffer with 0xDD. If the controller "lies" and says
-                 * READ_SUCCESS without actually transferring data (DMA Stall),
-                 * our memory will still hold 0xDD, causing memcmp to fail.
-                 */
-                memset(verify_buf, HN4_DMA_POISON_BYTE, len);
-
-                /* Read back from media */
-                res = hn4_hal_sync_io(vol->target_device, HN4_IO_READ, bad_lba, verify_buf, sectors);
-
-                if (res == HN4_OK) {
-                    /* BITWISE IDENTITY CHECK */
-                    if (memcmp(good_data, verify_buf, len) != 0) {
-                        /*
-                         * ZOMBIE BLOCK DETECTED:
-                         * The drive said Write OK, Barrier OK, Read OK...
-                         * but the data is wrong. The silicon is lying.
-                         */
-                        res = HN4_ERR_DATA_ROT;
-                    }
+        if (verify_buf) {
+            /*
+             * DMA GHOST DEFENSE:
+             * Poison the buffer with 0xDD. If the controller "lies" and says
+             * READ_SUCCESS without actually transferring data (DMA Stall),
+             * our memory will still hold 0xDD, causing memcmp to fail.
+             */
+            memset(verify_buf, HN4_DMA_POISON_BYTE, len);
+
+            /* Read back from media */
+            res = hn4_hal_sync_io(vol->target_device, HN4_IO_READ, bad_lba, verify_buf, sectors);
+
+            if (res == HN4_OK) {
+                /* BITWISE IDENTITY CHECK */
+                if (memcmp(good_data, verify_buf, len) != 0) {
+                    /*
+                     * ZOMBIE BLOCK DETECTED:
+                     * The drive said Write OK, Barrier OK, Read OK...
+                     * but the data is wrong. The silicon is lying.
+                     */
+                    res = HN4_ERR_DATA_ROT;
                 }
-                hn4_hal_mem_free(verify_buf);
-            } else {
-                /* If we can't verify, we can't certify the repair. */
-                res = HN4_ERR_NOMEM;
             }
+            hn4_hal_mem_free(verify_buf);
+        } else {
+            /* If we can't verify, we can't certify the repair. */
+            res = HN4_ERR_NOMEM;
         }
     }
 
@@ -263,3 +234,259 @@ _Check_return_ hn4_result_t hn4_repair_block(
         return HN4_ERR_MEDIA_TOXIC;
     }
 }
+
+_Check_return_ hn4_result_t hn4_repair_block(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN hn4_addr_t    bad_lba,
+    HN4_IN const void*   good_data,
+    HN4_IN uint32_t      len
+)
+{
+    /* 1. Pre-flight Validation */
+    if (!vol || !good_data) return HN4_ERR_INVALID_ARGUMENT;
+    if (len == 0) return HN4_OK;
+
+    if (vol->read_only) {
+        return HN4_ERR_ACCESS_DENIED;
+    }
+
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    uint32_t ss = caps->logical_block_size;
+
+    /*
+     * ALIGNMENT SAFETY:
+     * We cannot safely repair partial sectors without RMW, which is dangerous
+     * on already corrupted media. Require strict sector padding.
+     */
+    if (len % ss != 0) {
+        return HN4_ERR_ALIGNMENT_FAIL;
+    }
+
+    uint32_t sectors = len / ss;
+    hn4_result_t res;
+
+    /*
+     * 2. ATTEMPT OVERWRITE (The Scrub)
+     * We write the good data to the bad location.
+     */
+    res = hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, bad_lba, (void*)good_data, sectors);
+
+    /*
+     * 3. THE WALL (Barrier & Verify)
+     * BARRIER ENFORCEMENT:
+     * Force electrons into the floating gates.
+     * OPTIMIZATION: Skip if NVM (Byte-addressable persistence).
+     */
+    if (res == HN4_OK && !(vol->sb.info.hw_caps_flags & HN4_HW_NVM)) {
+        res = hn4_hal_barrier(vol->target_device);
+    }
+
+    return _repair_settle(vol, bad_lba, good_data, len, res);
+}
+
+/* =========================================================================
+ * DEFERRED REPAIR (MEDIC BACKLOG)
+ * =========================================================================
+ * Readers do not heal inline. A repair is parked in the medic queue with
+ * a copy of the good block and the Scavenger drains the backlog as one
+ * batch: all writes, one barrier, then the read-back verify per block.
+ *
+ * The target may have changed hands before the batch runs (freed,
+ * reallocated, rewritten). A repair is only applied while the slot is
+ * still allocated and still holds the same block (well_id + generation)
+ * or a header that fails its own CRC.
+ *
+ * That check is only good while the block cannot be freed. The drain
+ * claims every block of its batch before checking it, and hn4_free_block
+ * goes through hn4_repair_fence: a free drops queued repairs of the block
+ * and waits out a batch that holds it. A block therefore never changes
+ * hands between its check, its write and its verify.
+ */
+
+hn4_result_t hn4_repair_defer(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN hn4_addr_t    bad_lba,
+    HN4_IN const void*   good_data,
+    HN4_IN uint32_t      len
+)
+{
+    if (!vol || !good_data) return HN4_ERR_INVALID_ARGUMENT;
+    if (len == 0) return HN4_OK;
+    if (vol->read_only) return HN4_ERR_ACCESS_DENIED;
+
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    if (len % caps->logical_block_size != 0) return HN4_ERR_ALIGNMENT_FAIL;
+
+    void* copy = hn4_hal_mem_alloc(len);
+    if (!copy) return HN4_ERR_NOMEM;
+    memcpy(copy, good_data, len);
+
+    hn4_medic_queue_t* q     = &vol->medic_queue;
+    void*              stale = copy;
+    hn4_result_t       res   = HN4_ERR_BUSY;
+
+    hn4_hal_ticket_lock_acquire(&q->lock);
+
+    for (uint32_t i = 0; i < q->repair_count; i++) {
+        if (hn4_addr_to_u64(q->repairs[i].bad_lba) == hn4_addr_to_u64(bad_lba)) {
+            /* Same slot reported twice: keep the newer copy */
+            stale = q->repairs[i].payload;
+            q->repairs[i].payload = copy;
+            q->repairs[i].len     = len;
+            res = HN4_OK;
+            break;
+        }
+    }
+
+    if (res != HN4_OK && q->repair_count < HN4_MEDIC_REPAIR_SLOTS) {
+        hn4_medic_repair_t* r = &q->repairs[q->repair_count++];
+        r->bad_lba = bad_lba;
+        r->payload = copy;
+        r->len     = len;
+        stale = NULL;
+        res   = HN4_OK;
+    }
+
+    hn4_hal_ticket_lock_release(&q->lock);
+
+    if (stale) hn4_hal_mem_free(stale);
+    return res;
+}
+
+/* Is the queued target still the block that was found sick? */
+static bool _repair_target_unchanged(
+    hn4_volume_t*             vol,
+    const hn4_medic_repair_t* r,
+    void*                     probe,
+    uint32_t                  ss
+)
+{
+    uint32_t spb = vol->vol_block_size / ss;
+
+    if (spb > 0 && vol->void_bitmap) {
+        bool is_set = false;
+        if (_bitmap_op(vol, hn4_addr_to_u64(r->bad_lba) / spb, BIT_TEST, &is_set) != HN4_OK || !is_set) {
+            return false;
+        }
+    }
+
+    /* Unreadable is still sick */
+    if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, r->bad_lba, probe, 1) != HN4_OK) return true;
+
+    const hn4_block_header_t* cur  = (const hn4_block_header_t*)probe;
+    const hn4_block_header_t* good = (const hn4_block_header_t*)r->payload;
+
+    uint32_t hcrc = hn4_crc32(HN4_CRC_SEED_HEADER, cur, offsetof(hn4_block_header_t, header_crc));
+    if (hcrc != hn4_le32_to_cpu(cur->header_crc)) return true;
+
+    return memcmp(&cur->well_id, &good->well_id, sizeof(cur->well_id)) == 0 &&
+           cur->generation == good->generation;
+}
+
+uint32_t hn4_repair_drain(HN4_IN hn4_volume_t* vol)
+{
+    if (!vol) return 0;
+
+    hn4_medic_queue_t* q = &vol->medic_queue;
+    hn4_medic_repair_t batch[HN4_MEDIC_REPAIR_SLOTS];
+    uint32_t           n;
+
+    const hn4_hal_caps_t* caps  = hn4_hal_get_caps(vol->target_device);
+    uint32_t              ss    = caps->logical_block_size;
+    uint32_t              spb   = (vol->vol_block_size / ss) ? (vol->vol_block_size / ss) : 1;
+
+    /* Taking the batch and claiming its blocks is one step for hn4_repair_fence */
+    hn4_hal_ticket_lock_acquire(&q->lock);
+    n = q->repair_count;
+    memcpy(batch, q->repairs, n * sizeof(batch[0]));
+    for (uint32_t i = 0; i < n; i++) q->claimed[i] = hn4_addr_to_u64(batch[i].bad_lba) / spb;
+    q->claim_count  = n;
+    q->repair_count = 0;
+    hn4_hal_ticket_lock_release(&q->lock);
+
+    if (n == 0) return 0;
+
+    void*                 probe = vol->read_only ? NULL : hn4_hal_mem_alloc(ss);
+
+    hn4_result_t res[HN4_MEDIC_REPAIR_SLOTS];
+    bool         applied[HN4_MEDIC_REPAIR_SLOTS] = {0};
+    bool         written = false;
+    uint32_t     healed  = 0;
+
+    /* 1. Writes (no barrier between them) */
+    for (uint32_t i = 0; i < n && probe; i++) {
+        if (!_repair_target_unchanged(vol, &batch[i], probe, ss)) {
+            HN4_LOG_WARN("Auto-Medic: LBA %llu changed hands. Repair dropped.",
+                         (unsigned long long)hn4_addr_to_u64(batch[i].bad_lba));
+            continue;
+        }
+
+        res[i] = hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, batch[i].bad_lba,
+                                 batch[i].payload, batch[i].len / ss);
+        applied[i] = true;
+        if (res[i] == HN4_OK) written = true;
+    }
+
+    /* 2. One barrier for the whole batch */
+    if (written && !(vol->sb.info.hw_caps_flags & HN4_HW_NVM)) {
+        hn4_result_t bres = hn4_hal_barrier(vol->target_device);
+        if (bres != HN4_OK) {
+            for (uint32_t i = 0; i < n; i++) {
+                if (applied[i] && res[i] == HN4_OK) res[i] = bres;
+            }
+        }
+    }
+
+    /* 3. Verify + Quality Mask per block */
+    for (uint32_t i = 0; i < n; i++) {
+        if (applied[i] &&
+            _repair_settle(vol, batch[i].bad_lba, batch[i].payload, batch[i].len, res[i]) == HN4_OK) {
+            healed++;
+        }
+        hn4_hal_mem_free(batch[i].payload);
+    }
+
+    hn4_hal_ticket_lock_acquire(&q->lock);
+    q->claim_count = 0;
+    hn4_hal_ticket_lock_release(&q->lock);
+
+    if (probe) hn4_hal_mem_free(probe);
+    return healed;
+}
+
+void hn4_repair_fence(HN4_IN hn4_volume_t* vol, HN4_IN uint64_t block_idx)
+{
+    hn4_medic_queue_t* q = &vol->medic_queue;
+
+    /* Common case: no backlog, no batch in flight */
+    if (atomic_load(&q->repair_count) == 0 && atomic_load(&q->claim_count) == 0) return;
+
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    uint32_t ss  = caps ? caps->logical_block_size : 512;
+    uint32_t spb = (vol->vol_block_size / ss) ? (vol->vol_block_size / ss) : 1;
+
+    for (;;) {
+        bool claimed = false;
+
+        hn4_hal_ticket_lock_acquire(&q->lock);
+
+        for (uint32_t i = 0; i < q->repair_count; ) {
+            if (hn4_addr_to_u64(q->repairs[i].bad_lba) / spb == block_idx) {
+                hn4_hal_mem_free(q->repairs[i].payload);
+                q->repairs[i] = q->repairs[--q->repair_count];
+            } else {
+                i++;
+            }
+        }
+
+        for (uint32_t i = 0; i < q->claim_count && !claimed; i++) {
+            claimed = (q->claimed[i] == block_idx);
+        }
+
+        hn4_hal_ticket_lock_release(&q->lock);
+
+        if (!claimed) return;
+
+        hn4_hal_micro_sleep(10);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Auto-Medic (Self-Healing Logic)
+ * HEADER:      hn4_repair.h
+ * STATUS:      HARDENED / PRODUCTION (v2.5)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Overwrites a corrupted replica with a verified good copy, verifies the
+ * write and records the outcome in the Quality Mask. Readers park repairs
+ * in the medic queue (hn4_repair_defer); the Scavenger applies them in
+ * batches (hn4_repair_drain).
+ */
+
+#ifndef HN4_REPAIR_H
+#define HN4_REPAIR_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * hn4_repair_block
+ * Synchronous repair: write, barrier, read-back verify, Quality Mask.
+ * 'len' must be a multiple of the sector size.
+ */
+_Check_return_
+hn4_result_t hn4_repair_block(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN hn4_addr_t    bad_lba,
+    HN4_IN const void*   good_data,
+    HN4_IN uint32_t      len
+);
+
+/**
+ * hn4_repair_defer
+ * Queues a repair of 'bad_lba' with a copy of 'good_data' and returns
+ * without I/O. A second request for the same LBA replaces the payload.
+ * HN4_ERR_BUSY when the backlog is full (the repair is dropped).
+ */
+hn4_result_t hn4_repair_defer(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN hn4_addr_t    bad_lba,
+    HN4_IN const void*   good_data,
+    HN4_IN uint32_t      len
+);
+
+/**
+ * hn4_repair_drain
+ * Applies the queued repairs as one batch under a single barrier.
+ * Repairs whose target changed hands since they were queued are dropped.
+ * On a read-only volume the backlog is discarded. Returns blocks healed.
+ */
+uint32_t hn4_repair_drain(HN4_IN hn4_volume_t* vol);
+
+/**
+ * hn4_repair_fence
+ * Called by hn4_free_block before 'block_idx' is released. Drops queued
+ * repairs of the block and waits while a drain batch holds it, so no
+ * repair lands on the block once it can change hands.
+ */
+void hn4_repair_fence(HN4_IN hn4_volume_t* vol, HN4_IN uint64_t block_idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_REPAIR_H */
@@ -0,0 +1,188 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Residency Cache (Block -> LBA Memo)
+ * SOURCE:      hn4_residency.c
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * ENGINEERING NOTES:
+ * 1. CACHE: Direct-mapped by (seed_id, block_idx), striped locks. A
+ *    collision evicts. A lost entry costs one verification read.
+ * 2. INVALIDATION: Nothing is ever invalidated explicitly. Every entry
+ *    carries the write_gen and a signature of the trajectory physics it
+ *    was recorded under; a rewrite, migration (new V) or Horizon switch
+ *    makes it miss on its own.
+ * 3. SAFETY: The LBA must still be claimed in the Void Bitmap. A block the
+ *    Reaper freed is never handed to the eclipse.
+ */
+
+#include "hn4_residency.h"
+#include "hn4_allocator.h"
+#include "hn4_hal.h"
+#include "hn4_endians.h"
+#include "hn4_constants.h"
+#include <string.h>
+#include <stdatomic.h>
+
+#define HN4_RES_SLOTS       4096
+#define HN4_RES_LOCKS       64
+
+typedef struct {
+    hn4_u128_t  seed_id;
+    uint64_t    block_idx;
+    uint64_t    lba;
+    uint64_t    phys_sig;   /* G / V / M / Horizon at record time */
+    uint32_t    gen;
+    bool        used;
+} _res_entry_t;
+
+struct hn4_residency_cache {
+    hn4_spinlock_t  locks[HN4_RES_LOCKS];
+    _res_entry_t    slots[HN4_RES_SLOTS];
+};
+
+/* =========================================================================
+ * INTERNAL HELPERS
+ * ========================================================================= */
+
+static struct hn4_residency_cache* _res_cache(hn4_volume_t* vol, bool create)
+{
+    struct hn4_residency_cache* c = atomic_load_explicit(&vol->residency_cache, memory_order_acquire);
+    if (c || !create) return c;
+
+    c = hn4_hal_mem_alloc(sizeof(struct hn4_residency_cache));
+    if (!c) return NULL;
+
+    memset(c->slots, 0, sizeof(c->slots));
+    for (int i = 0; i < HN4_RES_LOCKS; i++) hn4_hal_spinlock_init(&c->locks[i]);
+
+    struct hn4_residency_cache* expected = NULL;
+    if (!atomic_compare_exchange_strong(&vol->residency_cache, &expected, c)) {
+        hn4_hal_mem_free(c);
+        c = expected;
+    }
+    return c;
+}
+
+HN4_INLINE uint32_t _res_index(hn4_u128_t seed, uint64_t block_idx)
+{
+    uint64_t h = (seed.lo ^ seed.hi ^ (block_idx * 0x9E3779B97F4A7C15ULL)) * HN4_NS_HASH_CONST;
+    return (uint32_t)((h >> 32) % HN4_RES_SLOTS);
+}
+
+/* Everything that moves a block's trajectory without bumping write_gen */
+static uint64_t _res_phys_sig(const hn4_anchor_t* a)
+{
+    uint64_t V = 0;
+    memcpy(&V, a->orbit_vector, 6);
+
+    uint64_t sig = hn4_le64_to_cpu(a->gravity_center) * HN4_NS_HASH_CONST;
+    sig ^= hn4_le64_to_cpu(V) * 0x9E3779B97F4A7C15ULL;
+    sig ^= (uint64_t)hn4_le16_to_cpu(a->fractal_scale) << 1;
+    sig ^= (hn4_le64_to_cpu(a->data_class) & HN4_HINT_HORIZON) ? 1 : 0;
+    return sig;
+}
+
+/* =========================================================================
+ * PUBLIC API
+ * ========================================================================= */
+
+void hn4_residency_note(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx,
+    HN4_IN uint64_t            lba
+)
+{
+    if (!vol || !anchor || lba == HN4_LBA_INVALID) return;
+
+    /* 230KB of table is not worth it on embedded profiles */
+    if (vol->sb.info.format_profile == HN4_PROFILE_PICO) return;
+
+    struct hn4_residency_cache* c = _res_cache(vol, true);
+    if (!c) return;
+
+    hn4_u128_t seed = hn4_le128_to_cpu(anchor->seed_id);
+    uint32_t   idx  = _res_index(seed, block_idx);
+
+    hn4_hal_spinlock_acquire(&c->locks[idx % HN4_RES_LOCKS]);
+
+    _res_entry_t* e = &c->slots[idx];
+    e->seed_id   = seed;
+    e->block_idx = block_idx;
+    e->lba       = lba;
+    e->phys_sig  = _res_phys_sig(anchor);
+    e->gen       = hn4_le32_to_cpu(anchor->write_gen);
+    e->used      = true;
+
+    hn4_hal_spinlock_release(&c->locks[idx % HN4_RES_LOCKS]);
+}
+
+uint64_t hn4_residency_lookup(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx
+)
+{
+    if (!vol || !anchor) return HN4_LBA_INVALID;
+
+    struct hn4_residency_cache* c = _res_cache(vol, false);
+    if (!c) return HN4_LBA_INVALID;
+
+    hn4_u128_t seed = hn4_le128_to_cpu(anchor->seed_id);
+    uint32_t   idx  = _res_index(seed, block_idx);
+    uint64_t   lba  = HN4_LBA_INVALID;
+
+    hn4_hal_spinlock_acquire(&c->locks[idx % HN4_RES_LOCKS]);
+
+    const _res_entry_t* e = &c->slots[idx];
+    if (e->used &&
+        e->seed_id.lo == seed.lo && e->seed_id.hi == seed.hi &&
+        e->block_idx == block_idx &&
+        e->gen == hn4_le32_to_cpu(anchor->write_gen) &&
+        e->phys_sig == _res_phys_sig(anchor)) {
+        lba = e->lba;
+    }
+
+    hn4_hal_spinlock_release(&c->locks[idx % HN4_RES_LOCKS]);
+
+    if (lba == HN4_LBA_INVALID) return lba;
+
+    /* The slot must still be ours to eclipse */
+    bool allocated = false;
+    if (!vol->void_bitmap ||
+        _bitmap_op(vol, lba, BIT_TEST, &allocated) != HN4_OK || !allocated) {
+        return HN4_LBA_INVALID;
+    }
+    return lba;
+}
+
+void hn4_residency_forget(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor
+)
+{
+    if (!vol || !anchor) return;
+
+    struct hn4_residency_cache* c = _res_cache(vol, false);
+    if (!c) return;
+
+    hn4_u128_t seed = hn4_le128_to_cpu(anchor->seed_id);
+
+    for (uint32_t l = 0; l < HN4_RES_LOCKS; l++) {
+        hn4_hal_spinlock_acquire(&c->locks[l]);
+        for (uint32_t i = l; i < HN4_RES_SLOTS; i += HN4_RES_LOCKS) {
+            _res_entry_t* e = &c->slots[i];
+            if (e->used && e->seed_id.lo == seed.lo && e->seed_id.hi == seed.hi) e->used = false;
+        }
+        hn4_hal_spinlock_release(&c->locks[l]);
+    }
+}
+
+void hn4_residency_release(HN4_IN hn4_volume_t* vol)
+{
+    if (!vol) return;
+
+    struct hn4_residency_cache* c = atomic_exchange(&vol->residency_cache, NULL);
+    if (c) hn4_hal_mem_free(c);
+}
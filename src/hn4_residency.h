@@ -0,0 +1,73 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Residency Cache (Block -> LBA Memo)
+ * HEADER:      hn4_residency.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Remembers where (file, block_idx) was last seen: by a verified read or a
+ * committed write. The writer uses it to pick the LBA to eclipse without
+ * re-probing orbits and reading the old block back.
+ *
+ * An entry is only trusted while the Anchor still carries the generation
+ * and trajectory physics (G, V, M, Horizon) it was recorded under and the
+ * LBA is still claimed in the Void Bitmap. Anything else is a miss and the
+ * caller falls back to _resolve_residency_verified.
+ */
+
+#ifndef HN4_RESIDENCY_H
+#define HN4_RESIDENCY_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * hn4_residency_note
+ * Records that 'block_idx' of the file lives at block 'lba' under the
+ * Anchor's current write_gen.
+ */
+void hn4_residency_note(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx,
+    HN4_IN uint64_t            lba
+);
+
+/**
+ * hn4_residency_lookup
+ * Returns the cached block LBA of 'block_idx', or HN4_LBA_INVALID.
+ * Issues no I/O.
+ */
+uint64_t hn4_residency_lookup(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint64_t            block_idx
+);
+
+/**
+ * hn4_residency_forget
+ * Drops every entry of the Anchor's file. For paths that free blocks of a
+ * file without moving its generation or physics (rolled-back writes).
+ */
+void hn4_residency_forget(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor
+);
+
+/**
+ * hn4_residency_release
+ * Drops the cache. Called from unmount.
+ */
+void hn4_residency_release(HN4_IN hn4_volume_t* vol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_RESIDENCY_H */
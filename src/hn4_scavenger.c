@@ -22,6 +22,7 @@
 #include "hn4_errors.h"
 #include "hn4_endians.h"
 #include "hn4_anchor.h"
+#include "hn4_repair.h"
 #include "hn4_addr.h"
 #include "hn4_annotations.h"
 #include "hn4_constants.h"
@@ -229,6 +230,28 @@ static void _reaper_flush(hn4_hal_device_t* dev, _reaper_batch_t* batch, hn4_vol
 
     qsort(batch->lbas, batch->count, sizeof(hn4_addr_t), _addr_cmp);
 
+    /*
+     * HDD Shred: route the zero-fill through the HAL elevator so adjacent
+     * victims go out as one merged write instead of one command per block.
+     * Falls back to per-block sync I/O if the queue cannot be allocated.
+     */
+    hn4_io_sched_t* sched = NULL;
+    hn4_io_req_t*   reqs  = NULL;
+    uint32_t        nreq  = 0;
+
+    if (batch->secure_shred && zero_buf && (caps->hw_flags & HN4_HW_ROTATIONAL)) {
+        sched = hn4_hal_mem_alloc(sizeof(hn4_io_sched_t));
+        reqs  = hn4_hal_mem_alloc(batch->count * sizeof(hn4_io_req_t));
+        if (sched && reqs) {
+            hn4_hal_sched_init(sched, dev);
+        } else {
+            if (sched) hn4_hal_mem_free(sched);
+            if (reqs)  hn4_hal_mem_free(reqs);
+            sched = NULL;
+            reqs  = NULL;
+        }
+    }
+
     /* --- PHASE 1: PHYSICAL SANITIZATION --- */
     uint32_t i = 0;
     while (i < batch->count) {
@@ -257,7 +280,16 @@ static void _reaper_flush(hn4_hal_device_t* dev, _reaper_batch_t* batch, hn4_vol
         if (batch->secure_shred && zero_buf) {
             for (uint32_t k = 0; k < merged; k++) {
                 hn4_addr_t target = hn4_addr_add(start, k * sectors_per_blk);
-                hn4_hal_sync_io(dev, HN4_IO_WRITE, target, zero_buf, sectors_per_blk);
+                if (sched) {
+                    hn4_io_req_t* r = &reqs[nreq++];
+                    r->op_code = HN4_IO_WRITE;
+                    r->lba     = target;
+                    r->buffer  = zero_buf;
+                    r->length  = sectors_per_blk;
+                    hn4_hal_sched_submit(sched, r, NULL);
+                } else {
+                    hn4_hal_sync_io(dev, HN4_IO_WRITE, target, zero_buf, sectors_per_blk);
+                }
             }
         } else if (!is_zns && !is_hdd) {
             /* 
@@ -272,6 +304,12 @@ static void _reaper_flush(hn4_hal_device_t* dev, _reaper_batch_t* batch, hn4_vol
         i += merged;
     }
 
+    if (sched) {
+        hn4_hal_sched_drain(sched);
+        hn4_hal_mem_free(reqs);
+        hn4_hal_mem_free(sched);
+    }
+
     /* --- PHASE 2: THE WALL (Barrier) --- */
     hn4_hal_barrier(dev);
 
@@ -556,7 +594,7 @@ static void _evacuate_zns_victim(
         bool found = false;
 
         if (vol->nano_cortex) {
-            hn4_hal_spinlock_acquire(&vol->locking.l2_lock);
+            hn4_hal_spinlock_acquire_shared(&vol->locking.l2_lock);
             size_t count = vol->cortex_size / sizeof(hn4_anchor_t);
             hn4_anchor_t* arr = (hn4_anchor_t*)vol->nano_cortex;
             for (size_t k = 0; k < count; k++) {
@@ -568,7 +606,7 @@ static void _evacuate_zns_victim(
                     break;
                 }
             }
-            hn4_hal_spinlock_release(&vol->locking.l2_lock);
+            hn4_hal_spinlock_release_shared(&vol->locking.l2_lock);
         }
 
         if (found) {
@@ -679,7 +717,7 @@ static void _medic_queue_push(hn4_volume_t* vol, uint32_t anchor_idx, uint32_t s
     hn4_medic_queue_t* q = &vol->medic_queue;
 
     /* Simple Ring Insertion (Latest replaces Oldest if full) */
-    hn4_hal_spinlock_acquire(&q->lock);
+    hn4_hal_ticket_lock_acquire(&q->lock);
 
     if (q->count < HN4_MEDIC_QUEUE_SIZE) {
         q->entries[q->count].anchor_idx = anchor_idx;
@@ -703,7 +741,7 @@ static void _medic_queue_push(hn4_volume_t* vol, uint32_t anchor_idx, uint32_t s
         }
     }
 
-    hn4_hal_spinlock_release(&q->lock);
+    hn4_hal_ticket_lock_release(&q->lock);
 }
 
 static void _rollback_delta(hn4_volume_t* vol, uint64_t old_lba, uint64_t seed_hash) {
@@ -1225,6 +1263,13 @@ static void _perform_leak_audit(hn4_volume_t* vol) {
                     if (hn4_le32_to_cpu(h->magic) != HN4_BLOCK_MAGIC) {
                         /* Garbage data in marked block -> Safe to free */
                         safe_to_free = true;
+
+                        /* Trained lexicons are owned by the Superblock, not an Anchor */
+                        const hn4_extension_header_t* ext = (const hn4_extension_header_t*)io_buf;
+                        if (hn4_le32_to_cpu(ext->magic) == HN4_MAGIC_META &&
+                            hn4_le32_to_cpu(ext->type) == HN4_EXT_TYPE_LEXICON) {
+                            safe_to_free = false;
+                        }
                     } else {
                         /* Valid Header. Find Owner. */
                         hn4_u128_t disk_id = hn4_le128_to_cpu(h->well_id);
@@ -1272,6 +1317,71 @@ static void _perform_leak_audit(hn4_volume_t* vol) {
 }
 
 
+/* =========================================================================
+ * THE SCRUBBER (Deferred Payload Verification)
+ * =========================================================================
+ * Under a relaxed read tier (HN4_INTEGRITY_HEADER / TRUST) the read path
+ * stops checking payload CRCs. The scrubber walks allocated data blocks in
+ * LBA order, a window per pulse, and checks header + payload CRC. A
+ * mismatch bumps crc_failures, which promotes reads back to FULL.
+ * Identity is not checked here: there is no Anchor in hand.
+ */
+
+#define HN4_SCRUB_BLOCKS_PER_PULSE  64
+#define HN4_SCRUB_SCAN_LIMIT        4096    /* Bitmap probes per pulse */
+
+static void _scrub_pulse(hn4_volume_t* vol)
+{
+    if (atomic_load(&vol->integrity.effective) == HN4_INTEGRITY_FULL) return;
+    if (!vol->void_bitmap) return;
+
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t ss  = (caps && caps->logical_block_size) ? caps->logical_block_size : 512;
+    uint32_t spb = bs / ss;
+    if (spb == 0) return;
+
+    uint64_t first = hn4_addr_to_u64(vol->sb.info.lba_flux_start) / spb;
+    uint64_t total = vol->vol_capacity_bytes / bs;
+    if (first >= total) return;
+
+    void* buf = hn4_hal_mem_alloc(bs);
+    if (!buf) return;
+
+    uint64_t cursor  = vol->integrity.scrub_cursor;
+    uint32_t checked = 0;
+    uint32_t payload = bs - (uint32_t)sizeof(hn4_block_header_t);
+
+    for (uint32_t scanned = 0; scanned < HN4_SCRUB_SCAN_LIMIT && checked < HN4_SCRUB_BLOCKS_PER_PULSE; scanned++) {
+        if (cursor < first || cursor >= total) cursor = first;
+        uint64_t lba = cursor++;
+
+        bool is_set = false;
+        if (_bitmap_op(vol, lba, BIT_TEST, &is_set) != HN4_OK || !is_set) continue;
+
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), buf, spb) != HN4_OK) {
+            continue;
+        }
+
+        hn4_block_header_t* hdr = (hn4_block_header_t*)buf;
+        if (hn4_le32_to_cpu(hdr->magic) != HN4_BLOCK_MAGIC) continue; /* Metadata / extensions */
+
+        checked++;
+
+        uint32_t hcrc = hn4_crc32(HN4_CRC_SEED_HEADER, hdr, offsetof(hn4_block_header_t, header_crc));
+        uint32_t dcrc = hn4_crc32(HN4_CRC_SEED_DATA, hdr->payload, payload);
+
+        if (hcrc != hn4_le32_to_cpu(hdr->header_crc) || dcrc != hn4_le32_to_cpu(hdr->data_crc)) {
+            atomic_fetch_add(&vol->health.crc_failures, 1);
+            HN4_LOG_WARN("Scrub: CRC mismatch at block %llu", (unsigned long long)lba);
+        }
+    }
+
+    vol->integrity.scrub_cursor = cursor;
+    atomic_fetch_add(&vol->integrity.scrubbed, checked);
+    hn4_hal_mem_free(buf);
+}
+
 /* =========================================================================
  * PUBLIC API: SCAVENGER PULSE
  * ========================================================================= */
@@ -1279,9 +1389,17 @@ static void _perform_leak_audit(hn4_volume_t* vol) {
 void hn4_scavenger_pulse(HN4_IN hn4_volume_t* vol)
 {
     /* 1. Pre-flight Checks */
-    if (!vol || vol->read_only) return;
+    if (!vol) return;
     if (vol->sb.info.state_flags & HN4_VOL_PANIC) return;
 
+    /* Read-only work: RO inference mounts are exactly who relaxes verification */
+    _scrub_pulse(vol);
+
+    if (vol->read_only) return;
+
+    /* Auto-Medic backlog queued by readers */
+    hn4_repair_drain(vol);
+
     hn4_time_t now = hn4_hal_get_time_ns();
 
     /* 2. Vital Signs & Mode Detection */
@@ -1310,7 +1428,7 @@ void hn4_scavenger_pulse(HN4_IN hn4_volume_t* vol)
          * We drain the triage list before scanning for garbage.
          * Limit: 4 surgeries per pulse to prevent IO starvation.
          */
-        hn4_hal_spinlock_acquire(&vol->medic_queue.lock);
+        hn4_hal_ticket_lock_acquire(&vol->medic_queue.lock);
 
         int surgeries = 0;
         while (vol->medic_queue.count > 0 && surgeries < 4) {
@@ -1334,7 +1452,7 @@ void hn4_scavenger_pulse(HN4_IN hn4_volume_t* vol)
             }
 
             /* Release Lock during IO-heavy surgery */
-            hn4_hal_spinlock_release(&vol->medic_queue.lock);
+            hn4_hal_ticket_lock_release(&vol->medic_queue.lock);
 
             if (idx < count) {
                 /* Perform Osteoplasty (Migration to new vector V') */
@@ -1343,9 +1461,9 @@ void hn4_scavenger_pulse(HN4_IN hn4_volume_t* vol)
             }
 
             /* Re-acquire for next iteration */
-            hn4_hal_spinlock_acquire(&vol->medic_queue.lock);
+            hn4_hal_ticket_lock_acquire(&vol->medic_queue.lock);
         }
-        hn4_hal_spinlock_release(&vol->medic_queue.lock);
+        hn4_hal_ticket_lock_release(&vol->medic_queue.lock);
 
 
         /* 
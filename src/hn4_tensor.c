@@ -31,6 +31,7 @@
 #include "hn4.h"
 #include "hn4_hal.h"
 #include "hn4_tensor.h"
+#include "hn4_write.h"
 #include "hn4_errors.h"
 #include "hn4_endians.h"
 #include "hn4_constants.h"
@@ -39,6 +40,10 @@
 #include "hn4_swizzle.h"
 #include "hn4_anchor.h" 
 #include "hn4_signet.h"
+#include "hn4_residency.h"
+#include "hn4_namespace.h"
+#include "hn4_allocator.h"
+#include "hn4_crc.h"
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
@@ -54,7 +59,14 @@
 #define HN4_FLAG_SIGNED (1ULL << 28)
 #endif
 
-#define MAX_ROLLBACK_TRACK 1024
+/*
+ * Parallel shard reads. Workers block on device latency, not CPU, so
+ * there are more of them than cores. Smaller ranges stay on the caller's
+ * thread, where the readahead window serves them.
+ */
+#define HN4_TENSOR_IO_WORKERS   8
+#define HN4_TENSOR_IO_DEPTH     (4 * HN4_TENSOR_IO_WORKERS)
+#define HN4_TENSOR_PAR_MIN      4       /* Blocks before the workers are used */
 
 /* 
  * 64MB BLOCK ALIGNMENT
@@ -129,6 +141,65 @@ static uint32_t _find_shard_idx(const hn4_tensor_ctx_t* ctx, uint64_t pos)
 }
 
 
+/*
+ * One block of a tensor read. Whole payloads are decoded straight into the
+ * caller's buffer; partial ones go through a bounce buffer.
+ */
+typedef struct {
+    hn4_tensor_ctx_t*   ctx;
+    hn4_anchor_t*       anchor;
+    uint64_t            block_idx;
+    uint8_t*            dst;
+    uint32_t            offset;     /* Into the block's payload */
+    uint32_t            len;
+    hn4_readahead_t*    ra;         /* Inline jobs only; NULL on workers */
+    hn4_result_t        res;
+    _Atomic uint32_t    done;
+} _tensor_io_t;
+
+static void _tensor_io_run(void* arg)
+{
+    _tensor_io_t*     j     = (_tensor_io_t*)arg;
+    hn4_tensor_ctx_t* ctx   = j->ctx;
+    bool              whole = (j->offset == 0 && j->len == ctx->payload_cap);
+
+    uint8_t* buf = whole ? j->dst : hn4_hal_mem_alloc(ctx->block_size);
+    if (!buf) {
+        j->res = HN4_ERR_NOMEM;
+        return;
+    }
+
+    /* hn4_read_block_atomic returns pure payload; the header is already stripped */
+    j->res = hn4_read_block_ra(j->ra, ctx->vol, j->anchor, j->block_idx, buf,
+                               whole ? ctx->payload_cap : ctx->block_size,
+                               HN4_PERM_READ | HN4_PERM_SOVEREIGN);
+
+    if (!whole) {
+        if (!HN4_IS_ERR(j->res)) memcpy(j->dst, buf + j->offset, j->len);
+        hn4_hal_mem_free(buf);
+    }
+}
+
+/*
+ * Volume's tensor I/O workers. NULL on bare metal, where every block is
+ * read inline.
+ */
+static hn4_hal_workq_t* _tensor_workq(hn4_volume_t* vol)
+{
+    hn4_hal_workq_t* q = atomic_load_explicit(&vol->tensor_workq, memory_order_acquire);
+    if (q) return q;
+
+    q = hn4_hal_workq_create(HN4_TENSOR_IO_WORKERS, HN4_TENSOR_IO_DEPTH);
+    if (!q) return NULL;
+
+    hn4_hal_workq_t* expected = NULL;
+    if (!atomic_compare_exchange_strong(&vol->tensor_workq, &expected, q)) {
+        hn4_hal_workq_destroy(q);
+        q = expected;
+    }
+    return q;
+}
+
 /**
  * _ai_map_p2p_bar
  * 
@@ -167,51 +238,233 @@ static hn4_result_t _ai_map_p2p_bar(
 }
 
 /* =========================================================================
- * 2. PUBLIC API: TENSOR VIRTUALIZATION
+ * 1.5. TENSOR MANIFEST (SHARD INDEX)
  * ========================================================================= */
 
-_Check_return_
-hn4_result_t hn4_tensor_open(
-    HN4_IN  hn4_volume_t* vol, 
-    HN4_IN  const char*   model_tag, 
-    HN4_OUT hn4_tensor_ctx_t** out_ctx
+/*
+ * The manifest lives at a Seed ID derived from the tag, so finding it is
+ * one hashed Cortex probe. Its tag_filter stays zero: it never matches a
+ * Bloom query and never moves the namespace generation.
+ */
+static hn4_u128_t _tman_seed(const char* tag)
+{
+    uint64_t a = 0xcbf29ce484222325ULL;
+    uint64_t b = 0x9E3779B97F4A7C15ULL;
+
+    for (const uint8_t* p = (const uint8_t*)tag; *p; p++) {
+        a = (a ^ *p) * 0x100000001b3ULL;
+        b = (b + *p) * HN4_NS_HASH_CONST;
+        b ^= b >> 29;
+    }
+
+    hn4_u128_t id;
+    id.lo = a ^ (b >> 17);
+    id.hi = b ^ ((uint64_t)HN4_TMAN_MAGIC << 32);
+    return id;
+}
+
+static uint32_t _tman_size(uint32_t count)
+{
+    return (uint32_t)(sizeof(hn4_manifest_header_t) +
+                      count * (sizeof(hn4_u128_t) + sizeof(hn4_tensor_manifest_geo_t)));
+}
+
+/*
+ * Fills 'shards' in stream order from the tag's manifest. Every entry is
+ * checked against its live Anchor (generation, mass, running offset), and
+ * the manifest as a whole against namespace generation 'gen', which
+ * catches shards that joined, left or were renamed. The entry for
+ * 'fresh' (NULL = none), just committed, is taken as is. Any mismatch
+ * returns false and the caller rescans.
+ */
+static bool _tman_load(
+    hn4_volume_t*       vol,
+    const char*         tag,
+    uint32_t            gen,
+    const hn4_anchor_t* fresh,
+    hn4_anchor_t*       shards,
+    uint32_t*           out_count
 )
 {
-    hn4_result_t result = HN4_OK;
-    hn4_tensor_ctx_t* ctx = NULL;
-    uint32_t found_count = 0;
+    /* A read-only mount of a dirty volume never bumped the generation */
+    if (vol->read_only && !(vol->sb.info.state_flags & HN4_VOL_CLEAN)) return false;
+
+    hn4_anchor_t man;
+    if (hn4_ns_get_anchor_by_id(vol, _tman_seed(tag), &man) != HN4_OK) return false;
+
+    uint64_t dclass = hn4_le64_to_cpu(man.data_class);
+    uint64_t mass   = hn4_le64_to_cpu(man.mass);
+    uint32_t bs     = vol->vol_block_size;
+
+    if ((dclass & HN4_AI_TYPE_MASK) != HN4_AI_TYPE_MANIFEST) return false;
+    if (mass < sizeof(hn4_manifest_header_t) || mass > HN4_BLOCK_PayloadSize(bs)) return false;
+
+    uint8_t* buf = hn4_hal_mem_alloc(bs);
+    if (!buf) return false;
+
+    bool ok = false;
+    if (hn4_read_block_atomic(vol, &man, 0, buf, bs, HN4_PERM_READ) != HN4_OK) goto out;
+
+    const hn4_manifest_header_t* hdr = (const hn4_manifest_header_t*)buf;
+    uint64_t count = hn4_le64_to_cpu(hdr->count);
+    uint64_t rsv   = hn4_le64_to_cpu(hdr->reserved);
+
+    if ((uint32_t)rsv != HN4_TMAN_MAGIC || (uint32_t)(rsv >> 32) != gen) goto out;
+    if (count == 0 || count >= HN4_MAX_TENSOR_SHARDS) goto out;
+    if (_tman_size((uint32_t)count) > mass) goto out;
+
+    const hn4_tensor_manifest_geo_t* geo =
+        (const hn4_tensor_manifest_geo_t*)(buf + sizeof(*hdr) + count * sizeof(hn4_u128_t));
     uint64_t accumulator = 0;
 
-    if (HN4_UNLIKELY(!vol || !model_tag || !out_ctx)) {
-        return HN4_ERR_INVALID_ARGUMENT;
+    for (uint32_t i = 0; i < (uint32_t)count; i++) {
+        uint64_t s_mass = hn4_le64_to_cpu(geo[i].mass);
+
+        if (fresh && memcmp(&hdr->entries[i], &fresh->seed_id, sizeof(hn4_u128_t)) == 0) {
+            shards[i] = *fresh;
+        } else {
+            if (hn4_ns_get_anchor_by_id(vol, hn4_le128_to_cpu(hdr->entries[i]), &shards[i]) != HN4_OK) goto out;
+            if (shards[i].write_gen != geo[i].write_gen) goto out;
+            if (s_mass == 0 || s_mass != hn4_le64_to_cpu(shards[i].mass)) goto out;
+        }
+
+        if (hn4_le64_to_cpu(geo[i].offset) != accumulator) goto out;
+        if ((UINT64_MAX - accumulator) < s_mass) goto out;
+
+        accumulator += s_mass;
     }
 
-    ctx = hn4_hal_mem_alloc(sizeof(hn4_tensor_ctx_t));
-    if (!ctx) return HN4_ERR_NOMEM;
-    memset(ctx, 0, sizeof(hn4_tensor_ctx_t));
+    *out_count = (uint32_t)count;
+    ok = true;
 
-    /* --- PHASE 1: GATHER --- */
-    ctx->shards = hn4_hal_mem_alloc(sizeof(hn4_anchor_t) * HN4_MAX_TENSOR_SHARDS);
-    if (!ctx->shards) {
-        result = HN4_ERR_NOMEM;
-        goto failure;
+out:
+    hn4_hal_mem_free(buf);
+    return ok;
+}
+
+/*
+ * Writes the manifest for 'count' sorted shards, indexed at namespace
+ * generation 'gen' (sampled before the scan, so a racing change leaves
+ * the manifest stale rather than wrong). An identical manifest is not
+ * rewritten.
+ */
+static hn4_result_t _tman_store(
+    hn4_volume_t*       vol,
+    const char*         tag,
+    const hn4_anchor_t* shards,
+    uint32_t            count,
+    uint32_t            gen
+)
+{
+    uint32_t bs   = vol->vol_block_size;
+    uint32_t need = _tman_size(count);
+
+    if (need > HN4_BLOCK_PayloadSize(bs)) return HN4_ERR_TAG_OVERFLOW;
+
+    uint8_t* buf = hn4_hal_mem_alloc(bs);
+    uint8_t* old = hn4_hal_mem_alloc(bs);
+    if (!buf || !old) {
+        hn4_hal_mem_free(buf);
+        hn4_hal_mem_free(old);
+        return HN4_ERR_NOMEM;
+    }
+    memset(buf, 0, bs);
+
+    hn4_manifest_header_t* hdr = (hn4_manifest_header_t*)buf;
+    hdr->count    = hn4_cpu_to_le64(count);
+    hdr->reserved = hn4_cpu_to_le64(((uint64_t)gen << 32) | HN4_TMAN_MAGIC);
+
+    hn4_tensor_manifest_geo_t* geo =
+        (hn4_tensor_manifest_geo_t*)(buf + sizeof(*hdr) + (size_t)count * sizeof(hn4_u128_t));
+    uint64_t accumulator = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        hdr->entries[i]  = shards[i].seed_id;
+        geo[i].offset    = hn4_cpu_to_le64(accumulator);
+        geo[i].mass      = shards[i].mass;
+        geo[i].write_gen = shards[i].write_gen;
+        accumulator     += hn4_le64_to_cpu(shards[i].mass);
     }
 
+    hn4_result_t res;
+    hn4_anchor_t man;
+    hn4_u128_t   seed = _tman_seed(tag);
+
+    res = hn4_ns_get_anchor_by_id(vol, seed, &man);
+
+    if (res == HN4_OK) {
+        uint64_t dclass = hn4_le64_to_cpu(man.data_class);
+        if ((dclass & HN4_AI_TYPE_MASK) != HN4_AI_TYPE_MANIFEST) {
+            res = HN4_ERR_ID_MISMATCH;
+            goto out;
+        }
+        if (hn4_le64_to_cpu(man.mass) == need &&
+            hn4_read_block_atomic(vol, &man, 0, old, bs, HN4_PERM_READ) == HN4_OK &&
+            memcmp(old, buf, need) == 0)
+        {
+            goto out;
+        }
+    } else if (res == HN4_ERR_NOT_FOUND || res == HN4_ERR_TOMBSTONE) {
+        memset(&man, 0, sizeof(man));
+        man.seed_id      = hn4_cpu_to_le128(seed);
+        man.public_id    = man.seed_id;
+        man.data_class   = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_AI_TYPE_MANIFEST);
+        man.permissions  = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+        man.create_clock = hn4_cpu_to_le32((uint32_t)(hn4_hal_get_time_ns() / 1000000000ULL));
+
+        uint64_t v = 1;
+        memcpy(man.orbit_vector, &v, 6);
+    } else {
+        goto out;
+    }
+
+    /* The write path only grows mass; a shorter list must shrink it */
+    man.mass = hn4_cpu_to_le64(need);
+
+    res = hn4_write_block_replace(vol, &man, 0, buf, need, HN4_PERM_SOVEREIGN | HN4_PERM_WRITE);
+    if (res == HN4_OK) res = hn4_write_anchor_atomic(vol, &man);
+
+out:
+    hn4_hal_mem_free(old);
+    hn4_hal_mem_free(buf);
+    return res;
+}
+
+/* =========================================================================
+ * 2. PUBLIC API: TENSOR VIRTUALIZATION
+ * ========================================================================= */
+
+/*
+ * Resonance Scan: gathers the shards carrying 'tag' from the Cortex,
+ * verifies their names and sorts them into stream order.
+ */
+static hn4_result_t _tensor_gather(
+    hn4_volume_t* vol,
+    const char*   tag,
+    hn4_anchor_t* shards,
+    uint32_t*     out_count
+)
+{
+    uint32_t found_count = 0;
+
     /* Scan the Cortex for anchors matching the tag */
-    result = hn4_ns_gather_tensor_shards(
-        vol, model_tag, ctx->shards, HN4_MAX_TENSOR_SHARDS, &found_count);
+    hn4_result_t result = hn4_ns_gather_tensor_shards(
+        vol, tag, shards, HN4_MAX_TENSOR_SHARDS, &found_count);
 
-    if (result != HN4_OK) goto failure;
+    if (result != HN4_OK) return result;
 
     uint32_t verified_count = 0;
     for (uint32_t i = 0; i < found_count; i++) {
         char name_buf[256];
+        /* KV freezes, graphs and manifests share the tag but are not shards */
+        if (HN4_AI_TYPE_IS_AUX(hn4_le64_to_cpu(shards[i].data_class))) continue;
+
         /* Resolve name from inline buffer or extension */
-        if (hn4_ns_get_name(vol, &ctx->shards[i], name_buf, sizeof(name_buf)) == HN4_OK) {
-            if (strcmp(name_buf, model_tag) == 0) {
+        if (hn4_ns_get_name(vol, &shards[i], name_buf, sizeof(name_buf)) == HN4_OK) {
+            if (strcmp(name_buf, tag) == 0) {
                 /* Valid match: Pack array */
                 if (i != verified_count) {
-                    ctx->shards[verified_count] = ctx->shards[i];
+                    shards[verified_count] = shards[i];
                 }
                 verified_count++;
             }
@@ -219,21 +472,54 @@ hn4_result_t hn4_tensor_open(
     }
     found_count = verified_count; /* Update count to verified subset */
     
-    if (found_count == 0) {
-        result = HN4_ERR_NOT_FOUND;
-        goto failure;
-    }
+    if (found_count == 0) return HN4_ERR_NOT_FOUND;
 
     if (HN4_UNLIKELY(found_count == HN4_MAX_TENSOR_SHARDS)) {
         HN4_LOG_CRIT("Tensor Open: Shard count hit limit (%u). Ambiguous completeness.", 
                      HN4_MAX_TENSOR_SHARDS);
-        result = HN4_ERR_TAG_OVERFLOW;
+        return HN4_ERR_TAG_OVERFLOW;
+    }
+
+    qsort(shards, found_count, sizeof(hn4_anchor_t), _shard_cmp);
+
+    *out_count = found_count;
+    return HN4_OK;
+}
+
+_Check_return_
+hn4_result_t hn4_tensor_open(
+    HN4_IN  hn4_volume_t* vol, 
+    HN4_IN  const char*   model_tag, 
+    HN4_OUT hn4_tensor_ctx_t** out_ctx
+)
+{
+    hn4_result_t result = HN4_OK;
+    hn4_tensor_ctx_t* ctx = NULL;
+    uint32_t found_count = 0;
+    uint64_t accumulator = 0;
+
+    if (HN4_UNLIKELY(!vol || !model_tag || !out_ctx)) {
+        return HN4_ERR_INVALID_ARGUMENT;
+    }
+
+    ctx = hn4_hal_mem_alloc(sizeof(hn4_tensor_ctx_t));
+    if (!ctx) return HN4_ERR_NOMEM;
+    memset(ctx, 0, sizeof(hn4_tensor_ctx_t));
+
+    /* --- PHASE 1: GATHER --- */
+    ctx->shards = hn4_hal_mem_alloc(sizeof(hn4_anchor_t) * HN4_MAX_TENSOR_SHARDS);
+    if (!ctx->shards) {
+        result = HN4_ERR_NOMEM;
         goto failure;
     }
 
-    /* --- PHASE 2: GEOMETRY MAP --- */
-    qsort(ctx->shards, found_count, sizeof(hn4_anchor_t), _shard_cmp);
+    /* Manifest first; a stale or missing one costs a full scan. Open never writes */
+    if (!_tman_load(vol, model_tag, atomic_load(&vol->ns_generation), NULL, ctx->shards, &found_count)) {
+        result = _tensor_gather(vol, model_tag, ctx->shards, &found_count);
+        if (result != HN4_OK) goto failure;
+    }
 
+    /* --- PHASE 2: GEOMETRY MAP --- */
     /* Allocate N+1 to hold EOF sentinel */
     ctx->shard_offsets = hn4_hal_mem_alloc(sizeof(uint64_t) * (found_count + 1));
     if (!ctx->shard_offsets) {
@@ -278,6 +564,7 @@ hn4_result_t hn4_tensor_open(
         goto failure;
     }
     ctx->payload_cap = p_cap;
+    ctx->ra          = hn4_readahead_create(vol);
 
     atomic_fetch_add(&vol->health.ref_count, 1);
 
@@ -321,93 +608,175 @@ hn4_result_t hn4_tensor_read(
         read_len = ctx->total_size_bytes - global_offset;
     }
 
-    void* bounce_buf = hn4_hal_mem_alloc(ctx->block_size);
-    if (HN4_UNLIKELY(!bounce_buf)) return HN4_ERR_NOMEM;
-
-    uint8_t* cursor      = (uint8_t*)buf;
-    uint64_t remaining   = read_len;
-    uint64_t current_pos = global_offset;
-    hn4_result_t res     = HN4_OK;
+    uint32_t shard_idx = _find_shard_idx(ctx, global_offset);
+    if (HN4_UNLIKELY(shard_idx == HN4_SHARD_INVALID)) return HN4_ERR_GEOMETRY;
 
-    uint32_t shard_idx = _find_shard_idx(ctx, current_pos);
-    
-    if (HN4_UNLIKELY(shard_idx == HN4_SHARD_INVALID)) {
-        res = HN4_ERR_GEOMETRY;
-        goto cleanup;
+    /*
+     * Every block of the range is an independent job placed at its own
+     * offset in 'buf', so up to HN4_TENSOR_IO_DEPTH reads are in flight
+     * across shards. Jobs are reaped in order; the first failure stops
+     * issuing and is returned once the in-flight ones have drained.
+     */
+    hn4_hal_workq_t* q      = NULL;
+    _tensor_io_t     inline_job;
+    _tensor_io_t*    jobs   = &inline_job;
+    uint32_t         depth  = 1;
+
+    if (read_len / ctx->payload_cap >= HN4_TENSOR_PAR_MIN) {
+        q = _tensor_workq(ctx->vol);
+        if (q) {
+            jobs = hn4_hal_mem_alloc(HN4_TENSOR_IO_DEPTH * sizeof(_tensor_io_t));
+            if (jobs) {
+                depth = HN4_TENSOR_IO_DEPTH;
+            } else {
+                jobs = &inline_job;
+                q    = NULL;
+            }
+        }
     }
 
-    while (remaining > 0 && shard_idx < ctx->shard_count) {
-        
-        hn4_anchor_t* anchor = &ctx->shards[shard_idx];
-        uint64_t shard_start = ctx->shard_offsets[shard_idx];
-        uint64_t shard_end   = ctx->shard_offsets[shard_idx + 1];
-        uint64_t shard_mass  = shard_end - shard_start;
-
-        uint64_t local_offset = current_pos - shard_start;
-
-        while (remaining > 0 && local_offset < shard_mass) {
-            
-            uint64_t block_idx = local_offset / ctx->payload_cap;
-            
-            /* Logical Block Bounds Check */
-            uint64_t max_blocks = (shard_mass + ctx->payload_cap - 1) / ctx->payload_cap;
-            if (block_idx >= max_blocks) {
-                res = HN4_ERR_DATA_ROT; /* Mass metadata mismatch */
-                goto cleanup;
+    uint8_t* cursor       = (uint8_t*)buf;
+    uint64_t remaining    = read_len;
+    uint64_t local_offset = global_offset - ctx->shard_offsets[shard_idx];
+    uint64_t issued       = 0;
+    uint64_t reaped       = 0;
+    hn4_result_t res      = HN4_OK;
+
+    for (;;) {
+        while (remaining > 0 && issued - reaped < depth) {
+            uint64_t shard_mass = ctx->shard_offsets[shard_idx + 1] - ctx->shard_offsets[shard_idx];
+
+            if (local_offset >= shard_mass) {
+                if (++shard_idx >= ctx->shard_count) {
+                    res = HN4_ERR_GEOMETRY;
+                    remaining = 0;
+                    break;
+                }
+                local_offset = 0;
+                continue;
             }
 
             uint32_t offset_in_blk = (uint32_t)(local_offset % ctx->payload_cap);
-            uint64_t bytes_available_in_blk = ctx->payload_cap - offset_in_blk;
-            uint64_t bytes_left_in_shard    = shard_mass - local_offset;
-            uint64_t fetch_len              = bytes_available_in_blk;
-            
-            if (fetch_len > bytes_left_in_shard) fetch_len = bytes_left_in_shard;
-            if (fetch_len > remaining) fetch_len = remaining;
+            uint64_t fetch_len     = ctx->payload_cap - offset_in_blk;
+
+            if (fetch_len > shard_mass - local_offset) fetch_len = shard_mass - local_offset;
+            if (fetch_len > remaining)                 fetch_len = remaining;
+
+            _tensor_io_t* j = &jobs[issued % depth];
+            j->ctx       = ctx;
+            j->anchor    = &ctx->shards[shard_idx];
+            j->block_idx = local_offset / ctx->payload_cap;
+            j->dst       = cursor;
+            j->offset    = offset_in_blk;
+            j->len       = (uint32_t)fetch_len;
+            j->ra        = q ? NULL : ctx->ra;
+            j->res       = HN4_OK;
+
+            hn4_hal_workq_submit(q, _tensor_io_run, j, &j->done);
+            issued++;
+
+            cursor       += fetch_len;
+            local_offset += fetch_len;
+            remaining    -= fetch_len;
+        }
 
-            if (HN4_UNLIKELY(fetch_len > UINT32_MAX)) {
-                res = HN4_ERR_GEOMETRY;
-                goto cleanup;
-            }
-            uint32_t chunk = (uint32_t)fetch_len;
-
-            /* 
-             * ATOMIC READ via HN4 Core
-             */
-            res = hn4_read_block_atomic(
-                ctx->vol, 
-                anchor, 
-                block_idx, 
-                bounce_buf, 
-                ctx->block_size,
-                HN4_PERM_READ | HN4_PERM_SOVEREIGN
-            );
-
-            if (HN4_UNLIKELY(HN4_IS_ERR(res))) {
-                goto cleanup;
-            }
+        if (reaped == issued) break;
 
-            /* 
-             * FIX: ABI CONTRACT ENFORCEMENT
-             * hn4_read_block_atomic returns PURE PAYLOAD in bounce_buf.
-             * The header is stripped by the atomic read layer.
-             * Do not add offsetof(header) or we read garbage/OOB.
-             */
-            memcpy(cursor, (uint8_t*)bounce_buf + offset_in_blk, chunk);
-
-            cursor       += chunk;
-            current_pos  += chunk;
-            local_offset += chunk;
-            remaining    -= chunk;
+        _tensor_io_t* j = &jobs[reaped % depth];
+        hn4_hal_workq_wait(q, &j->done);
+        reaped++;
+
+        if (HN4_IS_ERR(j->res) && !HN4_IS_ERR(res)) {
+            res       = j->res;
+            remaining = 0;
         }
-        shard_idx++;
     }
 
-cleanup:
-    hn4_hal_mem_free(bounce_buf);
+    if (jobs != &inline_job) hn4_hal_mem_free(jobs);
     return res;
 }
 
 
+_Check_return_
+hn4_result_t hn4_tensor_build_manifest(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN const char*   model_tag
+)
+{
+    if (HN4_UNLIKELY(!vol || !model_tag)) return HN4_ERR_INVALID_ARGUMENT;
+    if (vol->read_only) return HN4_ERR_ACCESS_DENIED;
+
+    hn4_anchor_t* shards = hn4_hal_mem_alloc(sizeof(hn4_anchor_t) * HN4_MAX_TENSOR_SHARDS);
+    if (!shards) return HN4_ERR_NOMEM;
+
+    uint32_t     count  = 0;
+    uint32_t     ns_gen = atomic_load(&vol->ns_generation);
+    hn4_result_t res    = _tensor_gather(vol, model_tag, shards, &count);
+
+    if (res == HN4_OK) res = _tman_store(vol, model_tag, shards, count, ns_gen);
+
+    hn4_hal_mem_free(shards);
+    return res;
+}
+
+void hn4_tensor_note_commit(
+    hn4_volume_t*       vol,
+    const hn4_anchor_t* anchor,
+    uint32_t            gen_from,
+    uint32_t            gen_to
+)
+{
+    if (vol->read_only) return;
+
+    uint64_t dclass = hn4_le64_to_cpu(anchor->data_class);
+    if (anchor->tag_filter == 0 || HN4_AI_TYPE_IS_AUX(dclass)) return;
+
+    char tag[256];
+    if (hn4_ns_get_name(vol, (hn4_anchor_t*)anchor, tag, sizeof(tag)) != HN4_OK || tag[0] == '\0') return;
+
+    hn4_anchor_t man;
+    bool indexed = (hn4_ns_get_anchor_by_id(vol, _tman_seed(tag), &man) == HN4_OK);
+
+    /* Untyped files index on request (hn4_tensor_build_manifest); weights index themselves */
+    if (!indexed && (dclass & HN4_AI_TYPE_MASK) != HN4_AI_TYPE_WEIGHTS) return;
+
+    hn4_anchor_t* shards = hn4_hal_mem_alloc(sizeof(hn4_anchor_t) * HN4_MAX_TENSOR_SHARDS);
+    if (!shards) return;
+
+    uint32_t count = 0;
+
+    if (!indexed || !_tman_load(vol, tag, gen_from, anchor, shards, &count)) {
+        /* Missing or stale: one rescan brings it current */
+        (void)hn4_tensor_build_manifest(vol, tag);
+        goto out;
+    }
+
+    uint64_t mask   = _ns_generate_tag_mask(tag, strlen(tag));
+    bool     member = (dclass & HN4_FLAG_VALID) && !(dclass & HN4_FLAG_TOMBSTONE) &&
+                      (hn4_le64_to_cpu(anchor->tag_filter) & mask) == mask;
+
+    uint32_t at = count;
+    for (uint32_t i = 0; i < count; i++) {
+        if (memcmp(&shards[i].seed_id, &anchor->seed_id, sizeof(hn4_u128_t)) == 0) at = i;
+    }
+
+    if (!member) {
+        if (at == count) goto out;
+        memmove(&shards[at], &shards[at + 1], (count - at - 1) * sizeof(hn4_anchor_t));
+        count--;
+    } else if (at == count) {
+        if (count + 1 >= HN4_MAX_TENSOR_SHARDS) goto out;
+        shards[count++] = *anchor;
+    }
+
+    if (count == 0) goto out;
+    qsort(shards, count, sizeof(hn4_anchor_t), _shard_cmp);
+    (void)_tman_store(vol, tag, shards, count, gen_to);
+
+out:
+    hn4_hal_mem_free(shards);
+}
+
 void hn4_tensor_close(hn4_tensor_ctx_t* ctx) 
 {
     if (ctx) {
@@ -416,6 +785,7 @@ void hn4_tensor_close(hn4_tensor_ctx_t* ctx)
         }
         if (ctx->shards)        hn4_hal_mem_free(ctx->shards);
         if (ctx->shard_offsets) hn4_hal_mem_free(ctx->shard_offsets);
+        hn4_readahead_destroy(ctx->ra);
         
         memset(ctx, 0xDD, sizeof(hn4_tensor_ctx_t));
         hn4_hal_mem_free(ctx);
@@ -426,6 +796,37 @@ void hn4_tensor_close(hn4_tensor_ctx_t* ctx)
  * 3. AI ACCELERATION: CONTEXT FREEZING
  * ========================================================================= */
 
+/*
+ * One block of a snapshot. Each job writes through its own copy of the
+ * Anchor: concurrent writes do not race on write_gen, and every block is
+ * stamped with the same generation.
+ */
+typedef struct {
+    hn4_volume_t*       vol;
+    hn4_anchor_t        anchor;
+    uint64_t            block_idx;
+    const uint8_t*      src;
+    uint32_t            len;
+    uint64_t            lba;        /* Allocated block, for rollback */
+    hn4_result_t        res;
+    _Atomic uint32_t    done;
+} _freeze_job_t;
+
+static void _freeze_job_run(void* arg)
+{
+    _freeze_job_t* j = (_freeze_job_t*)arg;
+
+    j->res = hn4_write_block_unsealed(j->vol, &j->anchor, j->block_idx, j->src, j->len,
+                                      HN4_PERM_SOVEREIGN | HN4_PERM_WRITE);
+    if (j->res != HN4_OK) return;
+
+    /* Capture actual allocated LBA for rollback */
+    j->lba = hn4_residency_lookup(j->vol, &j->anchor, j->block_idx);
+    if (j->lba == HN4_LBA_INVALID) {
+        j->lba = _resolve_residency_verified(j->vol, &j->anchor, j->block_idx);
+    }
+}
+
 _Check_return_
 hn4_result_t hn4_ai_freeze_context(
     HN4_IN hn4_volume_t* vol,
@@ -438,7 +839,9 @@ hn4_result_t hn4_ai_freeze_context(
     /* 
      * SAFETY CONTRACT:
      * This operation is Write-Atomic only at the final Anchor Commit.
-     * If a crash occurs during the write loop:
+     * Data blocks go out without per-block barriers; one barrier ahead of
+     * the commit makes all of them durable.
+     * If a crash occurs before the commit:
      * 1. Physical blocks allocated are leaked (orphaned).
      * 2. The Anchor is never written, so the file never technically exists.
      * 3. The Scavenger (Reaper) will reclaim leaked blocks via the Zero-Scan mechanism.
@@ -460,6 +863,29 @@ hn4_result_t hn4_ai_freeze_context(
         return HN4_ERR_ALIGNMENT_FAIL;
     }
 
+    uint32_t       payload_cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    uint64_t       n           = (len + payload_cap - 1) / payload_cap;
+    const uint8_t* ptr         = (const uint8_t*)kv_buffer;
+
+    if (n > SIZE_MAX / sizeof(_freeze_job_t)) return HN4_ERR_NOMEM;
+
+    _freeze_job_t* jobs = NULL;
+    if (n) {
+        jobs = hn4_hal_mem_alloc((size_t)n * sizeof(_freeze_job_t));
+        if (!jobs) return HN4_ERR_NOMEM;
+    }
+
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t off = i * payload_cap;
+
+        memset(&jobs[i], 0, sizeof(jobs[i]));
+        jobs[i].vol       = vol;
+        jobs[i].block_idx = i;
+        jobs[i].src       = ptr + off;
+        jobs[i].len       = (uint32_t)((len - off > payload_cap) ? payload_cap : len - off);
+        jobs[i].lba       = HN4_LBA_INVALID;
+    }
+
     /* 1. Anchor Construction */
     hn4_anchor_t anchor;
     memset(&anchor, 0, sizeof(anchor));
@@ -481,6 +907,8 @@ hn4_result_t hn4_ai_freeze_context(
     memcpy(anchor.orbit_vector, &v, 6);
     anchor.orbit_hints = hn4_cpu_to_le32(gpu_id); 
 
+    hn4_result_t res = HN4_OK;
+
     /* 
      * 1.5. SIGNET BRANDING (Provenance Enforcement - PRE-WRITE)
      * We must brand the anchor BEFORE writing data. 
@@ -494,11 +922,11 @@ hn4_result_t hn4_ai_freeze_context(
         memset(sig, 0xEE, 64); 
         memset(pub, 0xAA, 32);
 
-        hn4_result_t sig_res = hn4_signet_brand_anchor(vol, &anchor, author_id, sig, 64, pub);
+        res = hn4_signet_brand_anchor(vol, &anchor, author_id, sig, 64, pub);
         
-        if (sig_res != HN4_OK) {
-            HN4_LOG_CRIT("AI Freeze: Signet branding failed (%d). Aborting.", sig_res);
-            return sig_res; 
+        if (res != HN4_OK) {
+            HN4_LOG_CRIT("AI Freeze: Signet branding failed (%d). Aborting.", res);
+            goto rollback;
         }
         
         /* Mark Signed */
@@ -506,82 +934,79 @@ hn4_result_t hn4_ai_freeze_context(
         anchor.data_class = hn4_cpu_to_le64(dc | HN4_FLAG_SIGNED);
     }
 
-    /* 2. The Write Pipeline */
-    uint64_t lba_log[MAX_ROLLBACK_TRACK];
-    uint64_t remaining = len;
-    uint64_t offset = 0;
+    /* 2. The Write Pipeline: one job per block on the tensor workers */
+    hn4_hal_workq_t* q = _tensor_workq(vol);
 
-    const uint8_t* ptr = (const uint8_t*)kv_buffer;
+    for (uint64_t i = 0; i < n; i++) {
+        jobs[i].anchor = anchor;
+        hn4_hal_workq_submit(q, _freeze_job_run, &jobs[i], &jobs[i].done);
+    }
+    for (uint64_t i = 0; i < n; i++) hn4_hal_workq_wait(q, &jobs[i].done);
 
-    uint32_t bs = vol->vol_block_size;
-    uint32_t payload_cap = HN4_BLOCK_PayloadSize(bs); 
+    for (uint64_t i = 0; i < n && res == HN4_OK; i++) res = jobs[i].res;
+    if (res != HN4_OK) goto rollback;
 
-    uint64_t block_idx = 0;
-    hn4_result_t res = HN4_OK;
+    /* 3. The Wall: one barrier covers every block */
+    if (hn4_hal_barrier(vol->target_device) != HN4_OK) {
+        res = HN4_ERR_HW_IO;
+        goto rollback;
+    }
 
-    while (remaining > 0) {
-        /* FIX: Use payload_cap for comparison and assignment */
-        uint64_t chunk_64 = (remaining > payload_cap) ? payload_cap : remaining;
-        if (chunk_64 > UINT32_MAX) {
-            res = HN4_ERR_GEOMETRY;
-            goto rollback;
-        }
-        uint32_t chunk = (uint32_t)chunk_64;
-        
-        res = hn4_write_block_atomic(
-            vol, 
-            &anchor, 
-            block_idx, 
-            ptr + offset, 
-            chunk, 
-            HN4_PERM_SOVEREIGN | HN4_PERM_WRITE
-        );
-
-        if (res != HN4_OK) goto rollback;
-
-        /* Capture actual allocated LBA for immediate rollback if needed */
-        if (block_idx < MAX_ROLLBACK_TRACK) {
-             lba_log[block_idx] = _resolve_residency_verified(vol, &anchor, block_idx);
-        }
+    /* Fold the jobs' Anchor updates back, in block order */
+    uint32_t hints = hn4_le32_to_cpu(anchor.orbit_hints);
 
-        remaining -= chunk;
-        offset += chunk;
-        block_idx++;
+    for (uint64_t i = 0; i < n; i++) {
+        anchor.write_gen = jobs[i].anchor.write_gen;
+        anchor.mod_clock = jobs[i].anchor.mod_clock;
+
+        uint64_t c_idx = i >> 4;
+        if (c_idx < 16) {
+            uint32_t mask = 0x3U << (c_idx * 2);
+            hints = (hints & ~mask) | (hn4_le32_to_cpu(jobs[i].anchor.orbit_hints) & mask);
+        }
     }
+    anchor.orbit_hints = hn4_cpu_to_le32(hints);
 
-    /* 3. Final Commit */
-    return hn4_write_anchor_atomic(vol, &anchor);
+    /* 4. Final Commit */
+    res = hn4_write_anchor_atomic(vol, &anchor);
+
+    hn4_hal_mem_free(jobs);
+    return res;
 
 rollback:
     {
-        uint64_t rollback_limit = (block_idx < MAX_ROLLBACK_TRACK) ? block_idx : MAX_ROLLBACK_TRACK;
-        
+        /* The freed blocks must not be eclipsed by a retry under the same generation */
+        hn4_residency_forget(vol, &anchor);
+
         const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
         uint32_t sectors = vol->vol_block_size / caps->logical_block_size;
 
-        for (uint64_t r = 0; r < rollback_limit; r++) {
-            if (lba_log[r] != HN4_LBA_INVALID) {
+        for (uint64_t r = 0; r < n; r++) {
+            if (jobs[r].lba != HN4_LBA_INVALID) {
                 
                 #ifdef HN4_USE_128BIT
-                    hn4_u128_t blk = hn4_u128_from_u64(lba_log[r]);
+                    hn4_u128_t blk = hn4_u128_from_u64(jobs[r].lba);
                     hn4_addr_t phys = hn4_u128_mul_u64(blk, sectors);
                 #else
-                    hn4_addr_t phys = lba_log[r] * sectors;
+                    hn4_addr_t phys = jobs[r].lba * sectors;
                 #endif
 
                 hn4_free_block(vol, phys);
             }
         }
-        
-        if (block_idx >= MAX_ROLLBACK_TRACK) {
-            HN4_LOG_WARN("AI Freeze: Rollback log overflow (%llu blocks). Scavenger will reclaim.", 
-                         (unsigned long long)block_idx);
+
+        /* The Signet seal is unreachable too: the Anchor never lands */
+        if (hn4_le64_to_cpu(anchor.data_class) & HN4_FLAG_EXTENDED) {
+            uint64_t seal_idx;
+            memcpy(&seal_idx, anchor.inline_buffer, 8);
+            hn4_free_block(vol, hn4_addr_from_u64(hn4_le64_to_cpu(seal_idx) * sectors));
         }
     }
+
+    hn4_hal_mem_free(jobs);
     return res;
 }
 
-
 /* =========================================================================
  * 4. AI ACCELERATION: PRE-BAKED MANIFOLDS
  * ========================================================================= */
@@ -635,32 +1060,12 @@ hn4_result_t hn4_ai_persist_compute_graph(
     /* Mark as Signed */
     anchor.data_class = hn4_cpu_to_le64(hn4_le64_to_cpu(anchor.data_class) | HN4_FLAG_SIGNED);
 
-   /* Write Loop */
-    uint64_t remaining = blob_len;
-    uint64_t offset = 0;
-    const uint8_t* ptr = (const uint8_t*)binary_blob;
-    uint32_t bs = vol->vol_block_size;
-
-    uint32_t payload_cap = HN4_BLOCK_PayloadSize(bs);
-    uint64_t block_idx = 0;
-
-    while (remaining > 0) {
-
-        uint64_t chunk_64 = (remaining > payload_cap) ? payload_cap : remaining;
-        if (chunk_64 > UINT32_MAX) return HN4_ERR_GEOMETRY;
-
-        uint32_t chunk = (uint32_t)chunk_64;
-        
-        hn4_result_t res = hn4_write_block_atomic(
-            vol, &anchor, block_idx, ptr + offset, chunk, HN4_PERM_SOVEREIGN | HN4_PERM_WRITE
-        );
+   /* Write Loop (fresh Anchor: every block is a full replace, compression pipelined) */
+    hn4_result_t res = hn4_write_blocks_atomic(
+        vol, &anchor, 0, binary_blob, blob_len, HN4_PERM_SOVEREIGN | HN4_PERM_WRITE, NULL
+    );
 
-        if (res != HN4_OK) return res; 
-        
-        remaining -= chunk;
-        offset += chunk;
-        block_idx++;
-    }
+    if (res != HN4_OK) return res; 
 
     /* Final Persist (Commit Anchor) */
     return hn4_write_anchor_atomic(vol, &anchor);
@@ -819,9 +1224,12 @@ hn4_result_t hn4_ai_load_tensor_direct(
         /* 
          * Execute Read.
          * Tensor Logic handles sharding/RAID. HAL handles DMA.
-         * We chunk it by block_size to allow preemption.
+         * P2P goes one block at a time: the GPU context is per thread, so
+         * it must stay on this one. The CPU path hands hn4_tensor_read a
+         * Huge-Block per call, which it spreads over the tensor workers.
          */
-        uint64_t chunk = (remaining > ctx->block_size) ? ctx->block_size : remaining;
+        uint64_t step  = use_p2p ? ctx->block_size : HN4_AI_BLOCK_SIZE;
+        uint64_t chunk = (remaining > step) ? step : remaining;
         
         hn4_result_t res = hn4_tensor_read(ctx, global_offset, cursor, chunk);
 
@@ -16,6 +16,7 @@
 
 #include "hn4.h"
 #include "hn4_errors.h"
+#include "hn4_read.h"
 #include "hn4_annotations.h"
 
 
@@ -47,13 +48,35 @@ typedef struct {
     uint64_t      total_size_bytes; /* Exact logical size (Sum of masses) */
     uint32_t      block_size;       /* Cached volume block size */
     uint32_t      payload_cap;      /* Cached payload capacity per block */
+    hn4_readahead_t* ra;            /* Streaming window (NULL = synchronous) */
 } hn4_tensor_ctx_t;
 
+/*
+ * Tensor Manifest (block 0 of a MANIFEST Anchor).
+ * Starts with the generic hn4_manifest_header_t, whose entries[] list the
+ * shard seed_ids in stream order; one geometry record per shard follows
+ * the list. 'reserved' carries HN4_TMAN_MAGIC (low 32 bits) and the
+ * Superblock ns_generation at indexing time (high 32 bits).
+ */
+#define HN4_TMAN_MAGIC          0x4E414D54  /* "TMAN" */
+
+typedef struct HN4_PACKED {
+    uint64_t    offset;         /* Shard start in the stream */
+    uint64_t    mass;
+    uint32_t    write_gen;      /* Shard generation when indexed */
+    uint32_t    reserved;
+} hn4_tensor_manifest_geo_t;
+
 /**
  * hn4_tensor_open
  * 
- * Triggers a "Resonance Scan" to find all shards for a Model ID.
- * Sorts them by Seed ID and builds the cumulative geometry map.
+ * Loads the shard list from the tag's manifest: one hashed Cortex probe,
+ * then one probe per shard to check its generation and mass. A missing
+ * or stale manifest (a shard changed, or an Anchor joined, left or was
+ * renamed since indexing) falls back to a "Resonance Scan" of the Cortex,
+ * which sorts the shards by Seed ID. Open never writes: the manifest is
+ * kept by the commit path (hn4_tensor_note_commit) and
+ * hn4_tensor_build_manifest.
  * 
  * SAFETY: Enforces monotonicity of shard sizes. Zero-mass shards cause failure.
  * 
@@ -76,8 +99,12 @@ hn4_result_t hn4_tensor_open(
  * Handles variable shard sizes, boundary crossings, and payload unpacking.
  * 
  * PERFORMANCE:
- * - Allocates one bounce buffer per call (Hoisted).
  * - Uses Binary Search for shard lookup (LogN).
+ * - Ranges of HN4_TENSOR_PAR_MIN blocks or more are read concurrently on
+ *   the volume's tensor workers, across shards. Whole blocks decode straight
+ *   into 'buf'; only partial ones use a bounce buffer.
+ * - Shorter ranges are read on the caller's thread through the readahead
+ *   window.
  * 
  * @param ctx           Open tensor context.
  * @param global_offset Virtual byte offset (0 to total_size_bytes).
@@ -94,6 +121,36 @@ hn4_result_t hn4_tensor_read(
     HN4_IN  uint64_t len
 );
 
+/**
+ * hn4_tensor_build_manifest
+ * Rescans the Cortex for 'model_tag' and rewrites its manifest. Writers
+ * call it once the shards are on media, so the first open is already
+ * served from the index.
+ * @return HN4_OK, HN4_ERR_NOT_FOUND, HN4_ERR_ACCESS_DENIED (read-only),
+ *         HN4_ERR_TAG_OVERFLOW (list does not fit one block).
+ */
+_Check_return_
+hn4_result_t hn4_tensor_build_manifest(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN const char*   model_tag
+);
+
+/**
+ * hn4_tensor_note_commit
+ * Anchor commit hook (hn4_write_anchor_atomic). Folds the committed
+ * Anchor into the manifest of the tag it is named after, so shards keep
+ * their index current as they are written and hn4_tensor_open stays
+ * read-only. A stale index is rebuilt; a missing one only for
+ * HN4_AI_TYPE_WEIGHTS. 'gen_from' / 'gen_to' bracket the namespace
+ * generation move of this commit (equal if it did not move it).
+ */
+void hn4_tensor_note_commit(
+    HN4_IN hn4_volume_t*       vol,
+    HN4_IN const hn4_anchor_t* anchor,
+    HN4_IN uint32_t            gen_from,
+    HN4_IN uint32_t            gen_to
+);
+
 /**
  * hn4_tensor_close
  * Releases memory resources associated with the tensor context.
@@ -101,6 +158,31 @@ hn4_result_t hn4_tensor_read(
  */
 void hn4_tensor_close(hn4_tensor_ctx_t* ctx);
 
+/* =========================================================================
+ * CONTEXT SNAPSHOTS (KV CACHE / OPTIMIZER STATE)
+ * ========================================================================= */
+
+/**
+ * hn4_ai_freeze_context
+ *
+ * Writes 'len' bytes of a device-pinned context as a new signed snapshot
+ * tagged 'context_tag'. Blocks are written in parallel and made durable by
+ * one barrier ahead of the Anchor commit; a crash before the commit leaves
+ * no snapshot, only blocks for the Scavenger. Every freeze is a full,
+ * independent snapshot.
+ *
+ * @return HN4_OK, HN4_ERR_PROFILE_MISMATCH (non-AI volume),
+ *         HN4_ERR_GEOMETRY, HN4_ERR_ALIGNMENT_FAIL (2MB DMA alignment).
+ */
+_Check_return_
+hn4_result_t hn4_ai_freeze_context(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN const char*   context_tag,
+    HN4_IN const void*   kv_buffer,
+    HN4_IN uint64_t      len,
+    HN4_IN uint32_t      gpu_id
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,11 @@
 
 #include "hn4.h"
 #include "hn4_hal.h"
+#include "hn4_orbitmap.h"
+#include "hn4_compstat.h"
+#include "hn4_lexicon.h"
+#include "hn4_repair.h"
+#include "hn4_residency.h"
 #include "hn4_endians.h"
 #include "hn4_crc.h"
 #include "hn4_errors.h"
@@ -106,6 +111,8 @@ static hn4_result_t _broadcast_superblock(
     memcpy(cpu_sb, &vol->sb, sizeof(hn4_superblock_t));
 
     cpu_sb->info.last_mount_time = hn4_hal_get_time_ns();
+    cpu_sb->info.incompat_flags |= atomic_load(&vol->incompat_written);
+    cpu_sb->info.ns_generation   = atomic_load(&vol->ns_generation);
     
     if (bump_generation) {
         if (cpu_sb->info.copy_generation >= HN4_MAX_GENERATION) {
@@ -257,6 +264,10 @@ hn4_result_t hn4_unmount(HN4_INOUT hn4_volume_t* vol)
     }
 
     hn4_hal_device_t* dev = (hn4_hal_device_t*)vol->target_device;
+
+    /* Apply (or, when RO, discard) repairs the Scavenger has not reached */
+    hn4_repair_drain(vol);
+
     hn4_hal_barrier(dev);
 
     bool persistence_ok = true;
@@ -523,6 +534,12 @@ hn4_result_t hn4_unmount(HN4_INOUT hn4_volume_t* vol)
         #undef FREE_SAFE
         
         _safe_release_mem((void**)&vol->topo_map, topo_sz, false);
+        hn4_orbit_map_release(vol);
+        hn4_residency_release(vol);
+        hn4_compstat_release(vol);
+        hn4_lexicon_release(vol);
+        hn4_hal_workq_destroy(atomic_exchange(&vol->comp_workq, NULL));
+        hn4_hal_workq_destroy(atomic_exchange(&vol->tensor_workq, NULL));
 
         int status_code = (int)final_res;
         
@@ -22,6 +22,12 @@
 
 #include "hn4.h"
 #include "hn4_hal.h"
+#include "hn4_orbitmap.h"
+#include "hn4_residency.h"
+#include "hn4_compstat.h"
+#include "hn4_write.h"
+#include "hn4_compress.h"
+#include "hn4_lexicon.h"
 #include "hn4_crc.h"
 #include "hn4_swizzle.h"
 #include "hn4_ecc.h"
@@ -182,6 +188,7 @@ HN4_INLINE void _pack_header(hn4_block_header_t* h, hn4_u128_t id,
  * @param well_id       Target File ID (Anchor Seed).
  * @param logical_seq   Target Logical Block Index (N).
  * @param expected_gen  Current Write Generation of the Anchor.
+ * @param header_only   Read the header sector only (io_buf >= one sector).
  *
  * @return true if the block is a valid resident.
  */
@@ -191,7 +198,8 @@ static bool _verify_block_at_lba(
     HN4_IN void*         io_buf,
     HN4_IN hn4_u128_t    well_id,
     HN4_IN uint64_t      logical_seq,
-    HN4_IN uint64_t      expected_gen
+    HN4_IN uint64_t      expected_gen,
+    HN4_IN bool          header_only
 )
 {
     if (phys_blk_idx == HN4_LBA_INVALID) return false;
@@ -213,8 +221,8 @@ static bool _verify_block_at_lba(
 
     hn4_addr_t phys_lba = hn4_lba_from_blocks(phys_blk_idx * sectors);
 
-    /* 3. Read Verification */
-    if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, phys_lba, io_buf, sectors) != HN4_OK) {
+    /* 3. Read Verification (every check below is on the header) */
+    if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, phys_lba, io_buf, header_only ? 1 : sectors) != HN4_OK) {
         return false; /* Read error implies verification failed */
     }
 
@@ -317,7 +325,7 @@ uint64_t _resolve_residency_verified(
 
                 if (in_bounds) {
                     /* Pass Block Index to verification and output */
-                    if (_verify_block_at_lba(vol, linear_blk_idx, check_buf, my_well_id, block_idx, current_gen)) {
+                    if (_verify_block_at_lba(vol, linear_blk_idx, check_buf, my_well_id, block_idx, current_gen, false)) {
                         found_lba = linear_blk_idx;
                         goto Cleanup;
                     }
@@ -358,7 +366,7 @@ uint64_t _resolve_residency_verified(
     for (int i = 0; i < valid_count; i++) {
         uint64_t lba = candidates[i].lba;
         
-        if (_verify_block_at_lba(vol, lba, check_buf, my_well_id, block_idx, current_gen)) {
+        if (_verify_block_at_lba(vol, lba, check_buf, my_well_id, block_idx, current_gen, false)) {
             found_lba = lba;
             goto Cleanup;
         }
@@ -369,19 +377,226 @@ Cleanup:
     return found_lba;
 }
 
+/*
+ * _resolve_residency_replace
+ * Residency miss under HN4_WR_REPLACE. Only the old block's address is
+ * needed (to eclipse it), not its payload, so each candidate costs its
+ * header sector instead of a full block. The recorded orbit goes first.
+ * A block past the file's mass was never written and costs nothing.
+ */
+static uint64_t _resolve_residency_replace(
+    HN4_IN hn4_volume_t* vol,
+    HN4_IN hn4_anchor_t* anchor,
+    HN4_IN uint64_t      block_idx
+)
+{
+    uint32_t payload_cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    uint64_t mass        = hn4_le64_to_cpu(anchor->mass);
+
+    if (block_idx >= (mass + payload_cap - 1) / payload_cap) return HN4_LBA_INVALID;
+
+    /* Horizon files have a single candidate */
+    if (hn4_le64_to_cpu(anchor->data_class) & HN4_HINT_HORIZON) {
+        return _resolve_residency_verified(vol, anchor, block_idx);
+    }
+
+    const hn4_hal_caps_t* caps = hn4_hal_get_caps(vol->target_device);
+    void* hdr_buf = hn4_hal_mem_alloc(caps->logical_block_size);
+    if (!hdr_buf) return _resolve_residency_verified(vol, anchor, block_idx);
+
+    uint64_t G = hn4_le64_to_cpu(anchor->gravity_center);
+
+    const uint8_t* raw_v = anchor->orbit_vector;
+    uint64_t V = (uint64_t)raw_v[0] |
+                 ((uint64_t)raw_v[1] << 8)  |
+                 ((uint64_t)raw_v[2] << 16) |
+                 ((uint64_t)raw_v[3] << 24) |
+                 ((uint64_t)raw_v[4] << 32) |
+                 ((uint64_t)raw_v[5] << 40);
+
+    uint16_t   M    = hn4_le16_to_cpu(anchor->fractal_scale);
+    hn4_u128_t well = hn4_le128_to_cpu(anchor->seed_id);
+    uint64_t   gen  = (uint64_t)hn4_le32_to_cpu(anchor->write_gen);
+
+    /* Same hint source as the Read Path: orbit_hints, then the Orbit Map */
+    uint64_t cluster = block_idx >> 4;
+    int hint = (cluster < 16)
+             ? (int)((hn4_le32_to_cpu(anchor->orbit_hints) >> (uint32_t)(cluster * 2)) & 0x3u)
+             : hn4_orbit_map_lookup(vol, anchor, block_idx);
+
+    uint64_t found_lba = HN4_LBA_INVALID;
+
+    for (int i = -1; i < HN4_ORBIT_LIMIT; i++) {
+        int k = (i < 0) ? hint : i;
+        if (k < 0 || (i >= 0 && k == hint)) continue;
+
+        uint64_t lba = _calc_trajectory_lba(vol, G, V, block_idx, M, (uint8_t)k);
+        if (_verify_block_at_lba(vol, lba, hdr_buf, well, block_idx, gen, true)) {
+            found_lba = lba;
+            break;
+        }
+    }
+
+    hn4_hal_mem_free(hdr_buf);
+    return found_lba;
+}
+
 /* =========================================================================
  * CORE WRITE LOGIC
  * ========================================================================= */
 
-_Check_return_ hn4_result_t hn4_write_block_atomic(
+/*
+ * Compression Job
+ * One block compressed ahead of its write by the pipeline
+ * (hn4_write_blocks_atomic). 'done' is set by the work queue.
+ */
+typedef struct {
+    const void*         src;
+    uint32_t            len;
+    void*               out;        /* hn4_compress_bound(payload) bytes */
+    uint32_t            out_len;
+    uint32_t            dev_type;   /* Volume's compressor tuning */
+    uint64_t            hw_flags;
+    uint32_t            tcc_flags;  /* Profile's encoder options */
+    const hn4_tcc_lexicon_t* lex;   /* Trained lexicon, or NULL */
+    uint8_t             filter;     /* Shuffle pre-filter, 0 = none */
+    bool                attempted;  /* false: Compression Advisor said skip */
+    uint64_t            ns;         /* Time spent in TCC */
+    hn4_result_t        res;
+    _Atomic uint32_t    done;
+} _comp_job_t;
+
+/*
+ * _write_wants_compress
+ * ARCHIVE always tries; otherwise only on HINT_COMPRESSED. Never for
+ * encrypted data: the Read Path rejects blocks marked both Encrypted and
+ * Compressed (compression-oracle defence).
+ */
+static bool _write_wants_compress(hn4_volume_t* vol, uint64_t dclass)
+{
+    if (dclass & HN4_HINT_ENCRYPTED) return false;
+    if (vol->sb.info.format_profile == HN4_PROFILE_ARCHIVE) return true;
+    return (dclass & HN4_HINT_COMPRESSED) != 0;
+}
+
+/*
+ * _write_tcc_flags
+ * ARCHIVE trades encoder CPU for ratio (entropy-coded literals). Every
+ * other profile keeps the fast path; GAMING and AI read far more than
+ * they write and pay the decode on every read.
+ */
+static uint32_t _write_tcc_flags(hn4_volume_t* vol)
+{
+    return (vol->sb.info.format_profile == HN4_PROFILE_ARCHIVE) ? HN4_TCC_ENTROPY : 0;
+}
+
+/*
+ * _write_filter
+ * Shuffle filter byte for files that declare an element width (tensors,
+ * numeric arrays), 0 for everything else.
+ */
+static uint8_t _write_filter(uint64_t dclass)
+{
+    uint32_t code = (uint32_t)((dclass & HN4_HINT_ELEM_MASK) >> HN4_HINT_ELEM_SHIFT);
+    if (code == 0) return 0;
+
+    uint8_t filter = (uint8_t)(1U << code);     /* 2, 4, 8 bytes */
+    if (dclass & HN4_HINT_BITSHUFFLE) filter |= HN4_SHUF_BITS;
+    return filter;
+}
+
+/*
+ * _write_compress
+ * TCC, behind the shuffle filter when there is one. A filtered result is
+ * [Filter] [TCC of the planes] and is stored as HN4_COMP_TCC_SHUFFLE.
+ */
+static hn4_result_t _write_compress(
+    const void*              src,
+    uint32_t                 len,
+    uint8_t*                 out,
+    uint32_t                 cap,
+    uint32_t*                out_len,
+    uint32_t                 dev_type,
+    uint64_t                 hw_flags,
+    uint32_t                 tcc_flags,
+    const hn4_tcc_lexicon_t* lex,
+    uint8_t                  filter
+)
+{
+    if (!filter) {
+        return hn4_compress_block_ex(src, len, out, cap, out_len, dev_type, hw_flags, tcc_flags, lex);
+    }
+
+    void* planes = hn4_hal_mem_alloc(len);
+    if (!planes) return HN4_ERR_NOMEM;
+
+    hn4_result_t res = HN4_ERR_INVALID_ARGUMENT;
+    if (cap > 1 && hn4_shuffle(src, planes, len, filter)) {
+        out[0] = filter;
+        res = hn4_compress_block_ex(planes, len, out + 1, cap - 1, out_len, dev_type, hw_flags, tcc_flags, lex);
+        if (res == HN4_OK) (*out_len)++;
+    }
+
+    hn4_hal_mem_free(planes);
+    return res;
+}
+
+/*
+ * _write_note_incompat
+ * Raises the incompat bits for encodings in a payload about to be stored
+ * that older drivers cannot decode. They reach media with the next
+ * Superblock persist (incompat_written). Once every bit is set the
+ * stream is no longer walked.
+ */
+static void _write_note_incompat(hn4_volume_t* vol, const uint8_t* payload, uint32_t len, uint32_t algo)
+{
+    const uint64_t tracked = HN4_INCOMPAT_TCC_ECHO | HN4_INCOMPAT_TCC_ENTROPY | HN4_INCOMPAT_TCC_SHUFFLE;
+    uint64_t have = atomic_load_explicit(&vol->incompat_written, memory_order_relaxed);
+    if ((have & tracked) == tracked) return;
+
+    uint64_t bits = 0;
+    if (algo == HN4_COMP_TCC_SHUFFLE) {
+        bits |= HN4_INCOMPAT_TCC_SHUFFLE;
+        payload++;
+        len--;
+    }
+
+    uint32_t uses = hn4_tcc_stream_features(payload, len);
+    if (uses & HN4_TCC_USES_ECHO)    bits |= HN4_INCOMPAT_TCC_ECHO;
+    if (uses & HN4_TCC_USES_ENTROPY) bits |= HN4_INCOMPAT_TCC_ENTROPY;
+
+    if (bits & ~have) atomic_fetch_or(&vol->incompat_written, bits);
+}
+
+/* _write_block_core modes */
+#define HN4_WR_REPLACE      0x1U    /* 'data' is the whole new payload */
+#define HN4_WR_NO_WALL      0x2U    /* Caller issues the barrier before publishing */
+
+/*
+ * _write_block_core
+ * HN4_WR_REPLACE is the caller's assertion that 'data' is the whole new
+ * payload of the block (bytes past 'len' are zero). Nothing of the old
+ * block survives, so there is no Thaw and no full-block verification
+ * read: the previous residency comes from the RAM cache, or on a miss
+ * from a header-only probe (_resolve_residency_replace). Appends past the
+ * file's mass skip the probe.
+ *
+ * HN4_WR_NO_WALL skips the per-block barrier. Only for blocks no published
+ * Anchor can reach yet: the caller flushes once before the Anchor commit.
+ */
+static hn4_result_t _write_block_core(
     HN4_IN hn4_volume_t* vol,
     HN4_INOUT hn4_anchor_t* anchor,
     HN4_IN uint64_t block_idx,
     HN4_IN const void* data,
     HN4_IN uint32_t len,
-    HN4_IN uint32_t session_perms /* Delegated rights */
+    HN4_IN uint32_t session_perms, /* Delegated rights */
+    HN4_IN uint32_t mode,          /* HN4_WR_* */
+    HN4_IN const _comp_job_t* pre  /* Payload already compressed, or NULL */
 )
 {
+    bool replace = (mode & HN4_WR_REPLACE) != 0;
+
     HN4_LOG_CRIT("WRITE_ATOMIC: Enter. Vol=%p Block=%llu Len=%u", vol, (unsigned long long)block_idx, len);
 
    /* 1. Pointer & Geometry Checks (Must be explicit) */
@@ -478,14 +693,20 @@ retry_transaction:;
 
     /*
      * PHASE 0: RESIDENCY RESOLUTION
-     * Locate the previous block (if any) so we can eclipse it later.
+     * Locate the previous block (if any) so we can eclipse it later. A
+     * residency hit from the last read/write of this block under the same
+     * generation skips the orbit probe and its verification read.
      */
-    uint64_t old_lba = _resolve_residency_verified(vol, anchor, block_idx);
+    uint64_t old_lba = hn4_residency_lookup(vol, anchor, block_idx);
+    if (old_lba == HN4_LBA_INVALID) {
+        old_lba = replace ? _resolve_residency_replace(vol, anchor, block_idx)
+                          : _resolve_residency_verified(vol, anchor, block_idx);
+    }
     
     uint64_t mass = hn4_le64_to_cpu(anchor->mass);
     uint64_t logical_end = block_idx * payload_cap + len;
     
-    if (old_lba == HN4_LBA_INVALID && len < payload_cap && logical_end < mass) {
+    if (!replace && old_lba == HN4_LBA_INVALID && len < payload_cap && logical_end < mass) {
         HN4_LOG_CRIT("WRITE_ATOMIC: Partial write on missing block (Rot/Lost). Aborting.");
         /* No buffers allocated yet, safe to return */
         return HN4_ERR_DATA_ROT;
@@ -510,8 +731,9 @@ retry_transaction:;
     /* 
      * THAW PROTOCOL (Spec 20.5): 
      * If overwriting a block partially, we must Read-Modify-Write to preserve data.
+     * A full replace has nothing to preserve.
      */
-    if (old_lba != HN4_LBA_INVALID && len < payload_cap) {
+    if (!replace && old_lba != HN4_LBA_INVALID && len < payload_cap) {
         void* thaw_buf = hn4_hal_mem_alloc(bs);
         
          if (HN4_UNLIKELY(!thaw_buf)) {
@@ -563,10 +785,28 @@ retry_transaction:;
         uint8_t algo  = meta & HN4_COMP_ALGO_MASK;
         uint32_t csz  = meta >> HN4_COMP_SIZE_SHIFT;
         
-        if (algo == HN4_COMP_TCC) {
+        if (algo == HN4_COMP_TCC || algo == HN4_COMP_TCC_SHUFFLE) {
              uint32_t out_sz = 0;
-             hn4_result_t d_res = hn4_decompress_block(old_hdr->payload, csz, new_hdr_view->payload, payload_cap, &out_sz);
-             
+             const uint8_t* stream = old_hdr->payload;
+             uint8_t filter = 0;
+             void* planes = NULL;
+
+             if (algo == HN4_COMP_TCC_SHUFFLE && csz > 0) {
+                 filter = *stream++;
+                 csz--;
+                 planes = hn4_hal_mem_alloc(payload_cap);
+             }
+
+             hn4_result_t d_res = HN4_ERR_NOMEM;
+             if (algo == HN4_COMP_TCC || planes) {
+                 d_res = hn4_decompress_block_ex(stream, csz, planes ? planes : new_hdr_view->payload, payload_cap,
+                                                 &out_sz, hn4_lexicon_get(vol, hn4_tcc_stream_lexicon(stream, csz)));
+             }
+             if (d_res == HN4_OK && planes && !hn4_unshuffle(planes, new_hdr_view->payload, out_sz, filter)) {
+                 d_res = HN4_ERR_DATA_ROT;
+             }
+             hn4_hal_mem_free(planes);
+
              if (d_res != HN4_OK) {
                  hn4_hal_mem_free(thaw_buf);
                  hn4_hal_mem_free(io_buf);
@@ -590,21 +830,7 @@ retry_transaction:;
      * - HYPER_CLOUD: Never speculate. Only compress if HINT_COMPRESSED is explicitly set.
      *   (Server workloads are often already compressed/encrypted; avoiding the CPU hit boosts IOPS).
      */
-     bool try_compress = (dclass & HN4_HINT_COMPRESSED);
-    
-    if (vol->sb.info.format_profile == HN4_PROFILE_ARCHIVE) {
-        try_compress = true;
-    }
-
-    /* 
-     * SAFETY FIX: Mutual Exclusion.
-     * Encrypted data (high entropy) is incompressible. 
-     * Furthermore, the Read Path (_validate_block) explicitly rejects blocks 
-     * marked as both Encrypted and Compressed to prevent compression-oracle attacks.
-     */
-    if (dclass & HN4_HINT_ENCRYPTED) {
-        try_compress = false;
-    }
+    bool try_compress = _write_wants_compress(vol, dclass);
 
     /* 
      * If this is an Overwrite (old_lba valid), do NOT re-compress immediately.
@@ -617,42 +843,73 @@ retry_transaction:;
     if (try_compress && len > 128) {
         /* Calculate worst-case bound */
         uint32_t bound = hn4_compress_bound(len);
-        void* comp_scratch = hn4_hal_mem_alloc(bound);
-
-        if (comp_scratch) {
-            uint32_t comp_size = 0;
-
-            /* Attempt Compression */
-            hn4_result_t c_res = hn4_compress_block(
-                data,
-                len,
-                comp_scratch,
-                bound,
-                &comp_size,
-                vol->sb.info.device_type_tag, /* e.g. HN4_DEV_HDD */
-                vol->sb.info.hw_caps_flags    /* e.g. HN4_HW_NVM */
-            );
+        void* comp_scratch = NULL;
+        const void* comp_out = NULL;
+        uint32_t comp_size = 0;
+        hn4_result_t c_res = HN4_ERR_NOMEM;
+
+        bool attempted = false;
+        uint8_t filter = _write_filter(dclass);
+        uint64_t comp_ns = 0;
+
+        if (pre && pre->src == data && pre->len == len) {
+            /* Pipeline already did the work (or the advisor vetoed it) on submit */
+            attempted = pre->attempted;
+            comp_out  = pre->out;
+            comp_size = pre->out_len;
+            comp_ns   = pre->ns;
+            c_res     = pre->res;
+            filter    = pre->filter;
+        } else if (hn4_compstat_should_try(vol, anchor)) {
+            comp_scratch = hn4_hal_mem_alloc(bound);
+            
+            if (comp_scratch) {
+                /* Attempt Compression */
+                hn4_time_t t0 = hn4_hal_get_time_ns();
+                c_res = _write_compress(
+                    data,
+                    len,
+                    comp_scratch,
+                    bound,
+                    &comp_size,
+                    vol->sb.info.device_type_tag, /* e.g. HN4_DEV_HDD */
+                    vol->sb.info.hw_caps_flags,   /* e.g. HN4_HW_NVM */
+                    _write_tcc_flags(vol),
+                    hn4_lexicon_active(vol),
+                    filter
+                );
+                comp_ns   = (uint64_t)(hn4_hal_get_time_ns() - t0);
+                comp_out  = comp_scratch;
+                attempted = true;
+            }
+        }
 
-            /*
-             * Evaluation:
-             * - Must fit in payload_cap.
-             * - Must be efficient (comp_size < len).
-             * - Must succeed.
-             */
-            if (c_res == HN4_OK && comp_size < payload_cap && comp_size < len) {
-                /* SUCCESS: Commit compressed data */
-                memcpy(hdr->payload, comp_scratch, comp_size);
+        /* Feed the per-file policy: what we stored for the CPU we spent */
+        if (attempted) {
+            bool fits = (c_res == HN4_OK && comp_size < payload_cap && comp_size < len);
+            hn4_compstat_record(vol, anchor, len, fits ? comp_size : len, comp_ns);
+        }
 
-                /* Zero-fill remainder of payload slot is handled by memset(io_buf, 0) above */
+        /*
+         * Evaluation:
+         * - Must fit in payload_cap.
+         * - Must be efficient (comp_size < len).
+         * - Must succeed.
+         */
+        if (c_res == HN4_OK && comp_size < payload_cap && comp_size < len) {
+            /* SUCCESS: Commit compressed data */
+            memcpy(hdr->payload, comp_out, comp_size);
 
-                final_algo = HN4_COMP_TCC;
-                stored_len = comp_size; /* Store compressed size in meta */
-                HN4_LOG_CRIT("WRITE_ATOMIC: Compression Success. %u -> %u bytes.", len, comp_size);
-            }
-            /* ELSE: Fallback to Raw (Implicit) */
+            /* Zero-fill remainder of payload slot is handled by memset(io_buf, 0) above */
 
-            hn4_hal_mem_free(comp_scratch);
+            final_algo = filter ? HN4_COMP_TCC_SHUFFLE : HN4_COMP_TCC;
+            stored_len = comp_size; /* Store compressed size in meta */
+            _write_note_incompat(vol, hdr->payload, comp_size, final_algo);
+            HN4_LOG_CRIT("WRITE_ATOMIC: Compression Success. %u -> %u bytes.", len, comp_size);
         }
+        /* ELSE: Fallback to Raw (Implicit) */
+
+        hn4_hal_mem_free(comp_scratch);
     }
 
     /* Fallback: If compression failed/skipped, copy raw */
@@ -801,6 +1058,9 @@ retry_transaction:;
                     anchor->orbit_hints = hn4_cpu_to_le32(hints);
                 }
 
+                /* Beyond the hint range the per-file Orbit Map takes over */
+                hn4_orbit_map_record(vol, anchor, block_idx, k);
+
                 break;
             }
         }
@@ -1124,7 +1384,7 @@ retry_transaction:;
 
     /* 8. The Wall (Data Persistence Barrier) */
 
-    bool skip_barrier = false;
+    bool skip_barrier = (mode & HN4_WR_NO_WALL) != 0;
 
     /* NVM Optimization */
     if (vol->sb.info.hw_caps_flags & HN4_HW_NVM) skip_barrier = true;
@@ -1201,9 +1461,12 @@ retry_transaction:;
         goto retry_transaction;
     }
 
-    uint64_t now_le = hn4_cpu_to_le64(hn4_hal_get_time_ns());
+    uint64_t now_le = hn4_cpu_to_le64(hn4_hal_get_vol_tick(vol));
     atomic_store((_Atomic uint64_t*)&anchor->mod_clock, now_le);
 
+    /* The next overwrite of this block eclipses 'target_lba' without a probe */
+    hn4_residency_note(vol, anchor, block_idx, target_lba);
+
     /* 10. THE ECLIPSE (Atomic Discard of Old LBA) */
     if (old_lba != HN4_LBA_INVALID && old_lba != target_lba) {
         /* Barrier: Ensure the Anchor update (Step 9) is visible before freeing old space */
@@ -1219,3 +1482,212 @@ retry_transaction:;
     hn4_hal_mem_free(io_buf);
     return HN4_OK;
 }
+
+_Check_return_ hn4_result_t hn4_write_block_atomic(
+    HN4_IN hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor,
+    HN4_IN uint64_t block_idx,
+    HN4_IN const void* data,
+    HN4_IN uint32_t len,
+    HN4_IN uint32_t session_perms /* Delegated rights */
+)
+{
+    return _write_block_core(vol, anchor, block_idx, data, len, session_perms, 0, NULL);
+}
+
+/**
+ * hn4_write_block_replace
+ * Full-block overwrite. The caller asserts 'data' replaces the entire
+ * payload of 'block_idx' (a short 'len' zero-fills the tail). Skips the
+ * Thaw read and the old payload CRC. A cached residency makes the
+ * overwrite one device write; otherwise the old block is found by its
+ * header sector alone.
+ */
+_Check_return_ hn4_result_t hn4_write_block_replace(
+    HN4_IN hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor,
+    HN4_IN uint64_t block_idx,
+    HN4_IN const void* data,
+    HN4_IN uint32_t len,
+    HN4_IN uint32_t session_perms /* Delegated rights */
+)
+{
+    return _write_block_core(vol, anchor, block_idx, data, len, session_perms, HN4_WR_REPLACE, NULL);
+}
+
+/**
+ * hn4_write_block_unsealed
+ * hn4_write_block_replace without the per-block barrier, for blocks of an
+ * Anchor that is not on media yet. The caller must issue hn4_hal_barrier()
+ * before writing the Anchor that makes them reachable.
+ */
+_Check_return_ hn4_result_t hn4_write_block_unsealed(
+    HN4_IN hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor,
+    HN4_IN uint64_t block_idx,
+    HN4_IN const void* data,
+    HN4_IN uint32_t len,
+    HN4_IN uint32_t session_perms /* Delegated rights */
+)
+{
+    return _write_block_core(vol, anchor, block_idx, data, len, session_perms,
+                             HN4_WR_REPLACE | HN4_WR_NO_WALL, NULL);
+}
+
+/* =========================================================================
+ * COMPRESSION PIPELINE (MULTI-BLOCK WRITES)
+ * ========================================================================= */
+
+/*
+ * While the caller thread writes block N, workers compress N+1 .. N+depth.
+ * The job ring bounds the blocks in flight: a slot is only refilled once
+ * its block has been written (back-pressure on a slow device), and the
+ * work queue blocks submitters when every worker is busy (back-pressure on
+ * a slow CPU).
+ */
+#define HN4_COMP_PIPE_WORKERS   4
+#define HN4_COMP_PIPE_DEPTH     (2 * HN4_COMP_PIPE_WORKERS)
+
+static void _comp_job_run(void* arg)
+{
+    _comp_job_t* job = (_comp_job_t*)arg;
+    job->out_len = 0;
+    job->ns = 0;
+    job->res = HN4_ERR_INVALID_ARGUMENT;
+
+    if (job->attempted && job->len > 128) {
+        hn4_time_t t0 = hn4_hal_get_time_ns();
+        job->res = _write_compress(job->src, job->len, job->out,
+                                   hn4_compress_bound(job->len), &job->out_len,
+                                   job->dev_type, job->hw_flags, job->tcc_flags, job->lex, job->filter);
+        job->ns = (uint64_t)(hn4_hal_get_time_ns() - t0);
+    }
+}
+
+/*
+ * Volume's compression workers. NULL on bare metal. One CPU still gets a
+ * worker: it compresses while the caller sleeps on device I/O.
+ */
+static hn4_hal_workq_t* _comp_workq(hn4_volume_t* vol)
+{
+    hn4_hal_workq_t* q = atomic_load_explicit(&vol->comp_workq, memory_order_acquire);
+    if (q) return q;
+
+    uint32_t cpus = hn4_hal_cpu_count();
+    uint32_t workers = (cpus > 1) ? cpus - 1 : 1;
+    if (workers > HN4_COMP_PIPE_WORKERS) workers = HN4_COMP_PIPE_WORKERS;
+
+    q = hn4_hal_workq_create(workers, HN4_COMP_PIPE_DEPTH);
+    if (!q) return NULL;
+
+    hn4_hal_workq_t* expected = NULL;
+    if (!atomic_compare_exchange_strong(&vol->comp_workq, &expected, q)) {
+        hn4_hal_workq_destroy(q);
+        q = expected;
+    }
+    return q;
+}
+
+/**
+ * hn4_write_blocks_atomic
+ * Writes 'len' bytes as consecutive blocks starting at 'block_idx'. Every
+ * block is replaced outright (see hn4_write_block_replace); a short final
+ * block is zero-filled. When the file compresses, block N+1 is compressed
+ * on a worker while block N is written. Stops at the first failure;
+ * 'out_blocks' (optional) receives the number of blocks committed.
+ */
+_Check_return_ hn4_result_t hn4_write_blocks_atomic(
+    HN4_IN hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor,
+    HN4_IN uint64_t block_idx,
+    HN4_IN const void* data,
+    HN4_IN uint64_t len,
+    HN4_IN uint32_t session_perms,
+    HN4_OUT_OPT uint64_t* out_blocks
+)
+{
+    if (out_blocks) *out_blocks = 0;
+    if (HN4_UNLIKELY(!vol || !anchor || (!data && len))) return HN4_ERR_INVALID_ARGUMENT;
+
+    uint32_t payload_cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    if (HN4_UNLIKELY(payload_cap == 0)) return HN4_ERR_GEOMETRY;
+
+    uint64_t n = (len + payload_cap - 1) / payload_cap;
+    if (n == 0) return HN4_OK;
+    if (HN4_UNLIKELY(block_idx > UINT64_MAX - n)) return HN4_ERR_INVALID_ARGUMENT;
+
+    const uint8_t* src = (const uint8_t*)data;
+    uint64_t dclass = hn4_le64_to_cpu(anchor->data_class);
+
+    hn4_hal_workq_t* q = NULL;
+    _comp_job_t* jobs = NULL;
+    uint8_t* arena = NULL;
+    uint32_t bound = hn4_compress_bound(payload_cap);
+
+    if (n > 1 && _write_wants_compress(vol, dclass)) {
+        q = _comp_workq(vol);
+    }
+
+    if (q) {
+        jobs  = hn4_hal_mem_alloc(HN4_COMP_PIPE_DEPTH * sizeof(_comp_job_t));
+        arena = hn4_hal_mem_alloc((size_t)HN4_COMP_PIPE_DEPTH * bound);
+        if (!jobs || !arena) {
+            hn4_hal_mem_free(jobs);
+            hn4_hal_mem_free(arena);
+            jobs = NULL;
+            arena = NULL;
+        }
+    }
+
+    uint64_t submitted = 0;
+    uint64_t i = 0;
+    hn4_result_t res = HN4_OK;
+
+    for (; i < n; i++) {
+        uint64_t off   = i * payload_cap;
+        uint32_t chunk = (len - off > payload_cap) ? payload_cap : (uint32_t)(len - off);
+        _comp_job_t* job = NULL;
+
+        if (jobs) {
+            /* Keep the ring full: blocks i .. i + depth - 1 are queued */
+            while (submitted < n && submitted < i + HN4_COMP_PIPE_DEPTH) {
+                _comp_job_t* j = &jobs[submitted % HN4_COMP_PIPE_DEPTH];
+                uint64_t j_off = submitted * payload_cap;
+                
+                j->src = src + j_off;
+                j->len = (len - j_off > payload_cap) ? payload_cap : (uint32_t)(len - j_off);
+                j->out = arena + (submitted % HN4_COMP_PIPE_DEPTH) * bound;
+                j->dev_type = vol->sb.info.device_type_tag;
+                j->hw_flags = vol->sb.info.hw_caps_flags;
+                j->tcc_flags = _write_tcc_flags(vol);
+                j->lex = hn4_lexicon_active(vol);
+                j->filter = _write_filter(dclass);
+                j->attempted = (j->len > 128) && hn4_compstat_should_try(vol, anchor);
+
+                /* A vetoed block completes inline; no worker round trip */
+                hn4_hal_workq_submit(j->attempted ? q : NULL, _comp_job_run, j, &j->done);
+                submitted++;
+            }
+
+            job = &jobs[i % HN4_COMP_PIPE_DEPTH];
+            hn4_hal_workq_wait(q, &job->done);
+        }
+
+        res = _write_block_core(vol, anchor, block_idx + i, src + off, chunk,
+                                session_perms, HN4_WR_REPLACE, job);
+        if (res != HN4_OK) break;
+
+        if (out_blocks) *out_blocks = i + 1;
+    }
+
+    /* Jobs still owned by workers must finish before the ring is freed */
+    if (jobs) {
+        for (uint64_t k = (i < n) ? i + 1 : n; k < submitted; k++) {
+            hn4_hal_workq_wait(q, &jobs[k % HN4_COMP_PIPE_DEPTH].done);
+        }
+        hn4_hal_mem_free(arena);
+        hn4_hal_mem_free(jobs);
+    }
+
+    return res;
+}
@@ -0,0 +1,81 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      Atomic Write Pipeline
+ * HEADER:      hn4_write.h
+ * STATUS:      HARDENED / PRODUCTION (v26.4)
+ * COPYRIGHT:   (c) 2026 The Hydra-Nexus Team.
+ *
+ * DESCRIPTION:
+ * Shadow-hop block writes (hn4_write.c). Every entry point writes the new
+ * block to a free orbit, commits the Anchor in RAM and eclipses the old
+ * block; the caller persists the Anchor (hn4_write_anchor_atomic).
+ *
+ * hn4_write_block_atomic() itself is not prototyped here: older callers
+ * still use it without the 'session_perms' argument.
+ */
+
+#ifndef HN4_WRITE_H
+#define HN4_WRITE_H
+
+#include "hn4.h"
+#include "hn4_errors.h"
+#include "hn4_annotations.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * hn4_write_block_replace
+ * Full-block overwrite: 'data' is the whole new payload, a short 'len'
+ * zero-fills the tail. No Thaw read; a residency miss is resolved from
+ * the old block's header sector.
+ */
+_Check_return_
+hn4_result_t hn4_write_block_replace(
+    HN4_IN    hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor,
+    HN4_IN    uint64_t      block_idx,
+    HN4_IN    const void*   data,
+    HN4_IN    uint32_t      len,
+    HN4_IN    uint32_t      session_perms
+);
+
+/**
+ * hn4_write_block_unsealed
+ * hn4_write_block_replace without the per-block barrier, for blocks of an
+ * Anchor that is not on media yet. The caller issues hn4_hal_barrier()
+ * before writing the Anchor that makes them reachable.
+ */
+_Check_return_
+hn4_result_t hn4_write_block_unsealed(
+    HN4_IN    hn4_volume_t* vol,
+    HN4_INOUT hn4_anchor_t* anchor,
+    HN4_IN    uint64_t      block_idx,
+    HN4_IN    const void*   data,
+    HN4_IN    uint32_t      len,
+    HN4_IN    uint32_t      session_perms
+);
+
+/**
+ * hn4_write_blocks_atomic
+ * Writes 'len' bytes as consecutive replaced blocks from 'block_idx'.
+ * Compression of block N+1 overlaps the write of block N. Stops at the
+ * first failure; 'out_blocks' (optional) receives the blocks committed.
+ */
+_Check_return_
+hn4_result_t hn4_write_blocks_atomic(
+    HN4_IN      hn4_volume_t* vol,
+    HN4_INOUT   hn4_anchor_t* anchor,
+    HN4_IN      uint64_t      block_idx,
+    HN4_IN      const void*   data,
+    HN4_IN      uint64_t      len,
+    HN4_IN      uint32_t      session_perms,
+    HN4_OUT_OPT uint64_t*     out_blocks
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HN4_WRITE_H */
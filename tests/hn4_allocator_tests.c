@@ -9629,6 +9629,36 @@ hn4_TEST(Topology, Hop_Lie_Reroute) {
     cleanup_alloc_fixture(vol);
 }
 
+/*
+ * Test 11b: CPU Caller NUMA Slice
+ * RATIONALE:
+ * A thread with no accelerator context is biased to the slice tagged with
+ * its NUMA node, so its allocations land on node-local media.
+ */
+hn4_TEST(Topology, Cpu_Caller_Numa_Slice) {
+    hn4_volume_t* vol = create_alloc_fixture();
+    vol->sb.info.format_profile = HN4_PROFILE_AI;
+
+    /* Window [5000, 5512) for this thread's node */
+    vol->topo_count = 1;
+    vol->topo_map = hn4_hal_mem_alloc(sizeof(*vol->topo_map));
+    vol->topo_map[0].gpu_id = HN4_TOPO_NUMA_TAG | hn4_hal_numa_current_node();
+    vol->topo_map[0].lba_start = 5000;
+    vol->topo_map[0].lba_len = 512;
+
+    hn4_hal_sim_clear_gpu_context();
+
+    for (int i = 0; i < 16; i++) {
+        uint64_t G, V;
+        ASSERT_EQ(HN4_OK, hn4_alloc_genesis(vol, 0, HN4_ALLOC_DEFAULT, &G, &V));
+
+        uint64_t head = _calc_trajectory_lba(vol, G, V, 0, 0, 0);
+        ASSERT_TRUE(head >= 5000 && head < 5512);
+    }
+
+    cleanup_alloc_fixture(vol);
+}
+
 /*
  * Test 12: Genesis Blocking At 90
  */
@@ -16,6 +16,7 @@
 #include "hn4_endians.h"
 #include "hn4_constants.h"
 #include "hn4_compress.h"
+#include "hn4_lexicon.h"
 #include "hn4_addr.h"
 #include <string.h>
 #include <stdlib.h>
@@ -5471,3 +5472,531 @@ hn4_TEST(Compress, Lexicon_Prefix_Match_Fail) {
     free(out);
     compress_teardown(dev);
 }
+
+/* Token header in the decoder's grammar ('n' already minus the op's bias) */
+static uint8_t* _kt_token(uint8_t* p, uint8_t tag, uint32_t n)
+{
+    if (n < 63) { *p++ = tag | (uint8_t)n; return p; }
+    *p++ = tag | 63;
+    n -= 63;
+    while (n >= 255) { *p++ = 255; n -= 255; }
+    *p++ = (uint8_t)n;
+    return p;
+}
+
+/* Appends a BITMASK token of 'words' words, reference output into 'x' */
+static void _kt_bitmask(uint8_t** pp, uint8_t** xp, uint32_t words, uint64_t* rng)
+{
+    uint8_t* p = _kt_token(*pp, 0xC0, words * 4);
+    uint8_t* x = *xp;
+    uint8_t* mask = p;
+    uint32_t mask_bytes = (words + 7) / 8;
+    memset(mask, 0, mask_bytes);
+    p += mask_bytes;
+
+    for (uint32_t w = 0; w < words; w++) {
+        *rng ^= *rng << 13; *rng ^= *rng >> 7; *rng ^= *rng << 17;
+        if (*rng & 1) {
+            mask[w / 8] |= (uint8_t)(1 << (w % 8));
+            for (int b = 0; b < 4; b++) *p++ = *x++ = (uint8_t)(*rng >> (8 + 8 * b));
+        } else {
+            memset(x, 0, 4);
+            x += 4;
+        }
+    }
+    *pp = p;
+    *xp = x;
+}
+
+/* Decodes with and without the AVX2 expander; both must equal 'want' and leave the tail alone */
+static bool _kt_decode_both(const uint8_t* s, uint32_t slen, const uint8_t* want, uint32_t wlen)
+{
+    uint32_t saved = _hn4_cpu_features;
+    uint8_t* out = malloc(wlen + 64);
+    bool ok = true;
+
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        if (pass == 1) _hn4_cpu_features &= ~(uint32_t)(HN4_CPU_X86_AVX2 | HN4_CPU_X86_BMI2);
+        memset(out, 0xEE, wlen + 64);
+
+        uint32_t got = 0;
+        ok = (hn4_decompress_block(s, slen, out, wlen + 64, &got) == HN4_OK) &&
+             got == wlen && memcmp(out, want, wlen) == 0;
+        for (uint32_t i = wlen; ok && i < wlen + 64; i++) ok = (out[i] == 0xEE);
+    }
+
+    _hn4_cpu_features = saved;
+    free(out);
+    return ok;
+}
+
+/*
+ * Test 96: Decode_Kernels_Match_Reference
+ * Objective: The vector decode kernels (fill, ramp, short copy, mask
+ *            expansion) produce the scalar grammar's output for every length
+ *            class, on both dispatch paths, and never write past the data.
+ */
+hn4_TEST(Compress, Decode_Kernels_Match_Reference) {
+    uint8_t* s = malloc(1 << 20);
+    uint8_t* x = malloc(1 << 20);
+    uint8_t* p = s;
+    uint8_t* q = x;
+    uint64_t rng = 0x2545F4914F6CDD1DULL;
+
+    for (uint32_t n = 4; n <= 300; n += 7) {
+        /* ISOTOPE */
+        p = _kt_token(p, 0x40, n - 4);
+        *p++ = (uint8_t)n;
+        memset(q, (uint8_t)n, n); q += n;
+
+        /* GRADIENT, rising and falling, inside 0..255 */
+        int8_t slope = (n % 2) ? 1 : -1;
+        uint32_t g = (n > 200) ? 200 : n;
+        uint8_t v0 = (slope > 0) ? 10 : 250;
+        p = _kt_token(p, 0x80, g - 4);
+        *p++ = v0;
+        *p++ = (uint8_t)slope;
+        for (uint32_t i = 0; i < g; i++) *q++ = (uint8_t)(v0 + (int)i * slope);
+
+        /* LITERAL, every short-copy class */
+        uint32_t l = (n % 40) + 1;
+        p = _kt_token(p, 0x00, l);
+        for (uint32_t i = 0; i < l; i++) *p++ = *q++ = (uint8_t)(n * 31 + i);
+
+        /* LEXICON: "http://" and a 16-byte word */
+        *p++ = 0x00; *p++ = 0x01; *p++ = 1;
+        memcpy(q, "http://", 7); q += 7;
+        *p++ = 0x00; *p++ = 0x01; *p++ = 50;
+        memcpy(q, "0000000000000000", 16); q += 16;
+
+        /* BITMASK, full and partial mask bytes */
+        _kt_bitmask(&p, &q, n / 2 + 1, &rng);
+    }
+
+    ASSERT_TRUE(_kt_decode_both(s, (uint32_t)(p - s), x, (uint32_t)(q - x)));
+
+    free(x);
+    free(s);
+}
+
+/*
+ * Test 97: Decode_Bitmask_At_Stream_End
+ * Objective: A BITMASK token closing the stream (little or no slack after
+ *            the packed words) decodes identically; the wide load must stop
+ *            at the end of the input.
+ */
+hn4_TEST(Compress, Decode_Bitmask_At_Stream_End) {
+    uint8_t s[4096];
+    uint8_t x[8192];
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    for (uint32_t words = 1; words <= 160; words += 3) {
+        uint8_t* p = s;
+        uint8_t* q = x;
+        _kt_bitmask(&p, &q, words, &rng);
+        ASSERT_TRUE(_kt_decode_both(s, (uint32_t)(p - s), x, (uint32_t)(q - x)));
+    }
+}
+
+/* Reads a standard token header; returns the encoded length field */
+static uint32_t _kt_read_token(const uint8_t** pp, uint8_t* tag)
+{
+    const uint8_t* p = *pp;
+    *tag = *p & 0xC0;
+    uint32_t n = *p++ & 0x3F;
+    if (n == 63) {
+        uint8_t s;
+        do { s = *p++; n += s; } while (s == 255);
+    }
+    *pp = p;
+    return n;
+}
+
+/*
+ * Test 98: Scanner_Run_Boundaries
+ * Objective: The wide run scanners stop on exactly the byte the byte loop
+ *            would: an ISOTOPE run ends at the first differing byte at any
+ *            offset within a lane, and a GRADIENT run ends where the ramp
+ *            would leave 0..255 even though the data keeps going mod 256.
+ */
+hn4_TEST(Compress, Scanner_Run_Boundaries) {
+    uint8_t in[512];
+    uint8_t out[1024];
+    uint8_t back[512];
+    uint32_t out_len, back_len;
+    const uint8_t* p;
+    uint8_t tag;
+
+    for (uint32_t n = 8; n <= 200; n++) {
+        memset(in, 0x5A, n);
+        const uint8_t tail[6] = { 0x11, 0x93, 0x27, 0xE5, 0x3C, 0x81 };
+        memcpy(in + n, tail, sizeof(tail));
+
+        ASSERT_EQ(HN4_OK, hn4_compress_block(in, n + 6, out, sizeof(out), &out_len, HN4_DEV_SSD, 0));
+        p = out;
+        ASSERT_EQ(n - 4, _kt_read_token(&p, &tag));
+        ASSERT_EQ(HN4_OP_ISOTOPE, tag);
+        ASSERT_EQ(0x5A, *p);
+
+        ASSERT_EQ(HN4_OK, hn4_decompress_block(out, out_len, back, sizeof(back), &back_len));
+        ASSERT_EQ(n + 6, back_len);
+        ASSERT_EQ(0, memcmp(in, back, back_len));
+    }
+
+    /* 10, 13, ... 253 is 82 values; 256 -> 0 continues the pattern mod 256 only */
+    for (uint32_t i = 0; i < 120; i++) in[i] = (uint8_t)(10 + 3 * i);
+
+    ASSERT_EQ(HN4_OK, hn4_compress_block(in, 120, out, sizeof(out), &out_len, HN4_DEV_SSD, 0));
+    p = out;
+    ASSERT_EQ(82 - 4, _kt_read_token(&p, &tag));
+    ASSERT_EQ(HN4_OP_GRADIENT, tag);
+
+    ASSERT_EQ(HN4_OK, hn4_decompress_block(out, out_len, back, sizeof(back), &back_len));
+    ASSERT_EQ(120, back_len);
+    ASSERT_EQ(0, memcmp(in, back, 120));
+}
+
+/*
+ * Test 99: Echo_Repeated_Log_Lines
+ * Objective: Text whose redundancy is repeated phrases at a distance (log
+ *            lines) now compresses; nothing else in TCC could touch it.
+ */
+hn4_TEST(Compress, Echo_Repeated_Log_Lines) {
+    char in[4096];
+    uint32_t len = 0;
+    for (uint32_t i = 0; len + 96 < sizeof(in); i++) {
+        len += (uint32_t)snprintf(in + len, sizeof(in) - len,
+            "2026-10-18T09:14:%02u.%03uZ [INFO] net.conn: request id=%u status=ok\n",
+            i % 60, (i * 37) % 1000, 4100 + i * 7);
+    }
+
+    uint32_t cap = hn4_compress_bound(len);
+    uint8_t* out = malloc(cap);
+    uint8_t back[4096];
+    uint32_t out_len = 0, back_len = 0;
+
+    ASSERT_EQ(HN4_OK, hn4_compress_block(in, len, out, cap, &out_len, HN4_DEV_SSD, 0));
+    ASSERT_TRUE(out_len * 2 < len);
+
+    ASSERT_EQ(HN4_OK, hn4_decompress_block(out, out_len, back, sizeof(back), &back_len));
+    ASSERT_EQ(len, back_len);
+    ASSERT_EQ(0, memcmp(in, back, len));
+
+    free(out);
+}
+
+/*
+ * Test 100: Decompress_Echo_Overlap_And_Bounds
+ * Objective: An ECHO closer than its length replicates the period (the
+ *            LZ overlap rule); offsets of 0 or before the start of the
+ *            output, and lengths past the buffer, are DATA_ROT.
+ */
+hn4_TEST(Compress, Decompress_Echo_Overlap_And_Bounds) {
+    uint8_t out[64];
+    uint32_t got = 0;
+
+    /* "ab" + ECHO(off 2, len 8 + 12) */
+    const uint8_t period[] = { 0x02, 'a', 'b', 0x00, 0x03, 2, 0, 12 };
+    ASSERT_EQ(HN4_OK, hn4_decompress_block(period, sizeof(period), out, sizeof(out), &got));
+    ASSERT_EQ(22, got);
+    for (uint32_t i = 0; i < got; i++) ASSERT_EQ((i & 1) ? 'b' : 'a', out[i]);
+
+    /* 20 distinct bytes + ECHO(off 20, len 40): the 16-byte chunk path with overlap */
+    uint8_t far[1 + 20 + 5];
+    far[0] = 20;
+    for (int i = 0; i < 20; i++) far[1 + i] = (uint8_t)(0x30 + i);
+    far[21] = 0x00; far[22] = 0x03; far[23] = 20; far[24] = 0; far[25] = 32;
+    ASSERT_EQ(HN4_OK, hn4_decompress_block(far, sizeof(far), out, sizeof(out), &got));
+    ASSERT_EQ(60, got);
+    for (uint32_t i = 0; i < got; i++) ASSERT_EQ(0x30 + (i % 20), out[i]);
+
+    const uint8_t zero_off[]  = { 0x02, 'a', 'b', 0x00, 0x03, 0, 0, 0 };
+    const uint8_t before[]    = { 0x02, 'a', 'b', 0x00, 0x03, 3, 0, 0 };
+    const uint8_t too_long[]  = { 0x02, 'a', 'b', 0x00, 0x03, 1, 0, 60 };
+    const uint8_t truncated[] = { 0x02, 'a', 'b', 0x00, 0x03, 1 };
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(zero_off, sizeof(zero_off), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(before, sizeof(before), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(too_long, sizeof(too_long), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(truncated, sizeof(truncated), out, sizeof(out), &got));
+}
+
+/*
+ * Test 101: Entropy_Stage_Shrinks_Text_Literals
+ * Objective: With HN4_TCC_ENTROPY, prose (literal-heavy, skewed alphabet)
+ *            comes out smaller than the plain encoding, leads with the
+ *            entropy header, and decodes without any flag. The default
+ *            entry point never emits the header.
+ */
+hn4_TEST(Compress, Entropy_Stage_Shrinks_Text_Literals) {
+    static const char* words[] = {
+        "the ", "storage ", "engine ", "writes ", "each ", "block ", "to ",
+        "a ", "ballistic ", "trajectory ", "and ", "reads ", "it ", "back ",
+        "without ", "tables, ", "which ", "keeps ", "latency ", "flat. "
+    };
+    char in[4096];
+    uint32_t len = 0;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    while (len + 16 < sizeof(in)) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        const char* w = words[(rng >> 33) % 20];
+        memcpy(in + len, w, strlen(w));
+        len += (uint32_t)strlen(w);
+    }
+
+    uint32_t cap = hn4_compress_bound(len);
+    uint8_t* plain = malloc(cap);
+    uint8_t* coded = malloc(cap);
+    uint8_t back[4096];
+    uint32_t plain_len = 0, coded_len = 0, back_len = 0;
+
+    ASSERT_EQ(HN4_OK, hn4_compress_block(in, len, plain, cap, &plain_len, HN4_DEV_SSD, 0));
+    ASSERT_EQ(HN4_OK, hn4_compress_block_ex(in, len, coded, cap, &coded_len, HN4_DEV_SSD, 0, HN4_TCC_ENTROPY, NULL));
+
+    ASSERT_FALSE(plain[0] == 0x00 && plain[1] == 0x04);
+    ASSERT_EQ(0x00, coded[0]);
+    ASSERT_EQ(0x04, coded[1]);
+    ASSERT_TRUE(coded_len < plain_len);
+
+    /* Tokens behind the header still walk; only the header is new */
+    uint32_t plain_uses = hn4_tcc_stream_features(plain, plain_len);
+    ASSERT_EQ(0u, plain_uses & HN4_TCC_USES_ENTROPY);
+    ASSERT_EQ(plain_uses | HN4_TCC_USES_ENTROPY, hn4_tcc_stream_features(coded, coded_len));
+
+    ASSERT_EQ(HN4_OK, hn4_decompress_block(coded, coded_len, back, sizeof(back), &back_len));
+    ASSERT_EQ(len, back_len);
+    ASSERT_EQ(0, memcmp(in, back, len));
+
+    free(plain);
+    free(coded);
+}
+
+/*
+ * Test 102: Decompress_Entropy_Header_Validation
+ * Objective: A hand-built two-symbol table decodes; over-subscribed
+ *            lengths, codes outside an incomplete table, bitstream
+ *            over-read, unused coded bytes and a header anywhere but
+ *            first are DATA_ROT.
+ */
+hn4_TEST(Compress, Decompress_Entropy_Header_Validation) {
+    uint8_t out[64];
+    uint32_t got = 0;
+
+    /* 'a' = 0, 'b' = 1; "abab" = bits 0,1,0,1 LSB-first = 0x0A */
+    const uint8_t good[] = { 0x00, 0x04, 'a', 1, 0x11, 1, 0, 0, 0, 0x0A, 0x04 };
+    ASSERT_EQ(HN4_OK, hn4_decompress_block(good, sizeof(good), out, sizeof(out), &got));
+    ASSERT_EQ(4, got);
+    ASSERT_EQ(0, memcmp(out, "abab", 4));
+
+    /* Three 1-bit codes */
+    const uint8_t oversub[]  = { 0x00, 0x04, 'a', 2, 0x11, 0x01, 1, 0, 0, 0, 0x0A, 0x04 };
+    /* Only 'a' = 0 exists; bit 1 has no symbol */
+    const uint8_t hole[]     = { 0x00, 0x04, 'a', 0, 0x01, 1, 0, 0, 0, 0x02, 0x02 };
+    /* 20 symbols from 8 bits */
+    const uint8_t overread[] = { 0x00, 0x04, 'a', 1, 0x11, 1, 0, 0, 0, 0x0A, 0x14 };
+    /* Second coded byte never consumed */
+    const uint8_t unused[]   = { 0x00, 0x04, 'a', 1, 0x11, 2, 0, 0, 0, 0x0A, 0x0A, 0x04 };
+    /* Header after a literal */
+    const uint8_t late[]     = { 0x01, 'x', 0x00, 0x04, 'a', 1, 0x11, 1, 0, 0, 0, 0x0A, 0x04 };
+
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(oversub, sizeof(oversub), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(hole, sizeof(hole), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(overread, sizeof(overread), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(unused, sizeof(unused), out, sizeof(out), &got));
+    ASSERT_EQ(HN4_ERR_DATA_ROT, hn4_decompress_block(late, sizeof(late), out, sizeof(out), &got));
+}
+
+/* Fills 'lex' with 'n' NUL-terminated words; must be in seal order */
+static void _cmp_make_lexicon(hn4_tcc_lexicon_t* lex, uint32_t gen, const char* const* w, uint32_t n)
+{
+    memset(lex, 0, sizeof(*lex));
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t len = (uint32_t)strlen(w[i]);
+        lex->off[i] = (uint16_t)off;
+        lex->len[i] = (uint8_t)len;
+        memcpy(lex->data + off, w[i], len);
+        off += len;
+    }
+    lex->count = n;
+    lex->generation = gen;
+}
+
+/*
+ * Test 103: Trained_Lexicon_Bind_And_Generation
+ * Objective: A sealed lexicon shrinks text made of its words, the stream
+ *            is bound to its generation (also under the entropy header),
+ *            and decoding without it or with another generation fails.
+ *            Text that uses no trained word is encoded as if no lexicon
+ *            was given. Unsorted entries do not seal.
+ */
+hn4_TEST(Compress, Trained_Lexicon_Bind_And_Generation) {
+    static const char* const words[] = {
+        "kvstore.shard_rebalance", "quorum_lease_renewed", "replica_lag_ms="
+    };
+    hn4_tcc_lexicon_t* lex = malloc(sizeof(*lex));
+    hn4_tcc_lexicon_t* other = malloc(sizeof(*other));
+    _cmp_make_lexicon(lex, 7, words, 3);
+    _cmp_make_lexicon(other, 8, words, 3);
+    ASSERT_TRUE(hn4_tcc_lexicon_seal(lex));
+    ASSERT_TRUE(hn4_tcc_lexicon_seal(other));
+
+    char in[2048];
+    uint32_t len = 0;
+    for (uint32_t i = 0; len + 64 < sizeof(in); i++) {
+        len += (uint32_t)sprintf(in + len, "%s %u %s%u\n", words[i % 2], i * 37u, words[2], i % 97u);
+    }
+
+    uint32_t cap = hn4_compress_bound(len);
+    uint8_t* plain = malloc(cap);
+    uint8_t* bound = malloc(cap);
+    uint8_t back[2048];
+    uint32_t plain_len = 0, bound_len = 0, got = 0;
+
+    ASSERT_EQ(HN4_OK, hn4_compress_block_ex(in, len, plain, cap, &plain_len, HN4_DEV_SSD, 0, 0, NULL));
+    ASSERT_EQ(HN4_OK, hn4_compress_block_ex(in, len, bound, cap, &bound_len, HN4_DEV_SSD, 0, 0, lex));
+
+    ASSERT_TRUE(bound_len < plain_len);
+    ASSERT_EQ(0x00, bound[0]);
+    ASSERT_EQ(0x05, bound[1]);
+    ASSERT_EQ(7, hn4_tcc_stream_lexicon(bound, bound_len));
+    ASSERT_EQ(0, hn4_tcc_stream_lexicon(plain, plain_len));
+
+    ASSERT_EQ(HN4_OK, hn4_decompress_block_ex(bound, bound_len, back, sizeof(back), &got, lex));
+    ASSERT_EQ(len, got);
+    ASSERT_EQ(0, memcmp(in, back, len));
+
+    ASSERT_EQ(HN4_ERR_DECOMPRESS_FAIL, hn4_decompress_block(bound, bound_len, back, sizeof(back), &got));
+    ASSERT_EQ(HN4_ERR_DECOMPRESS_FAIL,
+              hn4_decompress_block_ex(bound, bound_len, back, sizeof(back), &got, other));
+
+    /* Entropy header first, binding behind it */
+    ASSERT_EQ(HN4_OK, hn4_compress_block_ex(in, len, bound, cap, &bound_len, HN4_DEV_SSD, 0, HN4_TCC_ENTROPY, lex));
+    ASSERT_EQ(7, hn4_tcc_stream_lexicon(bound, bound_len));
+    ASSERT_EQ(HN4_OK, hn4_decompress_block_ex(bound, bound_len, back, sizeof(back), &got, lex));
+    ASSERT_EQ(0, memcmp(in, back, len));
+
+    /* No trained word: no binding, identical stream */
+    char noise[512];
+    uint64_t x = 0x243F6A8885A308D3ULL;
+    for (uint32_t i = 0; i < sizeof(noise); i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        noise[i] = (char)x;
+    }
+    ASSERT_EQ(HN4_OK, hn4_compress_block_ex(noise, sizeof(noise), plain, cap, &plain_len, HN4_DEV_SSD, 0, 0, NULL));
+    ASSERT_EQ(HN4_OK, hn4_compress_block_ex(noise, sizeof(noise), bound, cap, &bound_len, HN4_DEV_SSD, 0, 0, lex));
+    ASSERT_EQ(plain_len, bound_len);
+    ASSERT_EQ(0, memcmp(plain, bound, plain_len));
+
+    /* 'r' before 'k' */
+    static const char* const unsorted[] = { "replica_lag_ms=", "kvstore.shard_rebalance" };
+    _cmp_make_lexicon(other, 9, unsorted, 2);
+    ASSERT_FALSE(hn4_tcc_lexicon_seal(other));
+
+    free(plain);
+    free(bound);
+    free(lex);
+    free(other);
+}
+
+/*
+ * Test 104: Shuffle_Filter_Roundtrip_And_Planes
+ * Objective: Byte and bit shuffles invert exactly for every width and for
+ *            lengths that leave a tail, put byte k / bit k of each element
+ *            in plane k, and reject bad filter bytes and in-place use.
+ */
+hn4_TEST(Compress, Shuffle_Filter_Roundtrip_And_Planes) {
+    uint8_t src[1031], mid[1031], back[1031];
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < sizeof(src); i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        src[i] = (uint8_t)x;
+    }
+
+    static const uint8_t widths[] = { 2, 3, 4, 8 };
+    static const uint32_t lens[] = { 0, 1, 15, 64, 1000, 1031 };
+    for (uint32_t m = 0; m < 2; m++) {
+        for (uint32_t w = 0; w < 4; w++) {
+            for (uint32_t l = 0; l < 6; l++) {
+                uint8_t f = widths[w] | (m ? HN4_SHUF_BITS : 0);
+                memset(back, 0, sizeof(back));
+                ASSERT_TRUE(hn4_shuffle(src, mid, lens[l], f));
+                ASSERT_TRUE(hn4_unshuffle(mid, back, lens[l], f));
+                ASSERT_EQ(0, memcmp(src, back, lens[l]));
+            }
+        }
+    }
+
+    /* Byte planes: 4-byte elements 0xDDCCBBAA, one plane per byte */
+    uint32_t words[64];
+    for (uint32_t i = 0; i < 64; i++) words[i] = hn4_cpu_to_le32(0xDDCCBBAAu);
+    ASSERT_TRUE(hn4_shuffle(words, mid, sizeof(words), 4));
+    for (uint32_t i = 0; i < 64; i++) {
+        ASSERT_EQ(0xAA, mid[i]);
+        ASSERT_EQ(0xDD, mid[192 + i]);
+    }
+
+    /* Bit planes: only bit 0 set in every element -> plane 0 all ones */
+    uint16_t halves[64];
+    for (uint32_t i = 0; i < 64; i++) halves[i] = hn4_cpu_to_le16(1);
+    ASSERT_TRUE(hn4_shuffle(halves, mid, sizeof(halves), 2 | HN4_SHUF_BITS));
+    for (uint32_t i = 0; i < 8; i++) ASSERT_EQ(0xFF, mid[i]);
+    for (uint32_t i = 8; i < 128; i++) ASSERT_EQ(0x00, mid[i]);
+
+    ASSERT_FALSE(hn4_shuffle(src, mid, 64, 1));
+    ASSERT_FALSE(hn4_shuffle(src, mid, 64, 9));
+    ASSERT_FALSE(hn4_shuffle(src, mid, 64, 0x24));
+    ASSERT_FALSE(hn4_unshuffle(src, src, 64, 4));
+}
+
+/*
+ * Test 105: Shuffle_Filter_Makes_Weights_Compressible
+ * Objective: fp32 and bf16 weights in a narrow exponent band do not
+ *            compress as-is but do once shuffled (the sign/exponent plane
+ *            is one run), and the shuffled stream inverts exactly.
+ */
+hn4_TEST(Compress, Shuffle_Filter_Makes_Weights_Compressible) {
+    const uint32_t n = 2048;
+    uint32_t* f32 = malloc(n * 4);
+    uint16_t* b16 = malloc(n * 2);
+    uint64_t x = 0x243F6A8885A308D3ULL;
+    for (uint32_t i = 0; i < n; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        /* Exponent 124..125: values in [0.125, 0.5) */
+        uint32_t bits = ((124u + (uint32_t)(x & 1)) << 23) | (uint32_t)((x >> 8) & 0x7FFFFF);
+        f32[i] = hn4_cpu_to_le32(bits);
+        b16[i] = hn4_cpu_to_le16((uint16_t)(bits >> 16));
+    }
+
+    struct { const void* p; uint32_t len; uint8_t filter; } cases[] = {
+        { f32, n * 4, 4 },
+        { f32, n * 4, 4 | HN4_SHUF_BITS },
+        { b16, n * 2, 2 },
+    };
+
+    uint8_t* planes = malloc(n * 4);
+    uint8_t* back   = malloc(n * 4);
+    uint8_t* out    = malloc(hn4_compress_bound(n * 4));
+
+    for (uint32_t c = 0; c < 3; c++) {
+        uint32_t cap = hn4_compress_bound(cases[c].len);
+        uint32_t raw_len = 0, shuf_len = 0, got = 0;
+
+        hn4_result_t r = hn4_compress_block(cases[c].p, cases[c].len, out, cap, &raw_len, HN4_DEV_SSD, 0);
+        ASSERT_TRUE(r != HN4_OK || raw_len > cases[c].len - cases[c].len / 16);
+
+        ASSERT_TRUE(hn4_shuffle(cases[c].p, planes, cases[c].len, cases[c].filter));
+        ASSERT_EQ(HN4_OK, hn4_compress_block(planes, cases[c].len, out, cap, &shuf_len, HN4_DEV_SSD, 0));
+        ASSERT_TRUE(shuf_len < cases[c].len - cases[c].len / 8);
+
+        ASSERT_EQ(HN4_OK, hn4_decompress_block(out, shuf_len, planes, cases[c].len, &got));
+        ASSERT_EQ(cases[c].len, got);
+        ASSERT_TRUE(hn4_unshuffle(planes, back, got, cases[c].filter));
+        ASSERT_EQ(0, memcmp(cases[c].p, back, got));
+    }
+
+    free(out);
+    free(back);
+    free(planes);
+    free(b16);
+    free(f32);
+}
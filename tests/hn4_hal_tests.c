@@ -4,10 +4,21 @@
  * STATUS: LOGIC VERIFICATION
  */
 
+#if !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE     /* clock_gettime, mkdtemp under -std=c11 */
+#endif
+
 #include "hn4_test.h"
 #include "hn4_hal.h"
 #include "hn4_errors.h"
+#include "hn4_addr.h"
 #include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
 
 /* --- FIXTURE HELPERS --- */
 
@@ -100,3 +111,648 @@ hn4_TEST(HAL_IO, NullDeviceGuard) {
     hn4_hal_shutdown();
 }
 
+
+/* =========================================================================
+ * TEST 4: Simulated Device - Barrier Cost Is Visible
+ * Rationale:
+ * Benchmarks on the RAM disk cannot tell 1 flush from 1000. The timing
+ * model must charge each barrier so barrier frequency shows up in the
+ * virtual clock.
+ * ========================================================================= */
+hn4_TEST(HAL_Sim, BarrierCostVisible) {
+    hn4_hal_init();
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+
+    hn4_hal_device_t* a = NULL;
+    hn4_hal_device_t* b = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, 16 * 1024 * 1024, &a));
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, 16 * 1024 * 1024, &b));
+
+    uint8_t buf[4096];
+    memset(buf, 0x5A, sizeof(buf));
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(a, HN4_IO_WRITE, hn4_addr_from_u64(i), buf, 1));
+        ASSERT_EQ(HN4_OK, hn4_hal_barrier(a));
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(b, HN4_IO_WRITE, hn4_addr_from_u64(i), buf, 1));
+    }
+    ASSERT_EQ(HN4_OK, hn4_hal_barrier(b));
+
+    hn4_hal_sim_stats_t sa, sb;
+    hn4_hal_sim_get_stats(a, &sa);
+    hn4_hal_sim_get_stats(b, &sb);
+
+    ASSERT_EQ(100, sa.flushes);
+    ASSERT_EQ(1, sb.flushes);
+    ASSERT_TRUE(hn4_hal_sim_now(a) > 10 * hn4_hal_sim_now(b));
+
+    /* Data path is real: read back */
+    uint8_t rd[4096] = {0};
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(a, HN4_IO_READ, hn4_addr_from_u64(42), rd, 1));
+    ASSERT_EQ(0, memcmp(buf, rd, sizeof(rd)));
+
+    hn4_hal_sim_destroy(a);
+    hn4_hal_sim_destroy(b);
+}
+
+/* =========================================================================
+ * TEST 5: Simulated Device - HDD Seek Model & Determinism
+ * Rationale:
+ * The inertial damper is only measurable if random I/O costs more than
+ * sequential I/O on rotational media, and runs are repeatable per seed.
+ * ========================================================================= */
+static hn4_time_t _sim_hdd_run(bool random, uint64_t seed) {
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_HDD, &prof);
+    prof.seed = seed;
+
+    hn4_hal_device_t* dev = NULL;
+    if (hn4_hal_sim_create(&prof, 64 * 1024 * 1024, &dev) != HN4_OK) return 0;
+
+    uint8_t buf[4096] = {0};
+    uint64_t lba = 0;
+    for (int i = 0; i < 64; i++) {
+        lba = random ? ((lba + 7919) * 31) % 16384 : (uint64_t)i;
+        hn4_hal_sync_io(dev, HN4_IO_READ, hn4_addr_from_u64(lba), buf, 1);
+    }
+
+    hn4_time_t t = hn4_hal_sim_now(dev);
+    hn4_hal_sim_destroy(dev);
+    return t;
+}
+
+hn4_TEST(HAL_Sim, HddSeekAndDeterminism) {
+    hn4_hal_init();
+
+    hn4_time_t seq  = _sim_hdd_run(false, 1);
+    hn4_time_t rnd1 = _sim_hdd_run(true, 1);
+    hn4_time_t rnd2 = _sim_hdd_run(true, 1);
+
+    ASSERT_TRUE(seq > 0);
+    ASSERT_TRUE(rnd1 > 10 * seq);
+    ASSERT_EQ(rnd1, rnd2);
+}
+
+/* =========================================================================
+ * TEST 6: Simulated Device - Queue Depth Overlap
+ * Rationale:
+ * Async submissions spread across channels; the host only pays for the
+ * deepest channel once it polls.
+ * ========================================================================= */
+static void _sim_noop_cb(hn4_io_req_t* r, hn4_result_t res) { (void)r; (void)res; }
+
+hn4_TEST(HAL_Sim, QueueDepthOverlap) {
+    hn4_hal_init();
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+
+    hn4_hal_device_t* dev = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, 16 * 1024 * 1024, &dev));
+
+    static uint8_t bufs[32][4096];
+    hn4_io_req_t reqs[32];
+    memset(reqs, 0, sizeof(reqs));
+
+    for (int i = 0; i < 32; i++) {
+        reqs[i].op_code = HN4_IO_READ;
+        reqs[i].lba     = hn4_addr_from_u64(i * 8);
+        reqs[i].buffer  = bufs[i];
+        reqs[i].length  = 1;
+        hn4_hal_submit_io(dev, &reqs[i], _sim_noop_cb);
+    }
+
+    /* Nothing waited yet */
+    ASSERT_EQ(0, hn4_hal_sim_now(dev));
+    hn4_hal_poll(dev);
+
+    /* 32 reads on 32 channels ~ one read latency, not 32 */
+    hn4_time_t t = hn4_hal_sim_now(dev);
+    ASSERT_TRUE((uint64_t)t >= prof.read_latency_ns);
+    ASSERT_TRUE((uint64_t)t < 2 * prof.read_latency_ns);
+
+    hn4_hal_sim_destroy(dev);
+}
+
+/* =========================================================================
+ * TEST 7: Simulated Device - Zone Append Semantics
+ * ========================================================================= */
+hn4_TEST(HAL_Sim, ZoneAppendReturnsLba) {
+    hn4_hal_init();
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_ZNS, &prof);
+
+    hn4_hal_device_t* dev = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, 64 * 1024 * 1024, &dev));
+    ASSERT_TRUE(hn4_hal_get_caps(dev)->hw_flags & HN4_HW_ZNS_NATIVE);
+
+    uint64_t zone_sectors = prof.zone_size_bytes / prof.sector_size;
+    hn4_addr_t zone1 = hn4_addr_from_u64(zone_sectors);
+
+    uint8_t buf[4096];
+    memset(buf, 0xC3, sizeof(buf));
+
+    hn4_addr_t r0, r1;
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, zone1, buf, 1, &r0));
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, zone1, buf, 1, &r1));
+    ASSERT_EQ(zone_sectors, hn4_addr_to_u64(r0));
+    ASSERT_EQ(zone_sectors + 1, hn4_addr_to_u64(r1));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_ZONE_RESET, zone1, NULL, 0));
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, zone1, buf, 1, &r0));
+    ASSERT_EQ(zone_sectors, hn4_addr_to_u64(r0));
+
+    hn4_hal_sim_destroy(dev);
+}
+
+/* =========================================================================
+ * TEST 8: Zone Emulator - Write Pointer Enforcement & State Machine
+ * Rationale:
+ * A ZNS drive rejects writes that do not start at the write pointer and
+ * transitions EMPTY -> OPEN -> FULL. Reset returns the zone to EMPTY.
+ * ========================================================================= */
+static hn4_hal_device_t* _create_zoned(uint32_t max_open, uint32_t max_active) {
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_ZNS, &prof);
+    prof.zone_size_bytes  = 64 * 1024;   /* 16 sectors */
+    prof.max_open_zones   = max_open;
+    prof.max_active_zones = max_active;
+
+    hn4_hal_device_t* dev = NULL;
+    if (hn4_hal_sim_create(&prof, 1024 * 1024, &dev) != HN4_OK) return NULL;
+    return dev;
+}
+
+hn4_TEST(HAL_Zone, WritePointerStateMachine) {
+    hn4_hal_init();
+
+    hn4_hal_device_t* dev = _create_zoned(0, 0);
+    ASSERT_TRUE(dev != NULL);
+
+    uint8_t buf[4096 * 16];
+    memset(buf, 0x77, sizeof(buf));
+    hn4_hal_zone_info_t zi;
+
+    /* Zone 0 is conventional: random writes allowed */
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_WRITE, hn4_addr_from_u64(9), buf, 1));
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 0, &zi));
+    ASSERT_EQ(HN4_ZONE_CONVENTIONAL, zi.state);
+
+    /* Zone 1 starts at LBA 16 */
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 1, &zi));
+    ASSERT_EQ(HN4_ZONE_EMPTY, zi.state);
+
+    ASSERT_EQ(HN4_ERR_ZONE_WP_MISMATCH, hn4_hal_sync_io(dev, HN4_IO_WRITE, hn4_addr_from_u64(17), buf, 1));
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_WRITE, hn4_addr_from_u64(16), buf, 4));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 1, &zi));
+    ASSERT_EQ(HN4_ZONE_OPEN, zi.state);
+    ASSERT_EQ(20, hn4_addr_to_u64(zi.write_ptr));
+
+    /* Append lands at WP and reports it */
+    hn4_addr_t landed;
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(16), buf, 2, &landed));
+    ASSERT_EQ(20, hn4_addr_to_u64(landed));
+
+    /* Cross-zone write rejected */
+    ASSERT_EQ(HN4_ERR_ZONE_WP_MISMATCH, hn4_hal_sync_io(dev, HN4_IO_WRITE, hn4_addr_from_u64(22), buf, 12));
+
+    /* Fill the rest -> FULL, further appends fail */
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_WRITE, hn4_addr_from_u64(22), buf, 10));
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 1, &zi));
+    ASSERT_EQ(HN4_ZONE_FULL, zi.state);
+    ASSERT_EQ(HN4_ERR_ZONE_FULL, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(16), buf, 1, &landed));
+
+    /* Data is real and reset zeroes it */
+    uint8_t rd[4096];
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_addr_from_u64(20), rd, 1));
+    ASSERT_EQ(0x77, rd[100]);
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_ZONE_RESET, hn4_addr_from_u64(16), NULL, 0));
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 1, &zi));
+    ASSERT_EQ(HN4_ZONE_EMPTY, zi.state);
+    ASSERT_EQ(16, hn4_addr_to_u64(zi.write_ptr));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_addr_from_u64(20), rd, 1));
+    ASSERT_EQ(0, rd[100]);
+
+    hn4_hal_sim_destroy(dev);
+}
+
+/* =========================================================================
+ * TEST 9: Zone Emulator - Open / Active Limits
+ * Rationale:
+ * Exceeding max-open implicitly closes the LRU open zone; exceeding
+ * max-active fails the write. A closed zone reopens on its next write.
+ * ========================================================================= */
+hn4_TEST(HAL_Zone, OpenActiveLimits) {
+    hn4_hal_init();
+
+    hn4_hal_device_t* dev = _create_zoned(2, 3);
+    ASSERT_TRUE(dev != NULL);
+
+    uint8_t buf[4096];
+    memset(buf, 0x11, sizeof(buf));
+    hn4_hal_zone_info_t zi;
+    hn4_addr_t landed;
+
+    /* Open zones 1 and 2 */
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(16), buf, 1, &landed));
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(32), buf, 1, &landed));
+
+    /* Zone 3 forces implicit close of zone 1 (LRU) */
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(48), buf, 1, &landed));
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 1, &zi));
+    ASSERT_EQ(HN4_ZONE_CLOSED, zi.state);
+
+    /* Zone 4 would be a 4th active zone */
+    ASSERT_EQ(HN4_ERR_ZONE_LIMIT, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(64), buf, 1, &landed));
+
+    /* Closed zone resumes at its write pointer */
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(16), buf, 1, &landed));
+    ASSERT_EQ(17, hn4_addr_to_u64(landed));
+    ASSERT_EQ(HN4_OK, hn4_hal_zone_report(dev, 1, &zi));
+    ASSERT_EQ(HN4_ZONE_OPEN, zi.state);
+
+    /* Reset releases the active resource */
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_ZONE_RESET, hn4_addr_from_u64(32), NULL, 0));
+    ASSERT_EQ(HN4_OK, hn4_hal_zns_append_sync(dev, hn4_addr_from_u64(64), buf, 1, &landed));
+    ASSERT_EQ(64, hn4_addr_to_u64(landed));
+
+    hn4_hal_sim_destroy(dev);
+}
+
+/* =========================================================================
+ * LOCK LAYER: SHARED / EXCLUSIVE / TICKET
+ * ========================================================================= */
+
+hn4_TEST(HAL_Lock, SharedExcludesWriter) {
+    hn4_spinlock_t l;
+    hn4_hal_spinlock_init(&l);
+
+    /* Readers stack */
+    hn4_hal_spinlock_acquire_shared(&l);
+    hn4_hal_spinlock_acquire_shared(&l);
+    ASSERT_EQ(2, atomic_load(&l.rw_state));
+
+    /* Exclusive side is still free to be claimed once readers drain */
+    hn4_hal_spinlock_release_shared(&l);
+    hn4_hal_spinlock_release_shared(&l);
+    hn4_hal_spinlock_acquire(&l);
+    ASSERT_EQ(HN4_RW_WRITER, atomic_load(&l.rw_state));
+    hn4_hal_spinlock_release(&l);
+    ASSERT_EQ(0, atomic_load(&l.rw_state));
+
+    /* Static initializer form used across the tree stays valid */
+    static hn4_spinlock_t s_lock = { .flag = ATOMIC_FLAG_INIT };
+    hn4_hal_spinlock_acquire_shared(&s_lock);
+    hn4_hal_spinlock_release_shared(&s_lock);
+    hn4_hal_spinlock_acquire(&s_lock);
+    hn4_hal_spinlock_release(&s_lock);
+}
+
+typedef struct {
+    hn4_spinlock_t    rw;
+    hn4_ticket_lock_t tl;
+    uint64_t          a, b;
+    uint64_t          ticket_count;
+    _Atomic uint32_t  torn;
+} _lock_shared_t;
+
+static void* _lock_writer(void* arg) {
+    _lock_shared_t* s = (_lock_shared_t*)arg;
+    for (int i = 0; i < 2000; i++) {
+        hn4_hal_spinlock_acquire(&s->rw);
+        s->a++;
+        s->b++;
+        hn4_hal_spinlock_release(&s->rw);
+
+        hn4_hal_ticket_lock_acquire(&s->tl);
+        s->ticket_count++;
+        hn4_hal_ticket_lock_release(&s->tl);
+    }
+    return NULL;
+}
+
+static void* _lock_reader(void* arg) {
+    _lock_shared_t* s = (_lock_shared_t*)arg;
+    for (int i = 0; i < 2000; i++) {
+        hn4_hal_spinlock_acquire_shared(&s->rw);
+        if (*(volatile uint64_t*)&s->a != *(volatile uint64_t*)&s->b) atomic_fetch_add(&s->torn, 1);
+        hn4_hal_spinlock_release_shared(&s->rw);
+    }
+    return NULL;
+}
+
+hn4_TEST(HAL_Lock, ConcurrentReadersWritersTickets) {
+    static _lock_shared_t s;
+    memset(&s, 0, sizeof(s));
+    hn4_hal_spinlock_init(&s.rw);
+    hn4_hal_ticket_lock_init(&s.tl);
+
+    pthread_t t[6];
+    for (int i = 0; i < 6; i++) {
+        pthread_create(&t[i], NULL, (i & 1) ? _lock_reader : _lock_writer, &s);
+    }
+    for (int i = 0; i < 6; i++) pthread_join(t[i], NULL);
+
+    ASSERT_EQ(0, atomic_load(&s.torn));
+    ASSERT_EQ(6000, s.a);
+    ASSERT_EQ(6000, s.b);
+    ASSERT_EQ(6000, s.ticket_count);
+    ASSERT_EQ(atomic_load(&s.tl.next), atomic_load(&s.tl.serving));
+    ASSERT_EQ(0, atomic_load(&s.rw.rw_state));
+}
+
+/* =========================================================================
+ * CLOCK ENGINE
+ * ========================================================================= */
+
+static uint64_t _os_mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+hn4_TEST(HAL_Clock, CalibratedAgainstOsClock) {
+    hn4_hal_init();
+    ASSERT_NE(HN4_CLOCK_COUNTER, hn4_hal_clock_source());
+
+    /* Same epoch as CLOCK_MONOTONIC (within 5ms) */
+    uint64_t os0  = _os_mono_ns();
+    uint64_t hal0 = hn4_hal_get_time_ns();
+    uint64_t skew = (hal0 > os0) ? hal0 - os0 : os0 - hal0;
+    ASSERT_TRUE(skew < 5000000ULL);
+
+    /* Rate matches over a 10ms window (within 10%) */
+    uint64_t prev = hal0;
+    while (_os_mono_ns() - os0 < 10000000ULL) {
+        uint64_t t = hn4_hal_get_time_ns();
+        ASSERT_TRUE(t >= prev);
+        prev = t;
+    }
+    uint64_t os_d  = _os_mono_ns() - os0;
+    uint64_t hal_d = hn4_hal_get_time_ns() - hal0;
+    ASSERT_TRUE(hal_d > os_d - os_d / 10);
+    ASSERT_TRUE(hal_d < os_d + os_d / 10);
+}
+
+hn4_TEST(HAL_Clock, VolumeTickNeverRegresses) {
+    hn4_hal_init();
+    hn4_volume_t* vol = calloc(1, sizeof(hn4_volume_t));
+    ASSERT_TRUE(vol != NULL);
+
+    hn4_time_t t0 = hn4_hal_get_vol_tick(vol);
+    ASSERT_TRUE(t0 > 0);
+    ASSERT_TRUE(hn4_hal_get_vol_tick(vol) >= t0);
+
+    /* Coarse clock shares the epoch; lag is a few ticks at most (VMs stretch it) */
+    const uint64_t slack = 16 * HN4_CLOCK_COARSE_NS;
+    ASSERT_TRUE((uint64_t)hn4_hal_get_time_ns() + slack >= (uint64_t)hn4_hal_get_coarse_ns());
+    ASSERT_TRUE((uint64_t)hn4_hal_get_coarse_ns() + slack >= (uint64_t)hn4_hal_get_time_ns());
+
+    /* Floor holds if another thread already published a later tick */
+    uint64_t ahead = (uint64_t)t0 + 1000000000ULL;
+    atomic_store(&vol->clock_tick, ahead);
+    ASSERT_EQ(ahead, (uint64_t)hn4_hal_get_vol_tick(vol));
+
+    free(vol);
+}
+
+/* =========================================================================
+ * NUMA TOPOLOGY (FAKE SYSFS TREE)
+ * ========================================================================= */
+
+static void _topo_write(const char* root, const char* rel, const char* text) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/devices/system/node/%s", root, rel);
+    FILE* f = fopen(path, "w");
+    if (f) { fputs(text, f); fclose(f); }
+}
+
+static void _topo_mkdir(const char* root, const char* rel) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", root, rel);
+    mkdir(path, 0755);
+}
+
+hn4_TEST(HAL_Topology, SysfsTwoNodeSlices) {
+    hn4_hal_init();
+
+    char root[] = "/tmp/hn4_topo_XXXXXX";
+    ASSERT_TRUE(mkdtemp(root) != NULL);
+    _topo_mkdir(root, "devices");
+    _topo_mkdir(root, "devices/system");
+    _topo_mkdir(root, "devices/system/node");
+    _topo_mkdir(root, "devices/system/node/node0");
+    _topo_mkdir(root, "devices/system/node/node1");
+    _topo_write(root, "online", "0-1\n");
+    _topo_write(root, "node0/cpulist", "0-3,8\n");
+    _topo_write(root, "node1/cpulist", "4-7\n");
+    _topo_write(root, "node0/distance", "10 21\n");
+    _topo_write(root, "node1/distance", "21 10\n");
+
+    ASSERT_EQ(HN4_OK, hn4_hal_topology_set_root(root));
+    ASSERT_EQ(2, hn4_hal_numa_node_count());
+    ASSERT_EQ(10, hn4_hal_numa_distance(0, 0));
+    ASSERT_EQ(21, hn4_hal_numa_distance(0, 1));
+    ASSERT_EQ(0,  hn4_hal_numa_distance(0, 7));
+
+    /* 1MB device: too small to slice at 1MB granularity */
+    hn4_hal_device_t* small = create_hal_device();
+    ASSERT_EQ(0, hn4_hal_get_topology_count(small));
+
+    /* 64MB device: two 32MB slices, tagged by node */
+    hn4_hal_device_t* dev = NULL;
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, 64ULL * 1024 * 1024, &dev));
+
+    ASSERT_EQ(2, hn4_hal_get_topology_count(dev));
+    struct { uint32_t id; uint32_t w; uint64_t start; uint64_t len; } map[2];
+    ASSERT_EQ(HN4_OK, hn4_hal_get_topology_data(dev, map, sizeof(map)));
+
+    uint64_t slice = (32ULL * 1024 * 1024) / hn4_hal_get_caps(dev)->logical_block_size;
+    ASSERT_EQ(HN4_TOPO_NUMA_TAG | 0, map[0].id);
+    ASSERT_EQ(HN4_TOPO_NUMA_TAG | 1, map[1].id);
+    ASSERT_EQ(0, map[0].start);
+    ASSERT_EQ(slice, map[1].start);
+    ASSERT_EQ(slice, map[1].len);
+
+    /* Node-preferred allocations are ordinary HAL heap blocks */
+    uint8_t* p = hn4_hal_mem_alloc_node(256 * 1024, 1);
+    ASSERT_TRUE(p != NULL);
+    ASSERT_EQ(0, p[0]);
+    ASSERT_EQ(0, p[256 * 1024 - 1]);
+    hn4_hal_mem_free(p);
+
+    hn4_hal_sim_destroy(dev);
+
+    /* Missing tree degrades to a single node */
+    ASSERT_EQ(HN4_OK, hn4_hal_topology_set_root("/nonexistent/hn4"));
+    ASSERT_EQ(1, hn4_hal_numa_node_count());
+    ASSERT_EQ(0, hn4_hal_numa_current_node());
+
+    hn4_hal_topology_set_root(NULL);
+
+    static const char* const litter[] = {
+        "devices/system/node/node0/cpulist", "devices/system/node/node0/distance",
+        "devices/system/node/node1/cpulist", "devices/system/node/node1/distance",
+        "devices/system/node/online", "devices/system/node/node0",
+        "devices/system/node/node1", "devices/system/node", "devices/system", "devices", ""
+    };
+    for (size_t i = 0; i < sizeof(litter) / sizeof(litter[0]); i++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", root, litter[i]);
+        remove(path);
+    }
+}
+
+/* =========================================================================
+ * ELEVATOR SCHEDULER
+ * ========================================================================= */
+
+static _Atomic uint32_t _sched_completions;
+static void _sched_count_cb(hn4_io_req_t* r, hn4_result_t res) {
+    (void)r;
+    if (res == HN4_OK) atomic_fetch_add(&_sched_completions, 1);
+}
+
+/* 48 single-sector writes: 32 scattered + 16 forming 8 adjacent pairs */
+static uint64_t _sched_lba_at(int i) {
+    if (i < 32) return ((uint64_t)(i + 1) * 7919ULL * 31ULL) % 24000ULL;
+    return 24000ULL + (uint64_t)((i - 32) / 2) * 1000ULL + (uint64_t)((i - 32) & 1);
+}
+
+static hn4_hal_sim_stats_t _sched_run(bool use_sched, hn4_io_sched_t* sched) {
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_HDD, &prof);
+    hn4_hal_device_t* dev = NULL;
+    hn4_hal_sim_create(&prof, 128ULL * 1024 * 1024, &dev);
+    uint32_t ss = hn4_hal_get_caps(dev)->logical_block_size;
+
+    static uint8_t bufs[48][4096];
+    static hn4_io_req_t reqs[48];
+    if (use_sched) hn4_hal_sched_init(sched, dev);
+    atomic_store(&_sched_completions, 0);
+
+    for (int i = 0; i < 48; i++) {
+        memset(bufs[i], 0xA0 + i, ss);
+        memset(&reqs[i], 0, sizeof(reqs[i]));
+        reqs[i].op_code = HN4_IO_WRITE;
+        reqs[i].lba     = hn4_addr_from_u64(_sched_lba_at(i));
+        reqs[i].buffer  = bufs[i];
+        reqs[i].length  = 1;
+        if (use_sched) hn4_hal_sched_submit(sched, &reqs[i], _sched_count_cb);
+        else           hn4_hal_submit_io(dev, &reqs[i], _sched_count_cb);
+    }
+    if (use_sched) hn4_hal_sched_drain(sched);
+    hn4_hal_poll(dev);
+
+    hn4_hal_sim_stats_t st;
+    hn4_hal_sim_get_stats(dev, &st);
+
+    /* Every write landed where it was aimed, merged or not */
+    uint8_t chk[4096];
+    for (int i = 0; i < 48; i++) {
+        hn4_hal_sync_io(dev, HN4_IO_READ, reqs[i].lba, chk, 1);
+        if (chk[0] != (uint8_t)(0xA0 + i) || chk[ss - 1] != (uint8_t)(0xA0 + i)) {
+            atomic_store(&_sched_completions, 0);
+        }
+    }
+
+    hn4_hal_sim_destroy(dev);
+    return st;
+}
+
+hn4_TEST(HAL_Sched, ClookSortsAndMerges) {
+    hn4_hal_init();
+    static hn4_io_sched_t sched;
+
+    hn4_hal_sim_stats_t fifo = _sched_run(false, NULL);
+    ASSERT_EQ(48, atomic_load(&_sched_completions));
+
+    hn4_hal_sim_stats_t elev = _sched_run(true, &sched);
+    ASSERT_EQ(48, atomic_load(&_sched_completions));
+
+    /* 8 pairs collapse into single commands */
+    ASSERT_EQ(8, sched.merged);
+    ASSERT_EQ(40, sched.dispatched);
+    ASSERT_EQ(0, atomic_load(&sched.in_flight));
+
+    /* One sweep instead of a random walk */
+    ASSERT_TRUE(elev.seek_distance * 4 < fifo.seek_distance);
+    ASSERT_TRUE(elev.busy_ns < fifo.busy_ns);
+}
+
+hn4_TEST(HAL_Sched, ExpiredRequestServedFirst) {
+    hn4_hal_init();
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_HDD, &prof);
+    hn4_hal_device_t* dev = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, 16ULL * 1024 * 1024, &dev));
+
+    static hn4_io_sched_t sched;
+    hn4_hal_sched_init(&sched, dev);
+
+    uint8_t buf[2][4096];
+    hn4_io_req_t far = { .op_code = HN4_IO_READ, .lba = hn4_addr_from_u64(3000), .buffer = buf[0], .length = 1 };
+    hn4_io_req_t near = { .op_code = HN4_IO_READ, .lba = hn4_addr_from_u64(8), .buffer = buf[1], .length = 1 };
+
+    atomic_store(&_sched_completions, 0);
+    hn4_hal_sched_submit(&sched, &far, _sched_count_cb);
+    ASSERT_EQ(0, atomic_load(&_sched_completions));
+
+    /* Age the queued read past its deadline; the next arrival kicks it */
+    sched.slots[0].deadline = 0;
+    hn4_hal_sched_submit(&sched, &near, _sched_count_cb);
+    ASSERT_EQ(2, atomic_load(&_sched_completions));
+    ASSERT_EQ(1, sched.expired);
+
+    /* Ordering point drains the queue before passing through */
+    hn4_io_req_t flush = { .op_code = HN4_IO_FLUSH };
+    hn4_hal_sched_submit(&sched, &near, _sched_count_cb);
+    hn4_hal_sched_submit(&sched, &flush, _sched_count_cb);
+    ASSERT_EQ(4, atomic_load(&_sched_completions));
+    ASSERT_EQ(0, sched.count);
+
+    hn4_hal_sim_destroy(dev);
+}
+
+static _Atomic uint32_t _workq_ran;
+
+static void _workq_slow_job(void* arg)
+{
+    (void)arg;
+    hn4_hal_micro_sleep(200);
+    atomic_fetch_add(&_workq_ran, 1);
+}
+
+hn4_TEST(HAL_WorkQ, CompletionAndBackpressure) {
+    hn4_hal_init();
+    hn4_hal_workq_t* q = hn4_hal_workq_create(2, 2);
+    ASSERT_TRUE(q != NULL);
+
+    /* 16 jobs through a 2-slot queue: submit blocks instead of dropping */
+    static _Atomic uint32_t done[16];
+    atomic_store(&_workq_ran, 0);
+    for (int i = 0; i < 16; i++) hn4_hal_workq_submit(q, _workq_slow_job, NULL, &done[i]);
+
+    hn4_hal_workq_wait(q, &done[15]);
+    ASSERT_EQ(1, atomic_load(&done[15]));
+
+    hn4_hal_workq_wait(q, NULL);
+    ASSERT_EQ(16, atomic_load(&_workq_ran));
+    for (int i = 0; i < 16; i++) ASSERT_EQ(1, atomic_load(&done[i]));
+
+    hn4_hal_workq_destroy(q);
+
+    /* No queue: the job runs inline in the caller */
+    _Atomic uint32_t inline_done = 0;
+    hn4_hal_workq_submit(NULL, _workq_slow_job, NULL, &inline_done);
+    ASSERT_EQ(1, atomic_load(&inline_done));
+    ASSERT_EQ(17, atomic_load(&_workq_ran));
+}
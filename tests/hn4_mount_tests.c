@@ -14,6 +14,8 @@
 #include "hn4_endians.h" 
 #include "hn4_constants.h" 
 #include "hn4_tensor.h"  
+#include "hn4_anchor.h"
+#include "hn4_addr.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -8853,22 +8855,8 @@ hn4_TEST(Optimization, Tombstone_Is_Occupied) {
 /* 
  * Helper: Inject an anchor that matches any tag query (Bloom Filter = All 1s).
  */
-static void inject_wildcard_anchor(hn4_volume_t* vol, uint32_t slot_idx, uint64_t id_lo, uint64_t id_hi, uint64_t mass, const char* name) {
-    hn4_anchor_t a = {0};
-    a.seed_id.lo = id_lo; 
-    a.seed_id.hi = id_hi;
-    a.seed_id = hn4_cpu_to_le128(a.seed_id);
-    
-    a.mass = hn4_cpu_to_le64(mass);
-    a.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_VOL_STATIC);
-    a.tag_filter = 0xFFFFFFFFFFFFFFFFULL; /* Matches ALL tag queries (Bloom) */
-    a.write_gen = hn4_cpu_to_le32(1);
-    a.orbit_vector[0] = 1;
-
-    /* FIX: Populate Name for strict verification in hn4_tensor_open */
-    if (name) {
-        strncpy((char*)a.inline_buffer, name, sizeof(a.inline_buffer)-1);
-    }
+/* Seals 'a' and stores it in Cortex slot 'slot_idx' (disk and RAM cache) */
+static void inject_anchor(hn4_volume_t* vol, uint32_t slot_idx, hn4_anchor_t a) {
     /* Checksum */
     a.checksum = 0;
     a.checksum = hn4_cpu_to_le32(hn4_crc32(0, &a, sizeof(a)));
@@ -8890,6 +8878,25 @@ static void inject_wildcard_anchor(hn4_volume_t* vol, uint32_t slot_idx, uint64_
     }
 }
 
+static void inject_wildcard_anchor(hn4_volume_t* vol, uint32_t slot_idx, uint64_t id_lo, uint64_t id_hi, uint64_t mass, const char* name) {
+    hn4_anchor_t a = {0};
+    a.seed_id.lo = id_lo; 
+    a.seed_id.hi = id_hi;
+    a.seed_id = hn4_cpu_to_le128(a.seed_id);
+    
+    a.mass = hn4_cpu_to_le64(mass);
+    a.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_VOL_STATIC);
+    a.tag_filter = 0xFFFFFFFFFFFFFFFFULL; /* Matches ALL tag queries (Bloom) */
+    a.write_gen = hn4_cpu_to_le32(1);
+    a.orbit_vector[0] = 1;
+
+    /* FIX: Populate Name for strict verification in hn4_tensor_open */
+    if (name) {
+        strncpy((char*)a.inline_buffer, name, sizeof(a.inline_buffer)-1);
+    }
+    inject_anchor(vol, slot_idx, a);
+}
+
 /*
  * Test T1: Tensor Open - Topological Sort
  * Scenario: Shards are scattered in Cortex with out-of-order IDs.
@@ -8995,6 +9002,249 @@ hn4_TEST(Tensor, Read_OOB) {
     destroy_fixture(dev);
 }
 
+/*
+ * hn4_write.c entry point; not prototyped in a header (see hn4_write.h).
+ */
+hn4_result_t hn4_write_block_atomic(hn4_volume_t* vol, hn4_anchor_t* anchor,
+                                    uint64_t block_idx, const void* data, uint32_t len,
+                                    uint32_t session_perms);
+
+/*
+ * Test T5: Tensor Read - Parallel Shard Span
+ * Scenario: Eight one-block shards, two of them short. A range covering
+ *           all of them, one starting and ending mid-shard, and a small one.
+ * Logic: Long ranges are read by the volume's tensor workers, each block
+ *        landing at its own offset; short ones stay on the caller's thread.
+ * Expected: Every range matches the written bytes.
+ */
+hn4_TEST(Tensor, Read_Parallel_Shard_Span) {
+    hn4_hal_device_t* dev = create_fixture_formatted();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    /* Fixture Q-Mask is zeroed (Toxic); mark it Silver so the shards can be written */
+    memset(vol->quality_mask, 0xAA, vol->qmask_size);
+
+    const uint32_t shards = 8;
+    uint32_t cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    uint8_t* want = malloc((size_t)shards * cap);
+    uint8_t* got  = malloc((size_t)shards * cap);
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < shards; i++) {
+        uint32_t mass = (i == 2 || i == 5) ? cap - 100 * i : cap;
+        for (uint32_t b = 0; b < mass; b++) want[total + b] = (uint8_t)(i * 31 + b * 7);
+
+        hn4_anchor_t a = {0};
+        a.seed_id.lo     = hn4_cpu_to_le64(100 + i);
+        a.gravity_center = hn4_cpu_to_le64(3000 + i * 64);
+        a.orbit_vector[0] = 1;
+        a.data_class     = hn4_cpu_to_le64(HN4_FLAG_VALID);
+        a.permissions    = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+        a.tag_filter     = 0xFFFFFFFFFFFFFFFFULL;
+        strncpy((char*)a.inline_buffer, "model:span", sizeof(a.inline_buffer) - 1);
+
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &a, 0, want + total, mass, 0));
+        ASSERT_EQ(mass, hn4_le64_to_cpu(a.mass));
+        inject_anchor(vol, 10 + i, a);
+        total += mass;
+    }
+
+    hn4_tensor_ctx_t* ctx = NULL;
+    ASSERT_EQ(HN4_OK, hn4_tensor_open(vol, "model:span", &ctx));
+    ASSERT_EQ(shards, ctx->shard_count);
+    ASSERT_EQ(total, ctx->total_size_bytes);
+
+    /* Whole tensor */
+    memset(got, 0, total);
+    ASSERT_EQ(HN4_OK, hn4_tensor_read(ctx, 0, got, total));
+    ASSERT_EQ(0, memcmp(want, got, total));
+    ASSERT_TRUE(atomic_load(&vol->tensor_workq) != NULL);
+
+    /* Mid-shard to mid-shard, clamped at EOF */
+    uint64_t off = cap + 1234;
+    memset(got, 0, total);
+    ASSERT_EQ(HN4_OK, hn4_tensor_read(ctx, off, got, total));
+    ASSERT_EQ(0, memcmp(want + off, got, total - off));
+
+    /* Across one shard boundary, inline */
+    off = 2 * cap - 10;
+    memset(got, 0, 64);
+    ASSERT_EQ(HN4_OK, hn4_tensor_read(ctx, off, got, 64));
+    ASSERT_EQ(0, memcmp(want + off, got, 64));
+
+    free(got);
+    free(want);
+    hn4_tensor_close(ctx);
+    hn4_unmount(vol);
+    destroy_fixture(dev);
+}
+
+/* The RAM buffer behind the fixture device (inverse of inject_nvm_buffer) */
+static uint8_t* _t6_ram(hn4_hal_device_t* dev) {
+    uintptr_t addr = ((uintptr_t)dev + sizeof(hn4_hal_caps_t) + 7) & ~(uintptr_t)7;
+    return *(uint8_t**)addr;
+}
+
+/* Breaks the on-media CRC of the Cortex slot holding 'seed'; the resident copy stays intact */
+static bool _t6_rot_cortex_slot(hn4_volume_t* vol, hn4_u128_t seed)
+{
+    uint32_t ss    = hn4_hal_get_caps(vol->target_device)->logical_block_size;
+    uint64_t start = hn4_addr_to_u64(vol->sb.info.lba_cortex_start);
+    uint64_t end   = hn4_addr_to_u64(vol->sb.info.lba_bitmap_start);
+    uint8_t* buf   = malloc(ss);
+    bool     hit   = false;
+
+    for (uint64_t s = start; s < end && !hit; s++) {
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_lba_from_sectors(s), buf, 1) != HN4_OK) break;
+        for (uint32_t off = 0; off + sizeof(hn4_anchor_t) <= ss; off += sizeof(hn4_anchor_t)) {
+            hn4_anchor_t* a = (hn4_anchor_t*)(buf + off);
+            if (a->seed_id.lo != seed.lo || a->seed_id.hi != seed.hi) continue;
+            a->checksum ^= hn4_cpu_to_le32(0xFFFF);
+            hit = (hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, hn4_lba_from_sectors(s), buf, 1) == HN4_OK);
+            break;
+        }
+    }
+    free(buf);
+    return hit;
+}
+
+/*
+ * Test T6: Tensor Open - Manifest Index
+ * Scenario: Three shards committed through the Cortex, then indexed. A
+ *           fourth shard is committed and folds itself into the index.
+ *           Its on-media Cortex slot is then rotted, which hides it from
+ *           a scan but not from the (resident) probe by ID. Later the
+ *           generation moves, then shards 0 and 3 are recommitted.
+ * Logic: Open trusts the manifest while every generation still matches,
+ *        so it still sees the hidden shard. A moved namespace forces a
+ *        rescan, which drops it; open never rewrites the index. The next
+ *        shard commits rebuild and extend the index.
+ * Expected: 4 shards from the manifest, 3 after the rescan (the media
+ *           image is unchanged by open), then 4 with the grown shard's
+ *           new mass.
+ */
+hn4_TEST(Tensor, Open_Manifest_Index) {
+    hn4_hal_device_t* dev = create_fixture_formatted();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    /* Fixture Q-Mask is zeroed (Toxic); mark it Silver so the shards can be written */
+    memset(vol->quality_mask, 0xAA, vol->qmask_size);
+
+    uint8_t data[256];
+    memset(data, 0x5C, sizeof(data));
+
+    hn4_anchor_t a[4];
+    for (uint32_t i = 0; i < 4; i++) {
+        memset(&a[i], 0, sizeof(a[i]));
+        a[i].seed_id.lo      = hn4_cpu_to_le64(700 + i);
+        a[i].seed_id.hi      = hn4_cpu_to_le64(0x7E5);
+        a[i].gravity_center  = hn4_cpu_to_le64(5000 + i * 64);
+        a[i].orbit_vector[0] = 1;
+        a[i].data_class      = hn4_cpu_to_le64(HN4_FLAG_VALID);
+        a[i].permissions     = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+        a[i].tag_filter      = 0xFFFFFFFFFFFFFFFFULL;
+        strncpy((char*)a[i].inline_buffer, "model:index", sizeof(a[i].inline_buffer) - 1);
+
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &a[i], 0, data, 100 + i, 0));
+        if (i < 3) ASSERT_EQ(HN4_OK, hn4_write_anchor_atomic(vol, &a[i]));
+    }
+
+    ASSERT_EQ(HN4_OK, hn4_tensor_build_manifest(vol, "model:index"));
+
+    /* Commit shard 3: the namespace moves and the index follows it */
+    uint32_t gen = atomic_load(&vol->ns_generation);
+    ASSERT_EQ(HN4_OK, hn4_write_anchor_atomic(vol, &a[3]));
+    ASSERT_EQ(gen + 1, atomic_load(&vol->ns_generation));
+    ASSERT_TRUE(_t6_rot_cortex_slot(vol, hn4_le128_to_cpu(a[3].seed_id)));
+
+    uint8_t* img = malloc(FIXTURE_SIZE);
+    memcpy(img, _t6_ram(dev), FIXTURE_SIZE);
+
+    hn4_tensor_ctx_t* ctx = NULL;
+    ASSERT_EQ(HN4_OK, hn4_tensor_open(vol, "model:index", &ctx));
+    ASSERT_EQ(4u, ctx->shard_count);
+    ASSERT_EQ(100u + 101 + 102 + 103, ctx->total_size_bytes);
+    hn4_tensor_close(ctx);
+
+    /* Namespace moved: rescan, twice, and nothing is written */
+    atomic_fetch_add(&vol->ns_generation, 1);
+    for (int pass = 0; pass < 2; pass++) {
+        ASSERT_EQ(HN4_OK, hn4_tensor_open(vol, "model:index", &ctx));
+        ASSERT_EQ(3u, ctx->shard_count);
+        hn4_tensor_close(ctx);
+    }
+    ASSERT_EQ(0, memcmp(img, _t6_ram(dev), FIXTURE_SIZE));
+
+    /* Grow shard 0 in place: the stale index is rebuilt, the namespace stands */
+    uint8_t more[150];
+    memset(more, 0x3A, sizeof(more));
+    gen = atomic_load(&vol->ns_generation);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &a[0], 0, more, sizeof(more), 0));
+    ASSERT_EQ(HN4_OK, hn4_write_anchor_atomic(vol, &a[0]));
+    ASSERT_EQ(gen, atomic_load(&vol->ns_generation));
+
+    /* Recommitting shard 3 repairs its slot and folds it back in */
+    ASSERT_EQ(HN4_OK, hn4_write_anchor_atomic(vol, &a[3]));
+
+    ASSERT_EQ(HN4_OK, hn4_tensor_open(vol, "model:index", &ctx));
+    ASSERT_EQ(4u, ctx->shard_count);
+    ASSERT_EQ(150u + 101 + 102 + 103, ctx->total_size_bytes);
+    hn4_tensor_close(ctx);
+
+    free(img);
+    hn4_unmount(vol);
+    destroy_fixture(dev);
+}
+
+/*
+ * Test T6b: Tensor Open - Weights Index Themselves
+ * Scenario: Two WEIGHTS shards are committed with no explicit indexing;
+ *           shard 1's on-media Cortex slot is then rotted.
+ * Logic: The first commit builds the manifest, the second folds into it,
+ *        so open is served from the index and still finds shard 1.
+ * Expected: 2 shards.
+ */
+hn4_TEST(Tensor, Open_Weights_Self_Indexed) {
+    hn4_hal_device_t* dev = create_fixture_formatted();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+    memset(vol->quality_mask, 0xAA, vol->qmask_size);
+
+    uint8_t data[128];
+    memset(data, 0x6D, sizeof(data));
+
+    hn4_anchor_t a[2];
+    for (uint32_t i = 0; i < 2; i++) {
+        memset(&a[i], 0, sizeof(a[i]));
+        a[i].seed_id.lo      = hn4_cpu_to_le64(800 + i);
+        a[i].seed_id.hi      = hn4_cpu_to_le64(0x7E6);
+        a[i].gravity_center  = hn4_cpu_to_le64(6000 + i * 64);
+        a[i].orbit_vector[0] = 1;
+        a[i].data_class      = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_AI_TYPE_WEIGHTS);
+        a[i].permissions     = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+        a[i].tag_filter      = 0xFFFFFFFFFFFFFFFFULL;
+        strncpy((char*)a[i].inline_buffer, "model:w", sizeof(a[i].inline_buffer) - 1);
+
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &a[i], 0, data, 60 + i, 0));
+        ASSERT_EQ(HN4_OK, hn4_write_anchor_atomic(vol, &a[i]));
+    }
+    ASSERT_TRUE(_t6_rot_cortex_slot(vol, hn4_le128_to_cpu(a[1].seed_id)));
+
+    hn4_tensor_ctx_t* ctx = NULL;
+    ASSERT_EQ(HN4_OK, hn4_tensor_open(vol, "model:w", &ctx));
+    ASSERT_EQ(2u, ctx->shard_count);
+    ASSERT_EQ(60u + 61, ctx->total_size_bytes);
+    hn4_tensor_close(ctx);
+
+    hn4_unmount(vol);
+    destroy_fixture(dev);
+}
+
 /* 
  * Test T11: Tensor - Write Attempt (API Check)
  * Scenario: Tensor context is read-only.
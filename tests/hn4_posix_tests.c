@@ -0,0 +1,445 @@
+/*
+ * HYDRA-NEXUS 4 (HN4) STORAGE ENGINE
+ * MODULE:      POSIX Shim Tests
+ * SOURCE:      hn4_posix_tests.c
+ * STATUS:      PRODUCTION
+ *
+ * TEST OBJECTIVE:
+ * Verify the per-handle write-back buffer (docs/posix-shim.md 4.3):
+ * coalescing, read-your-writes, SEEK_END, O_APPEND and the fsync/close
+ * durability points. Runs on a formatted simulated SSD so device writes
+ * can be counted and the volume remounted.
+ */
+
+#include "hn4.h"
+#include "hn4_test.h"
+#include "hn4_hal.h"
+#include "hn4_crc.h"
+#include "hn4_constants.h"
+#include <string.h>
+
+/* =========================================================================
+ * SHIM ABI (hn4_posix.c has no public header)
+ * ========================================================================= */
+
+typedef uint32_t hn4_mode_t;
+typedef int64_t  hn4_off_t;
+typedef int64_t  hn4_ssize_t;
+
+#define PX_O_RDWR       02
+#define PX_O_CREAT      0100
+#define PX_O_APPEND     02000
+#define PX_S_IRUSR      00400
+#define PX_S_IWUSR      00200
+#define PX_SEEK_SET     0
+#define PX_SEEK_END     2
+
+int         hn4_posix_open(hn4_volume_t* vol, const char* path, int flags, hn4_mode_t mode, hn4_handle_t** out);
+hn4_ssize_t hn4_posix_read(hn4_volume_t* vol, hn4_handle_t* handle, void* buf, size_t count);
+hn4_ssize_t hn4_posix_write(hn4_volume_t* vol, hn4_handle_t* handle, const void* buf, size_t count);
+hn4_off_t   hn4_posix_lseek(hn4_volume_t* vol, hn4_handle_t* handle, hn4_off_t offset, int whence);
+int         hn4_posix_close(hn4_volume_t* vol, hn4_handle_t* handle);
+int         hn4_posix_fsync(hn4_volume_t* vol, hn4_handle_t* handle);
+int         hn4_posix_rename(hn4_volume_t* vol, const char* oldpath, const char* newpath);
+
+/* Volume lifecycle (hn4_format.c, hn4_mount.c, hn4_unmount.c have no header) */
+hn4_result_t hn4_format(hn4_hal_device_t* dev, const hn4_format_params_t* params);
+hn4_result_t hn4_mount(hn4_hal_device_t* dev, const hn4_mount_params_t* params, hn4_volume_t** out_vol);
+hn4_result_t hn4_unmount(hn4_volume_t* vol);
+
+/* =========================================================================
+ * FIXTURE INFRASTRUCTURE
+ * ========================================================================= */
+
+#define PX_FIXTURE_SIZE     (128ULL * 1024 * 1024)
+#define PX_MODE             (PX_S_IRUSR | PX_S_IWUSR)
+
+static hn4_hal_device_t* posix_setup(void) {
+    hn4_hal_init();
+    hn4_crc_init();
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+
+    hn4_hal_device_t* sim = NULL;
+    if (hn4_hal_sim_create(&prof, PX_FIXTURE_SIZE, &sim) != HN4_OK) return NULL;
+
+    hn4_format_params_t fp = { .target_profile = HN4_PROFILE_GENERIC, .label = "POSIX" };
+    if (hn4_format(sim, &fp) != HN4_OK) {
+        hn4_hal_sim_destroy(sim);
+        return NULL;
+    }
+    return sim;
+}
+
+static uint64_t _px_writes(hn4_hal_device_t* dev) {
+    hn4_hal_sim_stats_t st;
+    hn4_hal_sim_get_stats(dev, &st);
+    return st.writes;
+}
+
+static void _px_pattern(uint8_t* buf, size_t len, uint8_t seed) {
+    for (size_t i = 0; i < len; i++) buf[i] = (uint8_t)(seed + i * 7);
+}
+
+/* =========================================================================
+ * TESTS
+ * ========================================================================= */
+
+/*
+ * TEST: Posix.WriteBack_Coalesces_Appends
+ * OBJECTIVE: Sub-block appends stay in RAM until the block's payload is
+ *            full, then go to disk as exactly one device write.
+ */
+hn4_TEST(Posix, WriteBack_Coalesces_Appends) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/log.txt", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+
+    uint32_t payload = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    uint32_t step    = 100;
+    uint8_t  rec[100];
+    _px_pattern(rec, sizeof(rec), 1);
+
+    uint64_t w0 = _px_writes(dev);
+
+    /* Every append short of the block end is absorbed */
+    uint32_t written = 0;
+    while (written + step < payload) {
+        ASSERT_EQ(step, hn4_posix_write(vol, h, rec, step));
+        written += step;
+    }
+    ASSERT_EQ(0, _px_writes(dev) - w0);
+
+    /* The append that completes the payload flushes it as one block */
+    uint32_t tail = payload - written;
+    ASSERT_EQ(tail, hn4_posix_write(vol, h, rec, tail));
+    ASSERT_EQ(1, _px_writes(dev) - w0);
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.WriteBack_Read_Your_Writes
+ * OBJECTIVE: The writing handle reads its buffered bytes back and sees the
+ *            buffered tail through lseek(SEEK_END), with nothing on disk.
+ */
+hn4_TEST(Posix, WriteBack_Read_Your_Writes) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/ryw.bin", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+
+    uint8_t data[300], out[300];
+    _px_pattern(data, sizeof(data), 3);
+
+    uint64_t w0 = _px_writes(dev);
+
+    ASSERT_EQ(200, hn4_posix_write(vol, h, data, 200));
+    ASSERT_EQ(100, hn4_posix_write(vol, h, data + 200, 100));
+
+    ASSERT_EQ(300, hn4_posix_lseek(vol, h, 0, PX_SEEK_END));
+
+    ASSERT_EQ(0, hn4_posix_lseek(vol, h, 0, PX_SEEK_SET));
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(300, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+
+    /* Overwrite in the middle of the buffered image */
+    ASSERT_EQ(50, hn4_posix_lseek(vol, h, 50, PX_SEEK_SET));
+    memset(data + 50, 0xEE, 10);
+    ASSERT_EQ(10, hn4_posix_write(vol, h, data + 50, 10));
+
+    ASSERT_EQ(0, hn4_posix_lseek(vol, h, 0, PX_SEEK_SET));
+    ASSERT_EQ(300, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+
+    ASSERT_EQ(0, _px_writes(dev) - w0);
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.Fsync_Persists_Buffered_Bytes
+ * OBJECTIVE: fsync is the durability point. A second, read-only mount of
+ *            the device sees everything written before fsync and nothing
+ *            still buffered after it.
+ */
+hn4_TEST(Posix, Fsync_Persists_Buffered_Bytes) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/synced.bin", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+
+    uint8_t data[1000], out[1200];
+    _px_pattern(data, sizeof(data), 5);
+
+    /* Unaligned chunks, all inside the buffered block */
+    for (uint32_t off = 0; off < sizeof(data); ) {
+        uint32_t n = (sizeof(data) - off < 333) ? (uint32_t)sizeof(data) - off : 333;
+        ASSERT_EQ(n, hn4_posix_write(vol, h, data + off, n));
+        off += n;
+    }
+
+    ASSERT_EQ(0, hn4_posix_fsync(vol, h));
+
+    /* Not fsynced: must not be visible to the second mount */
+    uint8_t extra[64];
+    _px_pattern(extra, sizeof(extra), 9);
+    ASSERT_EQ(64, hn4_posix_write(vol, h, extra, sizeof(extra)));
+
+    hn4_volume_t* ro = NULL;
+    hn4_mount_params_t rp = {0};
+    rp.mount_flags = HN4_MNT_READ_ONLY;
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &rp, &ro));
+
+    hn4_handle_t* rh = NULL;
+    ASSERT_EQ(0, hn4_posix_open(ro, "/synced.bin", 0, 0, &rh));
+    ASSERT_EQ(sizeof(data), hn4_posix_lseek(ro, rh, 0, PX_SEEK_END));
+    ASSERT_EQ(0, hn4_posix_lseek(ro, rh, 0, PX_SEEK_SET));
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(sizeof(data), hn4_posix_read(ro, rh, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+
+    ASSERT_EQ(0, hn4_posix_close(ro, rh));
+    ASSERT_EQ(HN4_OK, hn4_unmount(ro));
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.Close_Flushes_Buffer
+ * OBJECTIVE: Bytes that never filled a block reach the disk on close and
+ *            survive a remount.
+ */
+hn4_TEST(Posix, Close_Flushes_Buffer) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/closed.txt", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+
+    uint8_t data[700], out[800];
+    _px_pattern(data, sizeof(data), 11);
+
+    uint64_t w0 = _px_writes(dev);
+    ASSERT_EQ(400, hn4_posix_write(vol, h, data, 400));
+    ASSERT_EQ(300, hn4_posix_write(vol, h, data + 400, 300));
+    ASSERT_EQ(0, _px_writes(dev) - w0);
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_TRUE(_px_writes(dev) - w0 >= 1);
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+
+    /* Read back through a fresh read-only mount */
+    vol = NULL;
+    p.mount_flags = HN4_MNT_READ_ONLY;
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    ASSERT_EQ(0, hn4_posix_open(vol, "/closed.txt", 0, 0, &h));
+    ASSERT_EQ(700, hn4_posix_lseek(vol, h, 0, PX_SEEK_END));
+    ASSERT_EQ(0, hn4_posix_lseek(vol, h, 0, PX_SEEK_SET));
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(700, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.Append_Honours_Buffered_Tail
+ * OBJECTIVE: O_APPEND positions every write at the end of the buffered
+ *            tail, not at the committed Mass, even after a seek away.
+ */
+hn4_TEST(Posix, Append_Honours_Buffered_Tail) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    /* Committed prefix */
+    hn4_handle_t* h = NULL;
+    uint8_t head[100];
+    _px_pattern(head, sizeof(head), 13);
+    ASSERT_EQ(0, hn4_posix_open(vol, "/app.log", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+    ASSERT_EQ(100, hn4_posix_write(vol, h, head, sizeof(head)));
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+
+    ASSERT_EQ(0, hn4_posix_open(vol, "/app.log", PX_O_RDWR | PX_O_APPEND, 0, &h));
+
+    uint8_t a[50], b[70];
+    _px_pattern(a, sizeof(a), 17);
+    _px_pattern(b, sizeof(b), 19);
+
+    ASSERT_EQ(50, hn4_posix_write(vol, h, a, sizeof(a)));
+
+    /* A seek does not move the append point */
+    ASSERT_EQ(0, hn4_posix_lseek(vol, h, 0, PX_SEEK_SET));
+    ASSERT_EQ(70, hn4_posix_write(vol, h, b, sizeof(b)));
+    ASSERT_EQ(220, hn4_posix_lseek(vol, h, 0, PX_SEEK_END));
+
+    uint8_t out[256] = {0};
+    ASSERT_EQ(0, hn4_posix_lseek(vol, h, 0, PX_SEEK_SET));
+    ASSERT_EQ(220, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, head, 100));
+    ASSERT_EQ(0, memcmp(out + 100, a, 50));
+    ASSERT_EQ(0, memcmp(out + 150, b, 70));
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.Close_Keeps_Buffer_On_Flush_Error
+ * OBJECTIVE: A close whose flush fails returns the error and keeps the
+ *            handle and its buffered bytes. A retried close writes them.
+ */
+hn4_TEST(Posix, Close_Keeps_Buffer_On_Flush_Error) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/retry.txt", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+
+    uint8_t data[300], out[300];
+    _px_pattern(data, sizeof(data), 29);
+    ASSERT_EQ(300, hn4_posix_write(vol, h, data, sizeof(data)));
+
+    /* Core rejects every write while the volume is panicked */
+    atomic_fetch_or(&vol->sb.info.state_flags, HN4_VOL_PANIC);
+    ASSERT_TRUE(hn4_posix_close(vol, h) < 0);
+    atomic_fetch_and(&vol->sb.info.state_flags, ~(uint64_t)HN4_VOL_PANIC);
+
+    /* Handle still open, bytes still buffered */
+    ASSERT_EQ(0, hn4_posix_lseek(vol, h, 0, PX_SEEK_SET));
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(300, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+
+    ASSERT_EQ(0, hn4_posix_open(vol, "/retry.txt", 0, 0, &h));
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(300, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.WriteBack_Volume_Budget
+ * OBJECTIVE: Images count against the volume-wide budget and are returned
+ *            on close. With the budget spent a handle writes through.
+ */
+hn4_TEST(Posix, WriteBack_Volume_Budget) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint8_t data[100];
+    _px_pattern(data, sizeof(data), 31);
+
+    /* 1. Buffered: one image charged, returned on close */
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/budget_a.txt", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+    uint64_t w0 = _px_writes(dev);
+    ASSERT_EQ(100, hn4_posix_write(vol, h, data, sizeof(data)));
+    ASSERT_EQ(0, _px_writes(dev) - w0);
+    ASSERT_EQ((uint64_t)vol->vol_block_size, atomic_load(&vol->wb_bytes));
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+    ASSERT_EQ(0, atomic_load(&vol->wb_bytes));
+
+    /* 2. Budget spent by other handles: the write goes straight to disk */
+    uint64_t other = (4ULL << 20);
+    atomic_store(&vol->wb_bytes, other);
+
+    ASSERT_EQ(0, hn4_posix_open(vol, "/budget_b.txt", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+    w0 = _px_writes(dev);
+    ASSERT_EQ(100, hn4_posix_write(vol, h, data, sizeof(data)));
+    ASSERT_TRUE(_px_writes(dev) - w0 >= 1);
+    ASSERT_EQ(other, atomic_load(&vol->wb_bytes));
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+
+    atomic_store(&vol->wb_bytes, 0);
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
+
+/*
+ * TEST: Posix.Rename_After_Orbit_Map_Persist
+ * OBJECTIVE: Closing a file past the orbit_hints range persists its Orbit
+ *            Map, which moves the Anchor to the extended layout. A rename
+ *            afterwards must still leave a resolvable name and the data.
+ */
+hn4_TEST(Posix, Rename_After_Orbit_Map_Persist) {
+    hn4_hal_device_t* dev = posix_setup();
+    ASSERT_TRUE(dev != NULL);
+
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    /* One block past cluster 16, so the map has an entry */
+    hn4_off_t off = (hn4_off_t)(vol->vol_block_size - sizeof(hn4_block_header_t)) * 300;
+    uint8_t data[100], out[100];
+    _px_pattern(data, sizeof(data), 23);
+
+    hn4_handle_t* h = NULL;
+    ASSERT_EQ(0, hn4_posix_open(vol, "/orbit.bin", PX_O_RDWR | PX_O_CREAT, PX_MODE, &h));
+    ASSERT_EQ(off, hn4_posix_lseek(vol, h, off, PX_SEEK_SET));
+    ASSERT_EQ(100, hn4_posix_write(vol, h, data, sizeof(data)));
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+
+    ASSERT_EQ(0, hn4_posix_rename(vol, "/orbit.bin", "/moved.bin"));
+    ASSERT_TRUE(hn4_posix_open(vol, "/orbit.bin", 0, 0, &h) != 0);
+
+    ASSERT_EQ(0, hn4_posix_open(vol, "/moved.bin", 0, 0, &h));
+    ASSERT_EQ(off, hn4_posix_lseek(vol, h, off, PX_SEEK_SET));
+    memset(out, 0, sizeof(out));
+    ASSERT_EQ(100, hn4_posix_read(vol, h, out, sizeof(out)));
+    ASSERT_EQ(0, memcmp(out, data, sizeof(data)));
+    ASSERT_EQ(0, hn4_posix_close(vol, h));
+
+    ASSERT_EQ(HN4_OK, hn4_unmount(vol));
+    hn4_hal_sim_destroy(dev);
+}
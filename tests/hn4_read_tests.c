@@ -19,6 +19,11 @@
 #include "hn4_crc.h"
 #include "hn4_endians.h"
 #include "hn4_addr.h"
+#include "hn4_read.h"
+#include "hn4_orbitmap.h"
+#include "hn4_repair.h"
+#include "hn4_allocator.h"
+#include "hn4_namespace.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -7624,4 +7629,1068 @@ hn4_TEST(SDC, Cross_Slot_Contamination) {
     ASSERT_EQ(HN4_ERR_ID_MISMATCH, res);
 
     hn4_unmount(vol); read_fixture_teardown(dev);
-}
\ No newline at end of file
+}
+
+/* =========================================================================
+ * READAHEAD ENGINE
+ * ========================================================================= */
+
+/*
+ * Writes blocks 0..count-1 of a K=0 file at gravity G. Payload starts with
+ * the block index so reads can be checked for ordering.
+ */
+static void _ra_inject_stream(hn4_volume_t* vol, hn4_u128_t well_id, uint64_t G,
+                              uint64_t gen, uint32_t count, uint8_t fill)
+{
+    uint32_t bs = vol->vol_block_size;
+    uint32_t ss = hn4_hal_get_caps(vol->target_device)->logical_block_size;
+    uint8_t* raw = calloc(1, bs);
+    uint32_t payload_cap = bs - sizeof(hn4_block_header_t);
+
+    for (uint32_t i = 0; i < count; i++) {
+        memset(raw, 0, bs);
+        hn4_block_header_t* hdr = (hn4_block_header_t*)raw;
+
+        hdr->magic      = hn4_cpu_to_le32(HN4_BLOCK_MAGIC);
+        hdr->well_id    = hn4_cpu_to_le128(well_id);
+        hdr->generation = hn4_cpu_to_le64(gen);
+        hdr->seq_index  = hn4_cpu_to_le64(i);
+
+        memset(hdr->payload, fill, payload_cap);
+        memcpy(hdr->payload, &i, sizeof(i));
+
+        hdr->data_crc   = hn4_cpu_to_le32(hn4_crc32(HN4_CRC_SEED_DATA, hdr->payload, payload_cap));
+        hdr->header_crc = hn4_cpu_to_le32(hn4_crc32(HN4_CRC_SEED_HEADER, hdr, offsetof(hn4_block_header_t, header_crc)));
+
+        uint64_t lba = _calc_trajectory_lba(vol, G, 0, i, 0, 0);
+        bool changed;
+        _bitmap_op(vol, lba, 0 /* SET */, &changed);
+        hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, hn4_lba_from_blocks(lba * (bs / ss)), raw, bs / ss);
+    }
+    free(raw);
+}
+
+static void _ra_make_anchor(hn4_anchor_t* a, uint64_t id, uint64_t G, uint32_t gen)
+{
+    memset(a, 0, sizeof(*a));
+    a->seed_id.lo     = id;
+    a->gravity_center = hn4_cpu_to_le64(G);
+    a->write_gen      = hn4_cpu_to_le32(gen);
+    a->permissions    = hn4_cpu_to_le32(HN4_PERM_READ);
+    a->data_class     = hn4_cpu_to_le64(HN4_FLAG_VALID);
+}
+
+/*
+ * TEST: Readahead.SequentialWindowGrows
+ * OBJECTIVE: A linear scan is served from the window after the trigger,
+ *            and the window doubles up to the Generic profile cap.
+ */
+hn4_TEST(Readahead, SequentialWindowGrows) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xA0A0, 2000, 1);
+    _ra_inject_stream(vol, anchor.seed_id, 2000, 1, 48, 0x5A);
+
+    hn4_readahead_t* ra = hn4_readahead_create(vol);
+    ASSERT_TRUE(ra != NULL);
+
+    uint8_t buf[4096];
+    for (uint32_t i = 0; i < 48; i++) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, i, buf, sizeof(buf), 0));
+        uint32_t tag;
+        memcpy(&tag, buf, sizeof(tag));
+        ASSERT_EQ(i, tag);
+        ASSERT_EQ(0x5A, buf[100]);
+    }
+
+    hn4_readahead_stats_t st;
+    hn4_readahead_get_stats(ra, &st);
+
+    ASSERT_EQ(1, st.stride);
+    ASSERT_EQ(16, st.window_cap);
+    ASSERT_EQ(16, st.window);
+    /* Blocks 0..2 arm the detector, everything after comes from the window */
+    ASSERT_EQ(3, st.misses);
+    ASSERT_EQ(45, st.hits);
+
+    hn4_readahead_destroy(ra);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Readahead.StridedAccessDetected
+ * OBJECTIVE: Every 4th block (tensor row walk) is prefetched on stride 4.
+ */
+hn4_TEST(Readahead, StridedAccessDetected) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xB0B0, 3000, 1);
+    _ra_inject_stream(vol, anchor.seed_id, 3000, 1, 64, 0x11);
+
+    hn4_readahead_t* ra = hn4_readahead_create(vol);
+    ASSERT_TRUE(ra != NULL);
+
+    uint8_t buf[4096];
+    for (uint32_t i = 0; i < 64; i += 4) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, i, buf, sizeof(buf), 0));
+        uint32_t tag;
+        memcpy(&tag, buf, sizeof(tag));
+        ASSERT_EQ(i, tag);
+    }
+
+    hn4_readahead_stats_t st;
+    hn4_readahead_get_stats(ra, &st);
+    ASSERT_EQ(4, st.stride);
+    ASSERT_EQ(13, st.hits);
+    /* Never fetches the blocks in between */
+    ASSERT_TRUE(st.issued <= 16);
+
+    hn4_readahead_destroy(ra);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Readahead.RandomAccessStaysSynchronous
+ * OBJECTIVE: No stride, no I/O beyond what the caller asked for.
+ */
+hn4_TEST(Readahead, RandomAccessStaysSynchronous) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xC0C0, 4000, 1);
+    _ra_inject_stream(vol, anchor.seed_id, 4000, 1, 48, 0x22);
+
+    hn4_readahead_t* ra = hn4_readahead_create(vol);
+    ASSERT_TRUE(ra != NULL);
+
+    static const uint32_t order[] = { 5, 1, 30, 12, 2, 40, 7, 33 };
+    uint8_t buf[4096];
+
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, order[i], buf, sizeof(buf), 0));
+    }
+
+    hn4_readahead_stats_t st;
+    hn4_readahead_get_stats(ra, &st);
+    ASSERT_EQ(0, st.issued);
+    ASSERT_EQ(0, st.hits);
+    ASSERT_EQ(8, st.misses);
+
+    hn4_readahead_destroy(ra);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Readahead.RewriteNeverServesStaleWindow
+ * OBJECTIVE: Blocks prefetched under generation 1 must not be returned
+ *            once the file has been rewritten as generation 2.
+ */
+hn4_TEST(Readahead, RewriteNeverServesStaleWindow) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xD0D0, 5000, 1);
+    _ra_inject_stream(vol, anchor.seed_id, 5000, 1, 16, 0x01);
+
+    hn4_readahead_t* ra = hn4_readahead_create(vol);
+    ASSERT_TRUE(ra != NULL);
+
+    uint8_t buf[4096];
+    for (uint32_t i = 0; i < 4; i++) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, i, buf, sizeof(buf), 0));
+    }
+
+    hn4_readahead_stats_t st;
+    hn4_readahead_get_stats(ra, &st);
+    ASSERT_TRUE(st.issued > 0);
+
+    /* Rewrite in place and commit generation 2 */
+    _ra_inject_stream(vol, anchor.seed_id, 5000, 2, 16, 0x02);
+    anchor.write_gen = hn4_cpu_to_le32(2);
+
+    for (uint32_t i = 4; i < 16; i++) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, i, buf, sizeof(buf), 0));
+        ASSERT_EQ(0x02, buf[100]);
+    }
+
+    hn4_readahead_destroy(ra);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Readahead.PicoProfileDisabled
+ * OBJECTIVE: PICO has no window; the NULL handle degrades to a plain read.
+ */
+hn4_TEST(Readahead, PicoProfileDisabled) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xE0E0, 6000, 1);
+    _ra_inject_stream(vol, anchor.seed_id, 6000, 1, 2, 0x33);
+
+    vol->sb.info.format_profile = HN4_PROFILE_PICO;
+    hn4_readahead_t* ra = hn4_readahead_create(vol);
+    ASSERT_TRUE(ra == NULL);
+
+    uint8_t buf[4096];
+    ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, 1, buf, sizeof(buf), 0));
+    ASSERT_EQ(0x33, buf[100]);
+
+    vol->sb.info.format_profile = HN4_PROFILE_GENERIC;
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Readahead.OverlapsOnSimulatedSsd
+ * OBJECTIVE: On a 32-channel SSD timing model a sequential scan with
+ *            readahead costs a fraction of the QD1 virtual time.
+ */
+hn4_TEST(Readahead, OverlapsOnSimulatedSsd) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, R_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xF0F0, 7000, 1);
+    _ra_inject_stream(vol, anchor.seed_id, 7000, 1, 128, 0x44);
+
+    uint8_t buf[4096];
+
+    hn4_time_t t0 = hn4_hal_sim_now(sim);
+    for (uint32_t i = 0; i < 128; i++) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, i, buf, sizeof(buf), 0));
+    }
+    hn4_time_t qd1_ns = hn4_hal_sim_now(sim) - t0;
+
+    hn4_readahead_t* ra = hn4_readahead_create(vol);
+    ASSERT_TRUE(ra != NULL);
+
+    t0 = hn4_hal_sim_now(sim);
+    for (uint32_t i = 0; i < 128; i++) {
+        ASSERT_EQ(HN4_OK, hn4_read_block_ra(ra, vol, &anchor, i, buf, sizeof(buf), 0));
+        uint32_t tag;
+        memcpy(&tag, buf, sizeof(tag));
+        ASSERT_EQ(i, tag);
+    }
+    hn4_hal_poll(sim);
+    hn4_time_t ra_ns = hn4_hal_sim_now(sim) - t0;
+
+    ASSERT_TRUE(qd1_ns > 0);
+    ASSERT_TRUE(ra_ns * 4 < qd1_ns);
+
+    hn4_readahead_destroy(ra);
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/* =========================================================================
+ * HEDGED ORBIT PROBE
+ * ========================================================================= */
+
+/* Writes one block for (well_id, block_idx) at orbit k and claims it. */
+static void _hedge_inject(hn4_volume_t* vol, hn4_u128_t well_id, uint64_t G,
+                          uint64_t block_idx, uint8_t k, uint64_t gen, uint32_t tag)
+{
+    uint32_t bs = vol->vol_block_size;
+    uint32_t ss = hn4_hal_get_caps(vol->target_device)->logical_block_size;
+    uint8_t* raw = calloc(1, bs);
+    uint32_t payload_cap = bs - sizeof(hn4_block_header_t);
+    hn4_block_header_t* hdr = (hn4_block_header_t*)raw;
+
+    hdr->magic      = hn4_cpu_to_le32(HN4_BLOCK_MAGIC);
+    hdr->well_id    = hn4_cpu_to_le128(well_id);
+    hdr->generation = hn4_cpu_to_le64(gen);
+    hdr->seq_index  = hn4_cpu_to_le64(block_idx);
+
+    memcpy(hdr->payload, &tag, sizeof(tag));
+
+    hdr->data_crc   = hn4_cpu_to_le32(hn4_crc32(HN4_CRC_SEED_DATA, hdr->payload, payload_cap));
+    hdr->header_crc = hn4_cpu_to_le32(hn4_crc32(HN4_CRC_SEED_HEADER, hdr, offsetof(hn4_block_header_t, header_crc)));
+
+    uint64_t lba = _calc_trajectory_lba(vol, G, 0, block_idx, 0, k);
+    bool changed;
+    _bitmap_op(vol, lba, 0 /* SET */, &changed);
+    hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, hn4_lba_from_blocks(lba * (bs / ss)), raw, bs / ss);
+    free(raw);
+}
+
+/*
+ * TEST: Hedge.UnhintedDeepOrbitFound
+ * OBJECTIVE: A block past the hinted clusters that landed on k=5 (a
+ *            collision chain) is located by the fan-out.
+ */
+hn4_TEST(Hedge, UnhintedDeepOrbitFound) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xB1B1, 9000, 1);
+    _hedge_inject(vol, anchor.seed_id, 9000, 300, 5, 1, 0xDEAD0005);
+
+    uint8_t buf[4096];
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 300, buf, sizeof(buf), 0));
+
+    uint32_t tag;
+    memcpy(&tag, buf, sizeof(tag));
+    ASSERT_EQ(0xDEAD0005, tag);
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Hedge.ForeignBlockOnLowerOrbitSkipped
+ * OBJECTIVE: Another file's block on k=0 loses to the true block on k=2,
+ *            and is never overwritten by the Auto-Medic.
+ */
+hn4_TEST(Hedge, ForeignBlockOnLowerOrbitSkipped) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xB2B2, 11000, 1);
+
+    hn4_u128_t foreign = { .lo = 0x0BAD, .hi = 0 };
+    _hedge_inject(vol, foreign, 11000, 300, 0, 1, 0xF0F0F0F0);
+    _hedge_inject(vol, anchor.seed_id, 11000, 300, 2, 1, 0xDEAD0002);
+
+    uint8_t buf[4096];
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 300, buf, sizeof(buf), 0));
+
+    uint32_t tag;
+    memcpy(&tag, buf, sizeof(tag));
+    ASSERT_EQ(0xDEAD0002, tag);
+
+    /* The foreign block is intact */
+    uint32_t bs = vol->vol_block_size;
+    uint32_t ss = hn4_hal_get_caps(vol->target_device)->logical_block_size;
+    uint64_t lba = _calc_trajectory_lba(vol, 11000, 0, 300, 0, 0);
+    uint8_t* raw = calloc(1, bs);
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * (bs / ss)), raw, bs / ss));
+    hn4_block_header_t* hdr = (hn4_block_header_t*)raw;
+    ASSERT_EQ(0x0BAD, hn4_le128_to_cpu(hdr->well_id).lo);
+    free(raw);
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Hedge.FanOutCostsOneRoundTrip
+ * OBJECTIVE: On the simulated SSD a miss chain across six orbits costs
+ *            about one read latency, not six.
+ */
+hn4_TEST(Hedge, FanOutCostsOneRoundTrip) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, R_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xB3B3, 13000, 1);
+
+    /* Baseline: a single claimed orbit */
+    _hedge_inject(vol, anchor.seed_id, 13000, 400, 0, 1, 0x1);
+
+    uint8_t buf[4096];
+    hn4_time_t t0 = hn4_hal_sim_now(sim);
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 400, buf, sizeof(buf), 0));
+    hn4_time_t single_ns = hn4_hal_sim_now(sim) - t0;
+
+    /* Five foreign blocks ahead of the true one on k=5 */
+    hn4_u128_t foreign = { .lo = 0x0BAD, .hi = 0 };
+    for (uint8_t k = 0; k < 5; k++) _hedge_inject(vol, foreign, 13000, 500, k, 1, 0xF);
+    _hedge_inject(vol, anchor.seed_id, 13000, 500, 5, 1, 0x5);
+
+    t0 = hn4_hal_sim_now(sim);
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 500, buf, sizeof(buf), 0));
+    hn4_time_t chain_ns = hn4_hal_sim_now(sim) - t0;
+
+    uint32_t tag;
+    memcpy(&tag, buf, sizeof(tag));
+    ASSERT_EQ(0x5, tag);
+
+    ASSERT_TRUE(single_ns > 0);
+    ASSERT_TRUE(chain_ns < single_ns * 3);
+
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Hedge.HintedClusterReadsAlone
+ * OBJECTIVE: Inside the hint range only the hinted orbit is read, even
+ *            when other orbits are claimed (no fan-out).
+ */
+hn4_TEST(Hedge, HintedClusterReadsAlone) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, R_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xB4B4, 15000, 1);
+
+    hn4_u128_t foreign = { .lo = 0x0BAD, .hi = 0 };
+    _hedge_inject(vol, anchor.seed_id, 15000, 3, 0, 1, 0x3);
+    for (uint8_t k = 1; k < 4; k++) _hedge_inject(vol, foreign, 15000, 3, k, 1, 0xF);
+
+    hn4_hal_sim_stats_t before, after;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &before));
+
+    uint8_t buf[4096];
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 3, buf, sizeof(buf), 0));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &after));
+    ASSERT_EQ(1, after.reads - before.reads);
+
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Hedge.HealedCompletionWins
+ * OBJECTIVE: A fan-out read the device had to correct (HN4_INFO_HEALED)
+ *            still wins, is reported as healed, and is queued for a
+ *            rewrite that the next drain applies.
+ */
+hn4_TEST(Hedge, HealedCompletionWins) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, R_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xB5B5, 17000, 1);
+
+    hn4_u128_t foreign = { .lo = 0x0BAD, .hi = 0 };
+    _hedge_inject(vol, foreign, 17000, 300, 0, 1, 0xF);
+    _hedge_inject(vol, anchor.seed_id, 17000, 300, 2, 1, 0xDEAD0002);
+
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t ss  = hn4_hal_get_caps(sim)->logical_block_size;
+    uint64_t lba = _calc_trajectory_lba(vol, 17000, 0, 300, 0, 2);
+    hn4_hal_sim_set_weak(sim, lba * (bs / ss), bs / ss);
+
+    uint8_t buf[4096];
+    ASSERT_EQ(HN4_INFO_HEALED, hn4_read_block_atomic(vol, &anchor, 300, buf, sizeof(buf), 0));
+
+    uint32_t tag;
+    memcpy(&tag, buf, sizeof(tag));
+    ASSERT_EQ(0xDEAD0002, tag);
+
+    /* The medic rewrites the corrected copy in place */
+    ASSERT_EQ(1, hn4_repair_drain(vol));
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 300, buf, sizeof(buf), 0));
+    memcpy(&tag, buf, sizeof(tag));
+    ASSERT_EQ(0xDEAD0002, tag);
+
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/* =========================================================================
+ * ORBIT MAP (BEYOND THE 16-CLUSTER HINTS)
+ * ========================================================================= */
+
+static void _omap_make_anchor(hn4_anchor_t* a, uint64_t id, uint64_t G, const char* name)
+{
+    memset(a, 0, sizeof(*a));
+    a->seed_id.lo     = id;
+    a->gravity_center = hn4_cpu_to_le64(G);
+    a->write_gen      = hn4_cpu_to_le32(1);
+    a->permissions    = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+    a->data_class     = hn4_cpu_to_le64(HN4_FLAG_VALID);
+    strncpy((char*)a->inline_buffer, name, sizeof(a->inline_buffer));
+}
+
+/* Claims orbits 0 .. k-1 of 'block_idx' so the writer lands on k */
+static void _omap_occupy(hn4_volume_t* vol, uint64_t G, uint64_t block_idx, uint8_t k)
+{
+    for (uint8_t i = 0; i < k; i++) {
+        bool c;
+        _bitmap_op(vol, _calc_trajectory_lba(vol, G, 0, block_idx, 0, i), 0 /* SET */, &c);
+    }
+}
+
+/*
+ * TEST: OrbitMap.WriterRecordsBeyondHints
+ * OBJECTIVE: A block past cluster 15 displaced to k=2 is recorded, and the
+ *            next read aims at it with a single device read.
+ */
+hn4_TEST(OrbitMap, WriterRecordsBeyondHints) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, R_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _omap_make_anchor(&anchor, 0xC1C1, 17000, "big.bin");
+
+    ASSERT_EQ(-1, hn4_orbit_map_lookup(vol, &anchor, 300));
+
+    _omap_occupy(vol, 17000, 300, 2);
+    uint8_t data[] = "FAR_BLOCK_K2";
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 300, data, sizeof(data), HN4_PERM_SOVEREIGN));
+
+    ASSERT_EQ(2, hn4_orbit_map_lookup(vol, &anchor, 300));
+    /* The hint word itself is untouched */
+    ASSERT_EQ(0, hn4_le32_to_cpu(anchor.orbit_hints));
+
+    hn4_hal_sim_stats_t before, after;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &before));
+
+    uint8_t buf[4096] = {0};
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 300, buf, sizeof(buf), 0));
+    ASSERT_EQ(0, memcmp(buf, data, sizeof(data)));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &after));
+    ASSERT_EQ(1, after.reads - before.reads);
+
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: OrbitMap.StaleEntryFallsBack
+ * OBJECTIVE: A map entry pointing at the wrong orbit costs a fan-out, not
+ *            a failed read.
+ */
+hn4_TEST(OrbitMap, StaleEntryFallsBack) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _omap_make_anchor(&anchor, 0xC2C2, 19000, "stale.bin");
+
+    _omap_occupy(vol, 19000, 400, 1);
+    uint8_t data[] = "ON_K1";
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 400, data, sizeof(data), HN4_PERM_SOVEREIGN));
+    ASSERT_EQ(1, hn4_orbit_map_lookup(vol, &anchor, 400));
+
+    /* Lie about the orbit */
+    hn4_orbit_map_record(vol, &anchor, 400, 2);
+
+    uint8_t buf[4096] = {0};
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 400, buf, sizeof(buf), 0));
+    ASSERT_EQ(0, memcmp(buf, data, sizeof(data)));
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/* Counts the blocks on the Anchor's extension chain, 'last' gets its tail */
+static int _omap_chain_len(hn4_volume_t* vol, const hn4_anchor_t* a, uint64_t* last)
+{
+    uint64_t lba = 0;
+    uint8_t  buf[R_FIXTURE_BLK];
+    int      n   = 0;
+
+    memcpy(&lba, a->inline_buffer, 8);
+    lba = hn4_le64_to_cpu(lba);
+    if (last) *last = 0;
+
+    while (lba != 0 && n < 64) {
+        if (hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_addr_from_u64(lba), buf, R_FIXTURE_BLK / 512) != HN4_OK) break;
+        if (last) *last = lba;
+        lba = hn4_le64_to_cpu(((hn4_extension_header_t*)buf)->next_ext_lba);
+        n++;
+    }
+    return n;
+}
+
+/* Extended Anchor: 16 name bytes inline, the rest in one LONGNAME block */
+static hn4_result_t _omap_make_extended(hn4_volume_t* vol, hn4_anchor_t* a, uint64_t id, uint64_t G, const char* name)
+{
+    _omap_make_anchor(a, id, G, "");
+    a->data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_FLAG_EXTENDED);
+
+    size_t len  = strlen(name);
+    size_t frag = len < 16 ? len : 16;
+    memcpy(a->inline_buffer + 8, name, frag);
+    if (len == frag) return HN4_OK;
+
+    hn4_addr_t   phys;
+    hn4_result_t res = hn4_alloc_horizon(vol, &phys);
+    if (res != HN4_OK) return res;
+
+    uint8_t buf[R_FIXTURE_BLK] = {0};
+    hn4_extension_header_t* ext = (hn4_extension_header_t*)buf;
+    ext->magic = hn4_cpu_to_le32(HN4_MAGIC_META);
+    ext->type  = hn4_cpu_to_le32(HN4_EXT_TYPE_LONGNAME);
+    memcpy(ext->payload, name + frag, len - frag);
+    res = hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, phys, buf, R_FIXTURE_BLK / 512);
+
+    uint64_t ptr = hn4_cpu_to_le64(hn4_addr_to_u64(phys));
+    memcpy(a->inline_buffer, &ptr, 8);
+    return res;
+}
+
+/*
+ * TEST: OrbitMap.PersistReloadsAfterCacheLoss
+ * OBJECTIVE: A persisted map is found again through the extension chain
+ *            once the RAM cache is gone. Map blocks go behind the naming
+ *            extensions, so the name still resolves and an existing chain
+ *            head is kept.
+ */
+hn4_TEST(OrbitMap, PersistReloadsAfterCacheLoss) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    const char* names[2] = { "short.bin", "a_rather_long_name.bin" };
+
+    for (int n = 0; n < 2; n++) {
+        hn4_anchor_t anchor;
+        uint64_t G = 21000 + (uint64_t)n * 4000;
+        ASSERT_EQ(HN4_OK, _omap_make_extended(vol, &anchor, 0xC3C3 + n, G, names[n]));
+
+        uint64_t name_head = 0;
+        memcpy(&name_head, anchor.inline_buffer, 8);
+
+        /* Clusters 20 and 5000: both in the first map block */
+        _omap_occupy(vol, G, 320, 1);
+        _omap_occupy(vol, G, 80000, 2);
+
+        uint8_t data[] = "PERSISTED";
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 320, data, sizeof(data), HN4_PERM_SOVEREIGN));
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 80000, data, sizeof(data), HN4_PERM_SOVEREIGN));
+
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &anchor));
+
+        uint64_t head = 0;
+        memcpy(&head, anchor.inline_buffer, 8);
+        if (name_head != 0) {
+            /* LONGNAME stays first, the map hangs off its tail */
+            ASSERT_EQ(name_head, head);
+            ASSERT_EQ(2, _omap_chain_len(vol, &anchor, NULL));
+        } else {
+            ASSERT_TRUE(head != 0);
+            ASSERT_EQ(1, _omap_chain_len(vol, &anchor, NULL));
+        }
+
+        /* Clean map: second persist is a no-op */
+        hn4_anchor_t copy = anchor;
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &anchor));
+        ASSERT_EQ(0, memcmp(&copy, &anchor, sizeof(anchor)));
+
+        hn4_orbit_map_release(vol);
+
+        ASSERT_EQ(1, hn4_orbit_map_lookup(vol, &anchor, 320));
+        ASSERT_EQ(2, hn4_orbit_map_lookup(vol, &anchor, 80000));
+        ASSERT_EQ(-1, hn4_orbit_map_lookup(vol, &anchor, 640));
+
+        char name[64] = {0};
+        ASSERT_EQ(HN4_OK, hn4_ns_get_name(vol, &anchor, name, sizeof(name)));
+        ASSERT_EQ(0, strcmp(names[n], name));
+
+        /* Rewrite in place: the chain does not grow */
+        int len = _omap_chain_len(vol, &anchor, NULL);
+        hn4_orbit_map_record(vol, &anchor, 320, 0);
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &anchor));
+        uint64_t head2 = 0;
+        memcpy(&head2, anchor.inline_buffer, 8);
+        ASSERT_EQ(head, head2);
+        ASSERT_EQ(len, _omap_chain_len(vol, &anchor, NULL));
+
+        hn4_orbit_map_release(vol);
+        ASSERT_EQ(0, hn4_orbit_map_lookup(vol, &anchor, 320));
+    }
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: OrbitMap.InlineAnchorConverted
+ * OBJECTIVE: Persisting the map of an inline-named file moves it to the
+ *            extended layout. A name tail goes into a LONGNAME block at the
+ *            head of the chain, ahead of the map, and the name still
+ *            resolves. The map reloads once the RAM cache is gone.
+ */
+hn4_TEST(OrbitMap, InlineAnchorConverted) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    const char* names[2] = { "inline_name.bin", "inline_longer_name.bin" };
+
+    for (int n = 0; n < 2; n++) {
+        hn4_anchor_t anchor;
+        _omap_make_anchor(&anchor, 0xC5C5 + n, 26000, names[n]);
+
+        hn4_orbit_map_record(vol, &anchor, 320, 1);
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &anchor));
+        ASSERT_TRUE(hn4_le64_to_cpu(anchor.data_class) & HN4_FLAG_EXTENDED);
+
+        bool has_tail = strlen(names[n]) > 16;
+        ASSERT_EQ(has_tail ? 2 : 1, _omap_chain_len(vol, &anchor, NULL));
+
+        /* Name tail first, so the Namespace walk meets it before the map */
+        uint64_t head = 0;
+        uint8_t  buf[R_FIXTURE_BLK];
+        memcpy(&head, anchor.inline_buffer, 8);
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_addr_from_u64(hn4_le64_to_cpu(head)), buf, R_FIXTURE_BLK / 512));
+        ASSERT_EQ(has_tail ? HN4_EXT_TYPE_LONGNAME : HN4_EXT_TYPE_ORBITMAP,
+                  hn4_le32_to_cpu(((hn4_extension_header_t*)buf)->type));
+
+        char name[64] = {0};
+        ASSERT_EQ(HN4_OK, hn4_ns_get_name(vol, &anchor, name, sizeof(name)));
+        ASSERT_EQ(0, strcmp(names[n], name));
+
+        /* Already extended: a second persist leaves the Anchor alone */
+        hn4_anchor_t copy = anchor;
+        hn4_orbit_map_record(vol, &anchor, 320, 2);
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &anchor));
+        ASSERT_EQ(0, memcmp(&copy, &anchor, sizeof(anchor)));
+
+        hn4_orbit_map_release(vol);
+        ASSERT_EQ(2, hn4_orbit_map_lookup(vol, &anchor, 320));
+    }
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: OrbitMap.ChainStaysBounded
+ * OBJECTIVE: A map larger than HN4_OMAP_MAX_SEGS blocks persists only the
+ *            capped prefix, and a chain already near the Namespace walk
+ *            depth gets no new blocks. Repeated persists never grow it.
+ */
+hn4_TEST(OrbitMap, ChainStaysBounded) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint64_t per_blk = (uint64_t)(R_FIXTURE_BLK - sizeof(hn4_extension_header_t)
+                                  - sizeof(hn4_orbit_map_payload_t)) * 4;
+    uint64_t far_blk = (HN4_OMAP_FIRST_CLUSTER + (HN4_OMAP_MAX_SEGS + 1) * per_blk) << 4;
+
+    /* 1. Oversized map: capped at HN4_OMAP_MAX_SEGS blocks */
+    hn4_anchor_t a;
+    ASSERT_EQ(HN4_OK, _omap_make_extended(vol, &a, 0xC6C6, 27000, "capped_map_file.bin"));
+
+    for (uint64_t s = 0; s <= HN4_OMAP_MAX_SEGS + 1; s++) {
+        hn4_orbit_map_record(vol, &a, (HN4_OMAP_FIRST_CLUSTER + s * per_blk) << 4, 1);
+    }
+
+    for (int round = 0; round < 3; round++) {
+        hn4_orbit_map_record(vol, &a, far_blk, (uint8_t)(round & 1));
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &a));
+        ASSERT_EQ(1 + HN4_OMAP_MAX_SEGS, _omap_chain_len(vol, &a, NULL));
+    }
+
+    hn4_orbit_map_release(vol);
+    ASSERT_EQ(1, hn4_orbit_map_lookup(vol, &a, (HN4_OMAP_FIRST_CLUSTER + (HN4_OMAP_MAX_SEGS - 1) * per_blk) << 4));
+    ASSERT_EQ(-1, hn4_orbit_map_lookup(vol, &a, far_blk));
+
+    /* 2. Chain already 15 deep: the map does not fit, nothing is appended */
+    hn4_anchor_t b;
+    ASSERT_EQ(HN4_OK, _omap_make_extended(vol, &b, 0xC7C7, 28000, "deep_chain_file.bin"));
+
+    uint64_t tail = 0;
+    ASSERT_EQ(1, _omap_chain_len(vol, &b, &tail));
+
+    uint8_t buf[R_FIXTURE_BLK];
+    for (int i = 0; i < 14; i++) {
+        hn4_addr_t phys;
+        ASSERT_EQ(HN4_OK, hn4_alloc_horizon(vol, &phys));
+
+        memset(buf, 0, sizeof(buf));
+        hn4_extension_header_t* ext = (hn4_extension_header_t*)buf;
+        ext->magic = hn4_cpu_to_le32(HN4_MAGIC_META);
+        ext->type  = hn4_cpu_to_le32(HN4_EXT_TYPE_TAG);
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, phys, buf, R_FIXTURE_BLK / 512));
+
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(vol->target_device, HN4_IO_READ, hn4_addr_from_u64(tail), buf, R_FIXTURE_BLK / 512));
+        ((hn4_extension_header_t*)buf)->next_ext_lba = hn4_cpu_to_le64(hn4_addr_to_u64(phys));
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(vol->target_device, HN4_IO_WRITE, hn4_addr_from_u64(tail), buf, R_FIXTURE_BLK / 512));
+        tail = hn4_addr_to_u64(phys);
+    }
+    ASSERT_EQ(15, _omap_chain_len(vol, &b, NULL));
+
+    for (int round = 0; round < 3; round++) {
+        hn4_orbit_map_record(vol, &b, 320, 1);
+        hn4_orbit_map_record(vol, &b, (HN4_OMAP_FIRST_CLUSTER + per_blk) << 4, (uint8_t)(round & 1));
+        ASSERT_EQ(HN4_OK, hn4_orbit_map_persist(vol, &b));
+        ASSERT_EQ(15, _omap_chain_len(vol, &b, NULL));
+    }
+
+    char name[64] = {0};
+    ASSERT_EQ(HN4_OK, hn4_ns_get_name(vol, &b, name, sizeof(name)));
+    ASSERT_EQ(0, strcmp("deep_chain_file.bin", name));
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/* =========================================================================
+ * INTEGRITY TIERS
+ * ========================================================================= */
+
+/*
+ * hn4_scavenger.c entry point; not prototyped in a header.
+ */
+void hn4_scavenger_pulse(hn4_volume_t* vol);
+
+static void _tier_make_anchor(hn4_anchor_t* a, uint64_t id, uint64_t G)
+{
+    memset(a, 0, sizeof(*a));
+    a->seed_id.lo     = id;
+    a->gravity_center = hn4_cpu_to_le64(G);
+    a->write_gen      = hn4_cpu_to_le32(10);
+    a->permissions    = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+    a->data_class     = hn4_cpu_to_le64(HN4_FLAG_VALID);
+}
+
+/*
+ * TEST: Integrity.HeaderTierSkipsPayloadCrc
+ * OBJECTIVE: HEADER hands out a block with a rotten payload CRC; FULL
+ *            rejects the same block.
+ */
+hn4_TEST(Integrity, HeaderTierSkipsPayloadCrc) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    p.integrity_level = HN4_INTEGRITY_HEADER;
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+    ASSERT_EQ(HN4_INTEGRITY_HEADER, hn4_read_get_integrity(vol));
+
+    hn4_anchor_t anchor;
+    _tier_make_anchor(&anchor, 0x7171, 2100);
+
+    uint64_t lba = _calc_trajectory_lba(vol, 2100, 0, 0, 0, 0);
+    _inject_test_block(vol, lba, anchor.seed_id, 10, "ROT", 3, INJECT_BAD_DATA_CRC);
+
+    uint8_t buf[4096] = {0};
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 0, buf, sizeof(buf), 0));
+    ASSERT_EQ(0, memcmp(buf, "ROT", 3));
+
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_set_integrity(vol, HN4_INTEGRITY_FULL));
+    ASSERT_EQ(HN4_ERR_PAYLOAD_ROT, hn4_read_block_atomic(vol, &anchor, 0, buf, sizeof(buf), 0));
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Integrity.TrustNeedsMediaEcc
+ * OBJECTIVE: TRUST is only granted on NVM that advertises media ECC;
+ *            otherwise the mount falls back to HEADER. STRICT maps to FULL.
+ */
+hn4_TEST(Integrity, TrustNeedsMediaEcc) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    p.integrity_level = HN4_INTEGRITY_TRUST;
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    ASSERT_EQ(HN4_INTEGRITY_HEADER, hn4_read_get_integrity(vol));
+
+    ((hn4_hal_caps_t*)dev)->hw_flags |= HN4_HW_MEDIA_ECC;
+    ASSERT_EQ(HN4_INTEGRITY_TRUST, hn4_read_set_integrity(vol, HN4_INTEGRITY_TRUST));
+    ASSERT_EQ(HN4_INTEGRITY_TRUST, hn4_read_get_integrity(vol));
+
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_set_integrity(vol, HN4_INTEGRITY_STRICT));
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_set_integrity(vol, 99));
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Integrity.HealthChangePromotesToFull
+ * OBJECTIVE: Any movement of the health counters after the tier was set
+ *            promotes the mount back to FULL. A tainted volume never gets
+ *            a relaxed tier in the first place.
+ */
+hn4_TEST(Integrity, HealthChangePromotesToFull) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    p.integrity_level = HN4_INTEGRITY_HEADER;
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+    ASSERT_EQ(HN4_INTEGRITY_HEADER, hn4_read_get_integrity(vol));
+
+    atomic_fetch_add(&vol->health.crc_failures, 1);
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_get_integrity(vol));
+    /* Sticky */
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_get_integrity(vol));
+
+    atomic_fetch_add(&vol->health.taint_counter, 1);
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_set_integrity(vol, HN4_INTEGRITY_HEADER));
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Integrity.ScrubCatchesPayloadRot
+ * OBJECTIVE: Under HEADER, the Scavenger pulse checks the payload CRC the
+ *            reader skipped, counts the rot, and the mount returns to FULL.
+ */
+hn4_TEST(Integrity, ScrubCatchesPayloadRot) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    p.integrity_level = HN4_INTEGRITY_HEADER;
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _tier_make_anchor(&anchor, 0x7272, 2300);
+
+    uint64_t lba = _calc_trajectory_lba(vol, 2300, 0, 0, 0, 0);
+    _inject_test_block(vol, lba, anchor.seed_id, 10, "ROT", 3, INJECT_BAD_DATA_CRC);
+
+    uint8_t buf[4096] = {0};
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 0, buf, sizeof(buf), 0));
+
+    atomic_store(&vol->health.crc_failures, 0);
+    vol->integrity.health_sig = 0;
+    vol->integrity.scrub_cursor = lba;
+
+    hn4_scavenger_pulse(vol);
+
+    ASSERT_TRUE(atomic_load(&vol->integrity.scrubbed) >= 1);
+    ASSERT_EQ(1, atomic_load(&vol->health.crc_failures));
+    ASSERT_EQ(HN4_INTEGRITY_FULL, hn4_read_get_integrity(vol));
+    ASSERT_EQ(HN4_ERR_PAYLOAD_ROT, hn4_read_block_atomic(vol, &anchor, 0, buf, sizeof(buf), 0));
+
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
+
+/* =========================================================================
+ * DEFERRED AUTO-MEDIC
+ * ========================================================================= */
+
+/*
+ * TEST: Medic.ReaderQueuesRepairScavengerApplies
+ * OBJECTIVE: A rotten copy seen on the way to the good one is not rewritten
+ *            by the reader. It sits in the medic queue until the Scavenger
+ *            pulse drains it.
+ */
+hn4_TEST(Medic, ReaderQueuesRepairScavengerApplies) {
+    hn4_hal_device_t* dev = read_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _ra_make_anchor(&anchor, 0xD1D1, 13000, 1);
+    _hedge_inject(vol, anchor.seed_id, 13000, 300, 0, 1, 0xDEAD0000);
+    _hedge_inject(vol, anchor.seed_id, 13000, 300, 1, 1, 0xDEAD0000);
+
+    /* Rot one payload byte of k=0 */
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t ss  = hn4_hal_get_caps(vol->target_device)->logical_block_size;
+    uint64_t lba = _calc_trajectory_lba(vol, 13000, 0, 300, 0, 0);
+    hn4_addr_t phys = hn4_lba_from_blocks(lba * (bs / ss));
+    uint8_t* raw  = calloc(1, bs);
+    uint8_t* good = calloc(1, bs);
+    hn4_hal_sync_io(dev, HN4_IO_READ, phys, raw, bs / ss);
+    raw[bs - 1] ^= 0xFF;
+    hn4_hal_sync_io(dev, HN4_IO_WRITE, phys, raw, bs / ss);
+
+    atomic_store(&vol->health.heal_count, 0);
+    atomic_store(&vol->health.crc_failures, 0);
+
+    uint8_t buf[4096];
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 300, buf, sizeof(buf), 0));
+
+    uint32_t tag;
+    memcpy(&tag, buf, sizeof(tag));
+    ASSERT_EQ(0xDEAD0000, tag);
+
+    /* Queued, not written */
+    ASSERT_EQ(1, vol->medic_queue.repair_count);
+    ASSERT_EQ(1, atomic_load(&vol->health.crc_failures));
+    ASSERT_EQ(0, atomic_load(&vol->health.heal_count));
+
+    hn4_scavenger_pulse(vol);
+
+    ASSERT_EQ(0, vol->medic_queue.repair_count);
+    ASSERT_EQ(1, atomic_load(&vol->health.heal_count));
+
+    raw[bs - 1] ^= 0xFF;
+    hn4_hal_sync_io(dev, HN4_IO_READ, phys, good, bs / ss);
+    ASSERT_EQ(0, memcmp(good, raw, bs));
+
+    free(raw);
+    free(good);
+    hn4_unmount(vol);
+    read_fixture_teardown(dev);
+}
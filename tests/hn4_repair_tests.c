@@ -15,9 +15,12 @@
 #include "hn4_endians.h"
 #include "hn4_constants.h"
 #include "hn4_addr.h"
+#include "hn4_repair.h"
+#include "hn4_allocator.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdatomic.h>
+#include <pthread.h>
 
 /* =========================================================================
  * FIXTURE INFRASTRUCTURE
@@ -1408,4 +1411,226 @@ hn4_TEST(Repair, Recovery_ReadOnly_Denial) {
 
     hn4_unmount(vol);
     repair_teardown(dev);
-}
\ No newline at end of file
+}
+/* =========================================================================
+ * DEFERRED REPAIR (MEDIC BACKLOG)
+ * ========================================================================= */
+
+/* Flux block 'rel' -> sector address; claims it in the bitmap when asked. */
+static hn4_addr_t _rep_flux_block(hn4_volume_t* vol, uint64_t rel, bool claim)
+{
+    uint32_t spb   = REP_BLOCK_SIZE / REP_SECTOR_SIZE;
+    uint64_t first = hn4_addr_to_u64(vol->sb.info.lba_flux_start) / spb;
+
+    if (claim) {
+        bool c;
+        _bitmap_op(vol, first + rel, 0 /* SET */, &c);
+    }
+    return hn4_lba_from_sectors((first + rel) * spb);
+}
+
+/* A well-formed data block for (id, gen) filled with 'fill'. */
+static void _rep_make_block(uint8_t* raw, uint64_t id, uint64_t gen, uint8_t fill)
+{
+    memset(raw, fill, REP_BLOCK_SIZE);
+    hn4_block_header_t* hdr = (hn4_block_header_t*)raw;
+    hdr->magic      = hn4_cpu_to_le32(HN4_BLOCK_MAGIC);
+    hdr->well_id.lo = hn4_cpu_to_le64(id);
+    hdr->well_id.hi = 0;
+    hdr->generation = hn4_cpu_to_le64(gen);
+    hdr->data_crc   = hn4_cpu_to_le32(hn4_crc32(HN4_CRC_SEED_DATA, hdr->payload,
+                                                REP_BLOCK_SIZE - sizeof(hn4_block_header_t)));
+    hdr->header_crc = hn4_cpu_to_le32(hn4_crc32(HN4_CRC_SEED_HEADER, hdr,
+                                                offsetof(hn4_block_header_t, header_crc)));
+}
+
+/*
+ * TEST: Repair.Deferred_Batch_Heals
+ * OBJECTIVE: Deferred repairs touch nothing until drained; one drain
+ *            heals the whole batch.
+ */
+hn4_TEST(Repair, Deferred_Batch_Heals) {
+    hn4_hal_device_t* dev = repair_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t spb = REP_BLOCK_SIZE / REP_SECTOR_SIZE;
+    static uint8_t bad[REP_BLOCK_SIZE], good[REP_BLOCK_SIZE], rd[REP_BLOCK_SIZE];
+    memset(bad, 0x66, REP_BLOCK_SIZE);
+    _rep_make_block(good, 0xAB, 3, 0x77);
+
+    hn4_addr_t t[2] = { _rep_flux_block(vol, 200, true), _rep_flux_block(vol, 201, true) };
+
+    for (int i = 0; i < 2; i++) {
+        hn4_hal_sync_io(dev, HN4_IO_WRITE, t[i], bad, spb);
+        ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, t[i], good, REP_BLOCK_SIZE));
+    }
+
+    ASSERT_EQ(2, vol->medic_queue.repair_count);
+    hn4_hal_sync_io(dev, HN4_IO_READ, t[0], rd, spb);
+    ASSERT_EQ(0, memcmp(rd, bad, REP_BLOCK_SIZE));
+    ASSERT_EQ(0, atomic_load(&vol->health.heal_count));
+
+    ASSERT_EQ(2, hn4_repair_drain(vol));
+    ASSERT_EQ(0, vol->medic_queue.repair_count);
+    ASSERT_EQ(2, atomic_load(&vol->health.heal_count));
+
+    for (int i = 0; i < 2; i++) {
+        hn4_hal_sync_io(dev, HN4_IO_READ, t[i], rd, spb);
+        ASSERT_EQ(0, memcmp(rd, good, REP_BLOCK_SIZE));
+    }
+
+    hn4_unmount(vol);
+    repair_teardown(dev);
+}
+
+/*
+ * TEST: Repair.Deferred_Drops_Reused_Slot
+ * OBJECTIVE: A queued repair must not clobber a slot that was freed or
+ *            handed to another file before the drain.
+ */
+hn4_TEST(Repair, Deferred_Drops_Reused_Slot) {
+    hn4_hal_device_t* dev = repair_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t spb = REP_BLOCK_SIZE / REP_SECTOR_SIZE;
+    static uint8_t good[REP_BLOCK_SIZE], other[REP_BLOCK_SIZE], rd[REP_BLOCK_SIZE];
+    _rep_make_block(good,  0xAB, 3, 0x77);
+    _rep_make_block(other, 0xCD, 1, 0x55);
+
+    /* Slot reallocated to another file */
+    hn4_addr_t reused = _rep_flux_block(vol, 300, true);
+    ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, reused, good, REP_BLOCK_SIZE));
+    hn4_hal_sync_io(dev, HN4_IO_WRITE, reused, other, spb);
+
+    /* Slot freed */
+    hn4_addr_t freed = _rep_flux_block(vol, 301, false);
+    ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, freed, good, REP_BLOCK_SIZE));
+
+    ASSERT_EQ(0, hn4_repair_drain(vol));
+    ASSERT_EQ(0, atomic_load(&vol->health.heal_count));
+
+    hn4_hal_sync_io(dev, HN4_IO_READ, reused, rd, spb);
+    ASSERT_EQ(0, memcmp(rd, other, REP_BLOCK_SIZE));
+
+    hn4_unmount(vol);
+    repair_teardown(dev);
+}
+
+typedef struct {
+    hn4_volume_t*    vol;
+    hn4_addr_t       lba;
+    _Atomic bool     done;
+} _rep_free_ctx_t;
+
+static void* _rep_free_worker(void* arg)
+{
+    _rep_free_ctx_t* c = (_rep_free_ctx_t*)arg;
+    hn4_free_block(c->vol, c->lba);
+    atomic_store(&c->done, true);
+    return NULL;
+}
+
+/*
+ * TEST: Repair.Deferred_Free_Fences
+ * OBJECTIVE: Freeing a block drops its queued repair, and a free of a
+ *            block held by a drain batch waits until the batch is done.
+ */
+hn4_TEST(Repair, Deferred_Free_Fences) {
+    hn4_hal_device_t* dev = repair_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t spb = REP_BLOCK_SIZE / REP_SECTOR_SIZE;
+    static uint8_t good[REP_BLOCK_SIZE], bad[REP_BLOCK_SIZE], rd[REP_BLOCK_SIZE];
+    _rep_make_block(good, 0xAB, 3, 0x77);
+    memset(bad, 0x66, REP_BLOCK_SIZE);
+
+    /* 1. Queued repair of a freed block: dropped, never written */
+    hn4_addr_t t = _rep_flux_block(vol, 700, true);
+    hn4_hal_sync_io(dev, HN4_IO_WRITE, t, bad, spb);
+    ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, t, good, REP_BLOCK_SIZE));
+
+    hn4_free_block(vol, t);
+    ASSERT_EQ(0, vol->medic_queue.repair_count);
+    ASSERT_EQ(0, hn4_repair_drain(vol));
+
+    hn4_hal_sync_io(dev, HN4_IO_READ, t, rd, spb);
+    ASSERT_EQ(0, memcmp(rd, bad, REP_BLOCK_SIZE));
+
+    /* 2. Block held by a batch in flight: the free waits for it */
+    hn4_addr_t u   = _rep_flux_block(vol, 701, true);
+    uint64_t   blk = hn4_addr_to_u64(u) / spb;
+
+    vol->medic_queue.claimed[0]  = blk;
+    vol->medic_queue.claim_count = 1;
+
+    _rep_free_ctx_t ctx = { .vol = vol, .lba = u, .done = false };
+    pthread_t th;
+    ASSERT_EQ(0, pthread_create(&th, NULL, _rep_free_worker, &ctx));
+
+    hn4_hal_micro_sleep(20000);
+    ASSERT_FALSE(atomic_load(&ctx.done));
+
+    bool set = false;
+    ASSERT_EQ(HN4_OK, _bitmap_op(vol, blk, BIT_TEST, &set));
+    ASSERT_TRUE(set);
+
+    vol->medic_queue.claim_count = 0;
+    pthread_join(th, NULL);
+    ASSERT_TRUE(atomic_load(&ctx.done));
+
+    ASSERT_EQ(HN4_OK, _bitmap_op(vol, blk, BIT_TEST, &set));
+    ASSERT_FALSE(set);
+
+    hn4_unmount(vol);
+    repair_teardown(dev);
+}
+
+/*
+ * TEST: Repair.Deferred_Coalesces_And_Bounds
+ * OBJECTIVE: One entry per LBA (newest copy wins), a bounded backlog, and
+ *            no queueing on a read-only mount.
+ */
+hn4_TEST(Repair, Deferred_Coalesces_And_Bounds) {
+    hn4_hal_device_t* dev = repair_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t spb = REP_BLOCK_SIZE / REP_SECTOR_SIZE;
+    static uint8_t v1[REP_BLOCK_SIZE], v2[REP_BLOCK_SIZE], rd[REP_BLOCK_SIZE];
+    _rep_make_block(v1, 0xAB, 3, 0x11);
+    _rep_make_block(v2, 0xAB, 3, 0x22);
+
+    hn4_addr_t t = _rep_flux_block(vol, 400, true);
+    memset(rd, 0x66, REP_BLOCK_SIZE);
+    hn4_hal_sync_io(dev, HN4_IO_WRITE, t, rd, spb);
+
+    ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, t, v1, REP_BLOCK_SIZE));
+    ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, t, v2, REP_BLOCK_SIZE));
+    ASSERT_EQ(1, vol->medic_queue.repair_count);
+
+    ASSERT_EQ(1, hn4_repair_drain(vol));
+    hn4_hal_sync_io(dev, HN4_IO_READ, t, rd, spb);
+    ASSERT_EQ(0, memcmp(rd, v2, REP_BLOCK_SIZE));
+
+    for (uint32_t i = 0; i < HN4_MEDIC_REPAIR_SLOTS; i++) {
+        ASSERT_EQ(HN4_OK, hn4_repair_defer(vol, _rep_flux_block(vol, 500 + i, false), v1, REP_BLOCK_SIZE));
+    }
+    ASSERT_EQ(HN4_ERR_BUSY, hn4_repair_defer(vol, _rep_flux_block(vol, 600, false), v1, REP_BLOCK_SIZE));
+
+    /* Read-only: refused, and the backlog is discarded rather than written */
+    vol->read_only = true;
+    ASSERT_EQ(HN4_ERR_ACCESS_DENIED, hn4_repair_defer(vol, t, v1, REP_BLOCK_SIZE));
+    ASSERT_EQ(0, hn4_repair_drain(vol));
+    ASSERT_EQ(0, vol->medic_queue.repair_count);
+    vol->read_only = false;
+
+    hn4_unmount(vol);
+    repair_teardown(dev);
+}
@@ -8,6 +8,9 @@
 #include "hn4_tensor.h"
 #include "hn4_hal.h"
 #include "hn4_endians.h"
+#include "hn4_constants.h"
+#include "hn4_write.h"
+#include <stdlib.h>
 
 /* --- FIXTURES --- */
 
@@ -300,3 +303,251 @@ hn4_TEST(TensorOps, Freeze_Archive_Fail) {
     hn4_hal_mem_free(raw);
     destroy_tensor_vol(vol);
 }
+
+/* --- FREEZE FIXTURE --- */
+
+/*
+ * hn4_read.c entry point; not prototyped in a header.
+ */
+hn4_result_t hn4_read_block_atomic(hn4_volume_t* vol, const hn4_anchor_t* anchor,
+                                   uint64_t block_idx, void* out, uint32_t len,
+                                   uint32_t session_perms);
+
+#define FZ_BLK      (64ULL * 1024 * 1024)
+#define FZ_CAP      (1024ULL * 1024 * 1024)
+#define FZ_SS       4096
+#define FZ_CORTEX   1024ULL     /* Sector of the Cortex, inside block 0 */
+#define FZ_LEN      (FZ_BLK + 2 * 1024 * 1024) /* Spills into a second block */
+
+/*
+ * A mounted-looking 1GB AI volume: 16 blocks of 64MB, Flux in blocks 1-9,
+ * Horizon in blocks 10-13, a 256-sector Cortex in block 0.
+ * 'starved' leaves one Flux block (Quality Mask) and one Horizon block,
+ * which the Signet seal takes.
+ */
+static hn4_volume_t* create_freeze_vol(bool starved) {
+    hn4_volume_t* vol = hn4_hal_mem_alloc(sizeof(hn4_volume_t));
+    memset(vol, 0, sizeof(hn4_volume_t));
+
+    tensor_mock_dev_t* mdev = hn4_hal_mem_alloc(sizeof(tensor_mock_dev_t));
+    memset(mdev, 0, sizeof(tensor_mock_dev_t));
+
+#ifdef HN4_USE_128BIT
+    mdev->caps.total_capacity_bytes.lo = FZ_CAP;
+    vol->vol_capacity_bytes.lo = FZ_CAP;
+#else
+    mdev->caps.total_capacity_bytes = FZ_CAP;
+    vol->vol_capacity_bytes = FZ_CAP;
+#endif
+    mdev->caps.logical_block_size = FZ_SS;
+    mdev->caps.hw_flags = HN4_HW_NVM;
+    /* calloc: only the blocks a test writes are ever touched */
+    mdev->mmio_base = calloc(1, FZ_CAP);
+
+    vol->target_device = (hn4_hal_device_t*)mdev;
+    vol->sb.info.format_profile = HN4_PROFILE_AI;
+    vol->vol_block_size = FZ_BLK;
+    vol->sb.info.block_size = FZ_BLK;
+
+    uint64_t spb = FZ_BLK / FZ_SS;
+    vol->sb.info.lba_cortex_start  = FZ_CORTEX;
+    vol->sb.info.lba_bitmap_start  = FZ_CORTEX + 256;
+    vol->sb.info.lba_flux_start    = 1 * spb;
+    vol->sb.info.lba_horizon_start = 10 * spb;
+    vol->sb.info.lba_stream_start  = 10 * spb;
+    vol->sb.info.journal_start     = (starved ? 11 : 14) * spb;
+
+    vol->bitmap_size = 4096;
+    vol->void_bitmap = hn4_hal_mem_alloc(vol->bitmap_size);
+    memset(vol->void_bitmap, 0, vol->bitmap_size);
+
+    vol->qmask_size = 4096;
+    vol->quality_mask = hn4_hal_mem_alloc(vol->qmask_size);
+    if (starved) {
+        memset(vol->quality_mask, 0x00, vol->qmask_size); /* TOXIC */
+        vol->quality_mask[0] = HN4_Q_SILVER << 2;         /* Block 1 */
+    } else {
+        memset(vol->quality_mask, 0xAA, vol->qmask_size); /* SILVER */
+    }
+
+    vol->locking.l2_summary_bitmap = hn4_hal_mem_alloc(64);
+    memset(vol->locking.l2_summary_bitmap, 0, 64);
+
+    vol->cortex_size = 256 * FZ_SS;
+    vol->nano_cortex = hn4_hal_mem_alloc(vol->cortex_size);
+    memset(vol->nano_cortex, 0, vol->cortex_size);
+
+    return vol;
+}
+
+static void destroy_freeze_vol(hn4_volume_t* vol) {
+    tensor_mock_dev_t* mdev = (tensor_mock_dev_t*)vol->target_device;
+    free(mdev->mmio_base);
+    hn4_hal_mem_free(mdev);
+    hn4_hal_mem_free(vol->void_bitmap);
+    hn4_hal_mem_free(vol->quality_mask);
+    hn4_hal_mem_free(vol->locking.l2_summary_bitmap);
+    hn4_hal_mem_free(vol->nano_cortex);
+    hn4_hal_mem_free(vol);
+}
+
+/* Finds a committed Anchor other than 'skip' in the on-media Cortex */
+static bool _fz_find_anchor(hn4_volume_t* vol, const hn4_anchor_t* skip, hn4_anchor_t* out) {
+    tensor_mock_dev_t* mdev = (tensor_mock_dev_t*)vol->target_device;
+    hn4_anchor_t* slots = (hn4_anchor_t*)(mdev->mmio_base + FZ_CORTEX * FZ_SS);
+    size_t count = (256 * FZ_SS) / sizeof(hn4_anchor_t);
+
+    for (size_t i = 0; i < count; i++) {
+        if (slots[i].seed_id.lo == 0 && slots[i].seed_id.hi == 0) continue;
+        if (skip && slots[i].seed_id.lo == skip->seed_id.lo &&
+                    slots[i].seed_id.hi == skip->seed_id.hi) continue;
+        *out = slots[i];
+        return true;
+    }
+    return false;
+}
+
+/* 2MB-aligned KV buffer filled with a pattern derived from 'seed' */
+static uint8_t* _fz_kv(uint8_t seed, void** raw) {
+    *raw = malloc(FZ_LEN + 2 * 1024 * 1024);
+    uint8_t* buf = (uint8_t*)(((uintptr_t)*raw + (2 * 1024 * 1024 - 1)) &
+                              ~(uintptr_t)(2 * 1024 * 1024 - 1));
+    for (uint64_t i = 0; i < FZ_LEN; i++) buf[i] = (uint8_t)(i * 13 + seed);
+    return buf;
+}
+
+/* Reads every block of 'anchor' back and compares it against 'kv' */
+static bool _fz_matches(hn4_volume_t* vol, const hn4_anchor_t* anchor, const uint8_t* kv) {
+    uint32_t payload = HN4_BLOCK_PayloadSize(FZ_BLK);
+    uint8_t* out = malloc(FZ_BLK);
+    bool ok = true;
+
+    for (uint64_t off = 0, b = 0; off < FZ_LEN && ok; off += payload, b++) {
+        uint64_t n = (FZ_LEN - off < payload) ? FZ_LEN - off : payload;
+        ok = hn4_read_block_atomic(vol, anchor, b, out, FZ_BLK,
+                                   HN4_PERM_SOVEREIGN | HN4_PERM_READ) == HN4_OK &&
+             memcmp(out, kv + off, n) == 0;
+    }
+
+    free(out);
+    return ok;
+}
+
+/*
+ * TEST 16: Freeze Read-Back
+ * RATIONALE: A multi-block snapshot written by the parallel pipeline must be
+ *            readable in full through its committed Anchor. Every block
+ *            carries the generation the Anchor was committed with, and
+ *            the commit leaves the namespace generation alone.
+ */
+hn4_TEST(TensorOps, Freeze_Read_Back) {
+    hn4_volume_t* vol = create_freeze_vol(false);
+    void* raw;
+    uint8_t* kv = _fz_kv(7, &raw);
+
+    ASSERT_EQ(HN4_OK, hn4_ai_freeze_context(vol, "ctx:a", kv, FZ_LEN, 0));
+
+    hn4_anchor_t anchor;
+    ASSERT_TRUE(_fz_find_anchor(vol, NULL, &anchor));
+    ASSERT_EQ(FZ_LEN, hn4_le64_to_cpu(anchor.mass));
+    ASSERT_TRUE(_fz_matches(vol, &anchor, kv));
+
+    /* A KV snapshot is never a tensor shard: manifests stay valid */
+    ASSERT_EQ(0u, atomic_load(&vol->ns_generation));
+
+    free(raw);
+    destroy_freeze_vol(vol);
+}
+
+/*
+ * TEST 17: Re-Freeze Is Independent
+ * RATIONALE: Freezing the same tag again writes a full snapshot under a new
+ *            Anchor. Both snapshots stay readable with their own contents.
+ */
+hn4_TEST(TensorOps, Refreeze_Is_Independent) {
+    hn4_volume_t* vol = create_freeze_vol(false);
+    void *raw_a, *raw_b;
+    uint8_t* kv_a = _fz_kv(7, &raw_a);
+    uint8_t* kv_b = _fz_kv(91, &raw_b);
+
+    ASSERT_EQ(HN4_OK, hn4_ai_freeze_context(vol, "ctx:a", kv_a, FZ_LEN, 0));
+    hn4_anchor_t first;
+    ASSERT_TRUE(_fz_find_anchor(vol, NULL, &first));
+
+    ASSERT_EQ(HN4_OK, hn4_ai_freeze_context(vol, "ctx:a", kv_b, FZ_LEN, 0));
+    hn4_anchor_t second;
+    ASSERT_TRUE(_fz_find_anchor(vol, &first, &second));
+
+    ASSERT_TRUE(_fz_matches(vol, &first, kv_a));
+    ASSERT_TRUE(_fz_matches(vol, &second, kv_b));
+
+    free(raw_a);
+    free(raw_b);
+    destroy_freeze_vol(vol);
+}
+
+/*
+ * TEST 18: Freeze Rollback
+ * RATIONALE: With one usable block a two-block freeze must fail, and the
+ *            rollback must free every block it took (data and Signet seal).
+ *            No Anchor may reach the Cortex.
+ */
+hn4_TEST(TensorOps, Freeze_Rollback_Frees_All) {
+    hn4_volume_t* vol = create_freeze_vol(true);
+    void* raw;
+    uint8_t* kv = _fz_kv(7, &raw);
+
+    ASSERT_TRUE(HN4_IS_ERR(hn4_ai_freeze_context(vol, "ctx:a", kv, FZ_LEN, 0)));
+    ASSERT_EQ(0, atomic_load(&vol->alloc.used_blocks));
+
+    hn4_armored_word_t* words = (hn4_armored_word_t*)vol->void_bitmap;
+    for (size_t i = 0; i < vol->bitmap_size / sizeof(hn4_armored_word_t); i++) {
+        ASSERT_EQ(0, words[i].data);
+    }
+
+    hn4_anchor_t anchor;
+    ASSERT_FALSE(_fz_find_anchor(vol, NULL, &anchor));
+
+    free(raw);
+    destroy_freeze_vol(vol);
+}
+
+/*
+ * TEST 19: KV Snapshots Are Not Shuffled
+ * RATIONALE: The shuffle element width lives in data_class next to the AI
+ *            type field. A compressed KV_CACHE block must be stored as plain
+ *            TCC: its type bits must not be read as an element width.
+ *            (Freezes never set HINT_COMPRESSED, so the block is written
+ *            directly under a KV_CACHE class.)
+ */
+hn4_TEST(TensorOps, KV_Cache_Not_Shuffled) {
+    hn4_volume_t* vol = create_freeze_vol(false);
+    void* raw;
+    uint8_t* kv = _fz_kv(7, &raw);
+    memset(kv, 0x11, 1024 * 1024); /* Compressible */
+
+    hn4_anchor_t anchor;
+    memset(&anchor, 0, sizeof(anchor));
+    anchor.seed_id.lo      = hn4_cpu_to_le64(0x4B56);
+    anchor.seed_id.hi      = hn4_cpu_to_le64(0xCAC4E);
+    anchor.orbit_vector[0] = 1;
+    anchor.data_class      = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_AI_TYPE_KV_CACHE |
+                                             HN4_HINT_COMPRESSED);
+    anchor.permissions     = hn4_cpu_to_le32(HN4_PERM_READ | HN4_PERM_WRITE);
+
+    ASSERT_EQ(HN4_OK, hn4_write_block_replace(vol, &anchor, 0, kv, 1024 * 1024,
+                                              HN4_PERM_SOVEREIGN | HN4_PERM_WRITE));
+
+    /* Locate the block in Flux by its backlink */
+    tensor_mock_dev_t* mdev = (tensor_mock_dev_t*)vol->target_device;
+    const hn4_block_header_t* hdr = NULL;
+    for (uint64_t b = 1; b < 10 && !hdr; b++) {
+        const hn4_block_header_t* h = (const hn4_block_header_t*)(mdev->mmio_base + b * FZ_BLK);
+        if (h->well_id.lo == anchor.seed_id.lo && h->well_id.hi == anchor.seed_id.hi) hdr = h;
+    }
+    ASSERT_TRUE(hdr != NULL);
+    ASSERT_EQ(HN4_COMP_TCC, hn4_le32_to_cpu(hdr->comp_meta) & HN4_COMP_ALGO_MASK);
+
+    free(raw);
+    destroy_freeze_vol(vol);
+}
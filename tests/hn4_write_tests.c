@@ -19,6 +19,10 @@
 #include "hn4_constants.h"
 #include "hn4_signet.h"
 #include "hn4_addr.h"
+#include "hn4_residency.h"
+#include "hn4_write.h"
+#include "hn4_compstat.h"
+#include "hn4_lexicon.h"
 #include <string.h>
 #include <stdlib.h>
 #include <pthread.h>
@@ -13764,4 +13768,654 @@ hn4_TEST(Write, Generation_Strict_Monotonicity_Check) {
     free(raw);
     hn4_unmount(vol);
     write_fixture_teardown(dev);
-}
\ No newline at end of file
+}
+/* =========================================================================
+ * RESIDENCY CACHE
+ * ========================================================================= */
+
+static void _res_make_anchor(hn4_anchor_t* a, uint64_t id, uint64_t G)
+{
+    memset(a, 0, sizeof(*a));
+    a->seed_id.lo     = id;
+    a->gravity_center = hn4_cpu_to_le64(G);
+    a->data_class     = hn4_cpu_to_le64(HN4_FLAG_VALID);
+    a->permissions    = hn4_cpu_to_le32(HN4_PERM_WRITE | HN4_PERM_READ);
+    a->write_gen      = hn4_cpu_to_le32(1);
+}
+
+/*
+ * TEST: Write.Residency_Overwrite_Skips_Probe_Read
+ * OBJECTIVE: A full-block overwrite right after a write of the same block
+ *            eclipses the old LBA without reading the device.
+ */
+hn4_TEST(Write, Residency_Overwrite_Skips_Probe_Read) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, W_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xE1E1, 9000);
+
+    uint32_t cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    uint8_t* data = calloc(1, cap);
+
+    memset(data, 0x11, cap);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 3, data, cap, 0));
+    uint64_t first = hn4_residency_lookup(vol, &anchor, 3);
+    ASSERT_TRUE(first != HN4_LBA_INVALID);
+
+    hn4_hal_sim_stats_t before, after;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &before));
+
+    memset(data, 0x22, cap);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 3, data, cap, 0));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &after));
+    ASSERT_EQ(0, after.reads - before.reads);
+
+    /* The old slot was eclipsed, the new one is remembered */
+    uint64_t second = hn4_residency_lookup(vol, &anchor, 3);
+    ASSERT_TRUE(second != HN4_LBA_INVALID && second != first);
+
+    bool is_set = true;
+    _bitmap_op(vol, first, BIT_TEST, &is_set);
+    ASSERT_FALSE(is_set);
+
+    uint8_t* out = calloc(1, vol->vol_block_size);
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 3, out, vol->vol_block_size, 0));
+    ASSERT_EQ(0, memcmp(out, data, cap));
+
+    free(out);
+    free(data);
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Residency_Stale_Entry_Misses
+ * OBJECTIVE: An entry is only trusted under the generation and trajectory
+ *            it was recorded with, and only while its LBA is still claimed.
+ */
+hn4_TEST(Write, Residency_Stale_Entry_Misses) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xE2E2, 11000);
+
+    uint8_t buf[16] = "RESIDENT";
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 0, buf, sizeof(buf), 0));
+
+    uint64_t lba = hn4_residency_lookup(vol, &anchor, 0);
+    ASSERT_EQ(_resolve_residency_verified(vol, &anchor, 0), lba);
+
+    /* Another generation */
+    hn4_anchor_t probe = anchor;
+    probe.write_gen = hn4_cpu_to_le32(hn4_le32_to_cpu(anchor.write_gen) + 1);
+    ASSERT_EQ(HN4_LBA_INVALID, hn4_residency_lookup(vol, &probe, 0));
+
+    /* Another trajectory (migration) */
+    probe = anchor;
+    probe.orbit_vector[0] ^= 0x5;
+    ASSERT_EQ(HN4_LBA_INVALID, hn4_residency_lookup(vol, &probe, 0));
+
+    /* Slot released behind the cache's back */
+    _bitmap_op(vol, lba, BIT_CLEAR, NULL);
+    ASSERT_EQ(HN4_LBA_INVALID, hn4_residency_lookup(vol, &anchor, 0));
+    _bitmap_op(vol, lba, BIT_SET, NULL);
+
+    hn4_residency_forget(vol, &anchor);
+    ASSERT_EQ(HN4_LBA_INVALID, hn4_residency_lookup(vol, &anchor, 0));
+
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Replace_Skips_Thaw_And_Probe
+ * OBJECTIVE: A full-block replace with a cached residency costs one device
+ *            write and no reads. A short payload zero-fills the tail
+ *            instead of thawing the old bytes. On a cold cache the old
+ *            block is found from its header sector and still eclipsed; an
+ *            append past the mass needs no probe at all.
+ */
+hn4_TEST(Write, Replace_Skips_Thaw_And_Probe) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    hn4_hal_sim_profile_t prof;
+    hn4_hal_sim_default_profile(HN4_DEV_SSD, &prof);
+    hn4_hal_device_t* sim = NULL;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_create(&prof, W_FIXTURE_SIZE, &sim));
+    vol->target_device = sim;
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xE3E3, 13000);
+
+    uint32_t cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    uint8_t* data = calloc(1, cap);
+    uint8_t* out  = calloc(1, vol->vol_block_size);
+
+    memset(data, 0x11, cap);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 5, data, cap, 0));
+    uint64_t first = hn4_residency_lookup(vol, &anchor, 5);
+    ASSERT_TRUE(first != HN4_LBA_INVALID);
+
+    /* 1. Cached residency: short replace, old slot eclipsed */
+    hn4_hal_sim_stats_t before, after;
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &before));
+
+    memset(data, 0x22, cap / 2);
+    ASSERT_EQ(HN4_OK, hn4_write_block_replace(vol, &anchor, 5, data, cap / 2, 0));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &after));
+    ASSERT_EQ(0, after.reads - before.reads);
+    ASSERT_EQ(1, after.writes - before.writes);
+
+    bool is_set = true;
+    _bitmap_op(vol, first, BIT_TEST, &is_set);
+    ASSERT_FALSE(is_set);
+
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 5, out, vol->vol_block_size, 0));
+    ASSERT_EQ(0x22, out[0]);
+    ASSERT_EQ(0x22, out[cap / 2 - 1]);
+    ASSERT_EQ(0, out[cap / 2]);
+    ASSERT_EQ(0, out[cap - 1]);
+
+    /* 2. Cold cache: header-only probe, the old slot is still eclipsed */
+    uint64_t second = hn4_residency_lookup(vol, &anchor, 5);
+    ASSERT_TRUE(second != HN4_LBA_INVALID);
+    hn4_residency_forget(vol, &anchor);
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &before));
+
+    memset(data, 0x33, cap);
+    ASSERT_EQ(HN4_OK, hn4_write_block_replace(vol, &anchor, 5, data, cap, 0));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &after));
+    ASSERT_TRUE(after.reads - before.reads >= 1);
+    /* One sector per candidate, never a whole block */
+    uint32_t ss = hn4_hal_get_caps(sim)->logical_block_size;
+    ASSERT_EQ((after.reads - before.reads) * ss, after.bytes_read - before.bytes_read);
+    ASSERT_EQ(1, after.writes - before.writes);
+
+    is_set = true;
+    _bitmap_op(vol, second, BIT_TEST, &is_set);
+    ASSERT_FALSE(is_set);
+
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 5, out, vol->vol_block_size, 0));
+    ASSERT_EQ(0, memcmp(out, data, cap));
+
+    /* 3. Append past the mass: nothing to eclipse, nothing read */
+    hn4_residency_forget(vol, &anchor);
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &before));
+
+    ASSERT_EQ(HN4_OK, hn4_write_block_replace(vol, &anchor, 6, data, cap, 0));
+
+    ASSERT_EQ(HN4_OK, hn4_hal_sim_get_stats(sim, &after));
+    ASSERT_EQ(0, after.reads - before.reads);
+    ASSERT_EQ(1, after.writes - before.writes);
+
+    free(out);
+    free(data);
+    vol->target_device = dev;
+    hn4_hal_sim_destroy(sim);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Pipeline_Compresses_Every_Block
+ * OBJECTIVE: A multi-block write on a compressing file stores every block
+ *            TCC-compressed (worker-side compression feeds the writer) and
+ *            each one decodes back to its source slice.
+ */
+hn4_TEST(Write, Pipeline_Compresses_Every_Block) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t spb = bs / 512;
+    uint32_t cap = HN4_BLOCK_PayloadSize(bs);
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xE4E4, 15000);
+    anchor.orbit_vector[0] = 1;
+    anchor.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED);
+
+    const uint64_t blocks = 12;
+    uint64_t len = blocks * cap - 100;  /* Short tail block */
+    uint8_t* src = malloc(len);
+    for (uint64_t i = 0; i < len; i++) src[i] = (uint8_t)('a' + ((i / cap) % 26));
+
+    uint64_t done = 0;
+    ASSERT_EQ(HN4_OK, hn4_write_blocks_atomic(vol, &anchor, 0, src, len, 0, &done));
+    ASSERT_EQ(blocks, done);
+    ASSERT_EQ(len, hn4_le64_to_cpu(anchor.mass));
+
+    /* Hosted build: the pipeline ran on workers */
+    ASSERT_TRUE(atomic_load(&vol->comp_workq) != NULL);
+
+    uint8_t* raw = calloc(1, bs);
+    uint8_t* out = calloc(1, cap);
+    for (uint64_t b = 0; b < blocks; b++) {
+        uint64_t lba = _calc_trajectory_lba(vol, 15000, 1, b, 0, 0);
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), raw, spb));
+
+        hn4_block_header_t* h = (hn4_block_header_t*)raw;
+        uint32_t meta = hn4_le32_to_cpu(h->comp_meta);
+        ASSERT_EQ(HN4_COMP_TCC, meta & HN4_COMP_ALGO_MASK);
+
+        uint32_t want = (b == blocks - 1) ? cap - 100 : cap;
+        uint32_t got = 0;
+        ASSERT_EQ(HN4_OK, hn4_decompress_block(h->payload, meta >> HN4_COMP_SIZE_SHIFT, out, cap, &got));
+        ASSERT_EQ(want, got);
+        ASSERT_EQ(0, memcmp(out, src + b * cap, want));
+    }
+
+    free(out);
+    free(raw);
+    free(src);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Adaptive_Compression_Backs_Off
+ * OBJECTIVE: Incompressible blocks on a compressing file stop being fed to
+ *            TCC after HN4_CSTAT_FAIL_LIMIT failures, a failed probe doubles
+ *            the skip window, and one profitable block restores the default.
+ */
+hn4_TEST(Write, Adaptive_Compression_Backs_Off) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xC5C5, 16000);
+    anchor.orbit_vector[0] = 1;
+    anchor.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED);
+
+    uint8_t* noise = malloc(cap);
+    uint8_t* text  = malloc(cap);
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < cap; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        noise[i] = (uint8_t)x;
+        text[i]  = (uint8_t)('a' + ((i / 256) % 26));
+    }
+
+    hn4_compstat_t st;
+    ASSERT_EQ(HN4_ERR_NOT_FOUND, hn4_compstat_query(vol, &anchor, &st));
+
+    uint64_t b = 0;
+    for (int i = 0; i < HN4_CSTAT_FAIL_LIMIT; i++) {
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b++, noise, cap, 0));
+    }
+    ASSERT_EQ(HN4_OK, hn4_compstat_query(vol, &anchor, &st));
+    ASSERT_EQ(HN4_CSTAT_FAIL_LIMIT, st.attempts);
+    ASSERT_EQ(0, st.wins);
+    ASSERT_EQ(HN4_CSTAT_BACKOFF_MIN, st.backoff);
+    ASSERT_TRUE(st.ratio_q16 >= 65536 - (65536 >> HN4_CSTAT_MIN_GAIN_SHIFT));
+
+    /* Window: skipped outright */
+    for (int i = 0; i < HN4_CSTAT_BACKOFF_MIN; i++) {
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b++, noise, cap, 0));
+    }
+    ASSERT_EQ(HN4_OK, hn4_compstat_query(vol, &anchor, &st));
+    ASSERT_EQ(HN4_CSTAT_FAIL_LIMIT, st.attempts);
+    ASSERT_EQ(HN4_CSTAT_BACKOFF_MIN, st.skipped);
+    ASSERT_EQ(0, st.backoff);
+
+    /* Failed probe doubles the window */
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b++, noise, cap, 0));
+    ASSERT_EQ(HN4_OK, hn4_compstat_query(vol, &anchor, &st));
+    ASSERT_EQ(HN4_CSTAT_FAIL_LIMIT + 1, st.attempts);
+    ASSERT_EQ(2 * HN4_CSTAT_BACKOFF_MIN, st.backoff);
+
+    /* Compressible data is not even tried until the window runs out */
+    for (int i = 0; i < 2 * HN4_CSTAT_BACKOFF_MIN; i++) {
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b++, text, cap, 0));
+    }
+    ASSERT_EQ(HN4_OK, hn4_compstat_query(vol, &anchor, &st));
+    ASSERT_EQ(HN4_CSTAT_FAIL_LIMIT + 1, st.attempts);
+    ASSERT_EQ(3 * HN4_CSTAT_BACKOFF_MIN, st.skipped);
+
+    /* The next probe wins and resets the policy */
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b++, text, cap, 0));
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b++, text, cap, 0));
+    ASSERT_EQ(HN4_OK, hn4_compstat_query(vol, &anchor, &st));
+    ASSERT_EQ(HN4_CSTAT_FAIL_LIMIT + 3, st.attempts);
+    ASSERT_EQ(2, st.wins);
+    ASSERT_EQ(0, st.fail_streak);
+    ASSERT_EQ(0, st.backoff);
+    ASSERT_TRUE(st.bytes_out < st.bytes_in);
+
+    /* Volume totals mirror the only file that compressed */
+    hn4_compstat_t vt;
+    ASSERT_EQ(HN4_OK, hn4_compstat_query(vol, NULL, &vt));
+    ASSERT_EQ(st.attempts, vt.attempts);
+    ASSERT_EQ(st.skipped, vt.skipped);
+    ASSERT_EQ(st.bytes_in, vt.bytes_in);
+
+    free(text);
+    free(noise);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/* Log lines over a vocabulary the static TCC lexicon does not know */
+static uint32_t _lex_make_log(char* out, uint32_t cap, uint64_t seed)
+{
+    static const char* const words[] = {
+        "kvstore.shard_rebalance", "quorum_lease_renewed", "replica_lag_ms=",
+        "compaction_backlog_bytes=", "tombstone_sweep_done", "hinted_handoff_queue="
+    };
+    uint32_t len = 0;
+    while (len + 80 < cap) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        len += (uint32_t)sprintf(out + len, "%s %s%u\n", words[(seed >> 33) % 6],
+                                 words[2 + (seed >> 40) % 4], (uint32_t)(seed >> 52));
+    }
+    memset(out + len, '\n', cap - len);
+    return cap;
+}
+
+/*
+ * TEST: Write.Trained_Lexicon_Survives_Generations
+ * OBJECTIVE: A trained lexicon is persisted and chained from the
+ *            Superblock, compresses only once loaded by the mount hook,
+ *            and every generation still decodes its blocks after a newer
+ *            one is trained and the volume is remounted.
+ */
+hn4_TEST(Write, Trained_Lexicon_Survives_Generations) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t spb = bs / 512;
+    uint32_t cap = HN4_BLOCK_PayloadSize(bs);
+
+    char* sample = malloc(16384);
+    char* text   = malloc(cap);
+    char* back   = malloc(cap);
+    uint8_t* raw = calloc(1, bs);
+    _lex_make_log(text, cap, 2);
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0x1E71, 17000);
+    anchor.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED);
+
+    uint32_t size[3], bound[3];
+    for (uint32_t b = 0; b < 3; b++) {
+        if (b > 0) {
+            /* Train generation b; it compresses only after the mount hook */
+            uint32_t gen = 0;
+            ASSERT_EQ(HN4_OK, hn4_lexicon_train(vol, sample, _lex_make_log(sample, 16384, 10 + b), &gen));
+            ASSERT_EQ(b, gen);
+            ASSERT_EQ(b, vol->sb.info.lexicon_gen);
+            ASSERT_TRUE(vol->sb.info.incompat_flags & HN4_INCOMPAT_TCC_LEXICON);
+            ASSERT_TRUE(hn4_lexicon_get(vol, b) != NULL);
+            ASSERT_TRUE(hn4_lexicon_active(vol) == (b > 1 ? hn4_lexicon_get(vol, b - 1) : NULL));
+
+            hn4_lexicon_release(vol);
+            ASSERT_EQ(HN4_OK, hn4_lexicon_load(vol));
+            ASSERT_EQ(b, hn4_lexicon_active(vol)->generation);
+        }
+
+        ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, b, text, cap, 0));
+
+        uint64_t lba = _calc_trajectory_lba(vol, 17000, 0, b, 0, 0);
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), raw, spb));
+        hn4_block_header_t* h = (hn4_block_header_t*)raw;
+        uint32_t meta = hn4_le32_to_cpu(h->comp_meta);
+        ASSERT_EQ(HN4_COMP_TCC, meta & HN4_COMP_ALGO_MASK);
+        size[b]  = meta >> HN4_COMP_SIZE_SHIFT;
+        bound[b] = hn4_tcc_stream_lexicon(h->payload, size[b]);
+    }
+
+    ASSERT_EQ(0, bound[0]);
+    ASSERT_EQ(1, bound[1]);
+    ASSERT_EQ(2, bound[2]);
+    ASSERT_TRUE(size[1] < size[0]);
+    ASSERT_TRUE(size[2] < size[0]);
+
+    hn4_unmount(vol);
+    vol = NULL;
+
+    /* Chain is reloaded from media; old generations still decode */
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+    ASSERT_EQ(2, vol->sb.info.lexicon_gen);
+    ASSERT_EQ(2, hn4_lexicon_active(vol)->generation);
+
+    /* Reads are strict on generation: only the newest block via the API */
+    memset(back, 0, cap);
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, 2, back, cap, HN4_PERM_READ));
+    ASSERT_EQ(0, memcmp(text, back, cap));
+
+    uint32_t got = 0;
+    for (uint32_t b = 0; b < 2; b++) {
+        uint64_t lba = _calc_trajectory_lba(vol, 17000, 0, b, 0, 0);
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), raw, spb));
+        hn4_block_header_t* h = (hn4_block_header_t*)raw;
+        memset(back, 0, cap);
+        ASSERT_EQ(HN4_OK, hn4_decompress_block_ex(h->payload, size[b], back, cap, &got,
+                                                  hn4_lexicon_get(vol, bound[b])));
+        ASSERT_EQ(cap, got);
+        ASSERT_EQ(0, memcmp(text, back, cap));
+    }
+
+    /* Block 1 is bound to generation 1, not the active one */
+    ASSERT_EQ(HN4_ERR_DECOMPRESS_FAIL, hn4_decompress_block_ex(((hn4_block_header_t*)raw)->payload, size[1],
+                                                               back, cap, &got, hn4_lexicon_get(vol, 2)));
+
+    free(raw);
+    free(back);
+    free(text);
+    free(sample);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Echo_Raises_Incompat
+ * OBJECTIVE: Storing the first block with ECHO back-references raises
+ *            HN4_INCOMPAT_TCC_ECHO, and the bit reaches the Superblock
+ *            at unmount so older drivers refuse the volume.
+ */
+hn4_TEST(Write, Echo_Raises_Incompat) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t spb = bs / 512;
+    uint32_t cap = HN4_BLOCK_PayloadSize(bs);
+
+    char* text   = malloc(cap);
+    uint8_t* raw = calloc(1, bs);
+    _lex_make_log(text, cap, 7);
+
+    ASSERT_EQ(0, vol->sb.info.incompat_flags & HN4_INCOMPAT_TCC_ECHO);
+    ASSERT_EQ(0, atomic_load(&vol->incompat_written));
+
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xEC40, 18000);
+    anchor.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 0, text, cap, 0));
+
+    uint64_t lba = _calc_trajectory_lba(vol, 18000, 0, 0, 0, 0);
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), raw, spb));
+    hn4_block_header_t* h = (hn4_block_header_t*)raw;
+    uint32_t meta = hn4_le32_to_cpu(h->comp_meta);
+    ASSERT_EQ(HN4_COMP_TCC, meta & HN4_COMP_ALGO_MASK);
+    ASSERT_EQ(HN4_TCC_USES_ECHO, hn4_tcc_stream_features(h->payload, meta >> HN4_COMP_SIZE_SHIFT));
+    ASSERT_EQ(HN4_INCOMPAT_TCC_ECHO, atomic_load(&vol->incompat_written));
+
+    hn4_unmount(vol);
+    vol = NULL;
+
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+    ASSERT_TRUE(vol->sb.info.incompat_flags & HN4_INCOMPAT_TCC_ECHO);
+
+    free(raw);
+    free(text);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Entropy_Raises_Incompat
+ * OBJECTIVE: An ARCHIVE volume storing its first entropy-coded block
+ *            raises HN4_INCOMPAT_TCC_ENTROPY, persisted at unmount.
+ */
+hn4_TEST(Write, Entropy_Raises_Incompat) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t cap = HN4_BLOCK_PayloadSize(vol->vol_block_size);
+    char* text = malloc(cap);
+    _lex_make_log(text, cap, 9);
+
+    /* Non-ARCHIVE profiles never entropy-code */
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0xE470, 19000);
+    anchor.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 0, text, cap, 0));
+    ASSERT_EQ(0, atomic_load(&vol->incompat_written) & HN4_INCOMPAT_TCC_ENTROPY);
+
+    vol->sb.info.format_profile = HN4_PROFILE_ARCHIVE;
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &anchor, 1, text, cap, 0));
+    ASSERT_TRUE(atomic_load(&vol->incompat_written) & HN4_INCOMPAT_TCC_ENTROPY);
+
+    hn4_unmount(vol);
+    vol = NULL;
+
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+    ASSERT_TRUE(vol->sb.info.incompat_flags & HN4_INCOMPAT_TCC_ENTROPY);
+
+    free(text);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}
+
+/*
+ * TEST: Write.Shuffle_Filter_Numeric_Blocks
+ * OBJECTIVE: A file that declares its element width is stored byte-plane
+ *            shuffled (HN4_COMP_TCC_SHUFFLE, filter byte first) on both the
+ *            pipelined and the single-block path, comes out smaller than
+ *            plain TCC, and reads back unshuffled. The first shuffled
+ *            block raises HN4_INCOMPAT_TCC_SHUFFLE.
+ */
+hn4_TEST(Write, Shuffle_Filter_Numeric_Blocks) {
+    hn4_hal_device_t* dev = write_fixture_setup();
+    hn4_volume_t* vol = NULL;
+    hn4_mount_params_t p = {0};
+    ASSERT_EQ(HN4_OK, hn4_mount(dev, &p, &vol));
+
+    uint32_t bs  = vol->vol_block_size;
+    uint32_t spb = bs / 512;
+    uint32_t cap = HN4_BLOCK_PayloadSize(bs) & ~3U;
+
+    /* fp32 weights: two exponents, random mantissa */
+    const uint64_t blocks = 4;
+    uint64_t len = blocks * cap;
+    uint32_t* src = malloc(len);
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint64_t i = 0; i < len / 4; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        src[i] = ((124u + (uint32_t)(x & 1)) << 23) | (uint32_t)((x >> 8) & 0x7FFFFF);
+    }
+
+    uint8_t* raw    = calloc(1, bs);
+    uint8_t* planes = malloc(cap);
+    uint8_t* out    = malloc(cap);
+    uint8_t* plain  = malloc(hn4_compress_bound(cap));
+    uint32_t plain_len = 0;
+    ASSERT_EQ(HN4_OK, hn4_compress_block(src, cap, plain, hn4_compress_bound(cap),
+                                         &plain_len, HN4_DEV_SSD, 0));
+
+    /* 1. Pipelined path, 4-byte elements */
+    hn4_anchor_t anchor;
+    _res_make_anchor(&anchor, 0x5F5F, 18000);
+    anchor.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED |
+                                        (2ULL << HN4_HINT_ELEM_SHIFT));
+
+    uint64_t done = 0;
+    ASSERT_EQ(0, atomic_load(&vol->incompat_written) & HN4_INCOMPAT_TCC_SHUFFLE);
+    ASSERT_EQ(HN4_OK, hn4_write_blocks_atomic(vol, &anchor, 0, src, len, 0, &done));
+    ASSERT_EQ(blocks, done);
+    ASSERT_TRUE(atomic_load(&vol->incompat_written) & HN4_INCOMPAT_TCC_SHUFFLE);
+
+    for (uint64_t b = 0; b < blocks; b++) {
+        uint64_t lba = _calc_trajectory_lba(vol, 18000, 0, b, 0, 0);
+        ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), raw, spb));
+
+        hn4_block_header_t* h = (hn4_block_header_t*)raw;
+        uint32_t meta = hn4_le32_to_cpu(h->comp_meta);
+        uint32_t size = meta >> HN4_COMP_SIZE_SHIFT;
+        ASSERT_EQ(HN4_COMP_TCC_SHUFFLE, meta & HN4_COMP_ALGO_MASK);
+        ASSERT_EQ(4, h->payload[0]);
+        if (b == 0) ASSERT_TRUE(size < plain_len);
+
+        uint32_t got = 0;
+        ASSERT_EQ(HN4_OK, hn4_decompress_block(h->payload + 1, size - 1, planes, cap, &got));
+        ASSERT_EQ(cap, got);
+        ASSERT_TRUE(hn4_unshuffle(planes, out, cap, h->payload[0]));
+        ASSERT_EQ(0, memcmp(out, (uint8_t*)src + b * cap, cap));
+    }
+
+    memset(out, 0, cap);
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &anchor, blocks - 1, out, cap, HN4_PERM_READ));
+    ASSERT_EQ(0, memcmp(out, (uint8_t*)src + (blocks - 1) * cap, cap));
+
+    /* 2. Single-block path, bf16 (top half of each fp32) with bit planes */
+    uint16_t* bf16 = (uint16_t*)planes;
+    for (uint32_t i = 0; i < cap / 2; i++) bf16[i] = (uint16_t)(src[i] >> 16);
+
+    hn4_anchor_t a16;
+    _res_make_anchor(&a16, 0x5F60, 18100);
+    a16.data_class = hn4_cpu_to_le64(HN4_FLAG_VALID | HN4_HINT_COMPRESSED |
+                                     (1ULL << HN4_HINT_ELEM_SHIFT) | HN4_HINT_BITSHUFFLE);
+    ASSERT_EQ(HN4_OK, hn4_write_block_atomic(vol, &a16, 0, bf16, cap, 0));
+
+    uint64_t lba = _calc_trajectory_lba(vol, 18100, 0, 0, 0, 0);
+    ASSERT_EQ(HN4_OK, hn4_hal_sync_io(dev, HN4_IO_READ, hn4_lba_from_blocks(lba * spb), raw, spb));
+    hn4_block_header_t* h = (hn4_block_header_t*)raw;
+    ASSERT_EQ(HN4_COMP_TCC_SHUFFLE, hn4_le32_to_cpu(h->comp_meta) & HN4_COMP_ALGO_MASK);
+    ASSERT_EQ(2 | HN4_SHUF_BITS, h->payload[0]);
+
+    memset(out, 0, cap);
+    ASSERT_EQ(HN4_OK, hn4_read_block_atomic(vol, &a16, 0, out, cap, HN4_PERM_READ));
+    ASSERT_EQ(0, memcmp(out, bf16, cap));
+
+    free(plain);
+    free(out);
+    free(planes);
+    free(raw);
+    free(src);
+    hn4_unmount(vol);
+    write_fixture_teardown(dev);
+}